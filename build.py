@@ -10,12 +10,16 @@ build_type_group.add_argument('-r', '--release', dest='build_type', action='stor
 parser.set_defaults(build_type='Release')
 parser.add_argument('-a', '--asan', action='store_const', const='ON', default='OFF')
 parser.add_argument('-t', '--test', action='store_const', const='ON', default='OFF')
+parser.add_argument('-b', '--bench', action='store_const', const='ON', default='OFF')
+parser.add_argument('-p', '--python', action='store_const', const='ON', default='OFF')
 
 args = parser.parse_args()
 
 cmake_args = f'-DCMAKE_BUILD_TYPE={args.build_type} '
 cmake_args += f'-DENABLE_ASAN={args.asan} '
 cmake_args += f'-DENABLE_TEST={args.test} '
+cmake_args += f'-DENABLE_BENCH={args.bench} '
+cmake_args += f'-DENABLE_PYTHON={args.python} '
 
 def system_errexit(command: str):
     res = os.system(command)
@@ -0,0 +1,47 @@
+#! /usr/bin/env python3
+# 比较两次Google Benchmark的JSON输出，新结果比基准慢超过阈值的用例视为性能回退，存在回退时返回1
+import sys
+import json
+import argparse
+
+parser = argparse.ArgumentParser(description='compare benchmark results')
+parser.add_argument('baseline', help='baseline JSON output')
+parser.add_argument('contender', help='contender JSON output')
+parser.add_argument('-t', '--threshold', type=float, default=0.1, help='allowed relative slowdown, default 0.1')
+parser.add_argument('-m', '--metric', choices=['real_time', 'cpu_time'], default='real_time')
+
+args = parser.parse_args()
+
+# 重复运行时取均值聚合结果，否则取单次结果
+def load_times(path: str) -> dict:
+    with open(path) as f:
+        benchmarks = json.load(f)['benchmarks']
+    times = {}
+    for bench in benchmarks:
+        if bench.get('error_occurred'):
+            continue
+        if bench.get('run_type') == 'aggregate':
+            if bench.get('aggregate_name') == 'mean':
+                times[bench['run_name']] = bench[args.metric]
+        elif bench.get('run_name', bench['name']) not in times:
+            times[bench.get('run_name', bench['name'])] = bench[args.metric]
+    return times
+
+baseline = load_times(args.baseline)
+contender = load_times(args.contender)
+
+regressions = []
+width = max((len(name) for name in baseline), default=0)
+for name, base_time in baseline.items():
+    if name not in contender:
+        print(f'{name:<{width}}  missing in contender')
+        continue
+    ratio = contender[name] / base_time if base_time > 0 else 1.
+    mark = ''
+    if ratio > 1. + args.threshold:
+        mark = '  REGRESSION'
+        regressions.append(name)
+    print(f'{name:<{width}}  {base_time:12.3f}  {contender[name]:12.3f}  {ratio - 1.:+8.2%}{mark}')
+
+print(f'{len(regressions)} regression(s) beyond {args.threshold:.0%} in {len(baseline)} benchmark(s)')
+sys.exit(1 if regressions else 0)
@@ -0,0 +1,169 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace oops {
+// 缓存行大小，亦满足AVX-512对齐加载
+constexpr std::size_t CACHE_LINE_SIZE{64};
+// 透明大页大小
+constexpr std::size_t HUGE_PAGE_SIZE{std::size_t{2} << 20};
+
+namespace detail {
+inline std::size_t AllocationBytes(std::size_t n, std::size_t size) {
+    if (n > std::numeric_limits<std::size_t>::max() / size) {
+        throw std::bad_array_new_length();
+    }
+    return n * size;
+}
+
+// 以madvise(MADV_HUGEPAGE)提示内核对[p, p + bytes)使用透明大页，不支持时忽略
+void AdviseHugePage(void *p, std::size_t bytes) noexcept;
+} // namespace detail
+
+// 对齐分配器，首地址按Alignment对齐
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+public:
+    using value_type = T;
+    static constexpr std::size_t ALIGNMENT{Alignment > alignof(T) ? Alignment : alignof(T)};
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(detail::AllocationBytes(n, sizeof(T)), std::align_val_t{ALIGNMENT}));
+    }
+    void deallocate(T *p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{ALIGNMENT}); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept {
+        return false;
+    }
+};
+
+// 透明大页分配器：不小于HUGE_PAGE_SIZE的分配按大页对齐、长度取整并提示内核使用大页，减少TLB缺失
+// 较小的分配按缓存行对齐
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    HugePageAllocator() noexcept = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        const std::size_t bytes{detail::AllocationBytes(n, sizeof(T))};
+        if (bytes < HUGE_PAGE_SIZE) {
+            return static_cast<T *>(::operator new(bytes, std::align_val_t{SmallAlignment()}));
+        }
+        const std::size_t rounded{RoundUp(bytes)};
+        void *p{::operator new(rounded, std::align_val_t{HUGE_PAGE_SIZE})};
+        detail::AdviseHugePage(p, rounded);
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept {
+        if (n * sizeof(T) < HUGE_PAGE_SIZE) {
+            ::operator delete(p, std::align_val_t{SmallAlignment()});
+        } else {
+            ::operator delete(p, std::align_val_t{HUGE_PAGE_SIZE});
+        }
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U> &) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U> &) const noexcept {
+        return false;
+    }
+
+private:
+    static constexpr std::size_t SmallAlignment() {
+        return CACHE_LINE_SIZE > alignof(T) ? CACHE_LINE_SIZE : alignof(T);
+    }
+    static std::size_t RoundUp(std::size_t bytes) {
+        if (bytes > std::numeric_limits<std::size_t>::max() - HUGE_PAGE_SIZE) {
+            throw std::bad_array_new_length();
+        }
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+};
+
+// 缓冲回收池：释放的缓冲按2的幂字节数分级缓存，后续同级分配直接复用，缓冲按缓存行对齐
+// 适用于重复加载、转换同规模矩阵时避免反复向系统申请与归还内存
+class BufferPool {
+public:
+    BufferPool() = default;
+    ~BufferPool();
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    // 全局实例，有意不析构，保证静态对象析构时仍可归还缓冲
+    static BufferPool &Get();
+
+    void *Allocate(std::size_t bytes);
+    void Deallocate(void *p, std::size_t bytes) noexcept;
+
+    // 缓存总量上限，超出时归还的缓冲直接释放
+    void SetCapacity(std::size_t bytes);
+    std::size_t CachedBytes() const;
+    // 释放全部缓存
+    void Release();
+
+private:
+    static constexpr std::size_t NUM_CLASSES{std::numeric_limits<std::size_t>::digits};
+
+    static std::size_t SizeClass(std::size_t bytes);
+
+    mutable std::mutex mutex_;
+    std::array<std::vector<void *>, NUM_CLASSES> free_lists_;
+    std::size_t cached_bytes_{0};
+    std::size_t capacity_{std::size_t{1} << 30};
+};
+
+// 使用全局BufferPool的分配器
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        static_assert(alignof(T) <= CACHE_LINE_SIZE);
+        return static_cast<T *>(BufferPool::Get().Allocate(detail::AllocationBytes(n, sizeof(T))));
+    }
+    void deallocate(T *p, std::size_t n) noexcept { BufferPool::Get().Deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const noexcept {
+        return false;
+    }
+};
+} // namespace oops
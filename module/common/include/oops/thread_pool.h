@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace oops {
+// 非持有的可调用对象引用，避免std::function在每次并行调用时的堆分配
+template <typename Signature>
+class FunctionRef;
+
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+public:
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef>>>
+    FunctionRef(F &&f) noexcept
+        : obj_{const_cast<void *>(static_cast<const void *>(std::addressof(f)))},
+          call_{[](void *obj, Args... args) -> R {
+              return (*static_cast<std::add_pointer_t<F>>(obj))(std::forward<Args>(args)...);
+          }} {}
+
+    R operator()(Args... args) const { return call_(obj_, std::forward<Args>(args)...); }
+
+private:
+    void *obj_;
+    R (*call_)(void *, Args...);
+};
+
+// 固定线程数的线程池，调用线程参与并行任务执行
+// 1. Run：同步数据并行，任务状态位于调用栈上，不产生堆分配，嵌套调用退化为串行
+// 2. Submit：异步任务提交，返回std::future
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t num_threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // 获取默认全局实例，线程数可由环境变量OOPS_NUM_THREADS指定
+    static ThreadPool &Get();
+
+    // 并行度，包含调用线程
+    std::size_t Size() const { return workers_.size() + 1; }
+
+    // 执行f(task)，task取值[0, num_tasks)，阻塞至全部任务完成，首个异常在调用线程重新抛出
+    void Run(std::size_t num_tasks, FunctionRef<void(std::size_t)> f);
+
+    template <typename F>
+    auto Submit(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto task{std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f))};
+        auto future{task->get_future()};
+        if (workers_.empty()) {
+            (*task)();
+            return future;
+        }
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.emplace_back([task] { (*task)(); });
+        }
+        cv_.notify_one();
+        return future;
+    }
+
+    // 当前线程是否处于并行区域中
+    static bool InParallel();
+
+private:
+    struct Job {
+        Job(FunctionRef<void(std::size_t)> f, std::size_t num_tasks) : f{f}, num_tasks{num_tasks} {}
+
+        FunctionRef<void(std::size_t)> f;
+        std::size_t num_tasks{};
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::size_t active{0}; // 参与执行的工作线程数，受mutex_保护
+        std::exception_ptr exception;
+        std::mutex exception_mutex;
+    };
+
+    void WorkerLoop();
+    static void Execute(Job &job);
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    Job *job_{nullptr};
+    std::size_t job_generation_{0};
+    bool stop_{false};
+
+    std::mutex run_mutex_; // 串行化来自不同线程的Run
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+};
+
+// [begin, end)按grain切分为连续块并行执行f(block_begin, block_end)
+template <typename F>
+void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F &&f) {
+    if (end <= begin) {
+        return;
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t num_blocks{(end - begin + grain - 1) / grain};
+    if (num_blocks == 1) {
+        f(begin, end);
+        return;
+    }
+    ThreadPool::Get().Run(num_blocks, [begin, end, grain, &f](std::size_t block) {
+        std::size_t block_begin{begin + block * grain};
+        f(block_begin, std::min(block_begin + grain, end));
+    });
+}
+
+// [0, n)均分为num_chunks块执行f(chunk, chunk_begin, chunk_end)，块划分只依赖n和num_chunks
+template <typename F>
+void ParallelChunks(std::size_t n, std::size_t num_chunks, F &&f) {
+    num_chunks = std::max<std::size_t>(std::min(num_chunks, n), 1);
+    auto chunk_range = [n, num_chunks](std::size_t chunk) { return chunk * n / num_chunks; };
+    if (num_chunks == 1) {
+        f(std::size_t{0}, std::size_t{0}, n);
+        return;
+    }
+    ThreadPool::Get().Run(num_chunks, [&f, &chunk_range](std::size_t chunk) {
+        f(chunk, chunk_range(chunk), chunk_range(chunk + 1));
+    });
+}
+
+// 规约分块：块划分只依赖向量长度，结果与线程数无关，可复现
+constexpr std::size_t REDUCE_GRAIN{4096};
+constexpr std::size_t REDUCE_MAX_CHUNKS{256};
+
+inline std::size_t ReduceChunks(std::size_t n) {
+    return std::clamp<std::size_t>((n + REDUCE_GRAIN - 1) / REDUCE_GRAIN, 1, REDUCE_MAX_CHUNKS);
+}
+
+// 并行规约K个标量，f(begin, end)返回区间内的K个部分和，块间按固定顺序求和
+template <std::size_t K, typename Value, typename F>
+std::array<Value, K> ParallelReduce(std::size_t n, F &&f) {
+    std::array<std::array<Value, K>, REDUCE_MAX_CHUNKS> partials;
+    std::size_t num_chunks{ReduceChunks(n)};
+    ParallelChunks(n, num_chunks, [&partials, &f](std::size_t chunk, std::size_t begin, std::size_t end) {
+        partials[chunk] = f(begin, end);
+    });
+    std::array<Value, K> res{};
+    for (std::size_t chunk{0}; chunk < num_chunks; ++chunk) {
+        for (std::size_t k{0}; k < K; ++k) {
+            res[k] += partials[chunk][k];
+        }
+    }
+    return res;
+}
+} // namespace oops
@@ -0,0 +1,95 @@
+#include "oops/allocator.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace oops {
+namespace detail {
+void AdviseHugePage(void *p, std::size_t bytes) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // 内核未开启透明大页时madvise失败，不影响正确性
+    static_cast<void>(madvise(p, bytes, MADV_HUGEPAGE));
+#else
+    static_cast<void>(p);
+    static_cast<void>(bytes);
+#endif
+}
+} // namespace detail
+
+BufferPool::~BufferPool() { Release(); }
+
+BufferPool &BufferPool::Get() {
+    static BufferPool *instance{new BufferPool};
+    return *instance;
+}
+
+std::size_t BufferPool::SizeClass(std::size_t bytes) {
+    std::size_t size_class{6}; // 最小64字节
+    while (size_class + 1 < NUM_CLASSES && (std::size_t{1} << size_class) < bytes) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+void *BufferPool::Allocate(std::size_t bytes) {
+    const std::size_t size_class{SizeClass(bytes)};
+    const std::size_t class_bytes{std::size_t{1} << size_class};
+    if (class_bytes < bytes) {
+        throw std::bad_array_new_length();
+    }
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto &free_list{free_lists_[size_class]};
+        if (!free_list.empty()) {
+            void *p{free_list.back()};
+            free_list.pop_back();
+            cached_bytes_ -= class_bytes;
+            return p;
+        }
+    }
+    return ::operator new(class_bytes, std::align_val_t{CACHE_LINE_SIZE});
+}
+
+void BufferPool::Deallocate(void *p, std::size_t bytes) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+    const std::size_t size_class{SizeClass(bytes)};
+    const std::size_t class_bytes{std::size_t{1} << size_class};
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (cached_bytes_ + class_bytes <= capacity_) {
+            try {
+                free_lists_[size_class].push_back(p);
+                cached_bytes_ += class_bytes;
+                return;
+            } catch (const std::bad_alloc &) {
+                // 登记失败时直接释放
+            }
+        }
+    }
+    ::operator delete(p, std::align_val_t{CACHE_LINE_SIZE});
+}
+
+void BufferPool::SetCapacity(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    capacity_ = bytes;
+}
+
+std::size_t BufferPool::CachedBytes() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return cached_bytes_;
+}
+
+void BufferPool::Release() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (auto &free_list : free_lists_) {
+        for (void *p : free_list) {
+            ::operator delete(p, std::align_val_t{CACHE_LINE_SIZE});
+        }
+        free_list.clear();
+    }
+    cached_bytes_ = 0;
+}
+} // namespace oops
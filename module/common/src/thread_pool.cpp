@@ -0,0 +1,143 @@
+#include "oops/thread_pool.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace oops {
+namespace {
+thread_local bool in_parallel{false};
+
+// 并行区域标记，嵌套的Run退化为串行执行，避免工作线程互相等待
+class ParallelRegion {
+public:
+    ParallelRegion() : prev_{in_parallel} { in_parallel = true; }
+    ~ParallelRegion() { in_parallel = prev_; }
+
+private:
+    bool prev_;
+};
+
+std::size_t GetDefaultNumThreads() {
+    if (const char *env{std::getenv("OOPS_NUM_THREADS")}; env != nullptr) {
+        try {
+            auto num_threads{std::stoul(env)};
+            if (num_threads > 0) {
+                return num_threads;
+            }
+        } catch (const std::exception &) {
+            // 非法取值回退到硬件并发数
+        }
+    }
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    workers_.reserve(num_threads - 1);
+    for (std::size_t i{1}; i < num_threads; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool &ThreadPool::Get() {
+    static ThreadPool instance{GetDefaultNumThreads()};
+    return instance;
+}
+
+bool ThreadPool::InParallel() { return in_parallel; }
+
+void ThreadPool::Execute(Job &job) {
+    ParallelRegion region;
+    for (std::size_t task{job.next++}; task < job.num_tasks; task = job.next++) {
+        try {
+            job.f(task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock{job.exception_mutex};
+            if (!job.exception) {
+                job.exception = std::current_exception();
+            }
+        }
+        ++job.done;
+    }
+}
+
+void ThreadPool::Run(std::size_t num_tasks, FunctionRef<void(std::size_t)> f) {
+    if (num_tasks == 0) {
+        return;
+    }
+    if (num_tasks == 1 || workers_.empty() || in_parallel) {
+        for (std::size_t task{0}; task < num_tasks; ++task) {
+            f(task);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock{run_mutex_};
+    Job job{f, num_tasks};
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        job_ = &job;
+        ++job_generation_;
+    }
+    cv_.notify_all();
+
+    Execute(job);
+
+    {
+        // 等待所有任务完成且工作线程全部退出任务，之后job_才可失效
+        std::unique_lock<std::mutex> lock{mutex_};
+        done_cv_.wait(lock, [&job] { return job.done == job.num_tasks && job.active == 0; });
+        job_ = nullptr;
+    }
+    if (job.exception) {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    std::size_t seen_generation{0};
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (true) {
+        cv_.wait(lock, [this, &seen_generation] {
+            return stop_ || !tasks_.empty() || (job_ != nullptr && job_generation_ != seen_generation);
+        });
+        if (job_ != nullptr && job_generation_ != seen_generation) {
+            seen_generation = job_generation_;
+            Job &job{*job_};
+            ++job.active;
+            lock.unlock();
+            Execute(job);
+            lock.lock();
+            --job.active;
+            done_cv_.notify_all();
+            continue;
+        }
+        if (!tasks_.empty()) {
+            auto task{std::move(tasks_.front())};
+            tasks_.pop_front();
+            lock.unlock();
+            {
+                ParallelRegion region;
+                task();
+            }
+            lock.lock();
+            continue;
+        }
+        if (stop_) {
+            return;
+        }
+    }
+}
+} // namespace oops
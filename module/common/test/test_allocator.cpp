@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <vector>
+
+#include "oops/allocator.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+template <typename T>
+std::uintptr_t Address(const T *p) {
+    return reinterpret_cast<std::uintptr_t>(p);
+}
+} // namespace
+
+TEST(CommonAllocator, Aligned) {
+    for (std::size_t n : {1, 3, 1000}) {
+        std::vector<char, AlignedAllocator<char>> v(n);
+        EXPECT_EQ(Address(v.data()) % 64, 0);
+        std::vector<double, AlignedAllocator<double, 4096>> page(n);
+        EXPECT_EQ(Address(page.data()) % 4096, 0);
+    }
+    // 重绑定保留对齐参数
+    using Rebound = std::allocator_traits<AlignedAllocator<char, 256>>::rebind_alloc<int>;
+    static_assert(std::is_same_v<Rebound, AlignedAllocator<int, 256>>);
+    EXPECT_TRUE(AlignedAllocator<char>{} == AlignedAllocator<int>{});
+}
+
+TEST(CommonAllocator, HugePage) {
+    std::vector<double, HugePageAllocator<double>> small(100);
+    EXPECT_EQ(Address(small.data()) % CACHE_LINE_SIZE, 0);
+    std::vector<double, HugePageAllocator<double>> large(HUGE_PAGE_SIZE / sizeof(double) + 1, 1.0);
+    EXPECT_EQ(Address(large.data()) % HUGE_PAGE_SIZE, 0);
+    EXPECT_EQ(large.back(), 1.0);
+}
+
+TEST(CommonAllocator, BufferPool) {
+    BufferPool pool;
+    void *p{pool.Allocate(1000)};
+    EXPECT_EQ(Address(p) % CACHE_LINE_SIZE, 0);
+    pool.Deallocate(p, 1000);
+    EXPECT_EQ(pool.CachedBytes(), 1024);
+
+    // 同级分配复用缓存的缓冲
+    void *q{pool.Allocate(700)};
+    EXPECT_EQ(q, p);
+    EXPECT_EQ(pool.CachedBytes(), 0);
+    void *r{pool.Allocate(2000)};
+    EXPECT_NE(r, p);
+    pool.Deallocate(q, 700);
+    pool.Deallocate(r, 2000);
+    EXPECT_EQ(pool.CachedBytes(), 3072);
+
+    // 超出上限时直接释放
+    pool.Release();
+    pool.SetCapacity(1024);
+    pool.Deallocate(pool.Allocate(4096), 4096);
+    EXPECT_EQ(pool.CachedBytes(), 0);
+    pool.Deallocate(pool.Allocate(64), 64);
+    EXPECT_EQ(pool.CachedBytes(), 64);
+}
+
+TEST(CommonAllocator, PoolAllocator) {
+    BufferPool::Get().Release();
+    const double *data{nullptr};
+    {
+        std::vector<double, PoolAllocator<double>> v(1000, 1.0);
+        data = v.data();
+    }
+    EXPECT_GE(BufferPool::Get().CachedBytes(), 8192);
+    std::vector<double, PoolAllocator<double>> w(900);
+    EXPECT_EQ(w.data(), data);
+    BufferPool::Get().Release();
+}
@@ -0,0 +1,100 @@
+#include <numeric>
+#include <vector>
+
+#include "oops/thread_pool.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+TEST(CommonThreadPool, Run) {
+    ThreadPool pool{4};
+    EXPECT_EQ(pool.Size(), 4);
+
+    std::vector<int> hits(1000, 0);
+    pool.Run(hits.size(), [&hits](std::size_t task) { ++hits[task]; });
+    for (int hit : hits) {
+        EXPECT_EQ(hit, 1);
+    }
+}
+
+TEST(CommonThreadPool, RunException) {
+    ThreadPool pool{3};
+    EXPECT_THROW(
+        pool.Run(
+            100,
+            [](std::size_t task) {
+                if (task == 42) {
+                    throw std::runtime_error("task failed");
+                }
+            }),
+        std::runtime_error);
+
+    // 异常后线程池仍可用
+    std::atomic<std::size_t> count{0};
+    pool.Run(100, [&count](std::size_t) { ++count; });
+    EXPECT_EQ(count, 100);
+}
+
+TEST(CommonThreadPool, NestedRun) {
+    ThreadPool pool{4};
+    std::atomic<std::size_t> count{0};
+    pool.Run(8, [&pool, &count](std::size_t) {
+        EXPECT_TRUE(ThreadPool::InParallel());
+        pool.Run(8, [&count](std::size_t) { ++count; });
+    });
+    EXPECT_EQ(count, 64);
+    EXPECT_FALSE(ThreadPool::InParallel());
+}
+
+TEST(CommonThreadPool, Submit) {
+    ThreadPool pool{2};
+    std::vector<std::future<int>> futures;
+    for (int i{0}; i < 16; ++i) {
+        futures.push_back(pool.Submit([i] { return i * i; }));
+    }
+    int sum{0};
+    for (auto &future : futures) {
+        sum += future.get();
+    }
+    EXPECT_EQ(sum, 1240);
+}
+
+TEST(CommonThreadPool, ParallelFor) {
+    std::vector<std::size_t> v(10007);
+    ParallelFor(0, v.size(), 100, [&v](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            v[i] = i;
+        }
+    });
+    std::vector<std::size_t> expected(v.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(v, expected);
+}
+
+TEST(CommonThreadPool, ParallelChunks) {
+    std::vector<std::size_t> sums(7);
+    ParallelChunks(100, sums.size(), [&sums](std::size_t chunk, std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            sums[chunk] += i;
+        }
+    });
+    EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), std::size_t{0}), 4950);
+}
+
+TEST(CommonThreadPool, ParallelReduce) {
+    EXPECT_EQ(ReduceChunks(0), 1);
+    EXPECT_EQ(ReduceChunks(REDUCE_GRAIN + 1), 2);
+    EXPECT_EQ(ReduceChunks(REDUCE_GRAIN * REDUCE_MAX_CHUNKS * 2), REDUCE_MAX_CHUNKS);
+
+    const std::size_t n{100000};
+    auto sums{ParallelReduce<2, std::uint64_t>(n, [](std::size_t begin, std::size_t end) {
+        std::array<std::uint64_t, 2> partial{};
+        for (std::size_t i{begin}; i < end; ++i) {
+            partial[0] += i;
+            partial[1] += i * i;
+        }
+        return partial;
+    })};
+    EXPECT_EQ(sums[0], std::uint64_t{n * (n - 1) / 2});
+    EXPECT_EQ(sums[1], std::uint64_t{(n - 1) * n * (2 * n - 1) / 6});
+}
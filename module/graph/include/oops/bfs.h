@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "oops/graph.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+struct BfsOptions {
+    double alpha{15}; // 前沿出边数超过未访问顶点出边数的1/alpha时切换为自底向上
+    double beta{18};  // 自底向上时前沿顶点数少于顶点数的1/beta时切换回自顶向下
+};
+
+struct BfsResult {
+    std::vector<std::size_t> depths;  // 源点为0，不可达为GRAPH_NONE
+    std::vector<std::size_t> parents; // 上一层中指向该顶点的最小编号顶点，源点为自身，不可达为GRAPH_NONE
+};
+
+// 方向优化BFS(Beamer)：前沿较小时自顶向下扩展出边，前沿较大时改为未访问顶点自底向上查找位图前沿中的入邻居
+// 自顶向下以原子取最小确定父顶点，自底向上按升序扫描入邻居取首个命中者，两者结果相同，与线程数及切换时机无关
+template <typename Value, typename DimIndex, typename NnzIndex>
+BfsResult Bfs(const Csr<Value, DimIndex, NnzIndex> &a, std::size_t source, BfsOptions options = {}) {
+    detail::CheckGraph(a, "bfs");
+    const std::size_t n{a.M()};
+    if (source >= n) {
+        throw std::out_of_range("bfs source out of range");
+    }
+    const NnzIndex *row_ptr{a.GetRowPtr().data()};
+    const DimIndex *col_indices{a.GetColIndices().data()};
+    auto out_degree = [row_ptr](std::size_t v) { return static_cast<std::size_t>(row_ptr[v + 1] - row_ptr[v]); };
+
+    BfsResult result;
+    result.depths.assign(n, GRAPH_NONE);
+    std::vector<std::atomic<std::size_t>> parents(n);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v{begin}; v < end; ++v) {
+            parents[v].store(GRAPH_NONE, std::memory_order_relaxed);
+        }
+    });
+    // visited只在层间更新，自顶向下时只读
+    std::vector<std::uint8_t> visited(n, 0);
+    visited[source] = 1;
+    result.depths[source] = 0;
+    parents[source].store(source, std::memory_order_relaxed);
+
+    std::vector<std::size_t> frontier{source}, next;
+    std::size_t frontier_size{1};
+    std::size_t frontier_edges{out_degree(source)};
+    std::size_t unvisited_edges{a.StoredNnz() - frontier_edges};
+    bool bottom_up{false};
+    const std::size_t words{detail::BitWords(n)};
+    std::vector<std::uint64_t> bitmap, next_bitmap;
+    std::shared_ptr<const typename Csr<Value, DimIndex, NnzIndex>::PatternType> in;
+    // 按整字划分顶点区间，块间不共享位图字
+    constexpr std::size_t WORD_GRAIN{SPMV_ROW_GRAIN / 64};
+
+    for (std::size_t level{0}; frontier_size > 0; ++level) {
+        if (!bottom_up && static_cast<double>(frontier_edges) > static_cast<double>(unvisited_edges) / options.alpha) {
+            bottom_up = true;
+            if (in == nullptr) {
+                in = detail::InNeighbors(a);
+            }
+            bitmap.assign(words, 0);
+            for (auto v : frontier) {
+                detail::SetBit(bitmap.data(), v);
+            }
+        } else if (bottom_up && static_cast<double>(frontier_size) < static_cast<double>(n) / options.beta) {
+            bottom_up = false;
+            frontier.clear();
+            for (std::size_t v{0}; v < n; ++v) {
+                if (detail::TestBit(bitmap.data(), v)) {
+                    frontier.push_back(v);
+                }
+            }
+        }
+
+        std::atomic<std::size_t> next_size{0};
+        std::atomic<std::size_t> next_edges{0};
+        if (bottom_up) {
+            const NnzIndex *in_ptr{in->GetRowPtr().data()};
+            const DimIndex *in_indices{in->GetColIndices().data()};
+            next_bitmap.assign(words, 0);
+            ParallelFor(0, words, WORD_GRAIN, [&](std::size_t word_begin, std::size_t word_end) {
+                std::size_t size{0}, edges{0};
+                for (std::size_t v{word_begin * 64}; v < std::min(word_end * 64, n); ++v) {
+                    if (visited[v]) {
+                        continue;
+                    }
+                    for (auto i{in_ptr[v]}; i < in_ptr[v + 1]; ++i) {
+                        const std::size_t u{static_cast<std::size_t>(in_indices[i])};
+                        if (detail::TestBit(bitmap.data(), u)) {
+                            parents[v].store(u, std::memory_order_relaxed);
+                            detail::SetBit(next_bitmap.data(), v);
+                            ++size;
+                            edges += out_degree(v);
+                            break;
+                        }
+                    }
+                }
+                next_size.fetch_add(size, std::memory_order_relaxed);
+                next_edges.fetch_add(edges, std::memory_order_relaxed);
+            });
+            bitmap.swap(next_bitmap);
+            ParallelFor(0, words, WORD_GRAIN, [&](std::size_t word_begin, std::size_t word_end) {
+                for (std::size_t v{word_begin * 64}; v < std::min(word_end * 64, n); ++v) {
+                    if (detail::TestBit(bitmap.data(), v)) {
+                        visited[v] = 1;
+                        result.depths[v] = level + 1;
+                    }
+                }
+            });
+        } else {
+            // 每块收集本块首次发现的顶点，按块序拼接
+            constexpr std::size_t GRAIN{64};
+            std::vector<std::vector<std::size_t>> found((frontier.size() + GRAIN - 1) / GRAIN);
+            ParallelFor(0, frontier.size(), GRAIN, [&](std::size_t begin, std::size_t end) {
+                auto &local{found[begin / GRAIN]};
+                for (std::size_t f{begin}; f < end; ++f) {
+                    const std::size_t u{frontier[f]};
+                    for (auto i{row_ptr[u]}; i < row_ptr[u + 1]; ++i) {
+                        const std::size_t v{static_cast<std::size_t>(col_indices[i])};
+                        if (visited[v]) {
+                            continue;
+                        }
+                        std::size_t parent{parents[v].load(std::memory_order_relaxed)};
+                        while (u < parent && !parents[v].compare_exchange_weak(parent, u, std::memory_order_relaxed)) {
+                        }
+                        if (parent == GRAPH_NONE) {
+                            local.push_back(v);
+                        }
+                    }
+                }
+            });
+            next.clear();
+            for (const auto &local : found) {
+                next.insert(next.end(), local.begin(), local.end());
+            }
+            frontier.swap(next);
+            ParallelFor(0, frontier.size(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+                std::size_t edges{0};
+                for (std::size_t f{begin}; f < end; ++f) {
+                    visited[frontier[f]] = 1;
+                    result.depths[frontier[f]] = level + 1;
+                    edges += out_degree(frontier[f]);
+                }
+                next_edges.fetch_add(edges, std::memory_order_relaxed);
+            });
+            next_size = frontier.size();
+        }
+        frontier_size = next_size;
+        frontier_edges = next_edges;
+        unvisited_edges -= frontier_edges;
+    }
+
+    result.parents.resize(n);
+    for (std::size_t v{0}; v < n; ++v) {
+        result.parents[v] = parents[v].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+} // namespace oops
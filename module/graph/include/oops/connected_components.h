@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "oops/graph.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+struct ConnectedComponentsOptions {
+    std::size_t neighbor_rounds{2}; // 先以每个顶点的前若干个出邻居连接，得到近似分量
+    std::size_t num_samples{1024};  // 估计最大分量时抽样的顶点数
+    bool symmetric_pattern{false};  // 邻接模式对称(无向图)时不再遍历入边
+};
+
+namespace detail {
+// 将u与v所在的树合并，总是由编号大的根指向编号小的根，根为树中的最小顶点
+inline void LinkComponents(std::vector<std::atomic<std::size_t>> &comp, std::size_t u, std::size_t v) {
+    std::size_t p1{comp[u].load(std::memory_order_relaxed)};
+    std::size_t p2{comp[v].load(std::memory_order_relaxed)};
+    while (p1 != p2) {
+        const std::size_t high{std::max(p1, p2)};
+        const std::size_t low{std::min(p1, p2)};
+        std::size_t p_high{comp[high].load(std::memory_order_relaxed)};
+        if (p_high == low ||
+            (p_high == high && comp[high].compare_exchange_strong(p_high, low, std::memory_order_relaxed))) {
+            break;
+        }
+        p1 = comp[comp[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+        p2 = comp[low].load(std::memory_order_relaxed);
+    }
+}
+
+// 路径压缩，完成后每个顶点直接指向根
+inline void CompressComponents(std::vector<std::atomic<std::size_t>> &comp) {
+    ParallelFor(0, comp.size(), SPMV_ROW_GRAIN, [&comp](std::size_t begin, std::size_t end) {
+        for (std::size_t v{begin}; v < end; ++v) {
+            std::size_t c{comp[v].load(std::memory_order_relaxed)};
+            while (c != comp[c].load(std::memory_order_relaxed)) {
+                c = comp[c].load(std::memory_order_relaxed);
+            }
+            comp[v].store(c, std::memory_order_relaxed);
+        }
+    });
+}
+} // namespace detail
+
+// 弱连通分量(Afforest)：先以每个顶点的少量邻居连接并压缩，抽样找出最大分量，
+// 再只为不在最大分量中的顶点连接其余出边与全部入边，跳过大分量内部的大部分边
+// 返回各顶点的分量标签，取分量中的最小顶点编号，与线程数无关
+template <typename Value, typename DimIndex, typename NnzIndex>
+std::vector<std::size_t>
+ConnectedComponents(const Csr<Value, DimIndex, NnzIndex> &a, ConnectedComponentsOptions options = {}) {
+    detail::CheckGraph(a, "connected components");
+    const std::size_t n{a.M()};
+    const NnzIndex *row_ptr{a.GetRowPtr().data()};
+    const DimIndex *col_indices{a.GetColIndices().data()};
+
+    std::vector<std::atomic<std::size_t>> comp(n);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v{begin}; v < end; ++v) {
+            comp[v].store(v, std::memory_order_relaxed);
+        }
+    });
+    for (std::size_t round{0}; round < options.neighbor_rounds; ++round) {
+        ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t v{begin}; v < end; ++v) {
+                if (row_ptr[v] + round < static_cast<std::size_t>(row_ptr[v + 1])) {
+                    detail::LinkComponents(comp, v, col_indices[row_ptr[v] + round]);
+                }
+            }
+        });
+        detail::CompressComponents(comp);
+    }
+
+    // 固定种子抽样，只影响跳过哪些顶点，不影响结果
+    std::size_t largest{0};
+    if (n > 0) {
+        std::unordered_map<std::size_t, std::size_t> counts;
+        std::size_t largest_count{0};
+        std::uint64_t state{0x9e3779b97f4a7c15ULL};
+        for (std::size_t s{0}; s < options.num_samples; ++s) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const auto c{comp[(state >> 33) % n].load(std::memory_order_relaxed)};
+            const std::size_t count{++counts[c]};
+            if (count > largest_count) {
+                largest = c;
+                largest_count = count;
+            }
+        }
+    }
+
+    std::shared_ptr<const typename Csr<Value, DimIndex, NnzIndex>::PatternType> in;
+    if (!options.symmetric_pattern) {
+        in = detail::InNeighbors(a);
+    }
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v{begin}; v < end; ++v) {
+            if (comp[v].load(std::memory_order_relaxed) == largest) {
+                continue;
+            }
+            for (auto i{row_ptr[v] + static_cast<NnzIndex>(options.neighbor_rounds)}; i < row_ptr[v + 1]; ++i) {
+                detail::LinkComponents(comp, v, col_indices[i]);
+            }
+            if (in != nullptr) {
+                const auto &in_ptr{in->GetRowPtr()};
+                const auto &in_indices{in->GetColIndices()};
+                for (auto i{in_ptr[v]}; i < in_ptr[v + 1]; ++i) {
+                    detail::LinkComponents(comp, v, in_indices[i]);
+                }
+            }
+        }
+    });
+    detail::CompressComponents(comp);
+
+    std::vector<std::size_t> labels(n);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t v{begin}; v < end; ++v) {
+            labels[v] = comp[v].load(std::memory_order_relaxed);
+        }
+    });
+    return labels;
+}
+} // namespace oops
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "oops/convert.h"
+#include "oops/csr.h"
+#include "oops/sparse_vector.h"
+
+namespace oops {
+// 以CSR的稀疏模式表示有向图：a(u, v)存在即有边u -> v，第u行为u的出邻居，数值被忽略
+// 不可达顶点的深度、父顶点等以GRAPH_NONE表示
+constexpr std::size_t GRAPH_NONE{std::numeric_limits<std::size_t>::max()};
+
+namespace detail {
+template <typename Value, typename DimIndex, typename NnzIndex>
+void CheckGraph(const Csr<Value, DimIndex, NnzIndex> &a, const char *op) {
+    if (a.M() != a.N()) {
+        throw std::invalid_argument(std::string{op} + " requires a square adjacency matrix");
+    }
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        throw std::invalid_argument(std::string{op} + " requires general storage");
+    }
+}
+
+// 入邻居结构，即转置后的模式，第v行为v的入邻居且升序；缓存于a的模式上
+template <typename Value, typename DimIndex, typename NnzIndex>
+auto InNeighbors(const Csr<Value, DimIndex, NnzIndex> &a) {
+    return GetTransposedPattern(*a.GetPattern())->pattern;
+}
+} // namespace detail
+} // namespace oops
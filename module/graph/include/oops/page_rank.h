@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "oops/graph.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+struct PageRankOptions {
+    double damping{0.85};
+    double tolerance{1e-10};         // 相邻两次迭代的秩向量之差的1范数
+    std::size_t max_iterations{100};
+};
+
+struct PageRankResult {
+    std::vector<double> ranks; // 和为1
+    std::size_t iterations{0};
+    double residual{0};
+};
+
+// 拉取式PageRank：每次迭代以入邻居模式做一次pattern SpMV，y = A^T * (rank / out_degree)
+// 无出边顶点的秩均分给全部顶点；入邻居模式缓存于a的模式上，规约分块固定，结果与线程数无关
+template <typename Value, typename DimIndex, typename NnzIndex>
+PageRankResult PageRank(const Csr<Value, DimIndex, NnzIndex> &a, PageRankOptions options = {}) {
+    detail::CheckGraph(a, "page rank");
+    const std::size_t n{a.M()};
+    PageRankResult result;
+    if (n == 0) {
+        return result;
+    }
+    const NnzIndex *row_ptr{a.GetRowPtr().data()};
+    const auto in{detail::InNeighbors(a)};
+    const CsrView<std::monostate, DimIndex, NnzIndex> in_view{
+        n, n, nullptr, in->GetRowPtr().data(), in->GetColIndices().data()};
+
+    const double base{(1 - options.damping) / static_cast<double>(n)};
+    result.ranks.assign(n, 1 / static_cast<double>(n));
+    std::vector<double> contrib(n), pulled(n);
+    for (result.iterations = 0; result.iterations < options.max_iterations;) {
+        auto &ranks{result.ranks};
+        const double dangling{ParallelReduce<1, double>(n, [&](std::size_t begin, std::size_t end) {
+            double sum{0};
+            for (std::size_t v{begin}; v < end; ++v) {
+                const auto degree{row_ptr[v + 1] - row_ptr[v]};
+                contrib[v] = degree == 0 ? 0. : ranks[v] / static_cast<double>(degree);
+                sum += degree == 0 ? ranks[v] : 0.;
+            }
+            return std::array<double, 1>{sum};
+        })[0]};
+        SpMV(in_view, contrib.data(), pulled.data());
+        const double shared{base + options.damping * dangling / static_cast<double>(n)};
+        result.residual = ParallelReduce<1, double>(n, [&](std::size_t begin, std::size_t end) {
+            double sum{0};
+            for (std::size_t v{begin}; v < end; ++v) {
+                const double rank{shared + options.damping * pulled[v]};
+                sum += std::abs(rank - ranks[v]);
+                ranks[v] = rank;
+            }
+            return std::array<double, 1>{sum};
+        })[0];
+        ++result.iterations;
+        if (result.residual <= options.tolerance) {
+            break;
+        }
+    }
+    return result;
+}
+} // namespace oops
@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/graph.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+namespace detail {
+// 无向图的严格下三角邻接L：第i行为{j < i : a(i, j)或a(j, i)存在}，行内升序去重
+// 对称压缩存储只存一个三角，与其转置合并后同样得到完整的邻接
+template <typename Value, typename DimIndex, typename NnzIndex>
+void LowerAdjacency(
+    const Csr<Value, DimIndex, NnzIndex> &a, std::vector<std::size_t> &lower_ptr, std::vector<DimIndex> &lower) {
+    if (a.M() != a.N()) {
+        throw std::invalid_argument("triangle count requires a square adjacency matrix");
+    }
+    const std::size_t n{a.M()};
+    const auto in{InNeighbors(a)};
+    const NnzIndex *ptrs[2]{a.GetRowPtr().data(), in->GetRowPtr().data()};
+    const DimIndex *indices[2]{a.GetColIndices().data(), in->GetColIndices().data()};
+    // 归并第i行出邻居与入邻居中小于i的部分，对每个不同的邻居调用f
+    auto for_lower = [&](std::size_t i, auto &&f) {
+        auto p{ptrs[0][i]}, q{ptrs[1][i]};
+        const auto p_end{ptrs[0][i + 1]}, q_end{ptrs[1][i + 1]};
+        std::size_t last{GRAPH_NONE};
+        while (true) {
+            const std::size_t u{p < p_end ? static_cast<std::size_t>(indices[0][p]) : GRAPH_NONE};
+            const std::size_t v{q < q_end ? static_cast<std::size_t>(indices[1][q]) : GRAPH_NONE};
+            const std::size_t j{std::min(u, v)};
+            if (j >= i) {
+                break;
+            }
+            if (j != last) {
+                f(j);
+                last = j;
+            }
+            p += u == j;
+            q += v == j;
+        }
+    };
+    lower_ptr.assign(n + 1, 0);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            for_lower(i, [&](std::size_t) { ++lower_ptr[i + 1]; });
+        }
+    });
+    for (std::size_t i{0}; i < n; ++i) {
+        lower_ptr[i + 1] += lower_ptr[i];
+    }
+    lower.resize(lower_ptr[n]);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i) {
+            std::size_t pos{lower_ptr[i]};
+            for_lower(i, [&](std::size_t j) { lower[pos++] = static_cast<DimIndex>(j); });
+        }
+    });
+}
+} // namespace detail
+
+// 无向图的三角形数：以L为掩码计算C<L> = L * L^T，三角形数为C的元素之和
+// 掩码内的每个元素C(i, k)为L(i, :)与L(k, :)的内积，按有序列表求交计算，不需要稠密累加器
+// 每个三角形i > k > j恰计一次；有向边按无向边处理，自环与重复边被忽略
+template <typename Value, typename DimIndex, typename NnzIndex>
+std::uint64_t CountTriangles(const Csr<Value, DimIndex, NnzIndex> &a) {
+    std::vector<std::size_t> lower_ptr;
+    std::vector<DimIndex> lower;
+    detail::LowerAdjacency(a, lower_ptr, lower);
+    return ParallelReduce<1, std::uint64_t>(a.M(), [&](std::size_t begin, std::size_t end) {
+        std::uint64_t count{0};
+        for (std::size_t i{begin}; i < end; ++i) {
+            for (std::size_t p{lower_ptr[i]}; p < lower_ptr[i + 1]; ++p) {
+                const std::size_t k{static_cast<std::size_t>(lower[p])};
+                // L(i, :)中小于k的部分与L(k, :)求交
+                std::size_t x{lower_ptr[i]}, y{lower_ptr[k]};
+                while (x < p && y < lower_ptr[k + 1]) {
+                    if (lower[x] < lower[y]) {
+                        ++x;
+                    } else if (lower[y] < lower[x]) {
+                        ++y;
+                    } else {
+                        ++count;
+                        ++x;
+                        ++y;
+                    }
+                }
+            }
+        }
+        return std::array<std::uint64_t, 1>{count};
+    })[0];
+}
+} // namespace oops
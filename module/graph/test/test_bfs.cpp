@@ -0,0 +1,67 @@
+#include <deque>
+
+#include "oops/bfs.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+// 逐层串行BFS，父顶点取上一层中指向该顶点的最小编号顶点
+BfsResult ReferenceBfs(const Graph &a, std::size_t source) {
+    const std::size_t n{a.M()};
+    BfsResult ref{std::vector<std::size_t>(n, GRAPH_NONE), std::vector<std::size_t>(n, GRAPH_NONE)};
+    ref.depths[source] = 0;
+    ref.parents[source] = source;
+    std::vector<std::size_t> frontier{source};
+    for (std::size_t level{0}; !frontier.empty(); ++level) {
+        std::vector<std::size_t> next;
+        for (auto u : frontier) {
+            for (auto i{a.GetRowPtr()[u]}; i < a.GetRowPtr()[u + 1]; ++i) {
+                const std::size_t v{static_cast<std::size_t>(a.GetColIndices()[i])};
+                if (ref.depths[v] == GRAPH_NONE) {
+                    ref.depths[v] = level + 1;
+                    next.push_back(v);
+                }
+                if (ref.depths[v] == level + 1) {
+                    ref.parents[v] = std::min(ref.parents[v], u);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return ref;
+}
+} // namespace
+
+TEST(GraphBfs, Small) {
+    const auto a{MakeGraph(6, {{0, 2}, {0, 1}, {1, 3}, {2, 3}, {3, 4}, {4, 0}})};
+    const auto result{Bfs(a, 0)};
+    EXPECT_EQ(result.depths, (std::vector<std::size_t>{0, 1, 1, 2, 3, GRAPH_NONE}));
+    EXPECT_EQ(result.parents, (std::vector<std::size_t>{0, 0, 0, 1, 3, GRAPH_NONE}));
+    // 有向图沿出边搜索
+    EXPECT_EQ(Bfs(a, 3).depths, (std::vector<std::size_t>{2, 3, 3, 0, 1, GRAPH_NONE}));
+}
+
+TEST(GraphBfs, DirectionOptimizing) {
+    const auto a{MakeGraph(1 << 12, RmatEdges(12, 8, 7))};
+    // alpha极大时每层自底向上，极小时始终自顶向下，结果均与串行参考一致
+    for (double alpha : {15., 1e300, 1e-300}) {
+        BfsOptions options;
+        options.alpha = alpha;
+        for (std::size_t source : {0, 1, 100}) {
+            const auto result{Bfs(a, source, options)};
+            const auto ref{ReferenceBfs(a, source)};
+            EXPECT_EQ(result.depths, ref.depths);
+            EXPECT_EQ(result.parents, ref.parents);
+        }
+    }
+}
+
+TEST(GraphBfs, Errors) {
+    const auto a{MakeGraph(3, {{0, 1}})};
+    EXPECT_THROW(Bfs(a, 3), std::out_of_range);
+    const Csr<double, int32_t> rect{CsrStore<double, int32_t, int32_t>{3, {}, {0, 0}, {}}};
+    EXPECT_THROW(Bfs(rect, 0), std::invalid_argument);
+}
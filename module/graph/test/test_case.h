@@ -0,0 +1,35 @@
+#pragma once
+#include <utility>
+#include <vector>
+
+#include "oops/coo_builder.h"
+#include "oops/matrix_generator.h"
+
+namespace oops {
+namespace test {
+using Graph = Csr<std::monostate, int32_t>;
+using Edges = std::vector<std::pair<int32_t, int32_t>>;
+
+// 由边表构造pattern邻接矩阵，重复边合并；symmetric为true时同时加入反向边
+inline Graph MakeGraph(std::size_t n, const Edges &edges, bool symmetric = false) {
+    CooBuilder<std::monostate, int32_t> builder{n, n};
+    for (const auto &[u, v] : edges) {
+        builder.Add(u, v);
+        if (symmetric) {
+            builder.Add(v, u);
+        }
+    }
+    return builder.ToCsr();
+}
+
+// 2^scale个顶点的R-MAT有向图的边表，含重复边与自环
+inline Edges RmatEdges(std::size_t scale, std::size_t edge_factor, std::uint64_t seed) {
+    const auto coo{GenerateCoo<std::monostate, int32_t>(RmatGenerator{scale, edge_factor, seed})};
+    Edges edges(coo.StoredNnz());
+    for (std::size_t i{0}; i < edges.size(); ++i) {
+        edges[i] = {coo.GetRowIndices()[i], coo.GetColIndices()[i]};
+    }
+    return edges;
+}
+} // namespace test
+} // namespace oops
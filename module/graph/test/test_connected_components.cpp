@@ -0,0 +1,56 @@
+#include <numeric>
+
+#include "oops/connected_components.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+// 串行并查集，标签取分量中的最小顶点
+std::vector<std::size_t> ReferenceComponents(std::size_t n, const Edges &edges) {
+    std::vector<std::size_t> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t v) {
+        while (parent[v] != v) {
+            v = parent[v];
+        }
+        return v;
+    };
+    for (const auto &[u, v] : edges) {
+        const std::size_t ru{find(u)}, rv{find(v)};
+        parent[std::max(ru, rv)] = std::min(ru, rv);
+    }
+    std::vector<std::size_t> labels(n);
+    for (std::size_t v{0}; v < n; ++v) {
+        labels[v] = find(v);
+    }
+    return labels;
+}
+} // namespace
+
+TEST(GraphConnectedComponents, Small) {
+    const auto a{MakeGraph(7, {{1, 0}, {2, 1}, {5, 3}, {4, 5}})};
+    EXPECT_EQ(ConnectedComponents(a), (std::vector<std::size_t>{0, 0, 0, 3, 3, 3, 6}));
+}
+
+TEST(GraphConnectedComponents, Random) {
+    // 平均出度约1的稀疏有向图，含一个大分量与大量小分量
+    const std::size_t n{1 << 13};
+    const auto coo{GenerateCoo<std::monostate, int32_t>(ErdosRenyiGenerator{n, n, 0.6, 3})};
+    Edges edges;
+    for (std::size_t i{0}; i < coo.StoredNnz(); ++i) {
+        edges.emplace_back(coo.GetRowIndices()[i], coo.GetColIndices()[i]);
+    }
+    const auto ref{ReferenceComponents(n, edges)};
+    const auto directed{MakeGraph(n, edges)};
+    const auto undirected{MakeGraph(n, edges, true)};
+    for (std::size_t rounds : {0, 1, 2, 4}) {
+        ConnectedComponentsOptions options;
+        options.neighbor_rounds = rounds;
+        EXPECT_EQ(ConnectedComponents(directed, options), ref);
+        options.symmetric_pattern = true;
+        EXPECT_EQ(ConnectedComponents(undirected, options), ref);
+    }
+}
@@ -0,0 +1,63 @@
+#include <cmath>
+#include <numeric>
+
+#include "oops/page_rank.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+// 串行推送式幂迭代
+std::vector<double> ReferencePageRank(const Graph &a, double damping, std::size_t iterations) {
+    const std::size_t n{a.M()};
+    std::vector<double> ranks(n, 1. / n);
+    for (std::size_t it{0}; it < iterations; ++it) {
+        std::vector<double> next(n, (1 - damping) / n);
+        for (std::size_t u{0}; u < n; ++u) {
+            const auto degree{a.GetRowPtr()[u + 1] - a.GetRowPtr()[u]};
+            if (degree == 0) {
+                for (auto &r : next) {
+                    r += damping * ranks[u] / n;
+                }
+            }
+            for (auto i{a.GetRowPtr()[u]}; i < a.GetRowPtr()[u + 1]; ++i) {
+                next[a.GetColIndices()[i]] += damping * ranks[u] / degree;
+            }
+        }
+        ranks.swap(next);
+    }
+    return ranks;
+}
+} // namespace
+
+TEST(GraphPageRank, Cycle) {
+    // 有向环上的秩均匀分布
+    const auto a{MakeGraph(4, {{0, 1}, {1, 2}, {2, 3}, {3, 0}})};
+    const auto result{PageRank(a)};
+    EXPECT_EQ(result.iterations, 1);
+    for (auto r : result.ranks) {
+        EXPECT_DOUBLE_EQ(r, 0.25);
+    }
+}
+
+TEST(GraphPageRank, Random) {
+    const auto a{MakeGraph(1 << 10, RmatEdges(10, 4, 11))};
+    PageRankOptions options;
+    options.tolerance = 0;
+    options.max_iterations = 30;
+    const auto result{PageRank(a, options)};
+    EXPECT_EQ(result.iterations, 30);
+    const auto ref{ReferencePageRank(a, options.damping, 30)};
+    for (std::size_t v{0}; v < a.M(); ++v) {
+        EXPECT_NEAR(result.ranks[v], ref[v], 1e-12);
+    }
+
+    options.tolerance = 1e-12;
+    options.max_iterations = 1000;
+    const auto converged{PageRank(a, options)};
+    EXPECT_LT(converged.iterations, 1000);
+    EXPECT_LE(converged.residual, 1e-12);
+    EXPECT_NEAR(std::accumulate(converged.ranks.begin(), converged.ranks.end(), 0.), 1., 1e-12);
+}
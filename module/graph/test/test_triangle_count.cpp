@@ -0,0 +1,48 @@
+#include "oops/triangle_count.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+std::uint64_t ReferenceTriangles(std::size_t n, const Edges &edges) {
+    std::vector<std::vector<char>> adj(n, std::vector<char>(n, 0));
+    for (const auto &[u, v] : edges) {
+        if (u != v) {
+            adj[u][v] = adj[v][u] = 1;
+        }
+    }
+    std::uint64_t count{0};
+    for (std::size_t i{0}; i < n; ++i) {
+        for (std::size_t j{i + 1}; j < n; ++j) {
+            for (std::size_t k{j + 1}; adj[i][j] && k < n; ++k) {
+                count += adj[i][k] && adj[j][k];
+            }
+        }
+    }
+    return count;
+}
+} // namespace
+
+TEST(GraphTriangleCount, Small) {
+    Edges complete;
+    for (int32_t i{0}; i < 5; ++i) {
+        for (int32_t j{0}; j < i; ++j) {
+            complete.emplace_back(i, j);
+        }
+    }
+    EXPECT_EQ(CountTriangles(MakeGraph(5, complete, true)), 10);
+    // 只给出单向边与对称压缩存储时按无向图计数
+    EXPECT_EQ(CountTriangles(MakeGraph(5, complete)), 10);
+    const auto lower{MakeGraph(5, complete)};
+    EXPECT_EQ(CountTriangles(Graph{lower.GetPattern(), {}, MatrixSymmetric::SYMMETRIC_LOWER}), 10);
+    // 网格图没有三角形
+    EXPECT_EQ(CountTriangles(GenerateCsr<double, int32_t>(Laplacian2DGenerator{20, 20})), 0);
+}
+
+TEST(GraphTriangleCount, Random) {
+    const auto edges{RmatEdges(9, 8, 5)};
+    EXPECT_EQ(CountTriangles(MakeGraph(1 << 9, edges)), ReferenceTriangles(1 << 9, edges));
+    EXPECT_EQ(CountTriangles(MakeGraph(1 << 9, edges, true)), ReferenceTriangles(1 << 9, edges));
+}
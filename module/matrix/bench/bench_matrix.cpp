@@ -0,0 +1,265 @@
+#include <complex>
+#include <sstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "oops/convert.h"
+#include "oops/matrix_generator.h"
+#include "oops/matrix_market_io.h"
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+
+using namespace oops;
+
+namespace {
+// 随机矩阵的行数，每行平均8个元素
+constexpr int64_t MIN_ROWS{1 << 10};
+constexpr int64_t MAX_ROWS{1 << 18};
+constexpr double NNZ_PER_ROW{8};
+constexpr std::uint64_t SEED{42};
+
+// intmax_t与int64_t可能为同一类型，数值类型与索引类型分别命名
+template <typename Value>
+std::string ValueTypeName() {
+    if constexpr (std::is_same_v<Value, float>) {
+        return "float";
+    } else if constexpr (std::is_same_v<Value, double>) {
+        return "double";
+    } else if constexpr (std::is_same_v<Value, std::complex<float>>) {
+        return "complex<float>";
+    } else if constexpr (std::is_same_v<Value, std::complex<double>>) {
+        return "complex<double>";
+    } else if constexpr (std::is_same_v<Value, intmax_t>) {
+        return "intmax_t";
+    } else {
+        static_assert(std::is_same_v<Value, std::monostate>);
+        return "pattern";
+    }
+}
+
+template <typename Index>
+std::string IndexTypeName() {
+    return std::is_same_v<Index, int32_t> ? "int32_t" : "int64_t";
+}
+
+// 对类型列表中的每个类型调用f(meta::Identity<T>{})
+template <typename TL>
+struct ForEachType;
+
+template <typename... Ts>
+struct ForEachType<meta::TypeList<Ts...>> {
+    template <typename F>
+    static void Apply(F &&f) {
+        (f(meta::Identity<Ts>{}), ...);
+    }
+};
+
+template <typename Value, typename DimIndex>
+Coo<Value, DimIndex> MakeCoo(int64_t rows) {
+    const auto n{static_cast<std::size_t>(rows)};
+    return GenerateCoo<Value, DimIndex>(ErdosRenyiGenerator{n, n, NNZ_PER_ROW, SEED});
+}
+
+template <typename Value, typename DimIndex>
+std::string MakeMatrixMarketText(int64_t rows) {
+    std::ostringstream os;
+    WriteMatrixMarket(os, AnyCoo{MakeCoo<Value, DimIndex>(rows)});
+    return os.str();
+}
+
+template <typename Value, typename DimIndex>
+void BM_WriteMatrixMarket(benchmark::State &state) {
+    const AnyCoo coo{MakeCoo<Value, DimIndex>(state.range(0))};
+    std::size_t bytes{0};
+    for (auto _ : state) {
+        std::ostringstream os;
+        WriteMatrixMarket(os, coo);
+        bytes = os.str().size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(coo.StoredNnz()));
+}
+
+template <typename Value, typename DimIndex>
+void BM_ReadMatrixMarket(benchmark::State &state) {
+    const std::string text{MakeMatrixMarketText<Value, DimIndex>(state.range(0))};
+    std::size_t nnz{0};
+    for (auto _ : state) {
+        std::istringstream is{text};
+        nnz = ReadMatrixMarket(is).StoredNnz();
+        benchmark::DoNotOptimize(nnz);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nnz));
+}
+
+template <typename Value, typename DimIndex>
+void BM_ParseMatrixMarket(benchmark::State &state) {
+    const std::string text{MakeMatrixMarketText<Value, DimIndex>(state.range(0))};
+    std::size_t nnz{0};
+    for (auto _ : state) {
+        nnz = ParseMatrixMarket(text).StoredNnz();
+        benchmark::DoNotOptimize(nnz);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nnz));
+}
+
+template <typename Dst, typename Src>
+void RunConvertVector(benchmark::State &state, const std::vector<Src> &src) {
+    for (auto _ : state) {
+        auto dst{ConvertVector<Dst>(src)};
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(src.size()));
+}
+
+// 数值向量取自随机矩阵的values
+template <typename Src, typename Dst>
+void BM_ConvertValues(benchmark::State &state) {
+    RunConvertVector<Dst>(state, MakeCoo<Src, int32_t>(state.range(0)).GetValues());
+}
+
+// 索引向量取自随机矩阵的row_indices
+template <typename Src, typename Dst>
+void BM_ConvertIndices(benchmark::State &state) {
+    RunConvertVector<Dst>(state, MakeCoo<double, Src>(state.range(0)).GetRowIndices());
+}
+
+// 源矩阵固定为<double, int32_t>
+template <typename Value, typename DimIndex>
+void BM_AnyCooConvert(benchmark::State &state) {
+    const AnyCoo coo{MakeCoo<double, int32_t>(state.range(0))};
+    for (auto _ : state) {
+        auto dst{coo.Convert<Value, DimIndex>()};
+        benchmark::DoNotOptimize(dst.GetRowIndices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(coo.StoredNnz()));
+}
+
+// DiagNnz的结果缓存于矩阵，每次迭代在计时外复制一个未缓存的矩阵
+template <typename Value, typename DimIndex>
+void BM_DiagNnz(benchmark::State &state) {
+    const auto store{MakeCoo<Value, DimIndex>(state.range(0)).GetStore()};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Coo<Value, DimIndex> coo{store};
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(coo.DiagNnz());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(store.row_indices.size()));
+}
+
+template <typename Value, typename DimIndex>
+void BM_ToCsr(benchmark::State &state) {
+    const auto coo{MakeCoo<Value, DimIndex>(state.range(0))};
+    for (auto _ : state) {
+        auto csr{ToCsr(coo)};
+        benchmark::DoNotOptimize(csr.GetRowPtr().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(coo.StoredNnz()));
+}
+
+// 经视图转换，不使用矩阵模式上缓存的转置结构
+template <typename Value, typename DimIndex>
+void BM_ToCsc(benchmark::State &state) {
+    const auto csr{ToCsr(MakeCoo<Value, DimIndex>(state.range(0)))};
+    for (auto _ : state) {
+        auto csc{ToCsc(CsrView<Value, DimIndex>{csr})};
+        benchmark::DoNotOptimize(csc.GetColPtr().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(csr.StoredNnz()));
+}
+
+template <typename Value, typename DimIndex>
+void BM_SpMV(benchmark::State &state) {
+    const auto csr{ToCsr(MakeCoo<Value, DimIndex>(state.range(0)))};
+    const std::vector<Value> x(csr.N(), Value(1));
+    std::vector<Value> y(csr.M());
+    for (auto _ : state) {
+        SpMV(csr, x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(csr.StoredNnz()));
+}
+
+void Register(const std::string &name, void (*fn)(benchmark::State &)) {
+    benchmark::RegisterBenchmark(name.c_str(), fn)
+        ->RangeMultiplier(16)
+        ->Range(MIN_ROWS, MAX_ROWS)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+template <typename Value, typename DimIndex>
+struct RegisterMatrixBenchmarks {
+    static void Apply() {
+        const std::string types{"<" + ValueTypeName<Value>() + "," + IndexTypeName<DimIndex>() + ">"};
+        // 读取时索引类型由矩阵维度决定，只按数值类型注册
+        if constexpr (std::is_same_v<DimIndex, int32_t>) {
+            Register("ReadMatrixMarket<" + ValueTypeName<Value>() + ">", BM_ReadMatrixMarket<Value, DimIndex>);
+            Register("ParseMatrixMarket<" + ValueTypeName<Value>() + ">", BM_ParseMatrixMarket<Value, DimIndex>);
+        }
+        Register("WriteMatrixMarket" + types, BM_WriteMatrixMarket<Value, DimIndex>);
+        if constexpr (std::is_convertible_v<double, Value>) {
+            Register("AnyCooConvert" + types, BM_AnyCooConvert<Value, DimIndex>);
+        }
+        Register("DiagNnz" + types, BM_DiagNnz<Value, DimIndex>);
+        Register("ToCsr" + types, BM_ToCsr<Value, DimIndex>);
+        Register("ToCsc" + types, BM_ToCsc<Value, DimIndex>);
+        if constexpr (!std::is_same_v<Value, std::monostate>) {
+            Register("SpMV" + types, BM_SpMV<Value, DimIndex>);
+        }
+    }
+};
+
+// Convert不支持的类型组合在运行时抛出异常，注册时跳过；pattern矩阵不存储数值
+template <typename Src, typename Dst>
+struct RegisterConvertValues {
+    static void Apply() {
+        if constexpr (std::is_convertible_v<Src, Dst> && !std::is_same_v<Src, std::monostate> &&
+                      !std::is_same_v<Dst, std::monostate>) {
+            Register(
+                "ConvertVector<" + ValueTypeName<Src>() + "," + ValueTypeName<Dst>() + ">",
+                BM_ConvertValues<Src, Dst>);
+        }
+    }
+};
+
+template <typename Src, typename Dst>
+struct RegisterConvertIndices {
+    static void Apply() {
+        Register(
+            "ConvertVector<" + IndexTypeName<Src>() + "," + IndexTypeName<Dst>() + ">", BM_ConvertIndices<Src, Dst>);
+    }
+};
+
+// 按ValueTypeList与IndexTypeList的组合注册
+void RegisterBenchmarks() {
+    ForEachType<meta::CartProdT<ValueTypeList, IndexTypeList>>::Apply(
+        [](auto id) { meta::ApplyT<RegisterMatrixBenchmarks, typename decltype(id)::Type>::Apply(); });
+    ForEachType<meta::CartProdT<ValueTypeList, ValueTypeList>>::Apply(
+        [](auto id) { meta::ApplyT<RegisterConvertValues, typename decltype(id)::Type>::Apply(); });
+    ForEachType<meta::CartProdT<IndexTypeList, IndexTypeList>>::Apply(
+        [](auto id) { meta::ApplyT<RegisterConvertIndices, typename decltype(id)::Type>::Apply(); });
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    RegisterBenchmarks();
+    // 默认输出JSON，命令行中靠后的--benchmark_format可覆盖
+    std::vector<char *> args{argv, argv + argc};
+    char json_format[]{"--benchmark_format=json"};
+    args.insert(args.begin() + (argc > 0 ? 1 : 0), json_format);
+    int args_count{static_cast<int>(args.size())};
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
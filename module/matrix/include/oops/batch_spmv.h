@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 共享稀疏结构的矩阵每组最多同时计算的个数
+constexpr std::size_t BATCH_SPMV_GROUP{8};
+// 工作单元的最小负载(非零元数与行数之和)，避免单元过小时调度开销占优
+constexpr std::size_t BATCH_SPMV_MIN_UNIT{16384};
+
+// 批量SpMV中的一项，y = a * x
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+struct SpMVBatchItem {
+    CsrView<Value, DimIndex, NnzIndex> a;
+    const Value *x;
+    Value *y;
+};
+
+struct BatchSpMVOptions {
+    bool compare_patterns{false};    // 除地址相同外，按内容识别相同的稀疏结构
+    std::size_t units_per_thread{4}; // 每线程的期望工作单元数
+};
+
+namespace detail {
+template <typename Value, typename DimIndex, typename NnzIndex>
+bool SamePattern(
+    const CsrView<Value, DimIndex, NnzIndex> &lhs, const CsrView<Value, DimIndex, NnzIndex> &rhs, bool compare) {
+    if (lhs.GetSymmetric() != MatrixSymmetric::GENERAL || rhs.GetSymmetric() != MatrixSymmetric::GENERAL ||
+        lhs.M() != rhs.M() || lhs.N() != rhs.N()) {
+        return false;
+    }
+    if (lhs.GetRowPtr() == rhs.GetRowPtr() && lhs.GetColIndices() == rhs.GetColIndices()) {
+        return true;
+    }
+    if (!compare || !std::equal(lhs.GetRowPtr(), lhs.GetRowPtr() + lhs.M() + 1, rhs.GetRowPtr())) {
+        return false;
+    }
+    const NnzIndex *row_ptr{lhs.GetRowPtr()};
+    return std::equal(
+        lhs.GetColIndices() + row_ptr[0], lhs.GetColIndices() + row_ptr[lhs.M()], rhs.GetColIndices() + row_ptr[0]);
+}
+
+// 分组用的键：按地址识别时取地址与尺寸，按内容识别时对行指针与列索引做FNV哈希
+template <typename Value, typename DimIndex, typename NnzIndex>
+std::uint64_t PatternKey(const CsrView<Value, DimIndex, NnzIndex> &a, bool compare) {
+    std::uint64_t h{0xcbf29ce484222325ULL};
+    auto mix = [&h](std::uint64_t v) { h = (h ^ v) * 0x100000001b3ULL; };
+    mix(a.M());
+    mix(a.N());
+    if (!compare) {
+        mix(reinterpret_cast<std::uintptr_t>(a.GetRowPtr()));
+        mix(reinterpret_cast<std::uintptr_t>(a.GetColIndices()));
+        return h;
+    }
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    for (std::size_t r{0}; r <= a.M(); ++r) {
+        mix(static_cast<std::uint64_t>(row_ptr[r]));
+    }
+    for (auto i{row_ptr[0]}; i < row_ptr[a.M()]; ++i) {
+        mix(static_cast<std::uint64_t>(a.GetColIndices()[i]));
+    }
+    return h;
+}
+
+// 同一稀疏结构的k个矩阵逐行同时计算，列索引只读取一次，每个矩阵的求和顺序与SpMV相同
+template <typename Value, typename DimIndex, typename NnzIndex>
+void GroupSpMV(
+    const SpMVBatchItem<Value, DimIndex, NnzIndex> *items, const std::size_t *members, std::size_t k,
+    std::size_t row_begin, std::size_t row_end) {
+    const NnzIndex *row_ptr{items[members[0]].a.GetRowPtr()};
+    const DimIndex *col_indices{items[members[0]].a.GetColIndices()};
+    const Value *values[BATCH_SPMV_GROUP];
+    const Value *x[BATCH_SPMV_GROUP];
+    Value *y[BATCH_SPMV_GROUP];
+    for (std::size_t j{0}; j < k; ++j) {
+        values[j] = items[members[j]].a.GetValues();
+        x[j] = items[members[j]].x;
+        y[j] = items[members[j]].y;
+    }
+    for (std::size_t r{row_begin}; r < row_end; ++r) {
+        Value sum[BATCH_SPMV_GROUP]{};
+        for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+            const DimIndex c{col_indices[i]};
+            for (std::size_t j{0}; j < k; ++j) {
+                sum[j] += values[j][i] * x[j][c];
+            }
+        }
+        for (std::size_t j{0}; j < k; ++j) {
+            y[j][r] = sum[j];
+        }
+    }
+}
+} // namespace detail
+
+// 批量计算y_i = A_i * x_i，适用于大量小矩阵：全部矩阵按负载切分为工作单元，只发起一次并行
+// 稀疏结构相同的一般存储矩阵每BATCH_SPMV_GROUP个成组，共享行指针与列索引的读取
+// 每行只由一个单元按SpMV的顺序求和，结果与逐个调用SpMV逐位一致，与线程数无关
+// 对称压缩存储的矩阵各自作为一个单元串行计算
+template <typename Value, typename DimIndex, typename NnzIndex>
+void BatchSpMV(
+    const SpMVBatchItem<Value, DimIndex, NnzIndex> *items, std::size_t count, BatchSpMVOptions options = {}) {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+    // 1. 按稀疏结构分组，组按首个成员的出现顺序排列；哈希相同的候选组再逐一确认
+    std::vector<std::size_t> members;
+    std::vector<std::size_t> group_ptr{0};
+    {
+        std::vector<std::vector<std::size_t>> groups;
+        std::unordered_map<std::uint64_t, std::vector<std::size_t>> candidates;
+        for (std::size_t i{0}; i < count; ++i) {
+            const auto &a{items[i].a};
+            if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+                groups.push_back({i});
+                continue;
+            }
+            auto &bucket{candidates[detail::PatternKey(a, options.compare_patterns)]};
+            auto it{std::find_if(bucket.begin(), bucket.end(), [&](std::size_t g) {
+                return groups[g].size() < BATCH_SPMV_GROUP &&
+                       detail::SamePattern(items[groups[g][0]].a, a, options.compare_patterns);
+            })};
+            if (it == bucket.end()) {
+                bucket.push_back(groups.size());
+                groups.push_back({i});
+            } else {
+                groups[*it].push_back(i);
+            }
+        }
+        for (const auto &group : groups) {
+            members.insert(members.end(), group.begin(), group.end());
+            group_ptr.push_back(members.size());
+        }
+    }
+    const std::size_t num_groups{group_ptr.size() - 1};
+
+    // 2. 按负载切分工作单元，对称存储的组整体作为一个单元并排在最前
+    struct Unit {
+        std::size_t group;
+        std::size_t row_begin;
+        std::size_t row_end;
+    };
+    auto load = [&](std::size_t g) {
+        const auto &a{items[members[group_ptr[g]]].a};
+        return (a.StoredNnz() + a.M()) * (group_ptr[g + 1] - group_ptr[g]);
+    };
+    std::size_t total_load{0};
+    for (std::size_t g{0}; g < num_groups; ++g) {
+        total_load += load(g);
+    }
+    const std::size_t target{std::max(
+        total_load / std::max<std::size_t>(ThreadPool::Get().Size() * options.units_per_thread, 1),
+        BATCH_SPMV_MIN_UNIT)};
+    std::vector<Unit> units;
+    for (std::size_t g{0}; g < num_groups; ++g) {
+        const auto &a{items[members[group_ptr[g]]].a};
+        if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+            units.push_back({g, 0, a.M()});
+        }
+    }
+    for (std::size_t g{0}; g < num_groups; ++g) {
+        const auto &a{items[members[group_ptr[g]]].a};
+        if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+            continue;
+        }
+        // 行r之前的负载为(row_ptr[r] - row_ptr[0] + r) * k，对r单调，二分查找切分点
+        const NnzIndex *row_ptr{a.GetRowPtr()};
+        const std::size_t k{group_ptr[g + 1] - group_ptr[g]};
+        const std::size_t m{a.M()};
+        auto prefix = [row_ptr, k](std::size_t r) {
+            return (static_cast<std::size_t>(row_ptr[r] - row_ptr[0]) + r) * k;
+        };
+        std::size_t row_begin{0};
+        while (row_begin < m) {
+            std::size_t lo{row_begin + 1}, hi{m};
+            while (lo < hi) {
+                const std::size_t mid{lo + (hi - lo) / 2};
+                if (prefix(mid) - prefix(row_begin) < target) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            units.push_back({g, row_begin, lo});
+            row_begin = lo;
+        }
+    }
+
+    // 3. 单次并行执行全部单元
+    ThreadPool::Get().Run(units.size(), [&](std::size_t u) {
+        const Unit &unit{units[u]};
+        const std::size_t *group{members.data() + group_ptr[unit.group]};
+        const auto &item{items[group[0]]};
+        if (item.a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+            SpMV(item.a, item.x, item.y);
+            return;
+        }
+        detail::GroupSpMV(
+            items, group, group_ptr[unit.group + 1] - group_ptr[unit.group], unit.row_begin, unit.row_end);
+    });
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void BatchSpMV(const std::vector<SpMVBatchItem<Value, DimIndex, NnzIndex>> &items, BatchSpMVOptions options = {}) {
+    BatchSpMV(items.data(), items.size(), options);
+}
+
+// a、x、y逐项对应，y按需调整长度
+template <typename Matrix, typename Value>
+void BatchSpMV(
+    const std::vector<Matrix> &a, const std::vector<std::vector<Value>> &x, std::vector<std::vector<Value>> &y,
+    BatchSpMVOptions options = {}) {
+    using ItemType =
+        SpMVBatchItem<typename Matrix::ValueType, typename Matrix::DimIndexType, typename Matrix::NnzIndexType>;
+    if (x.size() != a.size()) {
+        throw std::invalid_argument("batch spmv x count mismatch");
+    }
+    y.resize(a.size());
+    std::vector<ItemType> items;
+    items.reserve(a.size());
+    for (std::size_t i{0}; i < a.size(); ++i) {
+        if (x[i].size() != a[i].N()) {
+            throw std::invalid_argument("spmv x size mismatch");
+        }
+        y[i].resize(a[i].M());
+        items.push_back({a[i], x[i].data(), y[i].data()});
+    }
+    BatchSpMV(items, options);
+}
+} // namespace oops
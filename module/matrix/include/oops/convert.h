@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/coo.h"
+#include "oops/csc.h"
+#include "oops/csr.h"
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// COO转CSR，行内按列索引升序排列，重复元素保持原始相对顺序，不做合并
+// Allocator为结果使用的分配器，void时为std::allocator
+template <typename NnzIndex = void, typename Allocator = void, typename Value, typename DimIndex>
+auto ToCsr(const CooView<Value, DimIndex> &coo) {
+    using NnzIndexType = std::conditional_t<std::is_void_v<NnzIndex>, DimIndex, NnzIndex>;
+    using AllocatorType = std::conditional_t<std::is_void_v<Allocator>, std::allocator<Value>, Allocator>;
+    using CsrType = Csr<Value, DimIndex, NnzIndexType, AllocatorType>;
+    constexpr bool has_values{!std::is_same_v<Value, std::monostate>};
+
+    const Value *coo_values{coo.GetValues()};
+    const DimIndex *coo_row_indices{coo.GetRowIndices()};
+    const DimIndex *coo_col_indices{coo.GetColIndices()};
+    const std::size_t m{coo.M()};
+    const std::size_t stored_nnz{coo.StoredNnz()};
+    if (stored_nnz > static_cast<std::size_t>(std::numeric_limits<NnzIndexType>::max())) {
+        throw std::overflow_error("stored nnz exceeds nnz index range");
+    }
+
+    typename CsrType::StoreType store;
+    store.n = coo.N();
+    store.row_ptr.assign(m + 1, 0);
+    for (std::size_t i{0}; i < stored_nnz; ++i) {
+        ++store.row_ptr[coo_row_indices[i] + 1];
+    }
+    std::partial_sum(store.row_ptr.begin(), store.row_ptr.end(), store.row_ptr.begin());
+
+    // 按行散射原始下标，再对行内下标按列排序，最后一次性收集列索引与值
+    std::vector<NnzIndexType> perm(stored_nnz);
+    {
+        std::vector<NnzIndexType> pos(store.row_ptr.begin(), store.row_ptr.end() - 1);
+        for (std::size_t i{0}; i < stored_nnz; ++i) {
+            perm[pos[coo_row_indices[i]]++] = static_cast<NnzIndexType>(i);
+        }
+    }
+
+    store.col_indices.resize(stored_nnz);
+    if constexpr (has_values) {
+        store.values.resize(stored_nnz);
+    }
+    ParallelFor(0, m, 1024, [&](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            auto first{perm.begin() + store.row_ptr[r]};
+            auto last{perm.begin() + store.row_ptr[r + 1]};
+            std::sort(first, last, [coo_col_indices](NnzIndexType lhs, NnzIndexType rhs) {
+                auto lhs_col{coo_col_indices[lhs]};
+                auto rhs_col{coo_col_indices[rhs]};
+                return lhs_col < rhs_col || (lhs_col == rhs_col && lhs < rhs);
+            });
+            for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                store.col_indices[i] = coo_col_indices[perm[i]];
+                if constexpr (has_values) {
+                    store.values[i] = coo_values[perm[i]];
+                }
+            }
+        }
+    });
+    return CsrType{std::move(store), coo.GetSymmetric()};
+}
+
+// 结果沿用输入的分配器
+template <typename NnzIndex = void, typename Value, typename DimIndex, typename Allocator>
+auto ToCsr(const Coo<Value, DimIndex, Allocator> &coo) {
+    return ToCsr<NnzIndex, Allocator>(CooView<Value, DimIndex>{coo});
+}
+
+// CSR转CSC，表示同一矩阵，对称属性不变
+template <typename Allocator = void, typename Value, typename DimIndex, typename NnzIndex>
+auto ToCsc(const CsrView<Value, DimIndex, NnzIndex> &a) {
+    using AllocatorType = std::conditional_t<std::is_void_v<Allocator>, std::allocator<Value>, Allocator>;
+    using CscType = Csc<Value, DimIndex, NnzIndex, AllocatorType>;
+    typename CscType::StoreType store;
+    store.m = a.M();
+    detail::TransposeStore(a, store.col_ptr, store.row_indices, store.values);
+    return CscType{std::move(store), a.GetSymmetric()};
+}
+
+// 结果沿用输入的分配器；转置结构缓存于a的模式上，模式不变时再次转换只收集数值
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+auto ToCsc(const Csr<Value, DimIndex, NnzIndex, Allocator> &a) {
+    using CscType = Csc<Value, DimIndex, NnzIndex, Allocator>;
+    const auto transposed{detail::GetTransposedPattern(*a.GetPattern())};
+    typename CscType::StoreType store;
+    store.m = a.M();
+    store.col_ptr = transposed->pattern->GetRowPtr();
+    store.row_indices = transposed->pattern->GetColIndices();
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        detail::GatherValues(a.GetValues().data(), transposed->src, store.values);
+    }
+    return CscType{std::move(store), a.GetSymmetric()};
+}
+
+inline AnyCsr ToCsr(const AnyCoo &coo) {
+    return coo.Visit([](const auto &var) -> AnyCsr { return ToCsr(var); });
+}
+} // namespace oops
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstddef>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -7,19 +8,22 @@
 #include "oops/type_list.h"
 
 namespace oops {
-// 数据存储类
-template <typename Value, typename DimIndex>
+// 数据存储类，Allocator按元素类型重绑定后用于各数组
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<Value>>
 struct CooStore {
     static_assert(std::is_integral_v<DimIndex>);
 
     using ValueType = Value;
     using DimIndexType = DimIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = std::vector<T, RebindAlloc<Allocator, T>>;
 
     std::size_t m;
     std::size_t n;
-    std::vector<Value> values;
-    std::vector<DimIndex> row_indices;
-    std::vector<DimIndex> col_indices;
+    Vector<Value> values;
+    Vector<DimIndex> row_indices;
+    Vector<DimIndex> col_indices;
 };
 
 template <typename Value, typename DimIndex>
@@ -29,10 +33,10 @@ struct Triplet {
     DimIndex col_index;
 };
 
-template <typename Value, typename DimIndex>
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<std::remove_const_t<Value>>>
 class CooIterator {
 public:
-    using StoreTypeBase = CooStore<std::remove_const_t<Value>, DimIndex>;
+    using StoreTypeBase = CooStore<std::remove_const_t<Value>, DimIndex, Allocator>;
     using StoreType = std::conditional_t<std::is_const_v<Value>, const StoreTypeBase, StoreTypeBase>;
     using TripletProxy = Triplet<Value &, DimIndex>;
 
@@ -81,18 +85,21 @@ private:
     std::size_t i_{0};
 };
 
-template <typename Value, typename DimIndex>
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<Value>>
 class Coo {
 public:
-    template <typename OtherValue, typename OtherDimIndex>
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
     friend class Coo;
 
-    using StoreType = CooStore<Value, DimIndex>;
+    using StoreType = CooStore<Value, DimIndex, Allocator>;
     using ValueType = typename StoreType::ValueType;
     using DimIndexType = typename StoreType::DimIndexType;
+    using AllocatorType = typename StoreType::AllocatorType;
+    template <typename T>
+    using Vector = typename StoreType::template Vector<T>;
 
-    using iterator = CooIterator<Value, DimIndex>;
-    using const_iterator = CooIterator<const Value, DimIndex>;
+    using iterator = CooIterator<Value, DimIndex, Allocator>;
+    using const_iterator = CooIterator<const Value, DimIndex, Allocator>;
 
     static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_COO};
     static constexpr MatrixNumeric VALUE_NUMERIC{MATRIX_NUMERIC_OF<Value>};
@@ -106,23 +113,24 @@ public:
     Coo(const Coo &) = default;
     Coo(Coo &&) noexcept = default;
 
-    template <typename OtherValue, typename OtherDimIndex>
-    Coo(const Coo<OtherValue, OtherDimIndex> &rhs) : store_{ConvertStore(rhs.store_)}, symmetric_{rhs.symmetric_} {}
-    template <typename OtherValue, typename OtherDimIndex>
-    Coo(Coo<OtherValue, OtherDimIndex> &&rhs)
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
+    Coo(const Coo<OtherValue, OtherDimIndex, OtherAllocator> &rhs)
+        : store_{ConvertStore(rhs.store_)}, symmetric_{rhs.symmetric_} {}
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
+    Coo(Coo<OtherValue, OtherDimIndex, OtherAllocator> &&rhs)
         : store_{ConvertStore(std::move(rhs.store_))}, symmetric_{rhs.symmetric_} {}
 
     Coo &operator=(const Coo &) = default;
     Coo &operator=(Coo &&) noexcept = default;
 
-    template <typename OtherValue, typename OtherDimIndex>
-    Coo &operator=(const Coo<OtherValue, OtherDimIndex> &rhs) {
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
+    Coo &operator=(const Coo<OtherValue, OtherDimIndex, OtherAllocator> &rhs) {
         store_ = ConvertStore(rhs.store_);
         symmetric_ = rhs.symmetric_;
         return *this;
     }
-    template <typename OtherValue, typename OtherDimIndex>
-    Coo &operator=(Coo<OtherValue, OtherDimIndex> &&rhs) {
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
+    Coo &operator=(Coo<OtherValue, OtherDimIndex, OtherAllocator> &&rhs) {
         store_ = ConvertStore(std::move(rhs.store_));
         symmetric_ = rhs.symmetric_;
         return *this;
@@ -179,27 +187,30 @@ public:
         return 2 * StoredNnz() - DiagNnz();
     }
 
-    const std::vector<Value> &GetValues() const { return store_.values; }
-    const std::vector<DimIndex> &GetRowIndices() const { return store_.row_indices; }
-    const std::vector<DimIndex> &GetColIndices() const { return store_.col_indices; }
+    const Vector<Value> &GetValues() const { return store_.values; }
+    const Vector<DimIndex> &GetRowIndices() const { return store_.row_indices; }
+    const Vector<DimIndex> &GetColIndices() const { return store_.col_indices; }
     const StoreType &GetStore() const { return store_; }
 
     // 提取内部Store所有权
     StoreType &ExtractStore() { return std::move(store_); }
 
 private:
-    template <typename OtherValue, typename OtherDimIndex>
-    static CooStore<Value, DimIndex> ConvertStore(const CooStore<OtherValue, OtherDimIndex> &rhs) {
+    // 目标分配器与源分配器同族时保留其状态
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
+    static StoreType ConvertStore(const CooStore<OtherValue, OtherDimIndex, OtherAllocator> &rhs) {
         return {
-            rhs.m, rhs.n, ConvertVector<Value>(rhs.values), ConvertVector<DimIndex>(rhs.row_indices),
-            ConvertVector<DimIndex>(rhs.col_indices)};
+            rhs.m, rhs.n, ConvertVector<Value, RebindAlloc<Allocator, Value>>(rhs.values),
+            ConvertVector<DimIndex, RebindAlloc<Allocator, DimIndex>>(rhs.row_indices),
+            ConvertVector<DimIndex, RebindAlloc<Allocator, DimIndex>>(rhs.col_indices)};
     }
 
-    template <typename OtherValue, typename OtherDimIndex>
-    static CooStore<Value, DimIndex> ConvertStore(CooStore<OtherValue, OtherDimIndex> &&rhs) {
+    template <typename OtherValue, typename OtherDimIndex, typename OtherAllocator>
+    static StoreType ConvertStore(CooStore<OtherValue, OtherDimIndex, OtherAllocator> &&rhs) {
         return {
-            rhs.m, rhs.n, ConvertVector<Value>(std::move(rhs.values)),
-            ConvertVector<DimIndex>(std::move(rhs.row_indices)), ConvertVector<DimIndex>(std::move(rhs.col_indices))};
+            rhs.m, rhs.n, ConvertVector<Value, RebindAlloc<Allocator, Value>>(std::move(rhs.values)),
+            ConvertVector<DimIndex, RebindAlloc<Allocator, DimIndex>>(std::move(rhs.row_indices)),
+            ConvertVector<DimIndex, RebindAlloc<Allocator, DimIndex>>(std::move(rhs.col_indices))};
     }
 
     DimIndex ComputeDiagNnz() const {
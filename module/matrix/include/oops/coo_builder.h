@@ -0,0 +1,422 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "oops/coo.h"
+#include "oops/csr.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+namespace detail {
+// 追加式分块缓冲：块容量逐次翻倍，已写入元素不搬移，Clear后保留已分配的块复用
+template <typename T>
+class ChunkArena {
+public:
+    static constexpr std::size_t MIN_CHUNK{256};
+    static constexpr std::size_t MAX_CHUNK{1 << 16};
+
+    void Push(const T &t) {
+        if (chunk_ == chunks_.size() || offset_ == chunks_[chunk_].capacity) {
+            NextChunk();
+        }
+        chunks_[chunk_].data[offset_++] = t;
+        ++size_;
+    }
+
+    std::size_t Size() const { return size_; }
+
+    void Clear() {
+        chunk_ = 0;
+        offset_ = 0;
+        size_ = 0;
+    }
+
+    // 按写入顺序对每个非空块调用f(data, count)
+    template <typename F>
+    void ForEachSegment(F &&f) const {
+        std::size_t rest{size_};
+        for (std::size_t c{0}; rest > 0; ++c) {
+            const std::size_t count{std::min(rest, chunks_[c].capacity)};
+            f(chunks_[c].data.get(), count);
+            rest -= count;
+        }
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<T[]> data;
+        std::size_t capacity{};
+    };
+
+    void NextChunk() {
+        if (size_ > 0) {
+            ++chunk_;
+        }
+        offset_ = 0;
+        if (chunk_ == chunks_.size()) {
+            const std::size_t capacity{chunks_.empty() ? MIN_CHUNK : std::min(2 * chunks_.back().capacity, MAX_CHUNK)};
+            chunks_.push_back({std::make_unique<T[]>(capacity), capacity});
+        }
+    }
+
+    std::vector<Chunk> chunks_;
+    std::size_t chunk_{0};
+    std::size_t offset_{0};
+    std::size_t size_{0};
+};
+
+// 各段元素按bucket_of分桶：逐段计数，按桶主序、段次序求偏移后并行散射，同桶内保持段顺序与段内顺序
+template <typename T, typename BucketOf>
+void BucketSegments(
+    const std::vector<std::pair<const T *, std::size_t>> &segments, std::size_t num_buckets, BucketOf &&bucket_of,
+    std::vector<T> &out, std::vector<std::size_t> &bucket_ptr) {
+    const std::size_t num_segments{segments.size()};
+    std::vector<std::size_t> offsets(num_segments * num_buckets, 0);
+    ParallelFor(0, num_segments, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t s{begin}; s < end; ++s) {
+            for (std::size_t i{0}; i < segments[s].second; ++i) {
+                ++offsets[s * num_buckets + bucket_of(segments[s].first[i])];
+            }
+        }
+    });
+    bucket_ptr.assign(num_buckets + 1, 0);
+    std::size_t offset{0};
+    for (std::size_t b{0}; b < num_buckets; ++b) {
+        bucket_ptr[b] = offset;
+        for (std::size_t s{0}; s < num_segments; ++s) {
+            const std::size_t count{offsets[s * num_buckets + b]};
+            offsets[s * num_buckets + b] = offset;
+            offset += count;
+        }
+    }
+    bucket_ptr[num_buckets] = offset;
+    out.resize(offset);
+    ParallelFor(0, num_segments, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t s{begin}; s < end; ++s) {
+            for (std::size_t i{0}; i < segments[s].second; ++i) {
+                const T &t{segments[s].first[i]};
+                out[offsets[s * num_buckets + bucket_of(t)]++] = t;
+            }
+        }
+    });
+}
+
+// 值的逐字节序，用于确定重复元素的累加顺序，使结果与线程调度无关
+template <typename Value>
+bool BytewiseLess(const Value &lhs, const Value &rhs) {
+    return std::memcmp(&lhs, &rhs, sizeof(Value)) < 0;
+}
+} // namespace detail
+
+// 多线程装配构造器
+// 1. 构造模式：Add将三元组追加至调用线程的私有缓冲，线程首次调用时登记缓冲，之后无锁；
+//    ToCsr/ToCoo按行块并行合并为行内列升序、重复元素求和的规范形式，并清空缓冲
+// 2. 复用模式：Reuse登记已知的稀疏模式，Add直接定位非零元在values中的位置，
+//    Assemble按位置块并行散射累加至values
+// 重复元素按值的逐字节序累加，结果与线程数及调度无关
+// Add可被多线程并发调用，其余成员函数须在无并发Add时调用；对称存储时由调用方保证只添加对应三角部分
+template <typename Value, typename DimIndex>
+class CooBuilder {
+    static_assert(std::is_integral_v<DimIndex>);
+    static constexpr bool HAS_VALUES{!std::is_same_v<Value, std::monostate>};
+
+public:
+    using CooType = Coo<Value, DimIndex>;
+
+    CooBuilder(std::size_t m, std::size_t n, MatrixSymmetric symmetric = MatrixSymmetric::GENERAL)
+        : m_{m}, n_{n}, symmetric_{symmetric}, id_{NextId()} {}
+
+    CooBuilder(const CooBuilder &) = delete;
+    CooBuilder &operator=(const CooBuilder &) = delete;
+
+    std::size_t M() const { return m_; }
+    std::size_t N() const { return n_; }
+    bool IsReusing() const { return reusing_; }
+
+    void Add(DimIndex row, DimIndex col, const Value &value = {}) {
+        // 负索引转换后超出范围
+        if (static_cast<std::size_t>(row) >= m_ || static_cast<std::size_t>(col) >= n_) {
+            std::ostringstream oss;
+            oss << "builder index (" << row << ", " << col << ") out of range";
+            throw std::out_of_range(oss.str());
+        }
+        auto &buffer{Local()};
+        if (reusing_) {
+            buffer.updates.Push({Find(row, col), value});
+        } else {
+            buffer.triplets.Push({value, row, col});
+        }
+    }
+
+    // 缓冲中尚未合并的元素数
+    std::size_t Size() const {
+        std::size_t size{0};
+        for (const auto &buffer : buffers_) {
+            size += buffer->triplets.Size() + buffer->updates.Size();
+        }
+        return size;
+    }
+
+    void Clear() {
+        for (auto &buffer : buffers_) {
+            buffer->triplets.Clear();
+            buffer->updates.Clear();
+        }
+    }
+
+    template <typename NnzIndex = DimIndex>
+    Csr<Value, DimIndex, NnzIndex> ToCsr() {
+        CheckBuilding();
+        using Entry = Triplet<Value, DimIndex>;
+        const std::size_t num_blocks{NumBlocks(m_)};
+        const std::size_t block_rows{(m_ + num_blocks - 1) / num_blocks};
+        std::vector<Entry> entries;
+        std::vector<std::size_t> block_ptr;
+        detail::BucketSegments(
+            Segments(&Buffer::triplets), num_blocks,
+            [block_rows](const Entry &e) { return static_cast<std::size_t>(e.row_index) / block_rows; }, entries,
+            block_ptr);
+
+        // 块内按行计数排序，行内按列及值排序后合并重复元素，压缩写回块区间起始处
+        std::vector<std::size_t> row_nnz(m_ + 1, 0);
+        ParallelFor(0, num_blocks, 1, [&](std::size_t begin, std::size_t end) {
+            std::vector<Entry> sorted;
+            std::vector<std::size_t> pos;
+            for (std::size_t b{begin}; b < end; ++b) {
+                const std::size_t r0{std::min(m_, b * block_rows)};
+                const std::size_t r1{std::min(m_, r0 + block_rows)};
+                pos.assign(r1 - r0 + 1, 0);
+                for (std::size_t i{block_ptr[b]}; i < block_ptr[b + 1]; ++i) {
+                    ++pos[entries[i].row_index - r0 + 1];
+                }
+                for (std::size_t r{r0}; r < r1; ++r) {
+                    pos[r - r0 + 1] += pos[r - r0];
+                }
+                sorted.resize(block_ptr[b + 1] - block_ptr[b]);
+                for (std::size_t i{block_ptr[b]}; i < block_ptr[b + 1]; ++i) {
+                    sorted[pos[entries[i].row_index - r0]++] = entries[i];
+                }
+                std::size_t out{block_ptr[b]};
+                auto first{sorted.begin()};
+                for (std::size_t r{r0}; r < r1; ++r) {
+                    const auto last{sorted.begin() + pos[r - r0]};
+                    std::sort(first, last, [](const Entry &lhs, const Entry &rhs) {
+                        if (lhs.col_index != rhs.col_index) {
+                            return lhs.col_index < rhs.col_index;
+                        }
+                        if constexpr (HAS_VALUES) {
+                            return detail::BytewiseLess(lhs.value, rhs.value);
+                        }
+                        return false;
+                    });
+                    const std::size_t row_begin{out};
+                    for (auto it{first}; it != last; ++it) {
+                        if (out > row_begin && entries[out - 1].col_index == it->col_index) {
+                            if constexpr (HAS_VALUES) {
+                                entries[out - 1].value += it->value;
+                            }
+                        } else {
+                            entries[out++] = *it;
+                        }
+                    }
+                    row_nnz[r + 1] = out - row_begin;
+                    first = last;
+                }
+            }
+        });
+        for (std::size_t r{0}; r < m_; ++r) {
+            row_nnz[r + 1] += row_nnz[r];
+        }
+        const std::size_t nnz{row_nnz[m_]};
+        if (nnz > static_cast<std::size_t>(std::numeric_limits<NnzIndex>::max())) {
+            throw std::overflow_error("stored nnz exceeds nnz index range");
+        }
+
+        CsrStore<Value, DimIndex, NnzIndex> store;
+        store.n = n_;
+        store.row_ptr.resize(m_ + 1);
+        std::transform(row_nnz.begin(), row_nnz.end(), store.row_ptr.begin(), [](std::size_t p) {
+            return static_cast<NnzIndex>(p);
+        });
+        store.col_indices.resize(nnz);
+        if constexpr (HAS_VALUES) {
+            store.values.resize(nnz);
+        }
+        ParallelFor(0, num_blocks, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t b{begin}; b < end; ++b) {
+                const std::size_t r0{std::min(m_, b * block_rows)};
+                const std::size_t r1{std::min(m_, r0 + block_rows)};
+                for (std::size_t i{row_nnz[r0]}, j{block_ptr[b]}; i < row_nnz[r1]; ++i, ++j) {
+                    store.col_indices[i] = entries[j].col_index;
+                    if constexpr (HAS_VALUES) {
+                        store.values[i] = entries[j].value;
+                    }
+                }
+            }
+        });
+        Clear();
+        return {std::move(store), symmetric_};
+    }
+
+    // 按行主序、行内列升序排列的规范COO
+    CooType ToCoo() {
+        auto csr{ToCsr<std::size_t>()};
+        const auto &csr_store{csr.GetStore()};
+        CooStore<Value, DimIndex> store;
+        store.m = m_;
+        store.n = n_;
+        store.row_indices.resize(csr.StoredNnz());
+        store.col_indices = csr_store.col_indices;
+        store.values = csr_store.values;
+        ParallelFor(0, m_, 1024, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                auto first{store.row_indices.begin()};
+                std::fill(first + csr_store.row_ptr[r], first + csr_store.row_ptr[r + 1], static_cast<DimIndex>(r));
+            }
+        });
+        return {std::move(store), symmetric_};
+    }
+
+    // 进入复用模式，pattern须为行内列严格升序的规范CSR，其后Add的位置须落在该模式内
+    template <typename NnzIndex>
+    void Reuse(const Csr<Value, DimIndex, NnzIndex> &pattern) {
+        static_assert(HAS_VALUES, "pattern matrix has no values");
+        if (pattern.M() != m_ || pattern.N() != n_) {
+            throw std::invalid_argument("reuse pattern dimension mismatch");
+        }
+        const auto &store{pattern.GetStore()};
+        row_ptr_.assign(store.row_ptr.begin(), store.row_ptr.end());
+        col_indices_ = store.col_indices;
+        for (std::size_t r{0}; r < m_; ++r) {
+            for (std::size_t i{row_ptr_[r] + 1}; i < row_ptr_[r + 1]; ++i) {
+                if (col_indices_[i - 1] >= col_indices_[i]) {
+                    throw std::invalid_argument("reuse pattern requires sorted unique columns");
+                }
+            }
+        }
+        Clear();
+        reusing_ = true;
+    }
+
+    // 复用模式下将缓冲中的元素累加至与模式对应的values，values先被置零，之后清空缓冲
+    void Assemble(std::vector<Value> &values) {
+        static_assert(HAS_VALUES, "pattern matrix has no values");
+        if (!reusing_) {
+            throw std::logic_error("builder is not in reuse mode");
+        }
+        const std::size_t nnz{col_indices_.size()};
+        values.assign(nnz, Value{});
+        const std::size_t num_blocks{NumBlocks(nnz)};
+        const std::size_t block_size{(nnz + num_blocks - 1) / std::max<std::size_t>(num_blocks, 1)};
+        std::vector<Update> updates;
+        std::vector<std::size_t> block_ptr;
+        detail::BucketSegments(
+            Segments(&Buffer::updates), num_blocks, [block_size](const Update &u) { return u.pos / block_size; },
+            updates, block_ptr);
+        ParallelFor(0, num_blocks, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t b{begin}; b < end; ++b) {
+                auto first{updates.begin() + block_ptr[b]};
+                auto last{updates.begin() + block_ptr[b + 1]};
+                std::sort(first, last, [](const Update &lhs, const Update &rhs) {
+                    return lhs.pos != rhs.pos ? lhs.pos < rhs.pos : detail::BytewiseLess(lhs.value, rhs.value);
+                });
+                for (auto it{first}; it != last; ++it) {
+                    values[it->pos] += it->value;
+                }
+            }
+        });
+        Clear();
+    }
+
+private:
+    struct Update {
+        std::size_t pos;
+        Value value;
+    };
+
+    struct Buffer {
+        detail::ChunkArena<Triplet<Value, DimIndex>> triplets;
+        detail::ChunkArena<Update> updates;
+    };
+
+    static std::uint64_t NextId() {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::size_t NumBlocks(std::size_t size) {
+        return std::max<std::size_t>(std::min<std::size_t>(size, 4 * ThreadPool::Get().Size()), 1);
+    }
+
+    // 调用线程的私有缓冲，线程局部缓存最近使用的构造器，未命中时加锁登记
+    Buffer &Local() {
+        struct Cache {
+            std::uint64_t id{0};
+            Buffer *buffer{nullptr};
+        };
+        thread_local Cache cache;
+        if (cache.id == id_) {
+            return *cache.buffer;
+        }
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto &buffer{index_[std::this_thread::get_id()]};
+        if (buffer == nullptr) {
+            buffers_.push_back(std::make_unique<Buffer>());
+            buffer = buffers_.back().get();
+        }
+        cache = {id_, buffer};
+        return *buffer;
+    }
+
+    template <typename T>
+    std::vector<std::pair<const T *, std::size_t>> Segments(detail::ChunkArena<T> Buffer::*arena) const {
+        std::vector<std::pair<const T *, std::size_t>> segments;
+        for (const auto &buffer : buffers_) {
+            ((*buffer).*arena).ForEachSegment([&segments](const T *data, std::size_t count) {
+                segments.emplace_back(data, count);
+            });
+        }
+        return segments;
+    }
+
+    std::size_t Find(DimIndex row, DimIndex col) const {
+        const auto first{col_indices_.begin() + row_ptr_[row]};
+        const auto last{col_indices_.begin() + row_ptr_[row + 1]};
+        const auto it{std::lower_bound(first, last, col)};
+        if (it == last || *it != col) {
+            std::ostringstream oss;
+            oss << "not found nnz at (" << row << ", " << col << ")";
+            throw std::out_of_range(oss.str());
+        }
+        return it - col_indices_.begin();
+    }
+
+    void CheckBuilding() const {
+        if (reusing_) {
+            throw std::logic_error("builder is in reuse mode");
+        }
+    }
+
+    std::size_t m_;
+    std::size_t n_;
+    MatrixSymmetric symmetric_;
+    std::uint64_t id_;
+    bool reusing_{false};
+    std::vector<std::size_t> row_ptr_;
+    std::vector<DimIndex> col_indices_;
+
+    std::mutex mutex_;
+    std::unordered_map<std::thread::id, Buffer *> index_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+} // namespace oops
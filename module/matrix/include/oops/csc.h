@@ -0,0 +1,95 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "oops/matrix_type.h"
+
+namespace oops {
+// 数据存储类，第c列元素位于[col_ptr[c], col_ptr[c + 1])，列内行索引升序
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex, typename Allocator = std::allocator<Value>>
+struct CscStore {
+    static_assert(std::is_integral_v<DimIndex>);
+    static_assert(std::is_integral_v<NnzIndex>);
+
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using NnzIndexType = NnzIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = std::vector<T, RebindAlloc<Allocator, T>>;
+
+    std::size_t m;
+    Vector<Value> values;
+    Vector<NnzIndex> col_ptr;
+    Vector<DimIndex> row_indices;
+};
+
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex, typename Allocator = std::allocator<Value>>
+class Csc {
+public:
+    using StoreType = CscStore<Value, DimIndex, NnzIndex, Allocator>;
+    using ValueType = typename StoreType::ValueType;
+    using DimIndexType = typename StoreType::DimIndexType;
+    using NnzIndexType = typename StoreType::NnzIndexType;
+    using AllocatorType = typename StoreType::AllocatorType;
+    template <typename T>
+    using Vector = typename StoreType::template Vector<T>;
+
+    static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_CSC};
+    static constexpr MatrixNumeric VALUE_NUMERIC{MATRIX_NUMERIC_OF<Value>};
+    static constexpr MatrixNumeric DIM_INDEX_NUMERIC{MATRIX_NUMERIC_OF<DimIndex>};
+    static constexpr MatrixNumeric NNZ_INDEX_NUMERIC{MATRIX_NUMERIC_OF<NnzIndex>};
+
+    Csc() = default;
+    // "pass-by-value + move" idiom
+    Csc(StoreType store) : store_{std::move(store)} {}
+    Csc(StoreType store, MatrixSymmetric symmetric) : store_{std::move(store)}, symmetric_{symmetric} {}
+
+    static constexpr MatrixFormat GetFormat() { return FORMAT; }
+    static constexpr MatrixNumeric GetValueNumeric() { return VALUE_NUMERIC; }
+    static constexpr MatrixNumeric GetDimIndexNumeric() { return DIM_INDEX_NUMERIC; }
+    static constexpr MatrixNumeric GetNnzIndexNumeric() { return NNZ_INDEX_NUMERIC; }
+    MatrixSymmetric GetSymmetric() const { return symmetric_; }
+
+    std::size_t M() const { return store_.m; }
+    std::size_t N() const { return store_.col_ptr.size() - 1; }
+    std::size_t StoredNnz() const { return store_.row_indices.size(); }
+
+    std::size_t DiagNnz() const {
+        if (!diag_nnz_) {
+            diag_nnz_ = ComputeDiagNnz();
+        }
+        return *diag_nnz_;
+    }
+
+    std::size_t Nnz() const {
+        if (symmetric_ == MatrixSymmetric::GENERAL) {
+            return StoredNnz();
+        }
+        return 2 * StoredNnz() - DiagNnz();
+    }
+
+    const Vector<Value> &GetValues() const { return store_.values; }
+    const Vector<NnzIndex> &GetColPtr() const { return store_.col_ptr; }
+    const Vector<DimIndex> &GetRowIndices() const { return store_.row_indices; }
+    const StoreType &GetStore() const { return store_; }
+
+private:
+    DimIndex ComputeDiagNnz() const {
+        DimIndex count{0};
+        for (std::size_t c{0}; c < N(); ++c) {
+            for (auto i{store_.col_ptr[c]}; i < store_.col_ptr[c + 1]; ++i) {
+                if (c == static_cast<std::size_t>(store_.row_indices[i])) {
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+
+    StoreType store_;
+    MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
+    mutable std::optional<DimIndex> diag_nnz_;
+};
+} // namespace oops
@@ -1,12 +1,17 @@
 #pragma once
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "oops/csr_pattern.h"
 #include "oops/matrix_type.h"
 
 namespace oops {
-// 数据存储类
-template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+// 数据存储类，Allocator按元素类型重绑定后用于各数组
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex, typename Allocator = std::allocator<Value>>
 struct CsrStore {
     static_assert(std::is_integral_v<DimIndex>);
     static_assert(std::is_integral_v<NnzIndex>);
@@ -14,58 +19,110 @@ struct CsrStore {
     using ValueType = Value;
     using DimIndexType = DimIndex;
     using NnzIndexType = NnzIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = std::vector<T, RebindAlloc<Allocator, T>>;
 
     std::size_t n;
-    std::vector<Value> values;
-    std::vector<NnzIndex> row_ptr;
-    std::vector<DimIndex> col_indices;
+    Vector<Value> values;
+    Vector<NnzIndex> row_ptr;
+    Vector<DimIndex> col_indices;
 };
 
-template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+// 只读的存储引用，数组引用Csr的数值与共享模式；需要可修改的副本时转换为CsrStore
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex, typename Allocator = std::allocator<Value>>
+struct CsrStoreRef {
+    using StoreType = CsrStore<Value, DimIndex, NnzIndex, Allocator>;
+    template <typename T>
+    using Vector = typename StoreType::template Vector<T>;
+
+    operator StoreType() const { return {n, values, row_ptr, col_indices}; }
+
+    std::size_t n;
+    const Vector<Value> &values;
+    const Vector<NnzIndex> &row_ptr;
+    const Vector<DimIndex> &col_indices;
+};
+
+// 数值与稀疏结构分离：结构为共享的不可变CsrPattern，复制Csr只复制数值
+// 由CsrStore构造时移入行指针与列索引生成新模式；模式不变时以UpdateValues就地替换数值
+// 默认构造与被移动后的对象引用同类型共享的0 x 0空模式，模式指针始终非空
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex, typename Allocator = std::allocator<Value>>
 class Csr {
 public:
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
+    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex, typename OtherAllocator>
     friend class Csr;
 
-    using StoreType = CsrStore<Value, DimIndex, NnzIndex>;
+    using StoreType = CsrStore<Value, DimIndex, NnzIndex, Allocator>;
+    using StoreRefType = CsrStoreRef<Value, DimIndex, NnzIndex, Allocator>;
     using ValueType = typename StoreType::ValueType;
     using DimIndexType = typename StoreType::DimIndexType;
     using NnzIndexType = typename StoreType::NnzIndexType;
+    using AllocatorType = typename StoreType::AllocatorType;
+    template <typename T>
+    using Vector = typename StoreType::template Vector<T>;
+    // 模式的分配器与数值类型无关，数值类型不同的Csr可共享同一模式
+    using PatternType = CsrPattern<DimIndex, NnzIndex, RebindAlloc<Allocator, NnzIndex>>;
 
     static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_CSR};
     static constexpr MatrixNumeric VALUE_NUMERIC{MATRIX_NUMERIC_OF<Value>};
     static constexpr MatrixNumeric DIM_INDEX_NUMERIC{MATRIX_NUMERIC_OF<DimIndex>};
     static constexpr MatrixNumeric NNZ_INDEX_NUMERIC{MATRIX_NUMERIC_OF<NnzIndex>};
 
-    Csr() = default;
+    Csr() : pattern_{EmptyPattern()} {}
     // "pass-by-value + move" idiom
-    Csr(StoreType store) : store_{std::move(store)} {}
-    Csr(StoreType store, MatrixSymmetric symmetric) : store_{std::move(store)}, symmetric_{symmetric} {}
+    Csr(StoreType store) : Csr{std::move(store), MatrixSymmetric::GENERAL} {}
+    Csr(StoreType store, MatrixSymmetric symmetric)
+        : values_{std::move(store.values)}, pattern_{std::make_shared<const PatternType>(
+                                                 store.n, std::move(store.row_ptr), std::move(store.col_indices))},
+          symmetric_{symmetric} {}
+    // 引用已有模式，values长度须与模式的存储非零元数一致(pattern矩阵为空)
+    Csr(std::shared_ptr<const PatternType> pattern, Vector<Value> values,
+        MatrixSymmetric symmetric = MatrixSymmetric::GENERAL)
+        : values_{std::move(values)}, pattern_{std::move(pattern)}, symmetric_{symmetric} {
+        if (pattern_ == nullptr) {
+            throw std::invalid_argument("csr pattern is null");
+        }
+        CheckValuesSize(values_.size());
+    }
 
     Csr(const Csr &) = default;
-    Csr(Csr &&) noexcept = default;
+    Csr(Csr &&rhs) noexcept
+        : values_{std::move(rhs.values_)}, pattern_{std::exchange(rhs.pattern_, EmptyPattern())},
+          symmetric_{rhs.symmetric_} {
+        rhs.values_.clear();
+    }
 
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
-    Csr(const Csr<OtherValue, OtherDimIndex, OtherNnzIndex> &rhs)
-        : store_{ConvertStore(rhs.store_)}, symmetric_{rhs.symmetric_} {}
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
-    Csr(Csr<OtherValue, OtherDimIndex, OtherNnzIndex> &&rhs)
-        : store_{ConvertStore(std::move(rhs.store_))}, symmetric_{rhs.symmetric_} {}
+    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex, typename OtherAllocator>
+    Csr(const Csr<OtherValue, OtherDimIndex, OtherNnzIndex, OtherAllocator> &rhs)
+        : values_{ConvertVector<Value, RebindAlloc<Allocator, Value>>(rhs.values_)},
+          pattern_{ConvertPattern(rhs.pattern_)}, symmetric_{rhs.symmetric_} {}
+    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex, typename OtherAllocator>
+    Csr(Csr<OtherValue, OtherDimIndex, OtherNnzIndex, OtherAllocator> &&rhs)
+        : values_{ConvertVector<Value, RebindAlloc<Allocator, Value>>(std::move(rhs.values_))},
+          pattern_{ConvertPattern(rhs.pattern_)}, symmetric_{rhs.symmetric_} {
+        rhs.values_.clear();
+        rhs.pattern_ = rhs.EmptyPattern();
+    }
 
     Csr &operator=(const Csr &) = default;
-    Csr &operator=(Csr &&) noexcept = default;
-
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
-    Csr &operator=(const Csr<OtherValue, OtherDimIndex, OtherNnzIndex> &rhs) {
-        store_ = ConvertStore(rhs.store_);
-        symmetric_ = rhs.symmetric_;
+    Csr &operator=(Csr &&rhs) noexcept {
+        if (this != &rhs) {
+            values_ = std::move(rhs.values_);
+            rhs.values_.clear();
+            pattern_ = std::exchange(rhs.pattern_, EmptyPattern());
+            symmetric_ = rhs.symmetric_;
+        }
         return *this;
     }
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
-    Csr &operator=(Csr<OtherValue, OtherDimIndex, OtherNnzIndex> &&rhs) {
-        store_ = ConvertStore(std::move(rhs.store_));
-        symmetric_ = rhs.symmetric_;
-        return *this;
+
+    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex, typename OtherAllocator>
+    Csr &operator=(const Csr<OtherValue, OtherDimIndex, OtherNnzIndex, OtherAllocator> &rhs) {
+        return *this = Csr{rhs};
+    }
+    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex, typename OtherAllocator>
+    Csr &operator=(Csr<OtherValue, OtherDimIndex, OtherNnzIndex, OtherAllocator> &&rhs) {
+        return *this = Csr{std::move(rhs)};
     }
 
     static constexpr MatrixFormat GetFormat() { return FORMAT; }
@@ -74,16 +131,10 @@ public:
     static constexpr MatrixNumeric GetNnzIndexNumeric() { return NNZ_INDEX_NUMERIC; }
     MatrixSymmetric GetSymmetric() const { return symmetric_; }
 
-    std::size_t M() const { return store_.row_ptr.size() - 1; }
-    std::size_t N() const { return store_.n; }
-    std::size_t StoredNnz() const { return store_.col_indices.size(); }
-
-    std::size_t DiagNnz() const {
-        if (!diag_nnz_) {
-            diag_nnz_ = ComputeDiagNnz();
-        }
-        return *diag_nnz_;
-    }
+    std::size_t M() const { return pattern_->M(); }
+    std::size_t N() const { return pattern_->N(); }
+    std::size_t StoredNnz() const { return pattern_->StoredNnz(); }
+    std::size_t DiagNnz() const { return pattern_->DiagNnz(); }
 
     std::size_t Nnz() const {
         if (symmetric_ == MatrixSymmetric::GENERAL) {
@@ -92,41 +143,107 @@ public:
         return 2 * StoredNnz() - DiagNnz();
     }
 
-    const std::vector<Value> &GetValues() const { return store_.values; }
-    const std::vector<DimIndex> &GetRowPtr() const { return store_.row_ptr; }
-    const std::vector<DimIndex> &GetColIndices() const { return store_.col_indices; }
-    const StoreType &GetStore() const { return store_; }
+    const Vector<Value> &GetValues() const { return values_; }
+    const Vector<NnzIndex> &GetRowPtr() const { return pattern_->GetRowPtr(); }
+    const Vector<DimIndex> &GetColIndices() const { return pattern_->GetColIndices(); }
+    const std::shared_ptr<const PatternType> &GetPattern() const { return pattern_; }
+    StoreRefType GetStore() const { return {N(), values_, GetRowPtr(), GetColIndices()}; }
+
+    // 模式不变，就地替换数值，长度须为StoredNnz()
+    void UpdateValues(const Value *values) {
+        static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+        std::copy(values, values + StoredNnz(), values_.begin());
+    }
+    void UpdateValues(Vector<Value> values) {
+        CheckValuesSize(values.size());
+        values_ = std::move(values);
+    }
 
 private:
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
-    static CsrStore<Value, DimIndex, NnzIndex>
-    ConvertStore(const CsrStore<OtherValue, OtherDimIndex, OtherNnzIndex> &rhs) {
-        return {
-            rhs.n, ConvertVector<Value>(rhs.values), ConvertVector<NnzIndex>(rhs.row_ptr),
-            ConvertVector<DimIndex>(rhs.col_indices)};
-    }
-
-    template <typename OtherValue, typename OtherDimIndex, typename OtherNnzIndex>
-    static CsrStore<Value, DimIndex, NnzIndex> ConvertStore(CsrStore<OtherValue, OtherDimIndex, OtherNnzIndex> &&rhs) {
-        return {
-            rhs.n, ConvertVector<Value>(std::move(rhs.values)), ConvertVector<NnzIndex>(std::move(rhs.row_ptr)),
-            ConvertVector<DimIndex>(std::move(rhs.col_indices))};
-    }
-
-    DimIndex ComputeDiagNnz() const {
-        DimIndex count{0};
-        for (std::size_t r{0}; r < M(); ++r) {
-            for (auto i{store_.row_ptr[r]}; i < store_.row_ptr[r + 1]; ++i) {
-                if (r == static_cast<std::size_t>(store_.col_indices[i])) {
-                    ++count;
-                }
-            }
+    // 进程内只分配一次
+    static const std::shared_ptr<const PatternType> &EmptyPattern() {
+        static const std::shared_ptr<const PatternType> empty{
+            std::make_shared<const PatternType>(0, Vector<NnzIndex>{}, Vector<DimIndex>{})};
+        return empty;
+    }
+
+    void CheckValuesSize(std::size_t size) const {
+        if (size != (std::is_same_v<Value, std::monostate> ? 0 : StoredNnz())) {
+            throw std::invalid_argument("csr values size mismatch");
         }
-        return count;
     }
 
-    StoreType store_;
+    // 模式类型相同时共享，否则转换索引类型后生成新模式
+    template <typename OtherPattern>
+    static std::shared_ptr<const PatternType> ConvertPattern(const std::shared_ptr<const OtherPattern> &rhs) {
+        if constexpr (std::is_same_v<OtherPattern, PatternType>) {
+            return rhs;
+        } else {
+            using PatternAllocator = typename PatternType::AllocatorType;
+            return std::make_shared<const PatternType>(
+                rhs->N(), ConvertVector<NnzIndex, RebindAlloc<PatternAllocator, NnzIndex>>(rhs->GetRowPtr()),
+                ConvertVector<DimIndex, RebindAlloc<PatternAllocator, DimIndex>>(rhs->GetColIndices()));
+        }
+    }
+
+    Vector<Value> values_;
+    std::shared_ptr<const PatternType> pattern_;
     MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
-    mutable std::optional<DimIndex> diag_nnz_;
 };
+
+template <typename TL>
+using ApplyToCsr = meta::ApplyT<Csr, TL>;
+using CsrVar = meta::ApplyT<std::variant, meta::TransformT<ApplyToCsr, meta::CartProdT<ValueTypeList, IndexTypeList>>>;
+
+#define OOPS_DEFINE_VISITOR(name)                                 \
+    auto name() const {                                           \
+        return Visit([](const auto &var) { return var.name(); }); \
+    }
+
+// 类型擦除的CSR，NnzIndex与DimIndex相同
+class AnyCsr {
+public:
+    template <typename Value, typename DimIndex>
+    AnyCsr(Csr<Value, DimIndex> csr) : csr_var_{std::move(csr)} {}
+
+    template <typename F>
+    auto Visit(F &&f) {
+        return std::visit(std::forward<F>(f), csr_var_);
+    }
+
+    template <typename F>
+    auto Visit(F &&f) const {
+        return std::visit(std::forward<F>(f), csr_var_);
+    }
+
+    OOPS_DEFINE_VISITOR(GetFormat);
+    OOPS_DEFINE_VISITOR(GetValueNumeric);
+    OOPS_DEFINE_VISITOR(GetDimIndexNumeric);
+    OOPS_DEFINE_VISITOR(GetSymmetric);
+    OOPS_DEFINE_VISITOR(M);
+    OOPS_DEFINE_VISITOR(N);
+    OOPS_DEFINE_VISITOR(StoredNnz);
+    OOPS_DEFINE_VISITOR(DiagNnz);
+    OOPS_DEFINE_VISITOR(Nnz);
+
+    template <typename Value, typename DimIndex>
+    const Csr<Value, DimIndex> &Get() const {
+        return std::get<Csr<Value, DimIndex>>(csr_var_);
+    }
+
+    template <typename Value, typename DimIndex>
+    Csr<Value, DimIndex> Convert() const {
+        return Visit([](const auto &var) { return Csr<Value, DimIndex>{var}; });
+    }
+
+    template <typename Value, typename DimIndex>
+    void ConvertInplace() {
+        csr_var_ = Convert<Value, DimIndex>();
+    }
+
+private:
+    CsrVar csr_var_;
+};
+
+#undef OOPS_DEFINE_VISITOR
 } // namespace oops
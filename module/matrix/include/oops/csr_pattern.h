@@ -0,0 +1,147 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "oops/matrix_type.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 模式哈希按固定大小分块并行计算，块数只依赖非零元数，结果与线程数无关
+constexpr std::size_t CSR_PATTERN_HASH_BLOCK{std::size_t{1} << 20};
+
+// 不可变的CSR稀疏结构(列数、行指针与列索引)，以std::shared_ptr在多个Csr间共享
+// 只依赖结构的派生数据(转置结构、符号分解等)通过Cached缓存于模式上，随最后一个持有者释放
+template <typename DimIndex, typename NnzIndex = DimIndex, typename Allocator = std::allocator<NnzIndex>>
+class CsrPattern {
+public:
+    static_assert(std::is_integral_v<DimIndex>);
+    static_assert(std::is_integral_v<NnzIndex>);
+
+    using DimIndexType = DimIndex;
+    using NnzIndexType = NnzIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = std::vector<T, RebindAlloc<Allocator, T>>;
+
+    // row_ptr长度为m + 1
+    CsrPattern(std::size_t n, Vector<NnzIndex> row_ptr, Vector<DimIndex> col_indices)
+        : n_{n}, row_ptr_{std::move(row_ptr)}, col_indices_{std::move(col_indices)} {
+        if (row_ptr_.empty()) {
+            row_ptr_.push_back(0);
+        }
+    }
+
+    CsrPattern(const CsrPattern &) = delete;
+    CsrPattern &operator=(const CsrPattern &) = delete;
+
+    std::size_t M() const { return row_ptr_.size() - 1; }
+    std::size_t N() const { return n_; }
+    std::size_t StoredNnz() const { return col_indices_.size(); }
+
+    const Vector<NnzIndex> &GetRowPtr() const { return row_ptr_; }
+    const Vector<DimIndex> &GetColIndices() const { return col_indices_; }
+
+    // 对角元素个数，首次调用时计算
+    std::size_t DiagNnz() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!diag_nnz_) {
+            std::size_t count{0};
+            for (std::size_t r{0}; r < M(); ++r) {
+                for (auto i{row_ptr_[r]}; i < row_ptr_[r + 1]; ++i) {
+                    if (r == static_cast<std::size_t>(col_indices_[i])) {
+                        ++count;
+                    }
+                }
+            }
+            diag_nnz_ = count;
+        }
+        return *diag_nnz_;
+    }
+
+    // 尺寸、行指针与列索引的FNV-1a哈希，首次调用时计算
+    std::uint64_t Hash() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!hash_) {
+            hash_ = ComputeHash();
+        }
+        return *hash_;
+    }
+
+    // 结构相同：尺寸、行指针与列索引逐元素相等
+    bool Same(const CsrPattern &rhs) const {
+        if (this == &rhs) {
+            return true;
+        }
+        return n_ == rhs.n_ && row_ptr_ == rhs.row_ptr_ && Hash() == rhs.Hash() && col_indices_ == rhs.col_indices_;
+    }
+
+    // 取键(T, key)对应的缓存，不存在时调用build()构造并缓存，build返回T
+    // build在锁外执行，并发首次访问时可能重复构造，仅保留先完成者
+    template <typename T, typename Build>
+    std::shared_ptr<const T> Cached(std::uint64_t key, Build &&build) const {
+        const CacheKey cache_key{std::type_index{typeid(T)}, key};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            auto it{cache_.find(cache_key)};
+            if (it != cache_.end()) {
+                return std::static_pointer_cast<const T>(it->second);
+            }
+        }
+        std::shared_ptr<const T> value{std::make_shared<const T>(build())};
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto [it, inserted]{cache_.emplace(cache_key, value)};
+        return std::static_pointer_cast<const T>(it->second);
+    }
+
+    // 已缓存的条目数
+    std::size_t CacheSize() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return cache_.size();
+    }
+
+private:
+    using CacheKey = std::pair<std::type_index, std::uint64_t>;
+
+    std::uint64_t ComputeHash() const {
+        constexpr std::uint64_t FNV_OFFSET{0xcbf29ce484222325ULL};
+        constexpr std::uint64_t FNV_PRIME{0x100000001b3ULL};
+        auto mix = [](std::uint64_t h, std::uint64_t v) { return (h ^ v) * FNV_PRIME; };
+        auto hash_range = [&](const auto *data, std::size_t size) {
+            const std::size_t num_blocks{std::max<std::size_t>(1, size / CSR_PATTERN_HASH_BLOCK)};
+            std::vector<std::uint64_t> block_hashes(num_blocks, FNV_OFFSET);
+            ParallelChunks(size, num_blocks, [&](std::size_t block, std::size_t begin, std::size_t end) {
+                std::uint64_t h{FNV_OFFSET};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    h = mix(h, static_cast<std::uint64_t>(data[i]));
+                }
+                block_hashes[block] = h;
+            });
+            std::uint64_t h{FNV_OFFSET};
+            for (auto block_hash : block_hashes) {
+                h = mix(h, block_hash);
+            }
+            return h;
+        };
+        std::uint64_t h{mix(mix(FNV_OFFSET, M()), n_)};
+        h = mix(h, hash_range(row_ptr_.data(), row_ptr_.size()));
+        return mix(h, hash_range(col_indices_.data(), col_indices_.size()));
+    }
+
+    std::size_t n_;
+    Vector<NnzIndex> row_ptr_;
+    Vector<DimIndex> col_indices_;
+
+    mutable std::mutex mutex_;
+    mutable std::optional<std::size_t> diag_nnz_;
+    mutable std::optional<std::uint64_t> hash_;
+    mutable std::map<CacheKey, std::shared_ptr<const void>> cache_;
+};
+} // namespace oops
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 数据存储类，第d条对角线偏移为offsets[d](列号减行号，升序)
+// values[d * m + r]为元素(r, r + offsets[d])，越界及不存在的位置填0
+// 第d条对角线上存在元素的行区间为segments[2s, 2s + 1)，s取[segment_ptr[d], segment_ptr[d + 1])，区间升序
+// segment_ptr为空时视为各对角线在列范围内全部存在
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<Value>>
+struct DiaStore {
+    static_assert(std::is_signed_v<DimIndex>, "diagonal offsets require a signed index");
+
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = std::vector<T, RebindAlloc<Allocator, T>>;
+
+    std::size_t m;
+    std::size_t n;
+    Vector<DimIndex> offsets;
+    Vector<Value> values;
+    Vector<std::size_t> segment_ptr;
+    Vector<DimIndex> segments;
+};
+
+struct DiaOptions {
+    double max_fill{3}; // 存储槽位数与非零元数之比的上限，超过时拒绝转换
+};
+
+// 对角线存储，适用于带状及结构化网格矩阵，SpMV按对角线连续访问values与x，可向量化
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<Value>>
+class Dia {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+
+public:
+    using StoreType = DiaStore<Value, DimIndex, Allocator>;
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = typename StoreType::template Vector<T>;
+
+    static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_DIA};
+
+    Dia() = default;
+    // "pass-by-value + move" idiom
+    Dia(StoreType store) : store_{std::move(store)} {}
+
+    static constexpr MatrixFormat GetFormat() { return FORMAT; }
+    static constexpr MatrixSymmetric GetSymmetric() { return MatrixSymmetric::GENERAL; }
+
+    std::size_t M() const { return store_.m; }
+    std::size_t N() const { return store_.n; }
+    std::size_t NumDiagonals() const { return store_.offsets.size(); }
+
+    const Vector<DimIndex> &GetOffsets() const { return store_.offsets; }
+    const Vector<Value> &GetValues() const { return store_.values; }
+    const Vector<std::size_t> &GetSegmentPtr() const { return store_.segment_ptr; }
+    const Vector<DimIndex> &GetSegments() const { return store_.segments; }
+    const StoreType &GetStore() const { return store_; }
+
+private:
+    StoreType store_;
+};
+
+// CSR转DIA，重复元素累加；对角线槽位数超过options.max_fill倍存储非零元时抛出std::invalid_argument
+template <typename Value, typename DimIndex, typename NnzIndex>
+Dia<Value, DimIndex> ToDia(const CsrView<Value, DimIndex, NnzIndex> &a, DiaOptions options = {}) {
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        throw std::invalid_argument("dia requires general storage");
+    }
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    const std::size_t m{a.M()};
+    const std::size_t n{a.N()};
+
+    // diag_of[offset + m - 1]为偏移对应的对角线编号
+    constexpr DimIndex NONE{-1};
+    std::vector<DimIndex> diag_of(m + n, NONE);
+    for (std::size_t r{0}; r < m; ++r) {
+        for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+            diag_of[col_indices[i] + m - 1 - r] = 0;
+        }
+    }
+    typename Dia<Value, DimIndex>::StoreType store;
+    store.m = m;
+    store.n = n;
+    for (std::size_t k{0}; k + 1 < m + n; ++k) {
+        if (diag_of[k] != NONE) {
+            diag_of[k] = static_cast<DimIndex>(store.offsets.size());
+            const std::ptrdiff_t offset{static_cast<std::ptrdiff_t>(k + 1) - static_cast<std::ptrdiff_t>(m)};
+            store.offsets.push_back(static_cast<DimIndex>(offset));
+        }
+    }
+    const double slots{static_cast<double>(store.offsets.size() * m)};
+    if (slots > options.max_fill * static_cast<double>(std::max<std::size_t>(a.StoredNnz(), 1))) {
+        throw std::invalid_argument("dia fill ratio exceeds limit");
+    }
+
+    const std::size_t num_diags{store.offsets.size()};
+    store.values.assign(num_diags * m, Value{});
+    std::vector<char> present(num_diags * m, 0);
+    ParallelFor(0, m, SPMV_ROW_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                const std::size_t d{static_cast<std::size_t>(diag_of[col_indices[i] + m - 1 - r])};
+                store.values[d * m + r] += values[i];
+                present[d * m + r] = 1;
+            }
+        }
+    });
+    // 各对角线上连续存在元素的行区间
+    std::vector<std::vector<DimIndex>> segments(num_diags);
+    ParallelFor(0, num_diags, 1, [&](std::size_t diag_begin, std::size_t diag_end) {
+        for (std::size_t d{diag_begin}; d < diag_end; ++d) {
+            const char *mask{present.data() + d * m};
+            for (std::size_t r{0}; r < m;) {
+                if (!mask[r]) {
+                    ++r;
+                    continue;
+                }
+                const std::size_t begin{r};
+                while (r < m && mask[r]) {
+                    ++r;
+                }
+                segments[d].push_back(static_cast<DimIndex>(begin));
+                segments[d].push_back(static_cast<DimIndex>(r));
+            }
+        }
+    });
+    store.segment_ptr.assign(num_diags + 1, 0);
+    for (std::size_t d{0}; d < num_diags; ++d) {
+        store.segment_ptr[d + 1] = store.segment_ptr[d] + segments[d].size() / 2;
+        store.segments.insert(store.segments.end(), segments[d].begin(), segments[d].end());
+    }
+    return {std::move(store)};
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+Dia<Value, DimIndex> ToDia(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, DiaOptions options = {}) {
+    return ToDia(CsrView<Value, DimIndex, NnzIndex>{a}, options);
+}
+
+// y = A * x，行分块并行，块内逐对角线累加，内层循环为连续访存
+// 只遍历对角线上存在元素的行区间，不计算填充槽位；无重复元素时与CSR SpMV结果逐位一致，x含Inf或NaN时亦然
+template <typename Value, typename DimIndex, typename Allocator>
+void SpMV(const Dia<Value, DimIndex, Allocator> &a, const Value *x, Value *y) {
+    const std::size_t m{a.M()};
+    const std::ptrdiff_t n{static_cast<std::ptrdiff_t>(a.N())};
+    const DimIndex *offsets{a.GetOffsets().data()};
+    const Value *values{a.GetValues().data()};
+    const std::size_t num_diags{a.NumDiagonals()};
+    const bool has_segments{!a.GetSegmentPtr().empty()};
+    const std::size_t *segment_ptr{a.GetSegmentPtr().data()};
+    const DimIndex *segments{a.GetSegments().data()};
+    ParallelFor(0, m, SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+        std::fill(y + row_begin, y + row_end, Value{});
+        for (std::size_t d{0}; d < num_diags; ++d) {
+            // 列号r + offset落在[0, n)内的行
+            const std::ptrdiff_t offset{offsets[d]};
+            const std::ptrdiff_t begin{std::max<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(row_begin), -offset)};
+            const std::ptrdiff_t end{std::min<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(row_end), n - offset)};
+            const Value *diag{values + d * m};
+            auto accumulate = [=](std::ptrdiff_t first, std::ptrdiff_t last) {
+                for (std::ptrdiff_t r{first}; r < last; ++r) {
+                    y[r] += diag[r] * x[r + offset];
+                }
+            };
+            if (!has_segments) {
+                accumulate(begin, end);
+                continue;
+            }
+            // 二分查找首个结束行大于begin的区间
+            std::size_t s{segment_ptr[d]};
+            for (std::size_t last{segment_ptr[d + 1]}; s < last;) {
+                const std::size_t mid{s + (last - s) / 2};
+                if (segments[2 * mid + 1] <= begin) {
+                    s = mid + 1;
+                } else {
+                    last = mid;
+                }
+            }
+            for (; s < segment_ptr[d + 1] && segments[2 * s] < end; ++s) {
+                accumulate(std::max<std::ptrdiff_t>(begin, segments[2 * s]),
+                           std::min<std::ptrdiff_t>(end, segments[2 * s + 1]));
+            }
+        }
+    });
+}
+
+template <typename Value, typename DimIndex, typename Allocator>
+void SpMV(const Dia<Value, DimIndex, Allocator> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+} // namespace oops
@@ -0,0 +1,238 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "oops/convert.h"
+#include "oops/csr.h"
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+namespace detail {
+// 按字节哈希与比较，-0.0与0.0、不同NaN视为不同值，压缩前后逐位一致
+template <typename Value>
+struct BytewiseHash {
+    std::size_t operator()(const Value &v) const {
+        unsigned char bytes[sizeof(Value)];
+        std::memcpy(bytes, &v, sizeof(Value));
+        std::uint64_t h{0xcbf29ce484222325ULL};
+        for (auto b : bytes) {
+            h = (h ^ b) * 0x100000001b3ULL;
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
+template <typename Value>
+struct BytewiseEqual {
+    bool operator()(const Value &lhs, const Value &rhs) const {
+        return std::memcmp(&lhs, &rhs, sizeof(Value)) == 0;
+    }
+};
+} // namespace detail
+
+struct DictCsrOptions {
+    std::size_t max_table{std::size_t{1} << 16}; // 值表容量上限，不超过65536
+};
+
+// 值字典压缩的CSR：不同取值存于值表，每个非零元只存8位或16位编码
+// 值表不超过256项时使用8位编码，否则使用16位编码，两组编码仅一组非空
+// 适用于图拉普拉斯、邻接矩阵、差分格式等取值种类很少的矩阵，SpMV从值表收集数值以减少访存量
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+class DictCsr {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+
+public:
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using NnzIndexType = NnzIndex;
+
+    static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_CSR};
+
+    DictCsr() = default;
+    DictCsr(
+        std::size_t n, std::vector<NnzIndex> row_ptr, std::vector<DimIndex> col_indices, std::vector<Value> table,
+        std::vector<std::uint8_t> codes8, std::vector<std::uint16_t> codes16,
+        MatrixSymmetric symmetric = MatrixSymmetric::GENERAL)
+        : n_{n}, row_ptr_{std::move(row_ptr)}, col_indices_{std::move(col_indices)}, table_{std::move(table)},
+          codes8_{std::move(codes8)}, codes16_{std::move(codes16)}, symmetric_{symmetric} {}
+
+    static constexpr MatrixFormat GetFormat() { return FORMAT; }
+    MatrixSymmetric GetSymmetric() const { return symmetric_; }
+
+    std::size_t M() const { return row_ptr_.size() - 1; }
+    std::size_t N() const { return n_; }
+    std::size_t StoredNnz() const { return col_indices_.size(); }
+    // 每个编码的字节数
+    std::size_t CodeBytes() const { return table_.size() <= 256 ? 1 : 2; }
+
+    const std::vector<NnzIndex> &GetRowPtr() const { return row_ptr_; }
+    const std::vector<DimIndex> &GetColIndices() const { return col_indices_; }
+    const std::vector<Value> &GetTable() const { return table_; }
+    const std::vector<std::uint8_t> &GetCodes8() const { return codes8_; }
+    const std::vector<std::uint16_t> &GetCodes16() const { return codes16_; }
+
+private:
+    std::size_t n_{0};
+    std::vector<NnzIndex> row_ptr_;
+    std::vector<DimIndex> col_indices_;
+    std::vector<Value> table_;
+    std::vector<std::uint8_t> codes8_;
+    std::vector<std::uint16_t> codes16_;
+    MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
+};
+
+// 检测取值种类并压缩，种类超过options.max_table时返回std::nullopt
+// 值表按首次出现的顺序排列，编码并行生成
+template <typename Value, typename DimIndex, typename NnzIndex>
+std::optional<DictCsr<Value, DimIndex, NnzIndex>>
+ToDictCsr(const CsrView<Value, DimIndex, NnzIndex> &a, DictCsrOptions options = {}) {
+    if (options.max_table > (std::size_t{1} << 16)) {
+        throw std::invalid_argument("dict csr table exceeds 16-bit codes");
+    }
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const std::size_t m{a.M()};
+    const std::size_t begin{static_cast<std::size_t>(row_ptr[0])};
+    const std::size_t stored_nnz{a.StoredNnz()};
+
+    std::unordered_map<Value, std::uint16_t, detail::BytewiseHash<Value>, detail::BytewiseEqual<Value>> codes;
+    std::vector<Value> table;
+    for (std::size_t i{begin}; i < begin + stored_nnz; ++i) {
+        if (codes.find(values[i]) == codes.end()) {
+            if (table.size() == options.max_table) {
+                return std::nullopt;
+            }
+            codes.emplace(values[i], static_cast<std::uint16_t>(table.size()));
+            table.push_back(values[i]);
+        }
+    }
+
+    std::vector<NnzIndex> out_row_ptr(m + 1);
+    for (std::size_t r{0}; r <= m; ++r) {
+        out_row_ptr[r] = row_ptr[r] - row_ptr[0];
+    }
+    std::vector<DimIndex> col_indices(a.GetColIndices() + begin, a.GetColIndices() + begin + stored_nnz);
+    std::vector<std::uint8_t> codes8;
+    std::vector<std::uint16_t> codes16;
+    auto encode = [&](auto &out) {
+        using Code = typename std::decay_t<decltype(out)>::value_type;
+        out.resize(stored_nnz);
+        ParallelFor(0, stored_nnz, SPMV_ROW_GRAIN, [&](std::size_t i_begin, std::size_t i_end) {
+            for (std::size_t i{i_begin}; i < i_end; ++i) {
+                out[i] = static_cast<Code>(codes.find(values[begin + i])->second);
+            }
+        });
+    };
+    if (table.size() <= 256) {
+        encode(codes8);
+    } else {
+        encode(codes16);
+    }
+    return DictCsr<Value, DimIndex, NnzIndex>{
+        a.N(),
+        std::move(out_row_ptr),
+        std::move(col_indices),
+        std::move(table),
+        std::move(codes8),
+        std::move(codes16),
+        a.GetSymmetric()};
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+std::optional<DictCsr<Value, DimIndex, NnzIndex>>
+ToDictCsr(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, DictCsrOptions options = {}) {
+    return ToDictCsr(CsrView<Value, DimIndex, NnzIndex>{a}, options);
+}
+
+// 先转换为CSR，行内列索引升序
+template <typename NnzIndex = void, typename Value, typename DimIndex, typename Allocator>
+auto ToDictCsr(const Coo<Value, DimIndex, Allocator> &a, DictCsrOptions options = {}) {
+    return ToDictCsr(ToCsr<NnzIndex>(a), options);
+}
+
+// 解压为CSR
+template <typename Value, typename DimIndex, typename NnzIndex>
+Csr<Value, DimIndex, NnzIndex> ToCsr(const DictCsr<Value, DimIndex, NnzIndex> &a) {
+    CsrStore<Value, DimIndex, NnzIndex> store{a.N(), {}, a.GetRowPtr(), a.GetColIndices()};
+    store.values.resize(a.StoredNnz());
+    const Value *table{a.GetTable().data()};
+    auto decode = [&](const auto &codes) {
+        ParallelFor(0, codes.size(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                store.values[i] = table[codes[i]];
+            }
+        });
+    };
+    if (a.CodeBytes() == 1) {
+        decode(a.GetCodes8());
+    } else {
+        decode(a.GetCodes16());
+    }
+    return {std::move(store), a.GetSymmetric()};
+}
+
+namespace detail {
+template <typename Value, typename DimIndex, typename NnzIndex, typename Code>
+void DictSpMV(const DictCsr<Value, DimIndex, NnzIndex> &a, const Code *codes, const Value *x, Value *y) {
+    const Value *table{a.GetTable().data()};
+    const NnzIndex *row_ptr{a.GetRowPtr().data()};
+    const DimIndex *col_indices{a.GetColIndices().data()};
+    const std::size_t m{a.M()};
+
+    if (a.GetSymmetric() == MatrixSymmetric::GENERAL) {
+        ParallelFor(0, m, SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                Value sum{};
+                for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                    sum += table[codes[i]] * x[col_indices[i]];
+                }
+                y[r] = sum;
+            }
+        });
+        return;
+    }
+
+    // 镜像部分为散射写，串行计算
+    MatrixSymmetric symmetric{a.GetSymmetric()};
+    std::fill(y, y + m, Value{});
+    for (std::size_t r{0}; r < m; ++r) {
+        Value sum{};
+        for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+            std::size_t c{static_cast<std::size_t>(col_indices[i])};
+            const Value v{table[codes[i]]};
+            sum += v * x[c];
+            if (c != r) {
+                y[c] += MirrorValue(symmetric, v) * x[r];
+            }
+        }
+        y[r] += sum;
+    }
+}
+} // namespace detail
+
+// y = A * x，结果与未压缩矩阵的SpMV逐位一致
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const DictCsr<Value, DimIndex, NnzIndex> &a, const Value *x, Value *y) {
+    if (a.CodeBytes() == 1) {
+        detail::DictSpMV(a, a.GetCodes8().data(), x, y);
+    } else {
+        detail::DictSpMV(a, a.GetCodes16().data(), x, y);
+    }
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const DictCsr<Value, DimIndex, NnzIndex> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+} // namespace oops
@@ -0,0 +1,494 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 合并后的增量，同一位置只保留最后一次操作
+template <typename Value, typename DimIndex>
+struct CsrDelta {
+    DimIndex row_index;
+    DimIndex col_index;
+    Value value;
+    bool erase;
+};
+
+// 动态CSR在某一时刻的只读快照：基矩阵与按行排列的增量，查询时逐行归并
+// 快照构造后不再变化，可被多线程同时查询，与后续的插入、删除及合并互不影响
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+class DynamicCsrSnapshot {
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+    using DeltaType = CsrDelta<Value, DimIndex>;
+
+    // deltas须按行、列升序排列且位置不重复；删除基矩阵中不存在元素的增量无效果，构造时丢弃
+    DynamicCsrSnapshot(std::shared_ptr<const CsrType> base, std::vector<DeltaType> deltas)
+        : base_{std::move(base)}, deltas_{std::move(deltas)}, delta_ptr_(base_->M() + 1, 0) {
+        deltas_.erase(std::remove_if(deltas_.begin(), deltas_.end(),
+                                     [this](const DeltaType &delta) {
+                                         return delta.erase && BaseFind(delta.row_index, delta.col_index) == nullptr;
+                                     }),
+                      deltas_.end());
+        for (const auto &delta : deltas_) {
+            ++delta_ptr_[delta.row_index + 1];
+        }
+        for (std::size_t r{0}; r < M(); ++r) {
+            delta_ptr_[r + 1] += delta_ptr_[r];
+        }
+        stored_nnz_ = base_->StoredNnz();
+        for (const auto &delta : deltas_) {
+            const bool exists{BaseFind(delta.row_index, delta.col_index) != nullptr};
+            if (!exists) {
+                ++stored_nnz_;
+                ++structural_;
+            } else if (delta.erase) {
+                --stored_nnz_;
+                ++structural_;
+            }
+        }
+    }
+
+    std::size_t M() const { return base_->M(); }
+    std::size_t N() const { return base_->N(); }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+    std::size_t StoredNnz() const { return stored_nnz_; }
+    // 尚未合并至基矩阵的增量数
+    std::size_t PendingDeltas() const { return deltas_.size(); }
+    const std::shared_ptr<const CsrType> &GetBase() const { return base_; }
+    const std::vector<DeltaType> &GetDeltas() const { return deltas_; }
+
+    bool Contains(std::size_t row, std::size_t col) const {
+        CheckIndex(row, col);
+        if (const DeltaType *delta{DeltaFind(row, col)}) {
+            return !delta->erase;
+        }
+        return BaseFind(row, col) != nullptr;
+    }
+
+    // 不存在的元素返回Value{}
+    Value Get(std::size_t row, std::size_t col) const {
+        CheckIndex(row, col);
+        if (const DeltaType *delta{DeltaFind(row, col)}) {
+            return delta->erase ? Value{} : delta->value;
+        }
+        if constexpr (!std::is_same_v<Value, std::monostate>) {
+            if (const DimIndex *found{BaseFind(row, col)}) {
+                return base_->GetValues()[found - base_->GetColIndices().data()];
+            }
+        }
+        return Value{};
+    }
+
+    // 按列升序对第row行的每个元素调用f(col, value)
+    template <typename F>
+    void ForEachInRow(std::size_t row, F &&f) const {
+        const auto &row_ptr{base_->GetRowPtr()};
+        const DimIndex *cols{base_->GetColIndices().data()};
+        std::size_t i{static_cast<std::size_t>(row_ptr[row])};
+        const std::size_t i_end{static_cast<std::size_t>(row_ptr[row + 1])};
+        std::size_t d{delta_ptr_[row]};
+        const std::size_t d_end{delta_ptr_[row + 1]};
+        while (i < i_end || d < d_end) {
+            if (d == d_end || (i < i_end && cols[i] < deltas_[d].col_index)) {
+                f(cols[i], BaseValue(i));
+                ++i;
+                continue;
+            }
+            const DeltaType &delta{deltas_[d++]};
+            if (i < i_end && cols[i] == delta.col_index) {
+                ++i;
+            }
+            if (!delta.erase) {
+                f(delta.col_index, delta.value);
+            }
+        }
+    }
+
+    // 归并为行内列升序的规范CSR，增量只改变数值时与基矩阵共享模式
+    CsrType ToCsr() const {
+        if (deltas_.empty()) {
+            return *base_;
+        }
+        if (structural_ == 0) {
+            typename CsrType::template Vector<Value> values;
+            if constexpr (!std::is_same_v<Value, std::monostate>) {
+                values = base_->GetValues();
+                const DimIndex *cols{base_->GetColIndices().data()};
+                for (const auto &delta : deltas_) {
+                    values[BaseFind(delta.row_index, delta.col_index) - cols] = delta.value;
+                }
+            }
+            return {base_->GetPattern(), std::move(values)};
+        }
+        if (stored_nnz_ > static_cast<std::size_t>(std::numeric_limits<NnzIndex>::max())) {
+            throw std::overflow_error("stored nnz exceeds nnz index range");
+        }
+        typename CsrType::StoreType store;
+        store.n = N();
+        store.row_ptr.assign(M() + 1, 0);
+        ParallelFor(0, M(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                NnzIndex count{0};
+                ForEachInRow(r, [&count](DimIndex, const Value &) { ++count; });
+                store.row_ptr[r + 1] = count;
+            }
+        });
+        for (std::size_t r{0}; r < M(); ++r) {
+            store.row_ptr[r + 1] += store.row_ptr[r];
+        }
+        store.col_indices.resize(stored_nnz_);
+        if constexpr (!std::is_same_v<Value, std::monostate>) {
+            store.values.resize(stored_nnz_);
+        }
+        ParallelFor(0, M(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                auto pos{static_cast<std::size_t>(store.row_ptr[r])};
+                ForEachInRow(r, [&](DimIndex col, const Value &value) {
+                    store.col_indices[pos] = col;
+                    if constexpr (!std::is_same_v<Value, std::monostate>) {
+                        store.values[pos] = value;
+                    }
+                    ++pos;
+                });
+            }
+        });
+        return {std::move(store)};
+    }
+
+private:
+    void CheckIndex(std::size_t row, std::size_t col) const {
+        if (row >= M() || col >= N()) {
+            std::ostringstream oss;
+            oss << "dynamic csr index (" << row << ", " << col << ") out of range";
+            throw std::out_of_range(oss.str());
+        }
+    }
+
+    Value BaseValue([[maybe_unused]] std::size_t i) const {
+        if constexpr (std::is_same_v<Value, std::monostate>) {
+            return {};
+        } else {
+            return base_->GetValues()[i];
+        }
+    }
+
+    const DimIndex *BaseFind(std::size_t row, std::size_t col) const {
+        const DimIndex *cols{base_->GetColIndices().data()};
+        const DimIndex *first{cols + base_->GetRowPtr()[row]};
+        const DimIndex *last{cols + base_->GetRowPtr()[row + 1]};
+        const DimIndex *it{std::lower_bound(first, last, static_cast<DimIndex>(col))};
+        return it != last && static_cast<std::size_t>(*it) == col ? it : nullptr;
+    }
+
+    const DeltaType *DeltaFind(std::size_t row, std::size_t col) const {
+        const DeltaType *first{deltas_.data() + delta_ptr_[row]};
+        const DeltaType *last{deltas_.data() + delta_ptr_[row + 1]};
+        const DeltaType *it{std::lower_bound(first, last, col, [](const DeltaType &delta, std::size_t c) {
+            return static_cast<std::size_t>(delta.col_index) < c;
+        })};
+        return it != last && static_cast<std::size_t>(it->col_index) == col ? it : nullptr;
+    }
+
+    std::shared_ptr<const CsrType> base_;
+    std::vector<DeltaType> deltas_;
+    std::vector<std::size_t> delta_ptr_;
+    std::size_t stored_nnz_{0};
+    std::size_t structural_{0}; // 新增或删除元素的增量数
+};
+
+// y = A * x，逐行归并基矩阵与增量，求和顺序与快照ToCsr后的SpMV一致
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const DynamicCsrSnapshot<Value, DimIndex, NnzIndex> &a, const Value *x, Value *y) {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+    if (a.PendingDeltas() == 0) {
+        SpMV(*a.GetBase(), x, y);
+        return;
+    }
+    ParallelFor(0, a.M(), SPMV_ROW_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            Value sum{};
+            a.ForEachInRow(r, [&](DimIndex col, const Value &value) { sum += value * x[col]; });
+            y[r] = sum;
+        }
+    });
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const DynamicCsrSnapshot<Value, DimIndex, NnzIndex> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+
+struct DynamicCsrOptions {
+    double merge_ratio{0.1};            // 待合并日志数超过基矩阵存储元素数的该比例时触发合并
+    std::size_t min_merge_logs{1 << 12}; // 待合并日志数不足该值时不触发合并
+    bool background_merge{true};        // 在线程池中异步合并，否则在触发合并的Snapshot调用中同步合并
+};
+
+// 支持并发插入与删除的动态CSR：不可变的基矩阵加各线程私有的插入、删除日志
+// 1. Insert/Erase追加至调用线程的日志，线程首次调用时登记日志，之后只获取本线程日志的锁
+// 2. Snapshot同时锁定全部日志取得一致的切分，按全局序号保留每个位置的最后一次操作，与基矩阵组成快照
+// 3. 日志积累到阈值时由Snapshot触发合并，合并在锁外生成新的基矩阵，提交时原子地替换基矩阵并截去已合并的日志
+// 基矩阵须为行内列严格升序的一般存储CSR；快照与基矩阵的内容只取决于操作的先后顺序，与线程数及合并时机无关
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+class DynamicCsr {
+    static_assert(std::is_integral_v<DimIndex>);
+
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+    using SnapshotType = DynamicCsrSnapshot<Value, DimIndex, NnzIndex>;
+
+    DynamicCsr(std::size_t m, std::size_t n, DynamicCsrOptions options = {})
+        : DynamicCsr{CsrType{typename CsrType::StoreType{n, {}, std::vector<NnzIndex>(m + 1, 0), {}}}, options} {}
+
+    explicit DynamicCsr(CsrType base, DynamicCsrOptions options = {})
+        : m_{base.M()}, n_{base.N()}, options_{options}, id_{NextId()},
+          base_{std::make_shared<const CsrType>(std::move(base))} {
+        if (base_->GetSymmetric() != MatrixSymmetric::GENERAL) {
+            throw std::invalid_argument("dynamic csr requires general storage");
+        }
+        const auto &row_ptr{base_->GetRowPtr()};
+        const auto &cols{base_->GetColIndices()};
+        for (std::size_t r{0}; r < base_->M(); ++r) {
+            for (auto i{row_ptr[r] + 1}; i < row_ptr[r + 1]; ++i) {
+                if (cols[i - 1] >= cols[i]) {
+                    throw std::invalid_argument("dynamic csr requires sorted unique columns");
+                }
+            }
+        }
+    }
+
+    ~DynamicCsr() {
+        if (merge_future_.valid()) {
+            merge_future_.wait();
+        }
+    }
+
+    DynamicCsr(const DynamicCsr &) = delete;
+    DynamicCsr &operator=(const DynamicCsr &) = delete;
+
+    std::size_t M() const { return m_; }
+    std::size_t N() const { return n_; }
+
+    // 插入或覆盖(row, col)处的元素
+    void Insert(DimIndex row, DimIndex col, const Value &value = {}) { Append(row, col, value, false); }
+    // 删除(row, col)处的元素，元素不存在时无效果
+    void Erase(DimIndex row, DimIndex col) { Append(row, col, Value{}, true); }
+
+    // 尚未合并至基矩阵的日志数，同一位置的多次操作分别计数
+    std::size_t PendingLogs() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        std::size_t count{0};
+        for (const auto &log : logs_) {
+            std::lock_guard<std::mutex> log_lock{log->mutex};
+            count += log->entries.size();
+        }
+        return count;
+    }
+
+    std::shared_ptr<const CsrType> GetBase() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return base_;
+    }
+
+    // 当前时刻的一致快照，此前完成的操作全部可见；无新操作时返回缓存的快照
+    std::shared_ptr<const SnapshotType> Snapshot() {
+        Cut cut{Capture()};
+        const double base_nnz{static_cast<double>(cut.snapshot->GetBase()->StoredNnz())};
+        const std::size_t threshold{
+            std::max(options_.min_merge_logs, static_cast<std::size_t>(options_.merge_ratio * base_nnz))};
+        if (cut.logs < threshold) {
+            return cut.snapshot;
+        }
+        if (!options_.background_merge) {
+            Commit(cut);
+            return Capture().snapshot;
+        }
+        std::lock_guard<std::mutex> lock{merge_mutex_};
+        if (!merge_future_.valid() || merge_future_.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+            if (merge_future_.valid()) {
+                merge_future_.get();
+            }
+            merge_future_ = ThreadPool::Get().Submit([this] { Commit(Capture()); });
+        }
+        return cut.snapshot;
+    }
+
+    // 等待进行中的后台合并，再将当前全部日志同步合并至基矩阵
+    void Merge() {
+        {
+            std::lock_guard<std::mutex> lock{merge_mutex_};
+            if (merge_future_.valid()) {
+                merge_future_.get();
+            }
+        }
+        Commit(Capture());
+    }
+
+private:
+    struct LogEntry {
+        std::uint64_t seq;
+        CsrDelta<Value, DimIndex> delta;
+    };
+
+    struct Log {
+        std::mutex mutex;
+        std::vector<LogEntry> entries;
+    };
+
+    // 快照及其对应的各日志前缀长度
+    struct Cut {
+        std::shared_ptr<const SnapshotType> snapshot;
+        std::vector<std::size_t> counts;
+        std::size_t logs{0};
+    };
+
+    static std::uint64_t NextId() {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Append(DimIndex row, DimIndex col, const Value &value, bool erase) {
+        // 负索引转换后超出范围
+        if (static_cast<std::size_t>(row) >= M() || static_cast<std::size_t>(col) >= N()) {
+            std::ostringstream oss;
+            oss << "dynamic csr index (" << row << ", " << col << ") out of range";
+            throw std::out_of_range(oss.str());
+        }
+        Log &log{Local()};
+        std::lock_guard<std::mutex> lock{log.mutex};
+        // 序号在日志锁内分配，持有全部日志锁时小于next_seq_的操作均已写入日志
+        log.entries.push_back({next_seq_.fetch_add(1, std::memory_order_relaxed), {row, col, value, erase}});
+    }
+
+    // 调用线程的私有日志，线程局部缓存最近使用的实例，未命中时加锁登记
+    Log &Local() {
+        struct Cache {
+            std::uint64_t id{0};
+            Log *log{nullptr};
+        };
+        thread_local Cache cache;
+        if (cache.id == id_) {
+            return *cache.log;
+        }
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto &log{index_[std::this_thread::get_id()]};
+        if (log == nullptr) {
+            logs_.push_back(std::make_unique<Log>());
+            log = logs_.back().get();
+        }
+        cache = {id_, log};
+        return *log;
+    }
+
+    // 锁定全部日志复制各自的前缀，锁外按位置与序号排序，每个位置保留序号最大的操作
+    Cut Capture() {
+        Cut cut;
+        std::vector<LogEntry> entries;
+        std::shared_ptr<const CsrType> base;
+        std::uint64_t version{0};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            std::vector<std::unique_lock<std::mutex>> log_locks;
+            for (const auto &log : logs_) {
+                log_locks.emplace_back(log->mutex);
+            }
+            version = next_seq_.load(std::memory_order_relaxed);
+            for (const auto &log : logs_) {
+                cut.counts.push_back(log->entries.size());
+                cut.logs += log->entries.size();
+            }
+            if (cache_ != nullptr && cache_version_ == version) {
+                cut.snapshot = cache_;
+                return cut;
+            }
+            entries.reserve(cut.logs);
+            for (const auto &log : logs_) {
+                entries.insert(entries.end(), log->entries.begin(), log->entries.end());
+            }
+            base = base_;
+        }
+        std::sort(entries.begin(), entries.end(), [](const LogEntry &lhs, const LogEntry &rhs) {
+            if (lhs.delta.row_index != rhs.delta.row_index) {
+                return lhs.delta.row_index < rhs.delta.row_index;
+            }
+            if (lhs.delta.col_index != rhs.delta.col_index) {
+                return lhs.delta.col_index < rhs.delta.col_index;
+            }
+            return lhs.seq < rhs.seq;
+        });
+        std::vector<CsrDelta<Value, DimIndex>> deltas;
+        for (std::size_t i{0}; i < entries.size(); ++i) {
+            if (i + 1 == entries.size() || entries[i + 1].delta.row_index != entries[i].delta.row_index ||
+                entries[i + 1].delta.col_index != entries[i].delta.col_index) {
+                deltas.push_back(entries[i].delta);
+            }
+        }
+        cut.snapshot = std::make_shared<const SnapshotType>(std::move(base), std::move(deltas));
+        std::lock_guard<std::mutex> lock{mutex_};
+        // 期间有新的操作或发生合并时快照已不是最新，不写入缓存
+        if (version == next_seq_.load(std::memory_order_relaxed) && base_ == cut.snapshot->GetBase()) {
+            cache_ = cut.snapshot;
+            cache_version_ = version;
+        }
+        return cut;
+    }
+
+    // 锁外生成新的基矩阵，再原子地替换基矩阵并截去切分内的日志；切分须基于当前基矩阵
+    void Commit(const Cut &cut) {
+        std::lock_guard<std::mutex> commit_lock{commit_mutex_};
+        if (cut.logs == 0) {
+            return;
+        }
+        auto base{std::make_shared<const CsrType>(cut.snapshot->ToCsr())};
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (base_ != cut.snapshot->GetBase()) {
+            return;
+        }
+        std::vector<std::unique_lock<std::mutex>> log_locks;
+        for (const auto &log : logs_) {
+            log_locks.emplace_back(log->mutex);
+        }
+        for (std::size_t i{0}; i < cut.counts.size(); ++i) {
+            auto &entries{logs_[i]->entries};
+            entries.erase(entries.begin(), entries.begin() + cut.counts[i]);
+        }
+        base_ = std::move(base);
+        cache_ = nullptr;
+    }
+
+    std::size_t m_;
+    std::size_t n_;
+    DynamicCsrOptions options_;
+    std::uint64_t id_;
+    std::atomic<std::uint64_t> next_seq_{0};
+
+    mutable std::mutex mutex_; // 保护日志登记、基矩阵与快照缓存，先于各日志锁获取
+    std::unordered_map<std::thread::id, Log *> index_;
+    std::vector<std::unique_ptr<Log>> logs_;
+    std::shared_ptr<const CsrType> base_;
+    std::shared_ptr<const SnapshotType> cache_;
+    std::uint64_t cache_version_{0};
+
+    std::mutex commit_mutex_; // 串行化合并
+    std::mutex merge_mutex_;  // 保护merge_future_
+    std::future<void> merge_future_;
+};
+} // namespace oops
@@ -0,0 +1,211 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// ELL部分行数的对齐粒度，每个ELL列切片首地址与SIMD宽度对齐
+constexpr std::size_t HYB_ROW_ALIGN{16};
+
+// 数据存储类：ELL部分按列主序存放，ell_*[k * ell_ld + r]为第r行第k个元素
+// 不足ell_width的行以值0、列号为行内末元素列号(空行为0)填充，ell_row_lengths为各行在ELL部分的元素数
+// ell_row_lengths为空时视为全部槽位有效；超出ell_width的元素按行有序存于COO部分
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<Value>>
+struct HybStore {
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = std::vector<T, RebindAlloc<Allocator, T>>;
+
+    std::size_t m;
+    std::size_t n;
+    std::size_t ell_width;
+    std::size_t ell_ld; // m按HYB_ROW_ALIGN向上取整
+    Vector<DimIndex> ell_col_indices;
+    Vector<Value> ell_values;
+    Vector<DimIndex> ell_row_lengths;
+    Vector<DimIndex> coo_row_indices;
+    Vector<DimIndex> coo_col_indices;
+    Vector<Value> coo_values;
+};
+
+struct HybOptions {
+    std::size_t ell_width{0};       // ELL宽度，0时自动选择
+    double ell_row_fraction{1. / 3}; // 自动选择时取最大宽度k，使不少于该比例的行长度达到k
+    double max_fill{3};              // ELL槽位数与ELL中非零元数之比的上限，超过时拒绝转换
+};
+
+// ELL与COO混合存储：规则部分按列切片连续访存并可向量化，少数长行溢出到COO
+template <typename Value, typename DimIndex, typename Allocator = std::allocator<Value>>
+class Hyb {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+
+public:
+    using StoreType = HybStore<Value, DimIndex, Allocator>;
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using AllocatorType = Allocator;
+    template <typename T>
+    using Vector = typename StoreType::template Vector<T>;
+
+    static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_HYB};
+
+    Hyb() = default;
+    // "pass-by-value + move" idiom
+    Hyb(StoreType store) : store_{std::move(store)} {}
+
+    static constexpr MatrixFormat GetFormat() { return FORMAT; }
+    static constexpr MatrixSymmetric GetSymmetric() { return MatrixSymmetric::GENERAL; }
+
+    std::size_t M() const { return store_.m; }
+    std::size_t N() const { return store_.n; }
+    std::size_t EllWidth() const { return store_.ell_width; }
+    std::size_t CooNnz() const { return store_.coo_values.size(); }
+
+    const StoreType &GetStore() const { return store_; }
+
+private:
+    StoreType store_;
+};
+
+// CSR转HYB，重复元素分别存储
+// ELL槽位数超过options.max_fill倍ELL中非零元数时抛出std::invalid_argument
+template <typename Value, typename DimIndex, typename NnzIndex>
+Hyb<Value, DimIndex> ToHyb(const CsrView<Value, DimIndex, NnzIndex> &a, HybOptions options = {}) {
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        throw std::invalid_argument("hyb requires general storage");
+    }
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    const std::size_t m{a.M()};
+    auto row_len = [row_ptr](std::size_t r) { return static_cast<std::size_t>(row_ptr[r + 1] - row_ptr[r]); };
+
+    std::size_t width{options.ell_width};
+    if (width == 0) {
+        // rows_at_least[k]为长度不小于k的行数
+        std::size_t max_len{0};
+        for (std::size_t r{0}; r < m; ++r) {
+            max_len = std::max(max_len, row_len(r));
+        }
+        std::vector<std::size_t> rows_at_least(max_len + 2, 0);
+        for (std::size_t r{0}; r < m; ++r) {
+            ++rows_at_least[row_len(r)];
+        }
+        for (std::size_t k{max_len}; k-- > 0;) {
+            rows_at_least[k] += rows_at_least[k + 1];
+        }
+        const double min_rows{std::max(options.ell_row_fraction * static_cast<double>(m), 1.)};
+        while (width < max_len && static_cast<double>(rows_at_least[width + 1]) >= min_rows) {
+            ++width;
+        }
+    }
+
+    typename Hyb<Value, DimIndex>::StoreType store;
+    store.m = m;
+    store.n = a.N();
+    store.ell_width = width;
+    store.ell_ld = (m + HYB_ROW_ALIGN - 1) / HYB_ROW_ALIGN * HYB_ROW_ALIGN;
+    std::size_t ell_nnz{0};
+    std::vector<NnzIndex> coo_ptr(m + 1, 0);
+    for (std::size_t r{0}; r < m; ++r) {
+        ell_nnz += std::min(row_len(r), width);
+        coo_ptr[r + 1] = coo_ptr[r] + static_cast<NnzIndex>(row_len(r) - std::min(row_len(r), width));
+    }
+    const double slots{static_cast<double>(width * m)};
+    if (slots > options.max_fill * static_cast<double>(std::max<std::size_t>(ell_nnz, 1))) {
+        throw std::invalid_argument("hyb fill ratio exceeds limit");
+    }
+
+    store.ell_col_indices.assign(width * store.ell_ld, 0);
+    store.ell_values.assign(width * store.ell_ld, Value{});
+    store.ell_row_lengths.resize(m);
+    store.coo_row_indices.resize(coo_ptr[m]);
+    store.coo_col_indices.resize(coo_ptr[m]);
+    store.coo_values.resize(coo_ptr[m]);
+    ParallelFor(0, m, SPMV_ROW_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            const std::size_t len{row_len(r)};
+            const std::size_t ell_len{std::min(len, width)};
+            store.ell_row_lengths[r] = static_cast<DimIndex>(ell_len);
+            for (std::size_t k{0}; k < ell_len; ++k) {
+                store.ell_col_indices[k * store.ell_ld + r] = col_indices[row_ptr[r] + k];
+                store.ell_values[k * store.ell_ld + r] = values[row_ptr[r] + k];
+            }
+            const DimIndex pad{ell_len == 0 ? DimIndex{0} : col_indices[row_ptr[r] + ell_len - 1]};
+            for (std::size_t k{ell_len}; k < width; ++k) {
+                store.ell_col_indices[k * store.ell_ld + r] = pad;
+            }
+            for (std::size_t k{ell_len}; k < len; ++k) {
+                const auto p{coo_ptr[r] + (k - ell_len)};
+                store.coo_row_indices[p] = static_cast<DimIndex>(r);
+                store.coo_col_indices[p] = col_indices[row_ptr[r] + k];
+                store.coo_values[p] = values[row_ptr[r] + k];
+            }
+        }
+    });
+    return {std::move(store)};
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+Hyb<Value, DimIndex> ToHyb(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, HybOptions options = {}) {
+    return ToHyb(CsrView<Value, DimIndex, NnzIndex>{a}, options);
+}
+
+// y = A * x，行分块并行；ELL部分逐列切片累加，COO部分按行有序，块内以二分定位
+// 每行先累加ELL再累加COO，与CSR行内顺序一致，结果与线程数无关
+// 填充槽位的乘积按行长度以选择丢弃(不引入分支)，x含Inf或NaN时仍与CSR SpMV结果逐位一致
+template <typename Value, typename DimIndex, typename Allocator>
+void SpMV(const Hyb<Value, DimIndex, Allocator> &a, const Value *x, Value *y) {
+    const auto &store{a.GetStore()};
+    const std::size_t width{store.ell_width};
+    const std::size_t ld{store.ell_ld};
+    const DimIndex *ell_col_indices{store.ell_col_indices.data()};
+    const Value *ell_values{store.ell_values.data()};
+    const DimIndex *ell_row_lengths{store.ell_row_lengths.empty() ? nullptr : store.ell_row_lengths.data()};
+    const DimIndex *coo_row_indices{store.coo_row_indices.data()};
+    const DimIndex *coo_col_indices{store.coo_col_indices.data()};
+    const Value *coo_values{store.coo_values.data()};
+    const std::size_t coo_nnz{store.coo_values.size()};
+    ParallelFor(0, a.M(), SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+        std::fill(y + row_begin, y + row_end, Value{});
+        for (std::size_t k{0}; k < width; ++k) {
+            const DimIndex *cols{ell_col_indices + k * ld};
+            const Value *vals{ell_values + k * ld};
+            if (ell_row_lengths == nullptr) {
+                for (std::size_t r{row_begin}; r < row_end; ++r) {
+                    y[r] += vals[r] * x[cols[r]];
+                }
+                continue;
+            }
+            // 行和从+0开始累加，不会为-0，加+0不改变结果
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                const Value product{vals[r] * x[cols[r]]};
+                y[r] += k < static_cast<std::size_t>(ell_row_lengths[r]) ? product : Value{};
+            }
+        }
+        auto first{std::lower_bound(coo_row_indices, coo_row_indices + coo_nnz, static_cast<DimIndex>(row_begin))};
+        for (std::size_t i{static_cast<std::size_t>(first - coo_row_indices)}; i < coo_nnz; ++i) {
+            const std::size_t r{static_cast<std::size_t>(coo_row_indices[i])};
+            if (r >= row_end) {
+                break;
+            }
+            y[r] += coo_values[i] * x[coo_col_indices[i]];
+        }
+    });
+}
+
+template <typename Value, typename DimIndex, typename Allocator>
+void SpMV(const Hyb<Value, DimIndex, Allocator> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+} // namespace oops
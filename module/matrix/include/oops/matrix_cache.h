@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "oops/coo.h"
+#include "oops/csr.h"
+
+namespace oops {
+struct MatrixCacheOptions {
+    std::filesystem::path dir;                        // 缓存目录，为空时取环境变量OOPS_MATRIX_CACHE_DIR，仍为空则不缓存
+    std::size_t size_limit{std::size_t{4} << 30};     // 缓存文件总字节数上限，超出时淘汰最久未使用的条目
+    std::size_t sample_block{std::size_t{64} << 10}; // 指纹采样块的字节数
+    std::size_t sample_count{16};                     // 指纹采样块数，均匀分布且含首尾
+};
+
+// 源文件的内容指纹：文件大小、修改时间与均匀采样块的FNV-1a哈希
+struct MatrixFingerprint {
+    std::uint64_t size;
+    std::int64_t mtime_ns;
+    std::uint64_t sample_hash;
+
+    // 缓存文件名使用的十六进制串
+    std::string Key() const;
+    bool operator==(const MatrixFingerprint &rhs) const {
+        return size == rhs.size && mtime_ns == rhs.mtime_ns && sample_hash == rhs.sample_hash;
+    }
+};
+
+MatrixFingerprint ComputeMatrixFingerprint(const std::filesystem::path &path, const MatrixCacheOptions &options = {});
+
+// 以指纹为键的本地磁盘缓存，条目为COO或CSR的二进制形式
+// 写入先落临时文件再原子改名，多进程共享同一目录时读者只会看到完整条目
+// 命中时刷新条目的修改时间，写入后按修改时间淘汰至size_limit以内
+// 损坏或格式不符的条目视为未命中并删除，缓存目录的读写失败不影响调用方
+class MatrixCache {
+public:
+    explicit MatrixCache(MatrixCacheOptions options = {});
+
+    bool Enabled() const { return !options_.dir.empty(); }
+    const MatrixCacheOptions &GetOptions() const { return options_; }
+
+    std::optional<AnyCoo> LoadCoo(const MatrixFingerprint &fingerprint) const;
+    std::optional<AnyCsr> LoadCsr(const MatrixFingerprint &fingerprint) const;
+    void StoreCoo(const MatrixFingerprint &fingerprint, const AnyCoo &coo) const;
+    void StoreCsr(const MatrixFingerprint &fingerprint, const AnyCsr &csr) const;
+
+    // 缓存目录中条目的总字节数
+    std::size_t TotalBytes() const;
+    // 淘汰最久未使用的条目直至总字节数不超过size_limit
+    void Evict() const;
+
+private:
+    std::filesystem::path EntryPath(const MatrixFingerprint &fingerprint, const char *suffix) const;
+
+    MatrixCacheOptions options_;
+    mutable std::mutex mutex_; // 串行化本进程内的淘汰
+};
+} // namespace oops
@@ -0,0 +1,31 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "oops/coo.h"
+#include "oops/matrix_cache.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+struct CollectionLoadOptions {
+    std::size_t max_files_in_flight{0};                  // 解析中与待交付的文件数上限，0表示线程池并行度的2倍
+    std::size_t max_bytes_in_flight{std::size_t{1} << 30}; // 解析中与待交付的源文件字节数上限，单个超限文件独占
+    std::size_t large_file_bytes{std::size_t{32} << 20};   // 不小于该值的文件在调用线程上分块并行解析
+    MatrixCacheOptions cache;                             // 逐文件读取时的缓存选项
+};
+
+// dir_or_pattern为目录时列出其中扩展名为.mtx的常规文件，否则按glob模式匹配(支持**递归)，结果按路径排序
+std::vector<std::filesystem::path> ListMatrixCollection(const std::string &dir_or_pattern);
+
+using CollectionCallback = FunctionRef<void(std::size_t index, const std::filesystem::path &path, AnyCoo coo)>;
+
+// 并发读取一组Matrix Market文件，按输入顺序在调用线程上逐个交付callback(index, path, coo)
+// 小文件提交到线程池，每个文件由一个线程整体解析；大文件先交付此前的全部文件，再由调用线程借助整个线程池分块解析
+// 解析中与待交付的文件数和字节数受限，超出时先交付最早的文件，内存占用与集合大小无关
+// 读取失败时等待已提交的文件结束后抛出std::runtime_error，消息含文件路径
+void LoadMatrixCollection(
+    const std::vector<std::filesystem::path> &paths, CollectionCallback callback, CollectionLoadOptions options = {});
+void LoadMatrixCollection(
+    const std::string &dir_or_pattern, CollectionCallback callback, CollectionLoadOptions options = {});
+} // namespace oops
@@ -0,0 +1,448 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/convert.h"
+#include "oops/coo.h"
+#include "oops/csr.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 生成时每个并行块的行数或边数
+constexpr std::size_t GENERATOR_GRAIN{4096};
+
+namespace detail {
+inline std::uint64_t SplitMix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline std::uint64_t HashKey(std::uint64_t seed, std::uint64_t a, std::uint64_t b = 0, std::uint64_t c = 0) {
+    return SplitMix64(SplitMix64(SplitMix64(SplitMix64(seed) ^ a) ^ b) ^ c);
+}
+
+// 以(seed, stream)为键的计数器随机数流，各行或各边独立，结果与并行划分无关
+class CounterRng {
+public:
+    CounterRng(std::uint64_t seed, std::uint64_t stream) : key_{HashKey(seed, stream)} {}
+
+    std::uint64_t Next() { return SplitMix64(key_ + 0x9e3779b97f4a7c15ULL * counter_++); }
+    // [0, 1)
+    double NextDouble() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+
+private:
+    std::uint64_t key_;
+    std::uint64_t counter_{0};
+};
+
+// 由键确定的随机数值：浮点取[-1, 1)，复数实部虚部各自取[-1, 1)，整数取[-9, 9]
+// 数值与稀疏结构使用不同的随机源，同一生成器对各数值类型得到相同的结构
+template <typename Value>
+Value RandomValue(std::uint64_t key) {
+    if constexpr (std::is_same_v<Value, std::monostate>) {
+        return {};
+    } else if constexpr (std::is_integral_v<Value>) {
+        return static_cast<Value>(static_cast<std::int64_t>(SplitMix64(key) % 19) - 9);
+    } else {
+        CounterRng rng{key, 0};
+        if constexpr (IS_COMPLEX<Value>) {
+            using Real = typename Value::value_type;
+            const double real{2 * rng.NextDouble() - 1};
+            return {static_cast<Real>(real), static_cast<Real>(2 * rng.NextDouble() - 1)};
+        } else {
+            return static_cast<Value>(2 * rng.NextDouble() - 1);
+        }
+    }
+}
+
+template <typename Value>
+Value MakeValue(double v) {
+    if constexpr (std::is_same_v<Value, std::monostate>) {
+        return {};
+    } else if constexpr (IS_COMPLEX<Value>) {
+        return Value{static_cast<typename Value::value_type>(v)};
+    } else {
+        return static_cast<Value>(v);
+    }
+}
+
+// 使count个RandomValue之和严格对角占优的对角元
+template <typename Value>
+Value DominantDiag(std::size_t count) {
+    const double bound{std::is_integral_v<Value> ? 9. : IS_COMPLEX<Value> ? 2. : 1.};
+    return MakeValue<Value>(bound * static_cast<double>(count) + 1);
+}
+
+template <typename DimIndex>
+void CheckGeneratorDims(std::size_t m, std::size_t n) {
+    if (m > static_cast<std::size_t>(std::numeric_limits<DimIndex>::max()) ||
+        n > static_cast<std::size_t>(std::numeric_limits<DimIndex>::max())) {
+        throw std::overflow_error("dimension exceeds dim index range");
+    }
+}
+
+// 按行生成器的第一遍：并行统计各行元素数，返回长度m + 1的偏移
+template <typename Value, typename Generator>
+std::vector<std::size_t> GeneratorRowOffsets(const Generator &gen) {
+    const std::size_t m{gen.M()};
+    std::vector<std::size_t> offsets(m + 1, 0);
+    ParallelFor(0, m, GENERATOR_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            std::size_t count{0};
+            gen.template Row<Value>(r, [&count](std::size_t, const Value &) { ++count; });
+            offsets[r + 1] = count;
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    return offsets;
+}
+} // namespace detail
+
+// 生成器接口：M()、N()、GetSymmetric()，以及
+// 1. ROW_WISE为true时，Row<Value>(r, emit)对行r按列升序调用emit(col, value)，同一行的多次调用产生相同序列
+// 2. ROW_WISE为false时，StoredNnz()给出元素数，Entry<Value>(i, row, col)写出第i个元素的行列号并返回其值
+// 随机生成器按(seed, 行号或元素号)派生独立的随机数流，结果只依赖参数与seed，与线程数无关
+
+// 按生成器并行构造COO，按行生成器的元素按行、行内按列升序排列
+template <typename Value, typename DimIndex, typename Generator>
+Coo<Value, DimIndex> GenerateCoo(const Generator &gen) {
+    detail::CheckGeneratorDims<DimIndex>(gen.M(), gen.N());
+    CooStore<Value, DimIndex> store;
+    store.m = gen.M();
+    store.n = gen.N();
+    auto resize = [&store](std::size_t stored_nnz) {
+        store.row_indices.resize(stored_nnz);
+        store.col_indices.resize(stored_nnz);
+        if constexpr (!std::is_same_v<Value, std::monostate>) {
+            store.values.resize(stored_nnz);
+        }
+    };
+    if constexpr (Generator::ROW_WISE) {
+        const std::vector<std::size_t> offsets{detail::GeneratorRowOffsets<Value>(gen)};
+        resize(offsets.back());
+        ParallelFor(0, gen.M(), GENERATOR_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                std::size_t i{offsets[r]};
+                gen.template Row<Value>(r, [&](std::size_t c, const Value &v) {
+                    store.row_indices[i] = static_cast<DimIndex>(r);
+                    store.col_indices[i] = static_cast<DimIndex>(c);
+                    if constexpr (!std::is_same_v<Value, std::monostate>) {
+                        store.values[i] = v;
+                    }
+                    ++i;
+                });
+            }
+        });
+    } else {
+        resize(gen.StoredNnz());
+        ParallelFor(0, gen.StoredNnz(), GENERATOR_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                std::size_t row, col;
+                Value v{gen.template Entry<Value>(i, row, col)};
+                store.row_indices[i] = static_cast<DimIndex>(row);
+                store.col_indices[i] = static_cast<DimIndex>(col);
+                if constexpr (!std::is_same_v<Value, std::monostate>) {
+                    store.values[i] = v;
+                }
+            }
+        });
+    }
+    return {std::move(store), gen.GetSymmetric()};
+}
+
+// 按生成器并行构造CSR：按行生成器两遍生成(先统计各行元素数，前缀和后再写入)，按元素生成器经COO转换
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex, typename Generator>
+Csr<Value, DimIndex, NnzIndex> GenerateCsr(const Generator &gen) {
+    detail::CheckGeneratorDims<DimIndex>(gen.M(), gen.N());
+    if constexpr (!Generator::ROW_WISE) {
+        return ToCsr<NnzIndex>(GenerateCoo<Value, DimIndex>(gen));
+    } else {
+        const std::vector<std::size_t> offsets{detail::GeneratorRowOffsets<Value>(gen)};
+        if (offsets.back() > static_cast<std::size_t>(std::numeric_limits<NnzIndex>::max())) {
+            throw std::overflow_error("stored nnz exceeds nnz index range");
+        }
+        CsrStore<Value, DimIndex, NnzIndex> store;
+        store.n = gen.N();
+        store.row_ptr.resize(offsets.size());
+        store.col_indices.resize(offsets.back());
+        if constexpr (!std::is_same_v<Value, std::monostate>) {
+            store.values.resize(offsets.back());
+        }
+        ParallelFor(0, gen.M(), GENERATOR_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                store.row_ptr[r] = static_cast<NnzIndex>(offsets[r]);
+                std::size_t i{offsets[r]};
+                gen.template Row<Value>(r, [&](std::size_t c, const Value &v) {
+                    store.col_indices[i] = static_cast<DimIndex>(c);
+                    if constexpr (!std::is_same_v<Value, std::monostate>) {
+                        store.values[i] = v;
+                    }
+                    ++i;
+                });
+            }
+        });
+        store.row_ptr.back() = static_cast<NnzIndex>(offsets.back());
+        return {std::move(store), gen.GetSymmetric()};
+    }
+}
+
+// nx * ny网格上的5点差分矩阵，节点(i, j)的行号为i * ny + j，对角元4，相邻节点-1
+class Laplacian2DGenerator {
+public:
+    static constexpr bool ROW_WISE{true};
+
+    Laplacian2DGenerator(std::size_t nx, std::size_t ny) : nx_{nx}, ny_{ny} {}
+
+    std::size_t M() const { return nx_ * ny_; }
+    std::size_t N() const { return M(); }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+
+    template <typename Value, typename Emit>
+    void Row(std::size_t r, Emit &&emit) const {
+        const std::size_t i{r / ny_}, j{r % ny_};
+        const Value off{detail::MakeValue<Value>(-1)};
+        if (i > 0) {
+            emit(r - ny_, off);
+        }
+        if (j > 0) {
+            emit(r - 1, off);
+        }
+        emit(r, detail::MakeValue<Value>(4));
+        if (j + 1 < ny_) {
+            emit(r + 1, off);
+        }
+        if (i + 1 < nx_) {
+            emit(r + ny_, off);
+        }
+    }
+
+private:
+    std::size_t nx_;
+    std::size_t ny_;
+};
+
+// nx * ny * nz网格上的7点差分矩阵，节点(i, j, k)的行号为(i * ny + j) * nz + k，对角元6，相邻节点-1
+class Laplacian3DGenerator {
+public:
+    static constexpr bool ROW_WISE{true};
+
+    Laplacian3DGenerator(std::size_t nx, std::size_t ny, std::size_t nz) : nx_{nx}, ny_{ny}, nz_{nz} {}
+
+    std::size_t M() const { return nx_ * ny_ * nz_; }
+    std::size_t N() const { return M(); }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+
+    template <typename Value, typename Emit>
+    void Row(std::size_t r, Emit &&emit) const {
+        const std::size_t k{r % nz_}, j{r / nz_ % ny_}, i{r / nz_ / ny_};
+        const std::size_t plane{ny_ * nz_};
+        const Value off{detail::MakeValue<Value>(-1)};
+        if (i > 0) {
+            emit(r - plane, off);
+        }
+        if (j > 0) {
+            emit(r - nz_, off);
+        }
+        if (k > 0) {
+            emit(r - 1, off);
+        }
+        emit(r, detail::MakeValue<Value>(6));
+        if (k + 1 < nz_) {
+            emit(r + 1, off);
+        }
+        if (j + 1 < ny_) {
+            emit(r + nz_, off);
+        }
+        if (i + 1 < nx_) {
+            emit(r + plane, off);
+        }
+    }
+
+private:
+    std::size_t nx_;
+    std::size_t ny_;
+    std::size_t nz_;
+};
+
+// n阶带状矩阵，下带宽lower、上带宽upper，带内元素随机，对角元使矩阵严格对角占优
+class BandedGenerator {
+public:
+    static constexpr bool ROW_WISE{true};
+
+    BandedGenerator(std::size_t n, std::size_t lower, std::size_t upper, std::uint64_t seed)
+        : n_{n}, lower_{lower}, upper_{upper}, seed_{seed} {}
+
+    std::size_t M() const { return n_; }
+    std::size_t N() const { return n_; }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+
+    template <typename Value, typename Emit>
+    void Row(std::size_t r, Emit &&emit) const {
+        const std::size_t begin{r > lower_ ? r - lower_ : 0};
+        const std::size_t end{std::min(n_, r + upper_ + 1)};
+        for (std::size_t c{begin}; c < end; ++c) {
+            emit(c, c == r ? detail::DominantDiag<Value>(lower_ + upper_)
+                           : detail::RandomValue<Value>(detail::HashKey(seed_, r, c)));
+        }
+    }
+
+private:
+    std::size_t n_;
+    std::size_t lower_;
+    std::size_t upper_;
+    std::uint64_t seed_;
+};
+
+// Erdős–Rényi随机矩阵G(m, n, p)，p = nnz_per_row / n，各元素独立以概率p出现
+// 每行以几何分布的间隔跳跃生成列号，代价与元素数成正比
+class ErdosRenyiGenerator {
+public:
+    static constexpr bool ROW_WISE{true};
+
+    ErdosRenyiGenerator(std::size_t m, std::size_t n, double nnz_per_row, std::uint64_t seed)
+        : m_{m}, n_{n}, p_{n == 0 ? 0 : std::min(nnz_per_row / static_cast<double>(n), 1.)}, seed_{seed} {
+        if (!(nnz_per_row >= 0)) {
+            throw std::invalid_argument("negative nnz per row");
+        }
+    }
+
+    std::size_t M() const { return m_; }
+    std::size_t N() const { return n_; }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+
+    template <typename Value, typename Emit>
+    void Row(std::size_t r, Emit &&emit) const {
+        if (p_ <= 0) {
+            return;
+        }
+        detail::CounterRng rng{seed_, r};
+        const double log_q{std::log1p(-p_)};
+        double c{-1};
+        while (true) {
+            // 下一个元素与上一个之间的间隔服从几何分布，p = 1时log_q为负无穷，间隔恒为1
+            const double gap{p_ >= 1 ? 0. : std::floor(std::log1p(-rng.NextDouble()) / log_q)};
+            c += 1 + gap;
+            if (c >= static_cast<double>(n_)) {
+                break;
+            }
+            const auto col{static_cast<std::size_t>(c)};
+            emit(col, detail::RandomValue<Value>(detail::HashKey(seed_, r, col)));
+        }
+    }
+
+private:
+    std::size_t m_;
+    std::size_t n_;
+    double p_;
+    std::uint64_t seed_;
+};
+
+// R-MAT(递归Kronecker)幂律图的邻接矩阵，2^scale个顶点，edge_factor * 2^scale条有向边
+// 每条边逐层以概率a、b、c、1 - a - b - c落入左上、右上、左下、右下象限，默认取Graph500参数
+// 保留重复边与自环，转换为CSR时重复元素按ToCsr的规则保留
+class RmatGenerator {
+public:
+    static constexpr bool ROW_WISE{false};
+
+    RmatGenerator(
+        std::size_t scale, std::size_t edge_factor, std::uint64_t seed, double a = 0.57, double b = 0.19,
+        double c = 0.19)
+        : scale_{scale}, edge_factor_{edge_factor}, seed_{seed}, a_{a}, b_{b}, c_{c} {
+        if (scale >= 63) {
+            throw std::invalid_argument("rmat scale too large");
+        }
+        if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+            throw std::invalid_argument("invalid rmat probabilities");
+        }
+    }
+
+    std::size_t M() const { return std::size_t{1} << scale_; }
+    std::size_t N() const { return M(); }
+    std::size_t StoredNnz() const { return edge_factor_ << scale_; }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+
+    template <typename Value>
+    Value Entry(std::size_t i, std::size_t &row, std::size_t &col) const {
+        detail::CounterRng rng{seed_, i};
+        row = 0;
+        col = 0;
+        for (std::size_t level{0}; level < scale_; ++level) {
+            const double u{rng.NextDouble()};
+            const std::size_t down{u >= a_ + b_}, right{(u >= a_ && u < a_ + b_) || u >= a_ + b_ + c_};
+            row = 2 * row + down;
+            col = 2 * col + right;
+        }
+        return detail::RandomValue<Value>(detail::HashKey(seed_, i, ~std::uint64_t{0}));
+    }
+
+private:
+    std::size_t scale_;
+    std::size_t edge_factor_;
+    std::uint64_t seed_;
+    double a_;
+    double b_;
+    double c_;
+};
+
+// 有限元式组装的块对角矩阵：num_blocks个block_size阶稠密单元块沿对角线排列，相邻块重叠overlap行列
+// overlap为0时为块对角矩阵，为1时相当于一维线性单元链；单元块对称，组装结果对称且对角占优
+class BlockDiagonalGenerator {
+public:
+    static constexpr bool ROW_WISE{true};
+
+    BlockDiagonalGenerator(std::size_t num_blocks, std::size_t block_size, std::size_t overlap, std::uint64_t seed)
+        : num_blocks_{num_blocks}, block_size_{block_size}, overlap_{overlap}, seed_{seed} {
+        if (block_size == 0 || overlap >= block_size) {
+            throw std::invalid_argument("block overlap must be less than block size");
+        }
+    }
+
+    std::size_t M() const { return num_blocks_ == 0 ? 0 : Stride() * (num_blocks_ - 1) + block_size_; }
+    std::size_t N() const { return M(); }
+    MatrixSymmetric GetSymmetric() const { return MatrixSymmetric::GENERAL; }
+
+    template <typename Value, typename Emit>
+    void Row(std::size_t r, Emit &&emit) const {
+        // 包含行r的块为[k_begin, k_end)，各块列区间的并集连续
+        const std::size_t stride{Stride()};
+        const std::size_t k_begin{r < block_size_ ? 0 : (r - block_size_) / stride + 1};
+        const std::size_t k_end{std::min(r / stride + 1, num_blocks_)};
+        const std::size_t col_end{(k_end - 1) * stride + block_size_};
+        for (std::size_t c{k_begin * stride}; c < col_end; ++c) {
+            Value v{};
+            if constexpr (!std::is_same_v<Value, std::monostate>) {
+                for (std::size_t k{k_begin}; k < k_end; ++k) {
+                    const std::size_t first{k * stride};
+                    if (c >= first && c < first + block_size_) {
+                        v += ElementValue<Value>(k, r - first, c - first);
+                    }
+                }
+            }
+            emit(c, v);
+        }
+    }
+
+private:
+    std::size_t Stride() const { return block_size_ - overlap_; }
+
+    // 第k个单元块的(i, j)元素，关于i、j对称
+    template <typename Value>
+    Value ElementValue(std::size_t k, std::size_t i, std::size_t j) const {
+        if (i == j) {
+            return detail::DominantDiag<Value>(block_size_ - 1);
+        }
+        return detail::RandomValue<Value>(detail::HashKey(seed_, k, std::min(i, j), std::max(i, j)));
+    }
+
+    std::size_t num_blocks_;
+    std::size_t block_size_;
+    std::size_t overlap_;
+    std::uint64_t seed_;
+};
+} // namespace oops
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "oops/csr.h"
+#include "oops/matrix_market_io.h"
+
+namespace oops {
+struct ExternalCsrOptions {
+    std::size_t memory_budget{std::size_t{256} << 20}; // 排序与归并缓冲区的总字节数上限
+    std::filesystem::path temp_dir;                   // 有序段所在目录，为空时使用系统临时目录
+};
+
+// 外存CSR文件描述，三个文件均为本机字节序的原始数组，模式矩阵没有values文件
+// 行指针为int64_t，列索引在m与n不超过int32_t范围时为int32_t，否则为int64_t
+struct ExternalCsr {
+    ValueTypeVar value_var;
+    IndexTypeVar dim_index_var;
+    MatrixSymmetric symmetric;
+    std::size_t m;
+    std::size_t n;
+    std::size_t stored_nnz;
+    std::size_t num_runs;     // 溢出的有序段数
+    std::size_t merge_passes; // 归并趟数，含最终写出CSR的一趟
+    std::filesystem::path row_ptr_path;
+    std::filesystem::path col_indices_path;
+    std::filesystem::path values_path;
+};
+
+// 流式读取Matrix Market并以外部排序转换为CSR，写出prefix.row_ptr、prefix.col_indices与prefix.values
+// 行内按列索引升序，重复元素保持文件中的相对顺序，结果与ToCsr(ReadMatrixMarket(is))一致
+// 读入与排序双缓冲：一段在线程池中排序并写出临时文件时，调用线程读取下一段
+// 段数超过单趟归并路数时先多趟归并，临时文件在返回或抛出异常时删除
+ExternalCsr
+ConvertMatrixMarketToCsr(std::istream &is, const std::filesystem::path &prefix, ExternalCsrOptions options = {});
+
+namespace detail {
+template <typename T>
+void ReadRawArray(const std::filesystem::path &path, T *data, std::size_t count) {
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(count * sizeof(T)))) {
+        throw std::runtime_error("failed to read " + path.string());
+    }
+}
+} // namespace detail
+
+// 将外存CSR读入内存，类型与文件不一致时抛出std::invalid_argument
+template <typename Value, typename DimIndex>
+Csr<Value, DimIndex, int64_t> ReadExternalCsr(const ExternalCsr &external) {
+    if (!std::holds_alternative<meta::Identity<Value>>(external.value_var) ||
+        !std::holds_alternative<meta::Identity<DimIndex>>(external.dim_index_var)) {
+        throw std::invalid_argument("external csr type mismatch");
+    }
+    CsrStore<Value, DimIndex, int64_t> store;
+    store.n = external.n;
+    store.row_ptr.resize(external.m + 1);
+    store.col_indices.resize(external.stored_nnz);
+    detail::ReadRawArray(external.row_ptr_path, store.row_ptr.data(), store.row_ptr.size());
+    detail::ReadRawArray(external.col_indices_path, store.col_indices.data(), store.col_indices.size());
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        store.values.resize(external.stored_nnz);
+        detail::ReadRawArray(external.values_path, store.values.data(), store.values.size());
+    }
+    return {std::move(store), external.symmetric};
+}
+} // namespace oops
@@ -1,8 +1,31 @@
 #pragma once
+#include <filesystem>
+#include <string_view>
+
 #include "oops/coo.h"
+#include "oops/matrix_cache.h"
 
 using namespace oops::meta;
 namespace oops {
+// Matrix Market头部，symmetric为对称时文件存储下三角
+struct MatrixMarketHeader {
+    ValueTypeVar value_var;
+    MatrixSymmetric symmetric;
+    std::size_t m;
+    std::size_t n;
+    std::size_t stored_nnz;
+};
+
+// 读取头部与尺寸行，流停在首个元素之前
+MatrixMarketHeader ReadMatrixMarketHeader(std::istream &is);
+// 只读取前stored_nnz个元素，其后的内容忽略
 AnyCoo ReadMatrixMarket(std::istream &is);
+// 解析整体读入内存的文本，要求每行一个元素：按行分块并行解析后顺序拼接，结果与ReadMatrixMarket一致
+// 前stored_nnz个元素之后的行同样忽略，即使无法解析
+AnyCoo ParseMatrixMarket(std::string_view text);
+// 按路径整体读入后以ParseMatrixMarket解析，启用缓存时先查找以源文件指纹为键的COO条目，未命中时解析并写入
+AnyCoo ReadMatrixMarket(const std::filesystem::path &path, const MatrixCacheOptions &options = {});
+// 按路径读取并转换为CSR，依次查找CSR与COO条目，转换结果写入缓存
+AnyCsr ReadMatrixMarketCsr(const std::filesystem::path &path, const MatrixCacheOptions &options = {});
 void WriteMatrixMarket(std::ostream &os, const AnyCoo &coo);
 } // namespace oops
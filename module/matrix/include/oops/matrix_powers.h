@@ -0,0 +1,200 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+struct MatrixPowersOptions {
+    std::size_t block_rows{0};        // 每块所属行数，0时按cache_bytes估计
+    std::size_t cache_bytes{1 << 18}; // 单块局部矩阵与向量的目标占用
+};
+
+// 矩阵幂核：计算V = [x, A * x, A^2 * x, ..., A^s * x]
+// 行按连续区间分块，Setup时为每块求出s步依赖的幽灵区并抽取局部子矩阵
+// Apply时各块独立完成全部s步，矩阵只流过一次；幽灵行在相邻块中重复计算
+// 局部行按进入依赖区的层次排列，第k步所需行恰为前缀，行内求和顺序与SpMV一致，结果与逐次SpMV相同
+// Apply的工作向量在Setup时分配，同一实例不可被多线程并发调用
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+class MatrixPowers {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+
+    explicit MatrixPowers(MatrixPowersOptions options = {}) : options_{options} {}
+    MatrixPowers(const CsrType &a, std::size_t steps, MatrixPowersOptions options = {}) : options_{options} {
+        Setup(a, steps);
+    }
+
+    void Setup(const CsrType &a, std::size_t steps) {
+        if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+            throw std::invalid_argument("matrix powers requires general storage");
+        }
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("matrix powers requires a square matrix");
+        }
+        const auto &store{a.GetStore()};
+        const std::size_t n{a.M()};
+        n_ = n;
+        steps_ = steps;
+
+        std::size_t block_rows{options_.block_rows};
+        if (block_rows == 0) {
+            const std::size_t nnz_bytes{a.StoredNnz() * (sizeof(Value) + sizeof(DimIndex))};
+            const std::size_t row_bytes{nnz_bytes / std::max<std::size_t>(n, 1) + (steps + 1) * sizeof(Value)};
+            block_rows = std::max<std::size_t>(options_.cache_bytes / std::max<std::size_t>(row_bytes, 1), 1);
+        }
+        const std::size_t num_blocks{(n + block_rows - 1) / block_rows};
+        blocks_.assign(num_blocks, {});
+        for (std::size_t b{0}; b < num_blocks; ++b) {
+            blocks_[b].row_begin = b * block_rows;
+            blocks_[b].row_end = std::min(n, (b + 1) * block_rows);
+        }
+
+        constexpr std::size_t NONE{std::numeric_limits<std::size_t>::max()};
+        const std::size_t num_chunks{ThreadPool::Get().Size()};
+        ParallelChunks(num_blocks, num_chunks, [&](std::size_t, std::size_t block_begin, std::size_t block_end) {
+            std::vector<std::size_t> local(n, NONE);
+            for (std::size_t b{block_begin}; b < block_end; ++b) {
+                auto &block{blocks_[b]};
+                // levels[k]为第k步需计算的行数(k = 0时为需读取x的行数)，逐层向外扩展
+                block.rows.clear();
+                block.levels.assign(steps + 1, 0);
+                for (std::size_t r{block.row_begin}; r < block.row_end; ++r) {
+                    local[r] = block.rows.size();
+                    block.rows.push_back(r);
+                }
+                std::size_t frontier{0};
+                for (std::size_t k{steps}; k > 0; --k) {
+                    block.levels[k] = block.rows.size();
+                    const std::size_t end{block.rows.size()};
+                    for (std::size_t l{frontier}; l < end; ++l) {
+                        const std::size_t r{block.rows[l]};
+                        for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                            const std::size_t c{static_cast<std::size_t>(store.col_indices[i])};
+                            if (local[c] == NONE) {
+                                local[c] = block.rows.size();
+                                block.rows.push_back(c);
+                            }
+                        }
+                    }
+                    std::sort(block.rows.begin() + end, block.rows.end());
+                    for (std::size_t l{end}; l < block.rows.size(); ++l) {
+                        local[block.rows[l]] = l;
+                    }
+                    frontier = end;
+                }
+                block.levels[0] = block.rows.size();
+
+                // 前levels[1]行的局部子矩阵，列索引换为局部编号
+                const std::size_t local_rows{steps > 0 ? block.levels[1] : 0};
+                block.row_ptr.assign(local_rows + 1, 0);
+                for (std::size_t l{0}; l < local_rows; ++l) {
+                    const std::size_t r{block.rows[l]};
+                    block.row_ptr[l + 1] = block.row_ptr[l] + (store.row_ptr[r + 1] - store.row_ptr[r]);
+                }
+                block.col_indices.resize(block.row_ptr[local_rows]);
+                block.values.resize(block.row_ptr[local_rows]);
+                for (std::size_t l{0}; l < local_rows; ++l) {
+                    const std::size_t r{block.rows[l]};
+                    auto p{block.row_ptr[l]};
+                    for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i, ++p) {
+                        block.col_indices[p] = static_cast<DimIndex>(local[store.col_indices[i]]);
+                        block.values[p] = store.values[i];
+                    }
+                }
+                for (auto r : block.rows) {
+                    local[r] = NONE;
+                }
+            }
+        });
+
+        std::size_t max_rows{0};
+        for (const auto &block : blocks_) {
+            max_rows = std::max(max_rows, block.rows.size());
+        }
+        work_.resize(std::min(num_chunks, std::max<std::size_t>(num_blocks, 1)));
+        for (auto &w : work_) {
+            w.resize(max_rows * (steps + 1));
+        }
+    }
+
+    std::size_t Steps() const { return steps_; }
+    std::size_t NumBlocks() const { return blocks_.size(); }
+
+    // 各块实际计算的行数之和，与n * s之比反映幽灵区的冗余计算量
+    std::size_t ComputedRows() const {
+        std::size_t sum{0};
+        for (const auto &block : blocks_) {
+            for (std::size_t k{1}; k <= steps_; ++k) {
+                sum += block.levels[k];
+            }
+        }
+        return sum;
+    }
+
+    // v为n x (s + 1)列主序矩阵，第k列为A^k * x
+    void Apply(const Value *x, Value *v, std::size_t ldv) const {
+        if (ldv < n_) {
+            throw std::invalid_argument("matrix powers leading dimension too small");
+        }
+        const std::size_t steps{steps_};
+        ParallelChunks(blocks_.size(), work_.size(), [&](std::size_t chunk, std::size_t block_begin,
+                                                         std::size_t block_end) {
+            Value *w{work_[chunk].data()};
+            for (std::size_t b{block_begin}; b < block_end; ++b) {
+                const auto &block{blocks_[b]};
+                const std::size_t len{block.rows.size()};
+                for (std::size_t l{0}; l < len; ++l) {
+                    w[l] = x[block.rows[l]];
+                }
+                for (std::size_t k{1}; k <= steps; ++k) {
+                    const Value *w_in{w + (k - 1) * len};
+                    Value *w_out{w + k * len};
+                    for (std::size_t l{0}; l < block.levels[k]; ++l) {
+                        Value sum{};
+                        for (auto i{block.row_ptr[l]}; i < block.row_ptr[l + 1]; ++i) {
+                            sum += block.values[i] * w_in[block.col_indices[i]];
+                        }
+                        w_out[l] = sum;
+                    }
+                }
+                const std::size_t owned{block.row_end - block.row_begin};
+                for (std::size_t k{0}; k <= steps; ++k) {
+                    std::copy_n(w + k * len, owned, v + block.row_begin + k * ldv);
+                }
+            }
+        });
+    }
+
+    void Apply(const std::vector<Value> &x, std::vector<Value> &v) const {
+        if (x.size() != n_) {
+            throw std::invalid_argument("matrix powers x size mismatch");
+        }
+        v.resize(n_ * (steps_ + 1));
+        Apply(x.data(), v.data(), n_);
+    }
+
+private:
+    struct Block {
+        std::size_t row_begin{};
+        std::size_t row_end{};
+        std::vector<std::size_t> rows;   // 局部行对应的全局行，前row_end - row_begin行为所属行
+        std::vector<std::size_t> levels; // 各步需计算的局部行前缀长度
+        std::vector<NnzIndex> row_ptr;
+        std::vector<DimIndex> col_indices;
+        std::vector<Value> values;
+    };
+
+    MatrixPowersOptions options_;
+    std::size_t n_{0};
+    std::size_t steps_{0};
+    std::vector<Block> blocks_;
+    mutable std::vector<std::vector<Value>> work_;
+};
+} // namespace oops
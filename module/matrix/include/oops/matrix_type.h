@@ -3,6 +3,7 @@
 #include <complex>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -11,7 +12,15 @@
 
 #include "oops/type_list.h"
 namespace oops {
-enum class MatrixFormat : std::uint8_t { SPARSE_COO, SPARSE_CSR, SPARSE_CSC, DENSE_ROW_MAJOR, DENSE_COL_MAJOR };
+enum class MatrixFormat : std::uint8_t {
+    SPARSE_COO,
+    SPARSE_CSR,
+    SPARSE_CSC,
+    DENSE_ROW_MAJOR,
+    DENSE_COL_MAJOR,
+    SPARSE_DIA,
+    SPARSE_HYB
+};
 enum class MatrixNumeric : std::uint8_t { REAL, COMPLEX, INTEGER, PATTERN, OTHER };
 enum class MatrixSymmetric : std::uint8_t {
     GENERAL,
@@ -89,38 +98,49 @@ Dst Convert(Src &&src) {
     }
 }
 
-template <typename Dst, typename Src>
-struct ConvertVectorImpl {
-    static auto F(const std::vector<Src> &src) {
-        std::vector<Dst> dst;
-        dst.reserve(src.size());
+template <typename Alloc, typename T>
+using RebindAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+// 目标分配器与源分配器同族时由源分配器重绑定得到，保留分配器状态，否则默认构造
+template <typename DstAlloc, typename SrcAlloc>
+DstAlloc RebindAllocator(const SrcAlloc &src) {
+    using DstValue = typename std::allocator_traits<DstAlloc>::value_type;
+    if constexpr (std::is_same_v<RebindAlloc<SrcAlloc, DstValue>, DstAlloc>) {
+        return DstAlloc(src);
+    } else {
+        return DstAlloc{};
+    }
+}
+
+// 逐元素转换，DstAlloc为void时沿用源向量的分配器族
+template <typename Dst, typename DstAlloc = void, typename Src, typename SrcAlloc>
+auto ConvertVector(const std::vector<Src, SrcAlloc> &src) {
+    using DstValue = std::decay_t<Dst>;
+    using Alloc = std::conditional_t<std::is_void_v<DstAlloc>, RebindAlloc<SrcAlloc, DstValue>, DstAlloc>;
+    std::vector<DstValue, Alloc> dst(RebindAllocator<Alloc>(src.get_allocator()));
+    dst.reserve(src.size());
+    if constexpr (std::is_same_v<DstValue, Src>) {
+        std::copy(src.begin(), src.end(), std::back_inserter(dst));
+    } else {
         std::transform(
-            src.begin(), src.end(), std::back_inserter(dst), [](const Src &src) { return Convert<Dst>(src); });
-        return dst;
+            src.begin(), src.end(), std::back_inserter(dst), [](const Src &src) { return Convert<DstValue>(src); });
     }
+    return dst;
+}
 
-    static auto F(std::vector<Src> &&src) {
-        std::vector<Dst> dst;
+template <typename Dst, typename DstAlloc = void, typename Src, typename SrcAlloc>
+auto ConvertVector(std::vector<Src, SrcAlloc> &&src) {
+    using DstValue = std::decay_t<Dst>;
+    using Alloc = std::conditional_t<std::is_void_v<DstAlloc>, RebindAlloc<SrcAlloc, DstValue>, DstAlloc>;
+    if constexpr (std::is_same_v<DstValue, Src> && std::is_same_v<Alloc, SrcAlloc>) {
+        return std::vector<DstValue, Alloc>(std::move(src));
+    } else {
+        std::vector<DstValue, Alloc> dst(RebindAllocator<Alloc>(src.get_allocator()));
         dst.reserve(src.size());
         std::transform(
             std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()), std::back_inserter(dst),
-            [](Src &&src) { return Convert<Dst>(std::move(src)); });
+            [](Src &&src) { return Convert<DstValue>(std::move(src)); });
         return dst;
     }
-};
-
-template <typename Dst>
-struct ConvertVectorImpl<Dst, Dst> {
-    static auto F(std::vector<Dst> src) { return src; }
-};
-
-template <typename Dst, typename Src>
-auto ConvertVector(const std::vector<Src> &src) {
-    return ConvertVectorImpl<std::decay_t<Dst>, std::decay_t<Src>>::F(src);
-}
-
-template <typename Dst, typename Src>
-auto ConvertVector(std::vector<Src> &&src) {
-    return ConvertVectorImpl<std::decay_t<Dst>, std::decay_t<Src>>::F(std::move(src));
 }
 } // namespace oops
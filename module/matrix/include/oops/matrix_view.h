@@ -0,0 +1,172 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+
+#include "oops/coo.h"
+#include "oops/csr.h"
+
+namespace oops {
+// 非持有的CSR视图，引用外部的row_ptr、col_indices与values，可来自Csr、内存映射文件、共享内存或NumPy数组
+// 行区间子视图共享values与col_indices，row_ptr保持绝对偏移，无需复制
+// 视图不延长底层数据的生命周期；pattern矩阵的values可为空
+template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+class CsrView {
+public:
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+    using NnzIndexType = NnzIndex;
+
+    static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_CSR};
+
+    CsrView() = default;
+    // row_ptr长度为m + 1
+    CsrView(
+        std::size_t m, std::size_t n, const Value *values, const NnzIndex *row_ptr, const DimIndex *col_indices,
+        MatrixSymmetric symmetric = MatrixSymmetric::GENERAL)
+        : m_{m}, n_{n}, values_{values}, row_ptr_{row_ptr}, col_indices_{col_indices}, symmetric_{symmetric} {}
+    template <typename Allocator>
+    CsrView(const Csr<Value, DimIndex, NnzIndex, Allocator> &csr)
+        : CsrView{
+              csr.M(), csr.N(), csr.GetValues().data(), csr.GetRowPtr().data(), csr.GetColIndices().data(),
+              csr.GetSymmetric()} {}
+    // 禁止引用临时对象
+    template <typename Allocator>
+    CsrView(Csr<Value, DimIndex, NnzIndex, Allocator> &&) = delete;
+
+    static constexpr MatrixFormat GetFormat() { return FORMAT; }
+    MatrixSymmetric GetSymmetric() const { return symmetric_; }
+
+    std::size_t M() const { return m_; }
+    std::size_t N() const { return n_; }
+    std::size_t StoredNnz() const { return row_ptr_ == nullptr ? 0 : row_ptr_[m_] - row_ptr_[0]; }
+
+    std::size_t DiagNnz() const {
+        std::size_t count{0};
+        for (std::size_t r{0}; r < m_; ++r) {
+            for (auto i{row_ptr_[r]}; i < row_ptr_[r + 1]; ++i) {
+                if (static_cast<std::size_t>(col_indices_[i]) == r + row_offset_) {
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+
+    std::size_t Nnz() const {
+        if (symmetric_ == MatrixSymmetric::GENERAL) {
+            return StoredNnz();
+        }
+        return 2 * StoredNnz() - DiagNnz();
+    }
+
+    // 第r行元素位于[GetRowPtr()[r], GetRowPtr()[r + 1])，偏移相对于GetValues()与GetColIndices()
+    const Value *GetValues() const { return values_; }
+    const NnzIndex *GetRowPtr() const { return row_ptr_; }
+    const DimIndex *GetColIndices() const { return col_indices_; }
+    // 子视图首行在原矩阵中的行号
+    std::size_t RowOffset() const { return row_offset_; }
+
+    // 行区间[begin, end)的子视图，列维度不变
+    CsrView Rows(std::size_t begin, std::size_t end) const {
+        if (begin > end || end > m_) {
+            throw std::out_of_range("row range out of range");
+        }
+        if (symmetric_ != MatrixSymmetric::GENERAL) {
+            throw std::invalid_argument("row range view requires general storage");
+        }
+        CsrView view{end - begin, n_, values_, row_ptr_ + begin, col_indices_, symmetric_};
+        view.row_offset_ = row_offset_ + begin;
+        return view;
+    }
+
+private:
+    std::size_t m_{0};
+    std::size_t n_{0};
+    const Value *values_{nullptr};
+    const NnzIndex *row_ptr_{nullptr};
+    const DimIndex *col_indices_{nullptr};
+    MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
+    std::size_t row_offset_{0};
+};
+
+// 非持有的COO视图，元素区间子视图无需复制
+template <typename Value, typename DimIndex>
+class CooView {
+public:
+    using ValueType = Value;
+    using DimIndexType = DimIndex;
+
+    static constexpr MatrixFormat FORMAT{MatrixFormat::SPARSE_COO};
+
+    CooView() = default;
+    CooView(
+        std::size_t m, std::size_t n, std::size_t stored_nnz, const Value *values, const DimIndex *row_indices,
+        const DimIndex *col_indices, MatrixSymmetric symmetric = MatrixSymmetric::GENERAL)
+        : m_{m}, n_{n}, stored_nnz_{stored_nnz}, values_{values}, row_indices_{row_indices},
+          col_indices_{col_indices}, symmetric_{symmetric} {}
+    template <typename Allocator>
+    CooView(const Coo<Value, DimIndex, Allocator> &coo)
+        : CooView{
+              coo.M(),
+              coo.N(),
+              coo.StoredNnz(),
+              coo.GetValues().data(),
+              coo.GetRowIndices().data(),
+              coo.GetColIndices().data(),
+              coo.GetSymmetric()} {}
+    template <typename Allocator>
+    CooView(Coo<Value, DimIndex, Allocator> &&) = delete;
+
+    static constexpr MatrixFormat GetFormat() { return FORMAT; }
+    MatrixSymmetric GetSymmetric() const { return symmetric_; }
+
+    std::size_t M() const { return m_; }
+    std::size_t N() const { return n_; }
+    std::size_t StoredNnz() const { return stored_nnz_; }
+
+    std::size_t DiagNnz() const {
+        std::size_t count{0};
+        for (std::size_t i{0}; i < stored_nnz_; ++i) {
+            if (row_indices_[i] == col_indices_[i]) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    std::size_t Nnz() const {
+        if (symmetric_ == MatrixSymmetric::GENERAL) {
+            return StoredNnz();
+        }
+        return 2 * StoredNnz() - DiagNnz();
+    }
+
+    const Value *GetValues() const { return values_; }
+    const DimIndex *GetRowIndices() const { return row_indices_; }
+    const DimIndex *GetColIndices() const { return col_indices_; }
+
+    // 元素区间[begin, end)的子视图，矩阵维度不变
+    CooView Entries(std::size_t begin, std::size_t end) const {
+        if (begin > end || end > stored_nnz_) {
+            throw std::out_of_range("entry range out of range");
+        }
+        return {
+            m_,
+            n_,
+            end - begin,
+            values_ == nullptr ? nullptr : values_ + begin,
+            row_indices_ + begin,
+            col_indices_ + begin,
+            symmetric_};
+    }
+
+private:
+    std::size_t m_{0};
+    std::size_t n_{0};
+    std::size_t stored_nnz_{0};
+    const Value *values_{nullptr};
+    const DimIndex *row_indices_{nullptr};
+    const DimIndex *col_indices_{nullptr};
+    MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
+};
+} // namespace oops
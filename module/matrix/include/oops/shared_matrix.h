@@ -0,0 +1,171 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "oops/coo.h"
+#include "oops/csr.h"
+#include "oops/matrix_view.h"
+
+namespace oops {
+// 共享段中矩阵的类型与布局描述，三个数组依次为values、row_ptr(COO为row_indices)、col_indices
+struct SharedMatrixInfo {
+    MatrixFormat format{};
+    MatrixSymmetric symmetric{};
+    MatrixNumeric value_numeric{};
+    MatrixNumeric dim_index_numeric{};
+    MatrixNumeric nnz_index_numeric{};
+    std::uint64_t m{};
+    std::uint64_t n{};
+    std::uint64_t stored_nnz{};
+    std::uint64_t bytes{}; // 段总长度
+    std::array<std::uint64_t, 3> counts{};
+    std::array<std::uint64_t, 3> item_sizes{};
+    std::array<std::uint64_t, 3> offsets{}; // 相对段首，按缓存行对齐
+};
+
+// 段首的头部，位于首个HEADER_BYTES字节内，引用计数与magic为跨进程原子量
+struct SharedMatrixHeader {
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    std::atomic<std::uint64_t> magic; // 发布完成后置位
+    std::atomic<std::uint64_t> ref_count;
+    SharedMatrixInfo info;
+};
+
+// 发布到POSIX共享内存或memfd的只读矩阵，节点内多进程共享同一份数据
+// 发布方写入数据后置位magic并将数据区设为只读；附加方仅映射，不复制数据
+// 每个实例持有一次引用，最后一个实例分离时删除具名段；memfd在全部描述符与映射关闭后由内核回收
+// 进程异常退出时引用不会归还，具名段需手动shm_unlink
+class SharedMatrix {
+public:
+    static constexpr std::size_t HEADER_BYTES{4096};
+
+    SharedMatrix() = default;
+    SharedMatrix(SharedMatrix &&rhs) noexcept;
+    SharedMatrix &operator=(SharedMatrix &&rhs) noexcept;
+    ~SharedMatrix() { Detach(); }
+
+    SharedMatrix(const SharedMatrix &) = delete;
+    SharedMatrix &operator=(const SharedMatrix &) = delete;
+
+    // name形如"/oops_a"，为空时使用memfd，通过Fd()经fork或SCM_RIGHTS传给其他进程
+    // 同名段已存在时抛出std::system_error
+    template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+    static SharedMatrix Publish(const std::string &name, const Csr<Value, DimIndex, NnzIndex, Allocator> &csr);
+    template <typename Value, typename DimIndex, typename Allocator>
+    static SharedMatrix Publish(const std::string &name, const Coo<Value, DimIndex, Allocator> &coo);
+
+    // 段尚未发布完成、已被释放，或头部的布局与段长度不符(截断或损坏)时抛出std::runtime_error
+    static SharedMatrix Attach(const std::string &name);
+    // 复制fd后附加，调用方仍持有原fd
+    static SharedMatrix Attach(int fd);
+    void Detach() noexcept;
+
+    bool Attached() const { return header_ != nullptr; }
+    const std::string &Name() const { return name_; }
+    int Fd() const { return fd_; }
+    const SharedMatrixInfo &Info() const { return header_->info; }
+    std::size_t UseCount() const { return header_->ref_count.load(std::memory_order_relaxed); }
+
+    // 类型与发布时不一致时抛出std::invalid_argument
+    template <typename Value, typename DimIndex, typename NnzIndex = DimIndex>
+    CsrView<Value, DimIndex, NnzIndex> GetCsr() const {
+        CheckType<Value, DimIndex, NnzIndex>(MatrixFormat::SPARSE_CSR);
+        const auto &info{Info()};
+        return {
+            info.m,
+            info.n,
+            static_cast<const Value *>(Array(0)),
+            static_cast<const NnzIndex *>(Array(1)),
+            static_cast<const DimIndex *>(Array(2)),
+            info.symmetric};
+    }
+
+    template <typename Value, typename DimIndex>
+    CooView<Value, DimIndex> GetCoo() const {
+        CheckType<Value, DimIndex, DimIndex>(MatrixFormat::SPARSE_COO);
+        const auto &info{Info()};
+        return {
+            info.m,
+            info.n,
+            info.stored_nnz,
+            static_cast<const Value *>(Array(0)),
+            static_cast<const DimIndex *>(Array(1)),
+            static_cast<const DimIndex *>(Array(2)),
+            info.symmetric};
+    }
+
+private:
+    template <typename Value, typename DimIndex, typename NnzIndex>
+    static SharedMatrixInfo MakeInfo(MatrixFormat format, MatrixSymmetric symmetric, std::size_t m, std::size_t n) {
+        SharedMatrixInfo info;
+        info.format = format;
+        info.symmetric = symmetric;
+        info.value_numeric = MATRIX_NUMERIC_OF<Value>;
+        info.dim_index_numeric = MATRIX_NUMERIC_OF<DimIndex>;
+        info.nnz_index_numeric = MATRIX_NUMERIC_OF<NnzIndex>;
+        info.m = m;
+        info.n = n;
+        info.item_sizes = {sizeof(Value), format == MatrixFormat::SPARSE_CSR ? sizeof(NnzIndex) : sizeof(DimIndex),
+                           sizeof(DimIndex)};
+        return info;
+    }
+
+    template <typename Value, typename DimIndex, typename NnzIndex>
+    void CheckType(MatrixFormat format) const {
+        const auto &info{Info()};
+        const auto expected{MakeInfo<Value, DimIndex, NnzIndex>(format, info.symmetric, info.m, info.n)};
+        if (info.format != format || info.value_numeric != expected.value_numeric ||
+            info.dim_index_numeric != expected.dim_index_numeric ||
+            info.nnz_index_numeric != expected.nnz_index_numeric || info.item_sizes != expected.item_sizes) {
+            throw std::invalid_argument("shared matrix type mismatch");
+        }
+    }
+
+    // 按info.counts与item_sizes计算布局，创建并以读写方式映射段，返回时尚未发布
+    static SharedMatrix Create(const std::string &name, SharedMatrixInfo info);
+    static SharedMatrix AttachFd(int fd, const std::string &name);
+    // 并行写入第i个数组
+    void Write(std::size_t i, const void *src);
+    // 数据区设为只读并置位magic
+    void Seal();
+    // 空数组返回nullptr
+    const void *Array(std::size_t i) const {
+        return Info().counts[i] == 0 ? nullptr : data_ + Info().offsets[i];
+    }
+
+    std::string name_;
+    int fd_{-1};
+    SharedMatrixHeader *header_{nullptr};
+    std::byte *data_{nullptr};
+};
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+SharedMatrix SharedMatrix::Publish(const std::string &name, const Csr<Value, DimIndex, NnzIndex, Allocator> &csr) {
+    auto info{MakeInfo<Value, DimIndex, NnzIndex>(MatrixFormat::SPARSE_CSR, csr.GetSymmetric(), csr.M(), csr.N())};
+    info.stored_nnz = csr.StoredNnz();
+    info.counts = {csr.GetValues().size(), csr.GetRowPtr().size(), csr.GetColIndices().size()};
+    auto shared{Create(name, info)};
+    shared.Write(0, csr.GetValues().data());
+    shared.Write(1, csr.GetRowPtr().data());
+    shared.Write(2, csr.GetColIndices().data());
+    shared.Seal();
+    return shared;
+}
+
+template <typename Value, typename DimIndex, typename Allocator>
+SharedMatrix SharedMatrix::Publish(const std::string &name, const Coo<Value, DimIndex, Allocator> &coo) {
+    auto info{MakeInfo<Value, DimIndex, DimIndex>(MatrixFormat::SPARSE_COO, coo.GetSymmetric(), coo.M(), coo.N())};
+    info.stored_nnz = coo.StoredNnz();
+    info.counts = {coo.GetValues().size(), coo.GetRowIndices().size(), coo.GetColIndices().size()};
+    auto shared{Create(name, info)};
+    shared.Write(0, coo.GetValues().data());
+    shared.Write(1, coo.GetRowIndices().data());
+    shared.Write(2, coo.GetColIndices().data());
+    shared.Seal();
+    return shared;
+}
+} // namespace oops
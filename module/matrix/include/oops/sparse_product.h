@@ -0,0 +1,214 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "oops/convert.h"
+#include "oops/csr.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 行乘积数 x 该值不小于列数时Gustavson使用稠密累加器，否则使用按列排序的累加器
+constexpr std::size_t SPGEMM_DENSE_RATIO{16};
+
+namespace detail {
+// 按行区间并行的分块数
+inline std::size_t RowChunks(std::size_t m) { return std::min<std::size_t>(m, 4 * ThreadPool::Get().Size()); }
+
+// 并行块按需借用的工作区，块结束时归还供后续块复用，创建的个数不超过同时执行的块数
+template <typename T>
+class WorkspacePool {
+public:
+    template <typename Make>
+    std::unique_ptr<T> Acquire(Make &&make) {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!free_.empty()) {
+                auto workspace{std::move(free_.back())};
+                free_.pop_back();
+                return workspace;
+            }
+        }
+        return std::make_unique<T>(make());
+    }
+
+    void Release(std::unique_ptr<T> workspace) {
+        if (workspace != nullptr) {
+            std::lock_guard<std::mutex> lock{mutex_};
+            free_.push_back(std::move(workspace));
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+};
+
+// 稠密累加器，marker记录各列最近一次写入的行
+template <typename Value>
+struct DenseAccumulator {
+    std::vector<std::size_t> marker;
+    std::vector<Value> values;
+};
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void CheckGeneral(const Csr<Value, DimIndex, NnzIndex> &a, const char *op) {
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        throw std::invalid_argument(std::string{op} + " requires general storage");
+    }
+}
+} // namespace detail
+
+// 转置，结果行内列索引升序
+// 转置后的模式缓存于a的模式上并由结果共享，模式不变时再次转置只收集数值
+template <typename Value, typename DimIndex, typename NnzIndex>
+Csr<Value, DimIndex, NnzIndex> Transpose(const Csr<Value, DimIndex, NnzIndex> &a) {
+    detail::CheckGeneral(a, "transpose");
+    const auto transposed{detail::GetTransposedPattern(*a.GetPattern())};
+    typename Csr<Value, DimIndex, NnzIndex>::template Vector<Value> values;
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        detail::GatherValues(a.GetValues().data(), transposed->src, values);
+    }
+    return {transposed->pattern, std::move(values)};
+}
+
+// C = A * B，Gustavson按行计算
+// 符号阶段统计每行非零数并做前缀和，数值阶段按行写入，行内列索引升序，结果与线程数无关
+// 乘积较多的行使用长度为列数的稠密累加器，由并行块借用复用；其余行将乘积按列稳定排序后合并，工作区与乘积数成正比
+// 两种累加器对同一列按乘积生成的顺序求和，结果相同
+template <typename Value, typename DimIndex, typename NnzIndex>
+Csr<Value, DimIndex, NnzIndex>
+Multiply(const Csr<Value, DimIndex, NnzIndex> &a, const Csr<Value, DimIndex, NnzIndex> &b) {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+    detail::CheckGeneral(a, "multiply");
+    detail::CheckGeneral(b, "multiply");
+    if (a.N() != b.M()) {
+        throw std::invalid_argument("multiply dimension mismatch");
+    }
+    const auto &a_store{a.GetStore()};
+    const auto &b_store{b.GetStore()};
+    const std::size_t m{a.M()};
+    const std::size_t n{b.N()};
+    const std::size_t num_chunks{detail::RowChunks(m)};
+    constexpr std::size_t NONE{std::numeric_limits<std::size_t>::max()};
+    // 第r行的乘积数，即该行非零数的上界
+    auto row_products = [&](std::size_t r) {
+        std::size_t count{0};
+        for (auto i{a_store.row_ptr[r]}; i < a_store.row_ptr[r + 1]; ++i) {
+            auto k{a_store.col_indices[i]};
+            count += static_cast<std::size_t>(b_store.row_ptr[k + 1] - b_store.row_ptr[k]);
+        }
+        return count;
+    };
+    auto dense = [n](std::size_t products) { return products * SPGEMM_DENSE_RATIO >= n; };
+
+    CsrStore<Value, DimIndex, NnzIndex> c_store;
+    c_store.n = n;
+    c_store.row_ptr.assign(m + 1, 0);
+    detail::WorkspacePool<std::vector<std::size_t>> markers;
+    ParallelChunks(m, num_chunks, [&](std::size_t, std::size_t row_begin, std::size_t row_end) {
+        std::unique_ptr<std::vector<std::size_t>> marker;
+        std::vector<DimIndex> cols;
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            NnzIndex count{0};
+            if (dense(row_products(r))) {
+                if (marker == nullptr) {
+                    marker = markers.Acquire([n] { return std::vector<std::size_t>(n, std::size_t{NONE}); });
+                }
+                for (auto i{a_store.row_ptr[r]}; i < a_store.row_ptr[r + 1]; ++i) {
+                    auto k{a_store.col_indices[i]};
+                    for (auto j{b_store.row_ptr[k]}; j < b_store.row_ptr[k + 1]; ++j) {
+                        auto &mark{(*marker)[b_store.col_indices[j]]};
+                        if (mark != r) {
+                            mark = r;
+                            ++count;
+                        }
+                    }
+                }
+            } else {
+                cols.clear();
+                for (auto i{a_store.row_ptr[r]}; i < a_store.row_ptr[r + 1]; ++i) {
+                    auto k{a_store.col_indices[i]};
+                    cols.insert(cols.end(), b_store.col_indices.begin() + b_store.row_ptr[k],
+                                b_store.col_indices.begin() + b_store.row_ptr[k + 1]);
+                }
+                std::sort(cols.begin(), cols.end());
+                count = static_cast<NnzIndex>(std::unique(cols.begin(), cols.end()) - cols.begin());
+            }
+            c_store.row_ptr[r + 1] = count;
+        }
+        markers.Release(std::move(marker));
+    });
+    std::partial_sum(c_store.row_ptr.begin(), c_store.row_ptr.end(), c_store.row_ptr.begin());
+
+    const std::size_t nnz{static_cast<std::size_t>(c_store.row_ptr[m])};
+    c_store.col_indices.resize(nnz);
+    c_store.values.resize(nnz);
+    detail::WorkspacePool<detail::DenseAccumulator<Value>> accumulators;
+    ParallelChunks(m, num_chunks, [&](std::size_t, std::size_t row_begin, std::size_t row_end) {
+        std::unique_ptr<detail::DenseAccumulator<Value>> acc;
+        std::vector<std::pair<DimIndex, Value>> products;
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            auto first{c_store.col_indices.begin() + c_store.row_ptr[r]};
+            if (!dense(row_products(r))) {
+                products.clear();
+                for (auto i{a_store.row_ptr[r]}; i < a_store.row_ptr[r + 1]; ++i) {
+                    auto k{a_store.col_indices[i]};
+                    const Value a_ik{a_store.values[i]};
+                    for (auto j{b_store.row_ptr[k]}; j < b_store.row_ptr[k + 1]; ++j) {
+                        products.emplace_back(b_store.col_indices[j], a_ik * b_store.values[j]);
+                    }
+                }
+                std::stable_sort(products.begin(), products.end(),
+                                 [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+                auto pos{static_cast<std::size_t>(c_store.row_ptr[r])};
+                for (std::size_t p{0}; p < products.size(); ++p) {
+                    if (p > 0 && products[p].first == products[p - 1].first) {
+                        c_store.values[pos - 1] += products[p].second;
+                    } else {
+                        c_store.col_indices[pos] = products[p].first;
+                        c_store.values[pos] = products[p].second;
+                        ++pos;
+                    }
+                }
+                continue;
+            }
+            if (acc == nullptr) {
+                acc = accumulators.Acquire([n] {
+                    return detail::DenseAccumulator<Value>{
+                        std::vector<std::size_t>(n, std::size_t{NONE}), std::vector<Value>(n)};
+                });
+            }
+            auto &marker{acc->marker};
+            auto &values{acc->values};
+            auto last{first};
+            for (auto i{a_store.row_ptr[r]}; i < a_store.row_ptr[r + 1]; ++i) {
+                auto k{a_store.col_indices[i]};
+                const Value a_ik{a_store.values[i]};
+                for (auto j{b_store.row_ptr[k]}; j < b_store.row_ptr[k + 1]; ++j) {
+                    auto c{b_store.col_indices[j]};
+                    if (marker[c] != r) {
+                        marker[c] = r;
+                        values[c] = a_ik * b_store.values[j];
+                        *(last++) = c;
+                    } else {
+                        values[c] += a_ik * b_store.values[j];
+                    }
+                }
+            }
+            std::sort(first, last);
+            for (auto i{c_store.row_ptr[r]}; i < c_store.row_ptr[r + 1]; ++i) {
+                c_store.values[i] = values[c_store.col_indices[i]];
+            }
+        }
+        accumulators.Release(std::move(acc));
+    });
+    return {std::move(c_store)};
+}
+} // namespace oops
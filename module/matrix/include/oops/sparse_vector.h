@@ -0,0 +1,195 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "oops/matrix_type.h"
+
+namespace oops {
+namespace detail {
+// 按位存储的索引集合，第i位位于bits[i / 64]的第i % 64位
+inline std::size_t BitWords(std::size_t n) { return (n + 63) / 64; }
+inline bool TestBit(const std::uint64_t *bits, std::size_t i) { return (bits[i >> 6] >> (i & 63)) & 1; }
+inline void SetBit(std::uint64_t *bits, std::size_t i) { bits[i >> 6] |= std::uint64_t{1} << (i & 63); }
+} // namespace detail
+
+enum class SparseVectorFormat {
+    SORTED, // 升序索引与对应数值，适合很稀疏的向量
+    BITMAP, // 按位标记非零位置，数值按位置稠密存储，适合较稠密的向量
+};
+
+// 稀疏向量，两种表示可相互转换；pattern向量(Value为std::monostate)不存储数值
+template <typename Value, typename Index = int32_t>
+class SparseVector {
+    static_assert(std::is_integral_v<Index>);
+    static constexpr bool HAS_VALUES{!std::is_same_v<Value, std::monostate>};
+
+public:
+    using ValueType = Value;
+    using IndexType = Index;
+
+    SparseVector() = default;
+    explicit SparseVector(std::size_t n) : n_{n} {}
+    // 升序表示，indices须严格升序且小于n，values与indices等长(pattern向量为空)
+    SparseVector(std::size_t n, std::vector<Index> indices, std::vector<Value> values = {})
+        : n_{n}, nnz_{indices.size()}, indices_{std::move(indices)}, values_{std::move(values)} {
+        if (HAS_VALUES ? values_.size() != indices_.size() : !values_.empty()) {
+            throw std::invalid_argument("sparse vector values size mismatch");
+        }
+        for (std::size_t k{0}; k < indices_.size(); ++k) {
+            if (indices_[k] < 0 || static_cast<std::size_t>(indices_[k]) >= n_ ||
+                (k > 0 && indices_[k - 1] >= indices_[k])) {
+                throw std::invalid_argument("sparse vector requires sorted unique indices in range");
+            }
+        }
+    }
+
+    // 位图表示，bits长度为(n + 63) / 64，values长度为n(pattern向量为空)
+    static SparseVector FromBitmap(std::size_t n, std::vector<std::uint64_t> bits, std::vector<Value> values = {}) {
+        if (bits.size() != BitWords(n) || (HAS_VALUES ? values.size() != n : !values.empty())) {
+            throw std::invalid_argument("sparse vector bitmap size mismatch");
+        }
+        if (n % 64 != 0 && !bits.empty() && (bits.back() >> (n % 64)) != 0) {
+            throw std::invalid_argument("sparse vector bitmap has bits beyond n");
+        }
+        SparseVector x{n};
+        x.format_ = SparseVectorFormat::BITMAP;
+        for (auto word : bits) {
+            x.nnz_ += static_cast<std::size_t>(__builtin_popcountll(word));
+        }
+        x.bits_ = std::move(bits);
+        x.values_ = std::move(values);
+        return x;
+    }
+
+    static std::size_t BitWords(std::size_t n) { return detail::BitWords(n); }
+
+    SparseVectorFormat GetFormat() const { return format_; }
+    std::size_t N() const { return n_; }
+    std::size_t Nnz() const { return nnz_; }
+    double Density() const { return n_ == 0 ? 0. : static_cast<double>(nnz_) / static_cast<double>(n_); }
+
+    // 升序表示的索引
+    const std::vector<Index> &GetIndices() const { return indices_; }
+    // 升序表示时与索引对应，位图表示时长度为N()，未标记位置的值无意义
+    const std::vector<Value> &GetValues() const { return values_; }
+    // 位图表示的标记字
+    const std::vector<std::uint64_t> &GetBits() const { return bits_; }
+
+    bool Contains(std::size_t i) const {
+        CheckIndex(i);
+        if (format_ == SparseVectorFormat::BITMAP) {
+            return detail::TestBit(bits_.data(), i);
+        }
+        return std::binary_search(indices_.begin(), indices_.end(), static_cast<Index>(i));
+    }
+
+    // 不存在的元素返回Value{}
+    Value Get(std::size_t i) const {
+        CheckIndex(i);
+        if constexpr (HAS_VALUES) {
+            if (format_ == SparseVectorFormat::BITMAP) {
+                return detail::TestBit(bits_.data(), i) ? values_[i] : Value{};
+            }
+            const auto it{std::lower_bound(indices_.begin(), indices_.end(), static_cast<Index>(i))};
+            if (it != indices_.end() && static_cast<std::size_t>(*it) == i) {
+                return values_[it - indices_.begin()];
+            }
+        }
+        return Value{};
+    }
+
+    // 按索引升序对每个元素调用f(index, value)
+    template <typename F>
+    void ForEach(F &&f) const {
+        if (format_ == SparseVectorFormat::SORTED) {
+            for (std::size_t k{0}; k < indices_.size(); ++k) {
+                f(static_cast<std::size_t>(indices_[k]), ValueAt(k));
+            }
+            return;
+        }
+        for (std::size_t w{0}; w < bits_.size(); ++w) {
+            for (std::uint64_t word{bits_[w]}; word != 0; word &= word - 1) {
+                const std::size_t i{w * 64 + static_cast<std::size_t>(__builtin_ctzll(word))};
+                f(i, ValueAt(i));
+            }
+        }
+    }
+
+    SparseVector ToSorted() const {
+        if (format_ == SparseVectorFormat::SORTED) {
+            return *this;
+        }
+        SparseVector x{n_};
+        x.nnz_ = nnz_;
+        x.indices_.reserve(nnz_);
+        if constexpr (HAS_VALUES) {
+            x.values_.reserve(nnz_);
+        }
+        ForEach([&x](std::size_t i, const Value &value) {
+            x.indices_.push_back(static_cast<Index>(i));
+            if constexpr (HAS_VALUES) {
+                x.values_.push_back(value);
+            }
+        });
+        return x;
+    }
+
+    SparseVector ToBitmap() const {
+        if (format_ == SparseVectorFormat::BITMAP) {
+            return *this;
+        }
+        SparseVector x{n_};
+        x.format_ = SparseVectorFormat::BITMAP;
+        x.nnz_ = nnz_;
+        x.bits_.assign(BitWords(n_), 0);
+        if constexpr (HAS_VALUES) {
+            x.values_.assign(n_, Value{});
+        }
+        for (std::size_t k{0}; k < indices_.size(); ++k) {
+            const auto i{static_cast<std::size_t>(indices_[k])};
+            detail::SetBit(x.bits_.data(), i);
+            if constexpr (HAS_VALUES) {
+                x.values_[i] = values_[k];
+            }
+        }
+        return x;
+    }
+
+    // 未存储的位置为Value{}
+    std::vector<Value> ToDense() const {
+        static_assert(HAS_VALUES, "pattern vector has no values");
+        std::vector<Value> dense(n_, Value{});
+        ForEach([&dense](std::size_t i, const Value &value) { dense[i] = value; });
+        return dense;
+    }
+
+private:
+    void CheckIndex(std::size_t i) const {
+        if (i >= n_) {
+            std::ostringstream oss;
+            oss << "sparse vector index " << i << " out of range";
+            throw std::out_of_range(oss.str());
+        }
+    }
+
+    // 升序表示时k为第k个元素，位图表示时为位置
+    Value ValueAt([[maybe_unused]] std::size_t k) const {
+        if constexpr (HAS_VALUES) {
+            return values_[k];
+        } else {
+            return {};
+        }
+    }
+
+    std::size_t n_{0};
+    SparseVectorFormat format_{SparseVectorFormat::SORTED};
+    std::size_t nnz_{0};
+    std::vector<Index> indices_;
+    std::vector<Value> values_;
+    std::vector<std::uint64_t> bits_;
+};
+} // namespace oops
@@ -0,0 +1,176 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/coo_builder.h"
+#include "oops/sparse_product.h"
+#include "oops/sparse_vector.h"
+#include "oops/spmv.h"
+
+namespace oops {
+struct SpMSpVOptions {
+    // x的密度超过该值时改为按行遍历全部非零元的稠密路径，结果为位图表示；否则按列访问，结果为升序表示
+    double dense_threshold{0.05};
+};
+
+namespace detail {
+template <typename Value, typename Index>
+struct SpMSpVProduct {
+    Index row_index;
+    Value value;
+};
+
+// 按列访问：只遍历x的活跃列，乘积按行区间分桶后桶内稳定排序合并
+// 同一行的乘积按列升序累加，与SpMV的求和顺序相同；转置结构缓存于a的模式上，首次调用时生成
+template <typename Value, typename DimIndex, typename NnzIndex, typename Index>
+SparseVector<Value, Index> SpMSpVColumns(const Csr<Value, DimIndex, NnzIndex> &a, const SparseVector<Value, Index> &x) {
+    constexpr bool HAS_VALUES{!std::is_same_v<Value, std::monostate>};
+    using Product = SpMSpVProduct<Value, Index>;
+    const std::size_t m{a.M()};
+    const auto xs{x.ToSorted()};
+    const std::size_t nnz_x{xs.Nnz()};
+    if (m == 0 || nnz_x == 0) {
+        return SparseVector<Value, Index>{m};
+    }
+    const auto transposed{GetTransposedPattern(*a.GetPattern())};
+    const NnzIndex *col_ptr{transposed->pattern->GetRowPtr().data()};
+    const DimIndex *row_indices{transposed->pattern->GetColIndices().data()};
+    const NnzIndex *src{transposed->src.data()};
+    const Index *x_indices{xs.GetIndices().data()};
+    [[maybe_unused]] const Value *x_values{xs.GetValues().data()};
+    [[maybe_unused]] const Value *values{nullptr};
+    if constexpr (HAS_VALUES) {
+        values = a.GetValues().data();
+    }
+
+    // 活跃列按升序分块，块内按列序生成乘积
+    std::vector<std::vector<Product>> products(RowChunks(nnz_x));
+    ParallelChunks(nnz_x, products.size(), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &local{products[chunk]};
+        for (std::size_t k{begin}; k < end; ++k) {
+            const auto c{static_cast<std::size_t>(x_indices[k])};
+            for (auto i{col_ptr[c]}; i < col_ptr[c + 1]; ++i) {
+                Product p{static_cast<Index>(row_indices[i]), {}};
+                if constexpr (HAS_VALUES) {
+                    p.value = values[src[i]] * x_values[k];
+                }
+                local.push_back(p);
+            }
+        }
+    });
+    std::vector<std::pair<const Product *, std::size_t>> segments;
+    for (const auto &local : products) {
+        segments.emplace_back(local.data(), local.size());
+    }
+    const std::size_t num_buckets{RowChunks(m)};
+    const std::size_t bucket_rows{(m + num_buckets - 1) / num_buckets};
+    std::vector<Product> merged;
+    std::vector<std::size_t> bucket_ptr;
+    BucketSegments(
+        segments, num_buckets,
+        [bucket_rows](const Product &p) { return static_cast<std::size_t>(p.row_index) / bucket_rows; }, merged,
+        bucket_ptr);
+    products.clear();
+
+    // 桶内按行稳定排序并合并同行乘积，压缩写回桶区间起始处
+    std::vector<std::size_t> bucket_nnz(num_buckets + 1, 0);
+    ParallelFor(0, num_buckets, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b{begin}; b < end; ++b) {
+            const auto first{merged.begin() + bucket_ptr[b]};
+            const auto last{merged.begin() + bucket_ptr[b + 1]};
+            std::stable_sort(
+                first, last, [](const Product &lhs, const Product &rhs) { return lhs.row_index < rhs.row_index; });
+            auto out{first};
+            for (auto it{first}; it != last; ++it) {
+                if (out != first && std::prev(out)->row_index == it->row_index) {
+                    if constexpr (HAS_VALUES) {
+                        std::prev(out)->value += it->value;
+                    }
+                } else {
+                    *out++ = *it;
+                }
+            }
+            bucket_nnz[b + 1] = static_cast<std::size_t>(out - first);
+        }
+    });
+    for (std::size_t b{0}; b < num_buckets; ++b) {
+        bucket_nnz[b + 1] += bucket_nnz[b];
+    }
+    std::vector<Index> y_indices(bucket_nnz[num_buckets]);
+    std::vector<Value> y_values(HAS_VALUES ? y_indices.size() : 0);
+    ParallelFor(0, num_buckets, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b{begin}; b < end; ++b) {
+            for (std::size_t k{0}; k < bucket_nnz[b + 1] - bucket_nnz[b]; ++k) {
+                const Product &p{merged[bucket_ptr[b] + k]};
+                y_indices[bucket_nnz[b] + k] = p.row_index;
+                if constexpr (HAS_VALUES) {
+                    y_values[bucket_nnz[b] + k] = p.value;
+                }
+            }
+        }
+    });
+    return SparseVector<Value, Index>{m, std::move(y_indices), std::move(y_values)};
+}
+
+// 按行访问：与SpMV相同按行并行遍历全部非零元，以位图判断列是否活跃，行内按列升序累加
+template <typename Value, typename DimIndex, typename NnzIndex, typename Index>
+SparseVector<Value, Index> SpMSpVRows(const Csr<Value, DimIndex, NnzIndex> &a, const SparseVector<Value, Index> &x) {
+    constexpr bool HAS_VALUES{!std::is_same_v<Value, std::monostate>};
+    const std::size_t m{a.M()};
+    const auto xb{x.ToBitmap()};
+    const std::uint64_t *x_bits{xb.GetBits().data()};
+    [[maybe_unused]] const Value *x_values{xb.GetValues().data()};
+    [[maybe_unused]] const Value *values{nullptr};
+    if constexpr (HAS_VALUES) {
+        values = a.GetValues().data();
+    }
+    const NnzIndex *row_ptr{a.GetRowPtr().data()};
+    const DimIndex *col_indices{a.GetColIndices().data()};
+
+    std::vector<std::uint64_t> bits(BitWords(m), 0);
+    std::vector<Value> y_values(HAS_VALUES ? m : 0);
+    // 按整字划分行区间，块间不共享位图字
+    ParallelFor(0, bits.size(), SPMV_ROW_GRAIN / 64, [&](std::size_t word_begin, std::size_t word_end) {
+        for (std::size_t r{word_begin * 64}; r < std::min(word_end * 64, m); ++r) {
+            Value sum{};
+            bool hit{false};
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                const auto c{static_cast<std::size_t>(col_indices[i])};
+                if (TestBit(x_bits, c)) {
+                    if constexpr (HAS_VALUES) {
+                        sum += values[i] * x_values[c];
+                    }
+                    hit = true;
+                }
+            }
+            if (hit) {
+                SetBit(bits.data(), r);
+                if constexpr (HAS_VALUES) {
+                    y_values[r] = sum;
+                }
+            }
+        }
+    });
+    return SparseVector<Value, Index>::FromBitmap(m, std::move(bits), std::move(y_values));
+}
+} // namespace detail
+
+// y = A * x，y的非零结构为A中活跃列所在的行(不剔除数值抵消为零的元素)
+// x很稀疏时按列只访问活跃列，密度超过阈值时改为按行的稠密路径；两条路径结果相同，与线程数无关
+// pattern矩阵与pattern向量只计算结构，可用于图算法的前沿扩展
+template <typename Value, typename DimIndex, typename NnzIndex, typename Index>
+SparseVector<Value, Index>
+SpMSpV(const Csr<Value, DimIndex, NnzIndex> &a, const SparseVector<Value, Index> &x, SpMSpVOptions options = {}) {
+    detail::CheckGeneral(a, "spmspv");
+    if (x.N() != a.N()) {
+        throw std::invalid_argument("spmspv x size mismatch");
+    }
+    if (x.Density() > options.dense_threshold) {
+        return detail::SpMSpVRows(a, x);
+    }
+    return detail::SpMSpVColumns(a, x);
+}
+} // namespace oops
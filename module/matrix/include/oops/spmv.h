@@ -0,0 +1,437 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/matrix_view.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 并行SpMV的行分块粒度
+constexpr std::size_t SPMV_ROW_GRAIN{1024};
+// 转置SpMV与对称SpMV的行分块上限，块数只依赖矩阵尺寸，各块持有一份累加缓冲
+constexpr std::size_t SPMV_T_MAX_CHUNKS{64};
+
+template <typename Value>
+Value Conj(const Value &v) {
+    if constexpr (IS_COMPLEX<Value>) {
+        return std::conj(v);
+    } else {
+        return v;
+    }
+}
+
+// 对称压缩存储下，已存储元素a(i, j)对应的镜像元素a(j, i)
+template <typename Value>
+Value MirrorValue(MatrixSymmetric symmetric, const Value &v) {
+    switch (symmetric) {
+    case MatrixSymmetric::HERMITIAN_LOWER:
+    case MatrixSymmetric::HERMITIAN_UPPER:
+        return Conj(v);
+    case MatrixSymmetric::SKEW_LOWER:
+    case MatrixSymmetric::SKEW_UPPER:
+        return -v;
+    default:
+        return v;
+    }
+}
+
+namespace detail {
+// 转置的压缩存储：ptr为各列起点，indices为行索引，列内升序，结果与线程数无关
+// 行区间按线程分块，各块统计列直方图，前缀和得到各块在每列中的写入起点后并行散射
+// 直方图占用块数 x 列数，块数按非零元与列数之比限制
+template <typename Value, typename DimIndex, typename NnzIndex, typename PtrVector, typename IndexVector,
+          typename ValueVector>
+void TransposeStore(
+    const CsrView<Value, DimIndex, NnzIndex> &a, PtrVector &ptr, IndexVector &indices, ValueVector &out_values) {
+    constexpr bool has_values{!std::is_same_v<Value, std::monostate>};
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    const std::size_t m{a.M()};
+    const std::size_t n{a.N()};
+    const std::size_t stored_nnz{a.StoredNnz()};
+    const std::size_t num_chunks{std::clamp<std::size_t>(
+        std::min(stored_nnz / std::max<std::size_t>(n, 1), m / SPMV_ROW_GRAIN), 1, ThreadPool::Get().Size())};
+
+    ptr.assign(n + 1, 0);
+    indices.resize(stored_nnz);
+    if constexpr (has_values) {
+        out_values.resize(stored_nnz);
+    }
+
+    // pos[chunk * n + c]先为块内第c列计数，再转为写入起点
+    std::vector<NnzIndex> pos(num_chunks * n, 0);
+    ParallelChunks(m, num_chunks, [&](std::size_t chunk, std::size_t row_begin, std::size_t row_end) {
+        NnzIndex *hist{pos.data() + chunk * n};
+        for (auto i{row_ptr[row_begin]}; i < row_ptr[row_end]; ++i) {
+            ++hist[col_indices[i]];
+        }
+    });
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t col_begin, std::size_t col_end) {
+        for (std::size_t c{col_begin}; c < col_end; ++c) {
+            NnzIndex count{0};
+            for (std::size_t chunk{0}; chunk < num_chunks; ++chunk) {
+                count += pos[chunk * n + c];
+            }
+            ptr[c + 1] = count;
+        }
+    });
+    std::partial_sum(ptr.begin(), ptr.end(), ptr.begin());
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t col_begin, std::size_t col_end) {
+        for (std::size_t c{col_begin}; c < col_end; ++c) {
+            NnzIndex offset{ptr[c]};
+            for (std::size_t chunk{0}; chunk < num_chunks; ++chunk) {
+                const NnzIndex count{pos[chunk * n + c]};
+                pos[chunk * n + c] = offset;
+                offset += count;
+            }
+        }
+    });
+    ParallelChunks(m, num_chunks, [&](std::size_t chunk, std::size_t row_begin, std::size_t row_end) {
+        NnzIndex *next{pos.data() + chunk * n};
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                const auto p{next[col_indices[i]]++};
+                indices[p] = static_cast<DimIndex>(r);
+                if constexpr (has_values) {
+                    out_values[p] = values[i];
+                }
+            }
+        }
+    });
+}
+
+// 转置结构：转置后的模式(列数为原行数)及其各元素在原CSR中的位置
+template <typename Pattern>
+struct TransposedPattern {
+    std::shared_ptr<const Pattern> pattern;
+    std::vector<typename Pattern::NnzIndexType> src;
+};
+
+// 取模式上缓存的转置结构，首次调用时以元素位置为值转置生成
+template <typename Pattern>
+std::shared_ptr<const TransposedPattern<Pattern>> GetTransposedPattern(const Pattern &pattern) {
+    using DimIndex = typename Pattern::DimIndexType;
+    using NnzIndex = typename Pattern::NnzIndexType;
+    return pattern.template Cached<TransposedPattern<Pattern>>(0, [&pattern] {
+        std::vector<NnzIndex> positions(pattern.StoredNnz());
+        std::iota(positions.begin(), positions.end(), NnzIndex{0});
+        typename Pattern::template Vector<NnzIndex> ptr;
+        typename Pattern::template Vector<DimIndex> indices;
+        TransposedPattern<Pattern> transposed;
+        TransposeStore(
+            CsrView<NnzIndex, DimIndex, NnzIndex>{
+                pattern.M(), pattern.N(), positions.data(), pattern.GetRowPtr().data(),
+                pattern.GetColIndices().data()},
+            ptr, indices, transposed.src);
+        transposed.pattern = std::make_shared<const Pattern>(pattern.M(), std::move(ptr), std::move(indices));
+        return transposed;
+    });
+}
+
+// out[k] = values[src[k]]
+template <typename Value, typename NnzIndex, typename ValueVector>
+void GatherValues(const Value *values, const std::vector<NnzIndex> &src, ValueVector &out) {
+    out.resize(src.size());
+    ParallelFor(0, src.size(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k{begin}; k < end; ++k) {
+            out[k] = values[src[k]];
+        }
+    });
+}
+
+// 对称压缩存储的y = A * x，stored(i)与mirror(i)为第i个已存储元素及其镜像元素的值
+// 各行先累加本行已存储元素，再沿转置结构收集其余行在本列的镜像元素，行间无写冲突，结果与线程数无关
+template <typename Value, typename DimIndex, typename NnzIndex, typename Pattern, typename Stored, typename Mirror>
+void SymmetricSpMVGather(const NnzIndex *row_ptr, const DimIndex *col_indices, std::size_t m,
+                         const TransposedPattern<Pattern> &transposed, Stored stored, Mirror mirror, const Value *x,
+                         Value *y) {
+    const NnzIndex *t_ptr{transposed.pattern->GetRowPtr().data()};
+    const DimIndex *t_indices{transposed.pattern->GetColIndices().data()};
+    const NnzIndex *src{transposed.src.data()};
+    ParallelFor(0, m, SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            Value sum{};
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                sum += stored(i) * x[col_indices[i]];
+            }
+            for (auto k{t_ptr[r]}; k < t_ptr[r + 1]; ++k) {
+                const auto c{static_cast<std::size_t>(t_indices[k])};
+                if (c != r) {
+                    sum += mirror(src[k]) * x[c];
+                }
+            }
+            y[r] = sum;
+        }
+    });
+}
+
+// 无转置结构(视图)时按行分块，镜像部分散射到各块私有的缓冲后按块序归约，结果与线程数无关
+// 块数只依赖行数与存储非零元数，缓冲总量不超过存储非零元数
+template <typename Value, typename DimIndex, typename NnzIndex, typename Stored, typename Mirror>
+void SymmetricSpMVChunks(const NnzIndex *row_ptr, const DimIndex *col_indices, std::size_t m, std::size_t stored_nnz,
+                         Stored stored, Mirror mirror, const Value *x, Value *y) {
+    auto scatter = [=](std::size_t row_begin, std::size_t row_end, Value *out) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            Value sum{};
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                const auto c{static_cast<std::size_t>(col_indices[i])};
+                sum += stored(i) * x[c];
+                if (c != r) {
+                    out[c] += mirror(i) * x[r];
+                }
+            }
+            out[r] += sum;
+        }
+    };
+    const std::size_t num_chunks{std::clamp<std::size_t>(
+        std::min(m / SPMV_ROW_GRAIN, stored_nnz / std::max<std::size_t>(m, 1)), 1, SPMV_T_MAX_CHUNKS)};
+    std::fill(y, y + m, Value{});
+    if (num_chunks == 1) {
+        scatter(0, m, y);
+        return;
+    }
+    // 首块直接写入y，其余块写入缓冲
+    std::vector<Value> buffers((num_chunks - 1) * m);
+    ParallelChunks(m, num_chunks, [&](std::size_t chunk, std::size_t row_begin, std::size_t row_end) {
+        scatter(row_begin, row_end, chunk == 0 ? y : buffers.data() + (chunk - 1) * m);
+    });
+    ParallelFor(0, m, SPMV_ROW_GRAIN, [&](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t chunk{1}; chunk < num_chunks; ++chunk) {
+            const Value *buffer{buffers.data() + (chunk - 1) * m};
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                y[r] += buffer[r];
+            }
+        }
+    });
+}
+} // namespace detail
+
+// y = A * x，对称压缩存储的矩阵按完整矩阵计算；行区间子视图时y为子视图对应的行
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const CsrView<Value, DimIndex, NnzIndex> &a, const Value *x, Value *y) {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    const std::size_t m{a.M()};
+
+    if (a.GetSymmetric() == MatrixSymmetric::GENERAL) {
+        ParallelFor(0, m, SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                Value sum{};
+                for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                    sum += values[i] * x[col_indices[i]];
+                }
+                y[r] = sum;
+            }
+        });
+        return;
+    }
+
+    const MatrixSymmetric symmetric{a.GetSymmetric()};
+    detail::SymmetricSpMVChunks(
+        row_ptr, col_indices, m, a.StoredNnz(), [values](std::size_t i) { return values[i]; },
+        [values, symmetric](std::size_t i) { return MirrorValue(symmetric, values[i]); }, x, y);
+}
+
+// 对称压缩存储时沿模式上缓存的转置结构收集镜像元素，不需要累加缓冲
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+void SpMV(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, const Value *x, Value *y) {
+    if (a.GetSymmetric() == MatrixSymmetric::GENERAL) {
+        SpMV(CsrView<Value, DimIndex, NnzIndex>{a}, x, y);
+        return;
+    }
+    const MatrixSymmetric symmetric{a.GetSymmetric()};
+    const Value *values{a.GetValues().data()};
+    detail::SymmetricSpMVGather(
+        a.GetRowPtr().data(), a.GetColIndices().data(), a.M(), *detail::GetTransposedPattern(*a.GetPattern()),
+        [values](std::size_t i) { return values[i]; },
+        [values, symmetric](std::size_t i) { return MirrorValue(symmetric, values[i]); }, x, y);
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const CsrView<Value, DimIndex, NnzIndex> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+void SpMV(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+
+// pattern矩阵的y = A * x，非零元取值为1，不访问values；x与y的类型由调用方决定
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const CsrView<std::monostate, DimIndex, NnzIndex> &a, const Value *x, Value *y) {
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    const std::size_t m{a.M()};
+
+    if (a.GetSymmetric() == MatrixSymmetric::GENERAL) {
+        ParallelFor(0, m, SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+            for (std::size_t r{row_begin}; r < row_end; ++r) {
+                Value sum{};
+                for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                    sum += x[col_indices[i]];
+                }
+                y[r] = sum;
+            }
+        });
+        return;
+    }
+
+    const Value mirror{MirrorValue(a.GetSymmetric(), Value{1})};
+    detail::SymmetricSpMVChunks(
+        row_ptr, col_indices, m, a.StoredNnz(), [](std::size_t) { return Value{1}; },
+        [mirror](std::size_t) { return mirror; }, x, y);
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+void SpMV(const Csr<std::monostate, DimIndex, NnzIndex, Allocator> &a, const Value *x, Value *y) {
+    if (a.GetSymmetric() == MatrixSymmetric::GENERAL) {
+        SpMV(CsrView<std::monostate, DimIndex, NnzIndex>{a}, x, y);
+        return;
+    }
+    const Value mirror{MirrorValue(a.GetSymmetric(), Value{1})};
+    detail::SymmetricSpMVGather(
+        a.GetRowPtr().data(), a.GetColIndices().data(), a.M(), *detail::GetTransposedPattern(*a.GetPattern()),
+        [](std::size_t) { return Value{1}; }, [mirror](std::size_t) { return mirror; }, x, y);
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SpMV(const CsrView<std::monostate, DimIndex, NnzIndex> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+void SpMV(
+    const Csr<std::monostate, DimIndex, NnzIndex, Allocator> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    y.resize(a.M());
+    SpMV(a, x.data(), y.data());
+}
+
+namespace detail {
+// 浮点原子累加，以CAS实现
+template <typename Value>
+void AtomicAdd(Value *p, Value v) {
+    Value expected;
+    __atomic_load(p, &expected, __ATOMIC_RELAXED);
+    Value desired{expected + v};
+    while (!__atomic_compare_exchange(p, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        desired = expected + v;
+    }
+}
+} // namespace detail
+
+// y = A^T * x，直接在行存储上按行散射，无需构造转置
+// 列数较少(块数 x 列数不超过存储非零元数)时各块散射到私有缓冲后按块序归约，结果与线程数无关
+// 列数较多时浮点类型改为原子累加，避免缓冲的初始化与归约开销，求和顺序不确定
+// 对称压缩存储的矩阵按完整矩阵计算；行区间子视图时x为子视图对应的行
+template <typename Value, typename DimIndex, typename NnzIndex>
+void TransposeSpMV(const CsrView<Value, DimIndex, NnzIndex> &a, const Value *x, Value *y) {
+    static_assert(!std::is_same_v<Value, std::monostate>, "pattern matrix has no values");
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    const std::size_t m{a.M()};
+    const std::size_t n{a.N()};
+
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        // A^T中已存储元素a(r, c)位于(c, r)，镜像元素位于(r, c)
+        MatrixSymmetric symmetric{a.GetSymmetric()};
+        std::fill(y, y + n, Value{});
+        for (std::size_t r{0}; r < m; ++r) {
+            Value sum{};
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                std::size_t c{static_cast<std::size_t>(col_indices[i])};
+                y[c] += values[i] * x[r];
+                if (c != r) {
+                    sum += MirrorValue(symmetric, values[i]) * x[c];
+                }
+            }
+            y[r] += sum;
+        }
+        return;
+    }
+
+    auto scatter = [=](std::size_t row_begin, std::size_t row_end, Value *out) {
+        for (std::size_t r{row_begin}; r < row_end; ++r) {
+            const Value xr{x[r]};
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                out[col_indices[i]] += values[i] * xr;
+            }
+        }
+    };
+    const std::size_t num_chunks{std::clamp<std::size_t>(m / SPMV_ROW_GRAIN, 1, SPMV_T_MAX_CHUNKS)};
+    std::fill(y, y + n, Value{});
+    if (num_chunks == 1) {
+        scatter(0, m, y);
+        return;
+    }
+    if constexpr (std::is_floating_point_v<Value>) {
+        if (num_chunks * n > a.StoredNnz()) {
+            ParallelFor(0, m, SPMV_ROW_GRAIN, [=](std::size_t row_begin, std::size_t row_end) {
+                for (std::size_t r{row_begin}; r < row_end; ++r) {
+                    const Value xr{x[r]};
+                    for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                        detail::AtomicAdd(y + col_indices[i], values[i] * xr);
+                    }
+                }
+            });
+            return;
+        }
+    }
+    // 首块直接写入y，其余块写入缓冲
+    std::vector<Value> buffers((num_chunks - 1) * n);
+    ParallelChunks(m, num_chunks, [&](std::size_t chunk, std::size_t row_begin, std::size_t row_end) {
+        scatter(row_begin, row_end, chunk == 0 ? y : buffers.data() + (chunk - 1) * n);
+    });
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t col_begin, std::size_t col_end) {
+        for (std::size_t chunk{1}; chunk < num_chunks; ++chunk) {
+            const Value *buffer{buffers.data() + (chunk - 1) * n};
+            for (std::size_t c{col_begin}; c < col_end; ++c) {
+                y[c] += buffer[c];
+            }
+        }
+    });
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+void TransposeSpMV(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, const Value *x, Value *y) {
+    TransposeSpMV(CsrView<Value, DimIndex, NnzIndex>{a}, x, y);
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+void TransposeSpMV(const CsrView<Value, DimIndex, NnzIndex> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    if (x.size() != a.M()) {
+        throw std::invalid_argument("transpose spmv x size mismatch");
+    }
+    y.resize(a.N());
+    TransposeSpMV(a, x.data(), y.data());
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+void TransposeSpMV(
+    const Csr<Value, DimIndex, NnzIndex, Allocator> &a, const std::vector<Value> &x, std::vector<Value> &y) {
+    TransposeSpMV(CsrView<Value, DimIndex, NnzIndex>{a}, x, y);
+}
+} // namespace oops
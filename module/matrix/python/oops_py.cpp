@@ -0,0 +1,204 @@
+// Python扩展模块oops，以ENABLE_PYTHON(build.py -p)构建；数组属性通过缓冲区协议零拷贝导出，解析、转换与计算期间释放GIL
+//
+//   import numpy as np, scipy.sparse as sp, oops
+//   a = oops.to_csr(oops.read_matrix_market("a.mtx"))
+//   s = sp.csr_matrix((np.asarray(a.data), np.asarray(a.indices), np.asarray(a.indptr)), shape=a.shape, copy=False)
+//   y = np.asarray(oops.spmv(a, np.ones(a.shape[1])))
+//
+// 对称压缩存储的矩阵仅导出已存储的三角部分，由symmetric属性区分
+#include <complex>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "pybind11/complex.h"
+#include "pybind11/pybind11.h"
+
+#include "oops/convert.h"
+#include "oops/matrix_market_io.h"
+#include "oops/spmv.h"
+
+namespace py = pybind11;
+using namespace oops;
+
+namespace {
+// 只读一维数组，持有底层矩阵或向量的引用，导出的视图存活期间数据保持有效
+struct ArrayBuffer {
+    std::shared_ptr<const void> owner;
+    const void *data{nullptr};
+    py::ssize_t size{0};
+    py::ssize_t itemsize{0};
+    std::string format;
+};
+
+template <typename T, typename Vector>
+ArrayBuffer MakeBuffer(std::shared_ptr<const void> owner, const Vector &vec) {
+    return {
+        std::move(owner), vec.data(), static_cast<py::ssize_t>(vec.size()), sizeof(T),
+        py::format_descriptor<T>::format()};
+}
+
+// pattern矩阵无数值数组，返回None
+template <typename Matrix>
+py::object ValuesBuffer(const std::shared_ptr<const void> &owner, const Matrix &matrix) {
+    using Value = typename Matrix::ValueType;
+    if constexpr (std::is_same_v<Value, std::monostate>) {
+        return py::none();
+    } else {
+        return py::cast(MakeBuffer<Value>(owner, matrix.GetValues()));
+    }
+}
+
+template <typename AnyMatrix>
+py::tuple Shape(const AnyMatrix &matrix) {
+    return py::make_tuple(matrix.M(), matrix.N());
+}
+
+std::shared_ptr<AnyCoo> ReadMatrixMarketFile(const std::string &path) {
+    py::gil_scoped_release release;
+    return std::make_shared<AnyCoo>(ReadMatrixMarket(std::filesystem::path{path}));
+}
+
+std::shared_ptr<AnyCsr> AnyCooToCsr(const AnyCoo &coo) {
+    py::gil_scoped_release release;
+    return std::make_shared<AnyCsr>(ToCsr(coo));
+}
+
+// 检查x并计算y = A * x，x需为数值类型为Value的连续一维数组
+template <typename Value, typename Matrix>
+ArrayBuffer SpMVBuffer(const Matrix &csr, const py::buffer_info &info) {
+    if (!info.item_type_is_equivalent_to<Value>()) {
+        throw std::invalid_argument("spmv x dtype mismatch: " + info.format);
+    }
+    if (info.ndim != 1 || static_cast<std::size_t>(info.shape[0]) != csr.N()) {
+        throw std::invalid_argument("spmv x size mismatch");
+    }
+    if (info.shape[0] > 1 && info.strides[0] != static_cast<py::ssize_t>(sizeof(Value))) {
+        throw std::invalid_argument("spmv x must be contiguous");
+    }
+    auto y{std::make_shared<std::vector<Value>>(csr.M())};
+    {
+        py::gil_scoped_release release;
+        SpMV(csr, static_cast<const Value *>(info.ptr), y->data());
+    }
+    return MakeBuffer<Value>(y, *y);
+}
+
+// pattern矩阵的非零元取值为1，按x的数值类型计算，y与x类型相同
+template <typename Matrix, typename Value, typename... Rest>
+ArrayBuffer PatternSpMVBuffer(const Matrix &csr, const py::buffer_info &info) {
+    if constexpr (sizeof...(Rest) > 0) {
+        if (!info.item_type_is_equivalent_to<Value>()) {
+            return PatternSpMVBuffer<Matrix, Rest...>(csr, info);
+        }
+    }
+    return SpMVBuffer<Value>(csr, info);
+}
+
+// y = A * x，x需为与矩阵数值类型相同的连续一维数组，pattern矩阵接受任意支持的数值类型
+ArrayBuffer AnyCsrSpMV(const AnyCsr &a, const py::buffer &x) {
+    const py::buffer_info info{x.request()};
+    return a.Visit([&info](const auto &csr) -> ArrayBuffer {
+        using Matrix = std::decay_t<decltype(csr)>;
+        using Value = typename Matrix::ValueType;
+        if constexpr (std::is_same_v<Value, std::monostate>) {
+            return PatternSpMVBuffer<
+                Matrix, double, float, std::complex<double>, std::complex<float>, std::intmax_t>(csr, info);
+        } else {
+            return SpMVBuffer<Value>(csr, info);
+        }
+    });
+}
+} // namespace
+
+PYBIND11_MODULE(oops, m) {
+    m.doc() = "oops sparse matrix bindings";
+
+    py::enum_<MatrixNumeric>(m, "MatrixNumeric")
+        .value("REAL", MatrixNumeric::REAL)
+        .value("COMPLEX", MatrixNumeric::COMPLEX)
+        .value("INTEGER", MatrixNumeric::INTEGER)
+        .value("PATTERN", MatrixNumeric::PATTERN)
+        .value("OTHER", MatrixNumeric::OTHER);
+
+    py::enum_<MatrixSymmetric>(m, "MatrixSymmetric")
+        .value("GENERAL", MatrixSymmetric::GENERAL)
+        .value("SYMMETRIC_LOWER", MatrixSymmetric::SYMMETRIC_LOWER)
+        .value("SYMMETRIC_UPPER", MatrixSymmetric::SYMMETRIC_UPPER)
+        .value("HERMITIAN_LOWER", MatrixSymmetric::HERMITIAN_LOWER)
+        .value("HERMITIAN_UPPER", MatrixSymmetric::HERMITIAN_UPPER)
+        .value("SKEW_LOWER", MatrixSymmetric::SKEW_LOWER)
+        .value("SKEW_UPPER", MatrixSymmetric::SKEW_UPPER);
+
+    py::class_<ArrayBuffer>(m, "ArrayBuffer", py::buffer_protocol())
+        .def_buffer([](const ArrayBuffer &b) {
+            return py::buffer_info(
+                const_cast<void *>(b.data), b.itemsize, b.format, 1, {b.size}, {b.itemsize}, true);
+        })
+        .def("__len__", [](const ArrayBuffer &b) { return b.size; });
+
+    py::class_<AnyCoo, std::shared_ptr<AnyCoo>>(m, "AnyCoo")
+        .def_property_readonly("shape", &Shape<AnyCoo>)
+        .def_property_readonly("nnz", &AnyCoo::Nnz)
+        .def_property_readonly("stored_nnz", &AnyCoo::StoredNnz)
+        .def_property_readonly("numeric", &AnyCoo::GetValueNumeric)
+        .def_property_readonly("symmetric", &AnyCoo::GetSymmetric)
+        .def_property_readonly(
+            "row",
+            [](const std::shared_ptr<AnyCoo> &self) {
+                return self->Visit([&self](const auto &coo) {
+                    using DimIndex = typename std::decay_t<decltype(coo)>::DimIndexType;
+                    return MakeBuffer<DimIndex>(self, coo.GetRowIndices());
+                });
+            })
+        .def_property_readonly(
+            "col",
+            [](const std::shared_ptr<AnyCoo> &self) {
+                return self->Visit([&self](const auto &coo) {
+                    using DimIndex = typename std::decay_t<decltype(coo)>::DimIndexType;
+                    return MakeBuffer<DimIndex>(self, coo.GetColIndices());
+                });
+            })
+        .def_property_readonly(
+            "data",
+            [](const std::shared_ptr<AnyCoo> &self) {
+                return self->Visit([&self](const auto &coo) { return ValuesBuffer(self, coo); });
+            })
+        .def("to_csr", &AnyCooToCsr);
+
+    py::class_<AnyCsr, std::shared_ptr<AnyCsr>>(m, "AnyCsr")
+        .def_property_readonly("shape", &Shape<AnyCsr>)
+        .def_property_readonly("nnz", &AnyCsr::Nnz)
+        .def_property_readonly("stored_nnz", &AnyCsr::StoredNnz)
+        .def_property_readonly("numeric", &AnyCsr::GetValueNumeric)
+        .def_property_readonly("symmetric", &AnyCsr::GetSymmetric)
+        .def_property_readonly(
+            "indptr",
+            [](const std::shared_ptr<AnyCsr> &self) {
+                return self->Visit([&self](const auto &csr) {
+                    using NnzIndex = typename std::decay_t<decltype(csr)>::NnzIndexType;
+                    return MakeBuffer<NnzIndex>(self, csr.GetRowPtr());
+                });
+            })
+        .def_property_readonly(
+            "indices",
+            [](const std::shared_ptr<AnyCsr> &self) {
+                return self->Visit([&self](const auto &csr) {
+                    using DimIndex = typename std::decay_t<decltype(csr)>::DimIndexType;
+                    return MakeBuffer<DimIndex>(self, csr.GetColIndices());
+                });
+            })
+        .def_property_readonly(
+            "data",
+            [](const std::shared_ptr<AnyCsr> &self) {
+                return self->Visit([&self](const auto &csr) { return ValuesBuffer(self, csr); });
+            })
+        .def("spmv", &AnyCsrSpMV, py::arg("x"));
+
+    m.def("read_matrix_market", &ReadMatrixMarketFile, py::arg("path"));
+    m.def("to_csr", &AnyCooToCsr, py::arg("coo"));
+    m.def("spmv", &AnyCsrSpMV, py::arg("a"), py::arg("x"));
+}
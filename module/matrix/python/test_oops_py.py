@@ -0,0 +1,50 @@
+#! /usr/bin/env python3
+# Python扩展模块冒烟测试：读入Matrix Market文件并转为CSR，SpMV结果与逐元素计算一致；只依赖标准库
+import array
+import os
+import sys
+import tempfile
+
+import oops
+
+MTX = '''%%MatrixMarket matrix coordinate real general
+3 4 5
+1 1 2.0
+1 4 -1.5
+2 2 3.0
+3 1 0.5
+3 3 4.0
+'''
+
+
+def main():
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'a.mtx')
+        with open(path, 'w') as f:
+            f.write(MTX)
+        coo = oops.read_matrix_market(path)
+    assert coo.shape == (3, 4) and coo.stored_nnz == 5
+    assert coo.numeric == oops.MatrixNumeric.REAL and coo.symmetric == oops.MatrixSymmetric.GENERAL
+
+    csr = oops.to_csr(coo)
+    assert memoryview(csr.indptr).tolist() == [0, 2, 3, 5]
+    assert memoryview(csr.indices).tolist() == [0, 3, 1, 0, 2]
+    assert memoryview(csr.data).tolist() == [2.0, -1.5, 3.0, 0.5, 4.0]
+
+    x = array.array('d', [1.0, 2.0, 3.0, 4.0])
+    expected = [2.0 * 1.0 - 1.5 * 4.0, 3.0 * 2.0, 0.5 * 1.0 + 4.0 * 3.0]
+    assert memoryview(oops.spmv(csr, x)).tolist() == expected
+    assert memoryview(csr.spmv(x)).tolist() == expected
+
+    # x的数值类型与长度须与矩阵相符
+    for bad in (array.array('f', [1.0] * 4), array.array('d', [1.0] * 3)):
+        try:
+            oops.spmv(csr, bad)
+        except ValueError:
+            continue
+        raise AssertionError('spmv accepted a mismatched x')
+    print('oops python smoke test passed')
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,469 @@
+#include "oops/matrix_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "oops/convert.h"
+#include "oops/matrix_market_io.h"
+
+namespace oops {
+namespace fs = std::filesystem;
+
+static constexpr char CACHE_MAGIC[8]{'O', 'O', 'P', 'S', 'M', 'C', '0', '1'};
+static constexpr const char *COO_SUFFIX{".coo"};
+static constexpr const char *CSR_SUFFIX{".csr"};
+
+// 条目文件头，其后依次为各数组的原始字节
+struct CacheHeader {
+    char magic[8];
+    std::uint64_t size;
+    std::int64_t mtime_ns;
+    std::uint64_t sample_hash;
+    std::uint8_t format;
+    std::uint8_t value_index; // ValueTypeVar中的下标
+    std::uint8_t index_index; // IndexTypeVar中的下标
+    std::uint8_t symmetric;
+    std::uint8_t reserved[4];
+    std::uint64_t m;
+    std::uint64_t n;
+    std::uint64_t stored_nnz;
+};
+
+static std::uint64_t Fnv1a(std::uint64_t h, const char *data, std::size_t size) {
+    for (std::size_t i{0}; i < size; ++i) {
+        h = (h ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+std::string MatrixFingerprint::Key() const {
+    char buf[64];
+    std::snprintf(
+        buf, sizeof(buf), "%016llx-%016llx-%016llx", static_cast<unsigned long long>(size),
+        static_cast<unsigned long long>(mtime_ns), static_cast<unsigned long long>(sample_hash));
+    return buf;
+}
+
+MatrixFingerprint ComputeMatrixFingerprint(const fs::path &path, const MatrixCacheOptions &options) {
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+    MatrixFingerprint fingerprint;
+    fingerprint.size = fs::file_size(path);
+    fingerprint.mtime_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(fs::last_write_time(path).time_since_epoch()).count();
+
+    // 文件不大于全部采样块时整体哈希，否则取首尾在内的sample_count个等距块
+    const std::size_t block{std::max<std::size_t>(options.sample_block, 1)};
+    const std::size_t count{std::max<std::size_t>(options.sample_count, 1)};
+    std::vector<char> buf;
+    std::uint64_t h{0xcbf29ce484222325ULL};
+    auto hash_range = [&](std::uint64_t offset, std::size_t size) {
+        buf.resize(size);
+        ifs.seekg(static_cast<std::streamoff>(offset));
+        if (!ifs.read(buf.data(), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("failed to read " + path.string());
+        }
+        h = Fnv1a(h, buf.data(), size);
+    };
+    if (fingerprint.size <= block * count) {
+        hash_range(0, fingerprint.size);
+    } else {
+        for (std::size_t i{0}; i < count; ++i) {
+            hash_range(count == 1 ? 0 : i * (fingerprint.size - block) / (count - 1), block);
+        }
+    }
+    fingerprint.sample_hash = h;
+    return fingerprint;
+}
+
+template <typename Var, std::size_t I = 0>
+static std::optional<Var> VariantFromIndex(std::size_t index) {
+    if constexpr (I == std::variant_size_v<Var>) {
+        return std::nullopt;
+    } else {
+        if (index == I) {
+            return Var{std::in_place_index<I>};
+        }
+        return VariantFromIndex<Var, I + 1>(index);
+    }
+}
+
+template <typename T>
+static void WriteArray(std::ofstream &ofs, const T *data, std::size_t count) {
+    if (!ofs.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)))) {
+        throw std::runtime_error("failed to write cache entry");
+    }
+}
+
+template <typename T>
+static bool ReadArray(std::ifstream &ifs, T *data, std::size_t count) {
+    return static_cast<bool>(ifs.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(count * sizeof(T))));
+}
+
+template <typename Matrix>
+static CacheHeader MakeHeader(const MatrixFingerprint &fingerprint, const Matrix &a) {
+    using Value = typename Matrix::ValueType;
+    using DimIndex = typename Matrix::DimIndexType;
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.size = fingerprint.size;
+    header.mtime_ns = fingerprint.mtime_ns;
+    header.sample_hash = fingerprint.sample_hash;
+    header.format = static_cast<std::uint8_t>(Matrix::FORMAT);
+    header.value_index = static_cast<std::uint8_t>(ValueTypeVar{meta::Identity<Value>{}}.index());
+    header.index_index = static_cast<std::uint8_t>(IndexTypeVar{meta::Identity<DimIndex>{}}.index());
+    header.symmetric = static_cast<std::uint8_t>(a.GetSymmetric());
+    header.m = a.M();
+    header.n = a.N();
+    header.stored_nnz = a.StoredNnz();
+    return header;
+}
+
+template <typename Value, typename DimIndex>
+static void WriteBody(std::ofstream &ofs, const Coo<Value, DimIndex> &coo) {
+    const auto &store{coo.GetStore()};
+    WriteArray(ofs, store.row_indices.data(), store.row_indices.size());
+    WriteArray(ofs, store.col_indices.data(), store.col_indices.size());
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        WriteArray(ofs, store.values.data(), store.values.size());
+    }
+}
+
+template <typename Value, typename DimIndex>
+static void WriteBody(std::ofstream &ofs, const Csr<Value, DimIndex> &csr) {
+    WriteArray(ofs, csr.GetRowPtr().data(), csr.GetRowPtr().size());
+    WriteArray(ofs, csr.GetColIndices().data(), csr.GetColIndices().size());
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        WriteArray(ofs, csr.GetValues().data(), csr.GetValues().size());
+    }
+}
+
+// 头部给出的各数组(元素数, 元素字节数)与条目正文的字节数恰好相符，元素字节数为0的数组不存储
+// 先于按头部分配内存检查，避免损坏的头部导致巨量分配
+static bool BodyFits(std::uintmax_t body_bytes, std::initializer_list<std::pair<std::uint64_t, std::size_t>> arrays) {
+    for (const auto &[count, element_size] : arrays) {
+        if (element_size == 0) {
+            continue;
+        }
+        if (count > body_bytes / element_size) {
+            return false;
+        }
+        body_bytes -= count * element_size;
+    }
+    return body_bytes == 0;
+}
+
+template <typename Value, typename DimIndex>
+static std::optional<AnyCoo> ReadCooBody(std::ifstream &ifs, const CacheHeader &header, std::uintmax_t body_bytes) {
+    constexpr std::size_t VALUE_SIZE{std::is_same_v<Value, std::monostate> ? 0 : sizeof(Value)};
+    const std::uint64_t nnz{header.stored_nnz};
+    if (!BodyFits(body_bytes, {{nnz, sizeof(DimIndex)}, {nnz, sizeof(DimIndex)}, {nnz, VALUE_SIZE}})) {
+        return std::nullopt;
+    }
+    CooStore<Value, DimIndex> store;
+    store.m = header.m;
+    store.n = header.n;
+    store.row_indices.resize(nnz);
+    store.col_indices.resize(nnz);
+    if (!ReadArray(ifs, store.row_indices.data(), nnz) || !ReadArray(ifs, store.col_indices.data(), nnz)) {
+        return std::nullopt;
+    }
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        store.values.resize(nnz);
+        if (!ReadArray(ifs, store.values.data(), nnz)) {
+            return std::nullopt;
+        }
+    }
+    return Coo<Value, DimIndex>{std::move(store), static_cast<MatrixSymmetric>(header.symmetric)};
+}
+
+// 行指针自0单调不减至nnz，列号位于[0, n)；不满足时条目视为损坏，避免越界访问
+template <typename RowPtr, typename ColIndices>
+static bool ValidCsrStructure(const RowPtr &row_ptr, const ColIndices &col_indices, std::uint64_t n) {
+    if (row_ptr.front() != 0 || static_cast<std::uint64_t>(row_ptr.back()) != col_indices.size()) {
+        return false;
+    }
+    for (std::size_t r{0}; r + 1 < row_ptr.size(); ++r) {
+        if (row_ptr[r] > row_ptr[r + 1]) {
+            return false;
+        }
+    }
+    return std::all_of(col_indices.begin(), col_indices.end(), [n](auto c) {
+        return c >= 0 && static_cast<std::uint64_t>(c) < n;
+    });
+}
+
+template <typename Value, typename DimIndex>
+static std::optional<AnyCsr> ReadCsrBody(std::ifstream &ifs, const CacheHeader &header, std::uintmax_t body_bytes) {
+    using NnzIndex = typename Csr<Value, DimIndex>::NnzIndexType;
+    constexpr std::size_t VALUE_SIZE{std::is_same_v<Value, std::monostate> ? 0 : sizeof(Value)};
+    const std::uint64_t nnz{header.stored_nnz};
+    // 行指针为m + 1个元素，拆为m与1两段以免m + 1溢出
+    if (!BodyFits(
+            body_bytes,
+            {{header.m, sizeof(NnzIndex)}, {1, sizeof(NnzIndex)}, {nnz, sizeof(DimIndex)}, {nnz, VALUE_SIZE}})) {
+        return std::nullopt;
+    }
+    CsrStore<Value, DimIndex> store;
+    store.n = header.n;
+    store.row_ptr.resize(header.m + 1);
+    store.col_indices.resize(nnz);
+    if (!ReadArray(ifs, store.row_ptr.data(), header.m + 1) || !ReadArray(ifs, store.col_indices.data(), nnz) ||
+        !ValidCsrStructure(store.row_ptr, store.col_indices, header.n)) {
+        return std::nullopt;
+    }
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        store.values.resize(nnz);
+        if (!ReadArray(ifs, store.values.data(), nnz)) {
+            return std::nullopt;
+        }
+    }
+    return Csr<Value, DimIndex>{std::move(store), static_cast<MatrixSymmetric>(header.symmetric)};
+}
+
+// 读取并校验条目，不存在、损坏或与指纹不符时返回空，读取中的任何异常同样视为损坏
+template <typename Any, typename ReadBody>
+static std::optional<Any> LoadEntry(
+    const fs::path &path, const MatrixFingerprint &fingerprint, MatrixFormat format, ReadBody &&read_body) {
+    std::ifstream ifs{path, std::ios::binary};
+    std::error_code ec;
+    const std::uintmax_t file_size{fs::file_size(path, ec)};
+    if (!ifs || ec) {
+        return std::nullopt;
+    }
+    std::optional<Any> any;
+    CacheHeader header;
+    if (file_size >= sizeof(CacheHeader) && ReadArray(ifs, &header, 1) &&
+        std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 && header.size == fingerprint.size &&
+        header.mtime_ns == fingerprint.mtime_ns && header.sample_hash == fingerprint.sample_hash &&
+        header.format == static_cast<std::uint8_t>(format)) {
+        auto value_var{VariantFromIndex<ValueTypeVar>(header.value_index)};
+        auto index_var{VariantFromIndex<IndexTypeVar>(header.index_index)};
+        if (value_var && index_var) {
+            try {
+                any = std::visit(
+                    [&](auto value_type, auto index_type) {
+                        using ValueType = typename decltype(value_type)::Type;
+                        using IndexType = typename decltype(index_type)::Type;
+                        return read_body(
+                            meta::Identity<ValueType>{}, meta::Identity<IndexType>{}, ifs, header,
+                            file_size - sizeof(CacheHeader));
+                    },
+                    *value_var, *index_var);
+            } catch (const std::exception &) {
+                any.reset();
+            }
+        }
+        // 条目须恰好读完
+        if (any && ifs.peek() != std::ifstream::traits_type::eof()) {
+            any.reset();
+        }
+    }
+    ifs.close();
+    if (!any) {
+        fs::remove(path, ec);
+        return std::nullopt;
+    }
+    // 刷新修改时间作为最近使用时间
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    return any;
+}
+
+MatrixCache::MatrixCache(MatrixCacheOptions options) : options_{std::move(options)} {
+    if (options_.dir.empty()) {
+        if (const char *env{std::getenv("OOPS_MATRIX_CACHE_DIR")}; env != nullptr) {
+            options_.dir = env;
+        }
+    }
+}
+
+fs::path MatrixCache::EntryPath(const MatrixFingerprint &fingerprint, const char *suffix) const {
+    return options_.dir / (fingerprint.Key() + suffix);
+}
+
+std::optional<AnyCoo> MatrixCache::LoadCoo(const MatrixFingerprint &fingerprint) const {
+    if (!Enabled()) {
+        return std::nullopt;
+    }
+    return LoadEntry<AnyCoo>(
+        EntryPath(fingerprint, COO_SUFFIX), fingerprint, MatrixFormat::SPARSE_COO,
+        [](auto value_type, auto index_type, std::ifstream &ifs, const CacheHeader &header,
+           std::uintmax_t body_bytes) {
+            using ValueType = typename decltype(value_type)::Type;
+            using IndexType = typename decltype(index_type)::Type;
+            return ReadCooBody<ValueType, IndexType>(ifs, header, body_bytes);
+        });
+}
+
+std::optional<AnyCsr> MatrixCache::LoadCsr(const MatrixFingerprint &fingerprint) const {
+    if (!Enabled()) {
+        return std::nullopt;
+    }
+    return LoadEntry<AnyCsr>(
+        EntryPath(fingerprint, CSR_SUFFIX), fingerprint, MatrixFormat::SPARSE_CSR,
+        [](auto value_type, auto index_type, std::ifstream &ifs, const CacheHeader &header,
+           std::uintmax_t body_bytes) {
+            using ValueType = typename decltype(value_type)::Type;
+            using IndexType = typename decltype(index_type)::Type;
+            return ReadCsrBody<ValueType, IndexType>(ifs, header, body_bytes);
+        });
+}
+
+// 写入同目录下的临时文件后改名，失败时删除临时文件并放弃缓存
+template <typename Any>
+static void StoreEntry(const fs::path &path, const MatrixFingerprint &fingerprint, const Any &any) {
+    static std::atomic<std::size_t> counter{0};
+    fs::path tmp{path};
+    tmp += ".tmp" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    std::error_code ec;
+    try {
+        fs::create_directories(path.parent_path());
+        {
+            std::ofstream ofs{tmp, std::ios::binary | std::ios::trunc};
+            if (!ofs) {
+                return;
+            }
+            any.Visit([&](const auto &a) {
+                const CacheHeader header{MakeHeader(fingerprint, a)};
+                WriteArray(ofs, &header, 1);
+                WriteBody(ofs, a);
+            });
+        }
+        fs::rename(tmp, path);
+    } catch (const std::exception &) {
+        fs::remove(tmp, ec);
+    }
+}
+
+void MatrixCache::StoreCoo(const MatrixFingerprint &fingerprint, const AnyCoo &coo) const {
+    if (!Enabled()) {
+        return;
+    }
+    StoreEntry(EntryPath(fingerprint, COO_SUFFIX), fingerprint, coo);
+    Evict();
+}
+
+void MatrixCache::StoreCsr(const MatrixFingerprint &fingerprint, const AnyCsr &csr) const {
+    if (!Enabled()) {
+        return;
+    }
+    StoreEntry(EntryPath(fingerprint, CSR_SUFFIX), fingerprint, csr);
+    Evict();
+}
+
+struct CacheEntryInfo {
+    fs::path path;
+    std::uintmax_t size;
+    fs::file_time_type time;
+};
+
+// 列出缓存条目，忽略临时文件与其他文件
+static std::vector<CacheEntryInfo> ListEntries(const fs::path &dir) {
+    std::vector<CacheEntryInfo> entries;
+    std::error_code ec;
+    for (fs::directory_iterator it{dir, ec}, end; !ec && it != end; it.increment(ec)) {
+        const fs::path &path{it->path()};
+        if (path.extension() != COO_SUFFIX && path.extension() != CSR_SUFFIX) {
+            continue;
+        }
+        std::error_code entry_ec;
+        const auto size{fs::file_size(path, entry_ec)};
+        const auto time{fs::last_write_time(path, entry_ec)};
+        if (!entry_ec) {
+            entries.push_back({path, size, time});
+        }
+    }
+    return entries;
+}
+
+std::size_t MatrixCache::TotalBytes() const {
+    std::size_t total{0};
+    if (Enabled()) {
+        for (const auto &entry : ListEntries(options_.dir)) {
+            total += entry.size;
+        }
+    }
+    return total;
+}
+
+void MatrixCache::Evict() const {
+    if (!Enabled()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto entries{ListEntries(options_.dir)};
+    std::size_t total{0};
+    for (const auto &entry : entries) {
+        total += entry.size;
+    }
+    std::sort(entries.begin(), entries.end(), [](const CacheEntryInfo &lhs, const CacheEntryInfo &rhs) {
+        return lhs.time < rhs.time || (lhs.time == rhs.time && lhs.path < rhs.path);
+    });
+    for (const auto &entry : entries) {
+        if (total <= options_.size_limit) {
+            break;
+        }
+        std::error_code ec;
+        fs::remove(entry.path, ec);
+        total -= entry.size;
+    }
+}
+
+// 整体读入后并行解析
+static AnyCoo ReadMatrixMarketFile(const fs::path &path) {
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+    std::string text(fs::file_size(path), '\0');
+    if (!ifs.read(text.data(), static_cast<std::streamsize>(text.size()))) {
+        throw std::runtime_error("failed to read " + path.string());
+    }
+    return ParseMatrixMarket(text);
+}
+
+AnyCoo ReadMatrixMarket(const fs::path &path, const MatrixCacheOptions &options) {
+    const MatrixCache cache{options};
+    if (!cache.Enabled()) {
+        return ReadMatrixMarketFile(path);
+    }
+    const MatrixFingerprint fingerprint{ComputeMatrixFingerprint(path, cache.GetOptions())};
+    if (auto coo{cache.LoadCoo(fingerprint)}) {
+        return std::move(*coo);
+    }
+    AnyCoo coo{ReadMatrixMarketFile(path)};
+    // 读取期间源文件被修改时不写入，避免以旧指纹缓存新内容
+    if (ComputeMatrixFingerprint(path, cache.GetOptions()) == fingerprint) {
+        cache.StoreCoo(fingerprint, coo);
+    }
+    return coo;
+}
+
+AnyCsr ReadMatrixMarketCsr(const fs::path &path, const MatrixCacheOptions &options) {
+    const MatrixCache cache{options};
+    if (!cache.Enabled()) {
+        return ToCsr(ReadMatrixMarket(path, options));
+    }
+    const MatrixFingerprint fingerprint{ComputeMatrixFingerprint(path, cache.GetOptions())};
+    if (auto csr{cache.LoadCsr(fingerprint)}) {
+        return std::move(*csr);
+    }
+    AnyCsr csr{ToCsr(ReadMatrixMarket(path, options))};
+    if (ComputeMatrixFingerprint(path, cache.GetOptions()) == fingerprint) {
+        cache.StoreCsr(fingerprint, csr);
+    }
+    return csr;
+}
+} // namespace oops
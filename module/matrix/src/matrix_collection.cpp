@@ -0,0 +1,110 @@
+#include "oops/matrix_collection.h"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <stdexcept>
+
+#include "glob/glob.hpp"
+#include "oops/matrix_market_io.h"
+
+namespace oops {
+namespace fs = std::filesystem;
+
+std::vector<fs::path> ListMatrixCollection(const std::string &dir_or_pattern) {
+    std::vector<fs::path> paths;
+    if (fs::is_directory(dir_or_pattern)) {
+        for (const auto &entry : fs::directory_iterator{dir_or_pattern}) {
+            if (entry.is_regular_file() && entry.path().extension() == ".mtx") {
+                paths.push_back(entry.path());
+            }
+        }
+    } else {
+        for (const auto &path : glob::rglob(dir_or_pattern)) {
+            if (fs::is_regular_file(path)) {
+                paths.push_back(path);
+            }
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    return paths;
+}
+
+// 已提交但未交付的文件
+struct PendingFile {
+    std::size_t index;
+    std::size_t bytes;
+    std::future<AnyCoo> future;
+};
+
+// 异常退出时等待已提交的任务结束，任务不再引用调用栈后才可返回
+class PendingGuard {
+public:
+    explicit PendingGuard(std::deque<PendingFile> &pending) : pending_{pending} {}
+    ~PendingGuard() {
+        for (auto &file : pending_) {
+            file.future.wait();
+        }
+    }
+
+    PendingGuard(const PendingGuard &) = delete;
+    PendingGuard &operator=(const PendingGuard &) = delete;
+
+private:
+    std::deque<PendingFile> &pending_;
+};
+
+static AnyCoo ReadCollectionFile(const fs::path &path, const MatrixCacheOptions &options) {
+    try {
+        return ReadMatrixMarket(path, options);
+    } catch (const std::exception &e) {
+        throw std::runtime_error(path.string() + ": " + e.what());
+    }
+}
+
+void LoadMatrixCollection(
+    const std::vector<fs::path> &paths, CollectionCallback callback, CollectionLoadOptions options) {
+    ThreadPool &pool{ThreadPool::Get()};
+    const std::size_t max_files{options.max_files_in_flight == 0 ? 2 * pool.Size() : options.max_files_in_flight};
+    std::deque<PendingFile> pending;
+    PendingGuard guard{pending};
+    std::size_t bytes_in_flight{0};
+
+    auto deliver_front = [&] {
+        PendingFile file{std::move(pending.front())};
+        pending.pop_front();
+        bytes_in_flight -= file.bytes;
+        callback(file.index, paths[file.index], file.future.get());
+    };
+
+    for (std::size_t i{0}; i < paths.size(); ++i) {
+        std::error_code ec;
+        const std::size_t bytes{static_cast<std::size_t>(fs::file_size(paths[i], ec))};
+        if (!ec && bytes >= options.large_file_bytes) {
+            while (!pending.empty()) {
+                deliver_front();
+            }
+            callback(i, paths[i], ReadCollectionFile(paths[i], options.cache));
+            continue;
+        }
+        const std::size_t file_bytes{ec ? 0 : bytes};
+        while (!pending.empty() &&
+               (pending.size() >= max_files || bytes_in_flight + file_bytes > options.max_bytes_in_flight)) {
+            deliver_front();
+        }
+        pending.push_back(
+            {i, file_bytes,
+             pool.Submit([path = paths[i], cache = options.cache] { return ReadCollectionFile(path, cache); })});
+        bytes_in_flight += file_bytes;
+    }
+    while (!pending.empty()) {
+        deliver_front();
+    }
+}
+
+void LoadMatrixCollection(
+    const std::string &dir_or_pattern, CollectionCallback callback, CollectionLoadOptions options) {
+    LoadMatrixCollection(ListMatrixCollection(dir_or_pattern), callback, std::move(options));
+}
+} // namespace oops
@@ -0,0 +1,335 @@
+#include "oops/matrix_market_external.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <unistd.h>
+
+#include "oops/thread_pool.h"
+
+namespace oops {
+namespace fs = std::filesystem;
+
+// 单趟归并中每路读缓冲的最小字节数，决定归并路数上限
+static constexpr std::size_t MERGE_BLOCK_BYTES{std::size_t{64} << 10};
+
+template <typename Value, typename DimIndex>
+struct ExternalEntry {
+    DimIndex row;
+    DimIndex col;
+    Value value;
+};
+
+template <typename DimIndex>
+struct ExternalEntry<std::monostate, DimIndex> {
+    DimIndex row;
+    DimIndex col;
+};
+
+template <typename Entry>
+static bool RowColLess(const Entry &lhs, const Entry &rhs) {
+    return lhs.row < rhs.row || (lhs.row == rhs.row && lhs.col < rhs.col);
+}
+
+template <typename Value, typename DimIndex>
+static void ReadEntry(std::istream &is, std::size_t m, std::size_t n, ExternalEntry<Value, DimIndex> &entry) {
+    std::int64_t row, col;
+    if constexpr (std::is_same_v<Value, std::monostate>) {
+        if (!(is >> row >> col)) {
+            throw std::runtime_error("failed to read pattern entry");
+        }
+    } else if constexpr (IS_COMPLEX<Value>) {
+        typename Value::value_type real, imag;
+        if (!(is >> row >> col >> real >> imag)) {
+            throw std::runtime_error("failed to read complex entry");
+        }
+        entry.value = {real, imag};
+    } else {
+        if (!(is >> row >> col >> entry.value)) {
+            throw std::runtime_error("failed to read floating point or integral entry");
+        }
+    }
+    // 行号越界会破坏流式写出的行指针，须在读入时检查
+    if (row < 1 || static_cast<std::size_t>(row) > m || col < 1 || static_cast<std::size_t>(col) > n) {
+        throw std::runtime_error("entry index out of range");
+    }
+    entry.row = static_cast<DimIndex>(row - 1);
+    entry.col = static_cast<DimIndex>(col - 1);
+}
+
+template <typename T>
+static void WriteRawArray(std::ofstream &ofs, const T *data, std::size_t count) {
+    if (!ofs.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)))) {
+        throw std::runtime_error("failed to write external csr file");
+    }
+}
+
+static std::ofstream OpenOutput(const fs::path &path) {
+    std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+    if (!ofs) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+    return ofs;
+}
+
+// 进程内唯一的临时目录，析构时删除
+class TempDir {
+public:
+    explicit TempDir(const fs::path &base) {
+        static std::atomic<std::size_t> counter{0};
+        const fs::path root{base.empty() ? fs::temp_directory_path() : base};
+        do {
+            path_ = root / ("oops_mtx_" + std::to_string(getpid()) + "_" + std::to_string(counter++));
+        } while (!fs::create_directory(path_));
+    }
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    TempDir(const TempDir &) = delete;
+    TempDir &operator=(const TempDir &) = delete;
+
+    const fs::path &Path() const { return path_; }
+
+private:
+    fs::path path_;
+};
+
+// 有序段的分块顺序读取
+template <typename Entry>
+class RunReader {
+public:
+    RunReader(const fs::path &path, std::size_t block_entries) : ifs_{path, std::ios::binary}, block_(block_entries) {
+        if (!ifs_) {
+            throw std::runtime_error("failed to open " + path.string());
+        }
+    }
+
+    // 读取下一个元素，段已读完时返回false
+    bool Next(Entry &entry) {
+        if (pos_ == size_) {
+            const auto bytes{static_cast<std::streamsize>(block_.size() * sizeof(Entry))};
+            ifs_.read(reinterpret_cast<char *>(block_.data()), bytes);
+            if (ifs_.bad() || ifs_.gcount() % sizeof(Entry) != 0) {
+                throw std::runtime_error("corrupted run file");
+            }
+            size_ = static_cast<std::size_t>(ifs_.gcount()) / sizeof(Entry);
+            pos_ = 0;
+            if (size_ == 0) {
+                return false;
+            }
+        }
+        entry = block_[pos_++];
+        return true;
+    }
+
+private:
+    std::ifstream ifs_;
+    std::vector<Entry> block_;
+    std::size_t pos_{0};
+    std::size_t size_{0};
+};
+
+// k路归并，键相同时段号小者优先，各段内部稳定排序，因此全局保持文件中的相对顺序
+template <typename Entry, typename Sink>
+static void MergeRuns(const std::vector<fs::path> &runs, std::size_t block_entries, Sink &&sink) {
+    std::vector<RunReader<Entry>> readers;
+    readers.reserve(runs.size());
+    std::vector<std::pair<Entry, std::size_t>> heap;
+    heap.reserve(runs.size());
+    for (std::size_t k{0}; k < runs.size(); ++k) {
+        readers.emplace_back(runs[k], block_entries);
+        Entry entry;
+        if (readers[k].Next(entry)) {
+            heap.emplace_back(entry, k);
+        }
+    }
+    auto greater = [](const std::pair<Entry, std::size_t> &lhs, const std::pair<Entry, std::size_t> &rhs) {
+        return RowColLess(rhs.first, lhs.first) || (!RowColLess(lhs.first, rhs.first) && lhs.second > rhs.second);
+    };
+    std::make_heap(heap.begin(), heap.end(), greater);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        auto &[entry, k]{heap.back()};
+        sink(entry);
+        if (readers[k].Next(entry)) {
+            std::push_heap(heap.begin(), heap.end(), greater);
+        } else {
+            heap.pop_back();
+        }
+    }
+}
+
+// 分块缓冲的顺序写出
+template <typename T>
+class BlockWriter {
+public:
+    BlockWriter(const fs::path &path, std::size_t block_entries) : ofs_{OpenOutput(path)} {
+        block_.reserve(block_entries);
+    }
+
+    void Push(const T &v) {
+        block_.push_back(v);
+        if (block_.size() == block_.capacity()) {
+            Flush();
+        }
+    }
+
+    void Flush() {
+        WriteRawArray(ofs_, block_.data(), block_.size());
+        block_.clear();
+    }
+
+private:
+    std::ofstream ofs_;
+    std::vector<T> block_;
+};
+
+template <typename Value, typename DimIndex>
+static ExternalCsr ConvertImpl(
+    std::istream &is, const MatrixMarketHeader &header, const fs::path &prefix, const ExternalCsrOptions &options) {
+    using Entry = ExternalEntry<Value, DimIndex>;
+    constexpr bool has_values{!std::is_same_v<Value, std::monostate>};
+    // 读入缓冲、排序缓冲与稳定排序的临时空间各占预算三分之一
+    const std::size_t run_entries{options.memory_budget / (3 * sizeof(Entry))};
+    if (run_entries == 0) {
+        throw std::invalid_argument("memory budget too small");
+    }
+
+    ExternalCsr external{
+        meta::Identity<Value>{},
+        meta::Identity<DimIndex>{},
+        header.symmetric,
+        header.m,
+        header.n,
+        header.stored_nnz,
+        0,
+        0,
+        prefix.string() + ".row_ptr",
+        prefix.string() + ".col_indices",
+        has_values ? fs::path{prefix.string() + ".values"} : fs::path{}};
+    TempDir temp_dir{options.temp_dir};
+
+    // 1. 读取并溢出有序段，两个缓冲区交替读入与排序
+    std::vector<fs::path> runs;
+    {
+        std::array<std::vector<Entry>, 2> buffers;
+        std::future<void> pending;
+        // 异常退出时须等待排序任务结束，之后才能释放其引用的缓冲区
+        struct PendingGuard {
+            std::future<void> &pending;
+            ~PendingGuard() {
+                if (pending.valid()) {
+                    pending.wait();
+                }
+            }
+        } guard{pending};
+
+        std::size_t current{0};
+        buffers[current].reserve(std::min(run_entries, header.stored_nnz));
+        Entry entry;
+        for (std::size_t i{0}; i < header.stored_nnz; ++i) {
+            ReadEntry(is, header.m, header.n, entry);
+            buffers[current].push_back(entry);
+            if (buffers[current].size() < run_entries && i + 1 < header.stored_nnz) {
+                continue;
+            }
+            if (pending.valid()) {
+                pending.get();
+            }
+            runs.push_back(temp_dir.Path() / ("run_" + std::to_string(runs.size())));
+            pending = ThreadPool::Get().Submit([&buffer = buffers[current], path = runs.back()] {
+                std::stable_sort(buffer.begin(), buffer.end(), RowColLess<Entry>);
+                auto ofs{OpenOutput(path)};
+                WriteRawArray(ofs, buffer.data(), buffer.size());
+            });
+            current ^= 1;
+            buffers[current].clear();
+            buffers[current].reserve(std::min(run_entries, header.stored_nnz - i - 1));
+        }
+        if (pending.valid()) {
+            pending.get();
+        }
+    }
+    external.num_runs = runs.size();
+
+    // 2. 段数超过归并路数时，相邻段成组归并为新段，保持段间顺序
+    const std::size_t max_fan_in{std::max<std::size_t>(options.memory_budget / MERGE_BLOCK_BYTES, 3) - 1};
+    auto block_entries = [&options](std::size_t fan_in, std::size_t entry_bytes) {
+        return std::max<std::size_t>(options.memory_budget / ((fan_in + 1) * entry_bytes), 1);
+    };
+    while (runs.size() > max_fan_in) {
+        std::vector<fs::path> merged;
+        for (std::size_t begin{0}; begin < runs.size(); begin += max_fan_in) {
+            const std::vector<fs::path> group(
+                runs.begin() + begin, runs.begin() + std::min(begin + max_fan_in, runs.size()));
+            merged.push_back(temp_dir.Path() / ("pass_" + std::to_string(external.merge_passes) + "_" +
+                                                std::to_string(merged.size())));
+            const std::size_t block{block_entries(group.size(), sizeof(Entry))};
+            BlockWriter<Entry> writer{merged.back(), block};
+            MergeRuns<Entry>(group, block, [&writer](const Entry &entry) { writer.Push(entry); });
+            writer.Flush();
+            for (const auto &path : group) {
+                fs::remove(path);
+            }
+        }
+        runs = std::move(merged);
+        ++external.merge_passes;
+    }
+
+    // 3. 最终归并，流式写出行指针、列索引与值
+    const std::size_t block{block_entries(runs.size(), sizeof(Entry) + sizeof(int64_t))};
+    BlockWriter<int64_t> row_ptr{external.row_ptr_path, block};
+    BlockWriter<DimIndex> col_indices{external.col_indices_path, block};
+    std::optional<BlockWriter<Value>> values;
+    if constexpr (has_values) {
+        values.emplace(external.values_path, block);
+    }
+    std::int64_t count{0};
+    std::size_t emitted{1}; // 已写出的行指针个数
+    row_ptr.Push(0);
+    MergeRuns<Entry>(runs, block, [&](const Entry &entry) {
+        for (; emitted <= static_cast<std::size_t>(entry.row); ++emitted) {
+            row_ptr.Push(count);
+        }
+        col_indices.Push(entry.col);
+        if constexpr (has_values) {
+            values->Push(entry.value);
+        }
+        ++count;
+    });
+    for (; emitted <= header.m; ++emitted) {
+        row_ptr.Push(count);
+    }
+    row_ptr.Flush();
+    col_indices.Flush();
+    if constexpr (has_values) {
+        values->Flush();
+    }
+    ++external.merge_passes;
+    return external;
+}
+
+ExternalCsr ConvertMatrixMarketToCsr(std::istream &is, const fs::path &prefix, ExternalCsrOptions options) {
+    const MatrixMarketHeader header{ReadMatrixMarketHeader(is)};
+    IndexTypeVar index_var;
+    if (std::max(header.m, header.n) <= static_cast<std::size_t>(std::numeric_limits<int32_t>::max())) {
+        index_var = meta::Identity<int32_t>{};
+    } else {
+        index_var = meta::Identity<int64_t>{};
+    }
+    return std::visit(
+        [&](auto value_type, auto index_type) {
+            using ValueType = typename decltype(value_type)::Type;
+            using IndexType = typename decltype(index_type)::Type;
+            return ConvertImpl<ValueType, IndexType>(is, header, prefix, options);
+        },
+        header.value_var, index_var);
+}
+} // namespace oops
@@ -1,9 +1,35 @@
 #include "oops/matrix_market_io.h"
 #include "oops/enum_bitset.h" // for ToUnderlying
 
+#include <charconv>
+#include <cstring>
+
 #include "oops/str.h"
+#include "oops/thread_pool.h"
 
 namespace oops {
+// 并行解析文本时每块的最小字节数
+static constexpr std::size_t PARSE_CHUNK_BYTES{std::size_t{1} << 20};
+
+template <typename Value>
+static const char *EntryErrorMessage() {
+    if constexpr (std::is_same_v<Value, std::monostate>) {
+        return "failed to read pattern entry";
+    } else if constexpr (IS_COMPLEX<Value>) {
+        return "failed to read complex entry";
+    } else {
+        return "failed to read floating point or integral entry";
+    }
+}
+
+// 行数不超过int32_t范围时使用int32_t索引
+static IndexTypeVar DimIndexVar(std::size_t m) {
+    if (m <= std::numeric_limits<int32_t>::max()) {
+        return meta::Identity<int32_t>{};
+    }
+    return meta::Identity<int64_t>{};
+}
+
 template <typename Value, typename DimIndex>
 static auto ReadMatrixMarketStore(std::istream &is, std::size_t m, std::size_t n, std::size_t stored_nnz) {
     CooStore<Value, DimIndex> store;
@@ -16,7 +42,7 @@ static auto ReadMatrixMarketStore(std::istream &is, std::size_t m, std::size_t n
     if constexpr (std::is_same_v<Value, std::monostate>) {
         for (std::size_t i{0}; i < stored_nnz; ++i) {
             if (!(is >> row_index >> col_index)) {
-                throw std::runtime_error("failed to read pattern entry");
+                throw std::runtime_error(EntryErrorMessage<Value>());
             }
             store.row_indices.push_back(row_index - 1);
             store.col_indices.push_back(col_index - 1);
@@ -26,7 +52,7 @@ static auto ReadMatrixMarketStore(std::istream &is, std::size_t m, std::size_t n
         store.values.reserve(stored_nnz);
         for (std::size_t i{0}; i < stored_nnz; ++i) {
             if (!(is >> row_index >> col_index >> real >> imag)) {
-                throw std::runtime_error("failed to read complex entry");
+                throw std::runtime_error(EntryErrorMessage<Value>());
             }
             store.row_indices.push_back(row_index - 1);
             store.col_indices.push_back(col_index - 1);
@@ -37,7 +63,7 @@ static auto ReadMatrixMarketStore(std::istream &is, std::size_t m, std::size_t n
         store.values.reserve(stored_nnz);
         for (std::size_t i{0}; i < stored_nnz; ++i) {
             if (!(is >> row_index >> col_index >> v)) {
-                throw std::runtime_error("failed to read floating point or integral entry");
+                throw std::runtime_error(EntryErrorMessage<Value>());
             }
             store.row_indices.push_back(row_index - 1);
             store.col_indices.push_back(col_index - 1);
@@ -47,7 +73,7 @@ static auto ReadMatrixMarketStore(std::istream &is, std::size_t m, std::size_t n
     return store;
 }
 
-AnyCoo ReadMatrixMarket(std::istream &is) {
+MatrixMarketHeader ReadMatrixMarketHeader(std::istream &is) {
     std::string buf;
     if (!std::getline(is, buf)) {
         throw std::runtime_error("bad istream");
@@ -110,15 +136,13 @@ AnyCoo ReadMatrixMarket(std::istream &is) {
     if (!(std::istringstream(buf) >> m >> n >> stored_nnz)) {
         throw std::runtime_error("bad matrix dimensions");
     }
-    std::cout << "m: " << m << " n: " << n << " stored_nnz: " << stored_nnz << std::endl;
-
-    IndexTypeVar index_var;
-    if (m <= std::numeric_limits<int32_t>::max()) {
-        index_var = meta::Identity<int32_t>{};
-    } else {
-        index_var = meta::Identity<int64_t>{};
-    }
+    return {value_var, symmetric, m, n, stored_nnz};
+}
 
+AnyCoo ReadMatrixMarket(std::istream &is) {
+    const MatrixMarketHeader header{ReadMatrixMarketHeader(is)};
+    const std::size_t m{header.m}, n{header.n}, stored_nnz{header.stored_nnz};
+    const MatrixSymmetric symmetric{header.symmetric};
     return std::visit(
         [&is, m, n, stored_nnz, symmetric](auto value_type, auto index_type) -> AnyCoo {
             using ValueType = typename decltype(value_type)::Type;
@@ -126,7 +150,154 @@ AnyCoo ReadMatrixMarket(std::istream &is) {
             return Coo<ValueType, IndexType>{
                 ReadMatrixMarketStore<ValueType, IndexType>(is, m, n, stored_nnz), symmetric};
         },
-        value_var, index_var);
+        header.value_var, DimIndexVar(m));
+}
+
+static bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// 跳过空白后解析一个数，from_chars不接受前导正号，须先跳过
+template <typename T>
+static bool ParseNumber(const char *&p, const char *end, T &value) {
+    while (p != end && IsBlank(*p)) {
+        ++p;
+    }
+    if (p != end && *p == '+') {
+        ++p;
+    }
+    auto [ptr, ec]{std::from_chars(p, end, value)};
+    if (ec != std::errc{}) {
+        return false;
+    }
+    p = ptr;
+    return true;
+}
+
+template <typename Value, typename DimIndex>
+struct ParsedChunk {
+    std::vector<DimIndex> row_indices;
+    std::vector<DimIndex> col_indices;
+    std::vector<Value> values;
+    bool failed{false}; // 遇到无法解析的行，其后的行未解析
+};
+
+// 解析[p, end)内的完整行，每个非空行一个元素，行尾多余内容忽略
+// 无法解析的行只在位于前stored_nnz个元素内时报错，由调用方判断，此处记录后停止
+template <typename Value, typename DimIndex>
+static void ParseLines(const char *p, const char *end, ParsedChunk<Value, DimIndex> &chunk) {
+    while (p != end) {
+        const char *eol{static_cast<const char *>(std::memchr(p, '\n', end - p))};
+        if (eol == nullptr) {
+            eol = end;
+        }
+        const char *q{p};
+        while (q != eol && IsBlank(*q)) {
+            ++q;
+        }
+        if (q != eol) {
+            DimIndex row_index, col_index;
+            bool ok{ParseNumber(q, eol, row_index) && ParseNumber(q, eol, col_index)};
+            if constexpr (IS_COMPLEX<Value>) {
+                typename Value::value_type real, imag;
+                ok = ok && ParseNumber(q, eol, real) && ParseNumber(q, eol, imag);
+                if (ok) {
+                    chunk.values.emplace_back(real, imag);
+                }
+            } else if constexpr (!std::is_same_v<Value, std::monostate>) {
+                Value v;
+                ok = ok && ParseNumber(q, eol, v);
+                if (ok) {
+                    chunk.values.push_back(v);
+                }
+            }
+            if (!ok) {
+                chunk.failed = true;
+                return;
+            }
+            chunk.row_indices.push_back(row_index - 1);
+            chunk.col_indices.push_back(col_index - 1);
+        }
+        p = eol == end ? end : eol + 1;
+    }
+}
+
+template <typename Value, typename DimIndex>
+static auto ParseMatrixMarketStore(std::string_view body, std::size_t m, std::size_t n, std::size_t stored_nnz) {
+    const std::size_t num_chunks{
+        std::clamp<std::size_t>(body.size() / PARSE_CHUNK_BYTES, 1, ThreadPool::Get().Size() * 4)};
+    // 行首位于[begin, end)的行归属该块
+    auto align = [&body](std::size_t pos) {
+        if (pos == 0 || pos >= body.size() || body[pos - 1] == '\n') {
+            return std::min(pos, body.size());
+        }
+        const std::size_t eol{body.find('\n', pos)};
+        return eol == std::string_view::npos ? body.size() : eol + 1;
+    };
+    std::vector<ParsedChunk<Value, DimIndex>> chunks(num_chunks);
+    ParallelChunks(body.size(), num_chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        ParseLines(body.data() + align(begin), body.data() + align(end), chunks[chunk]);
+    });
+
+    // 按块顺序拼接，与流式读取一样只读取前stored_nnz个元素，其后的行(含无法解析的行)忽略
+    std::vector<std::size_t> offsets(num_chunks + 1, 0);
+    for (std::size_t c{0}; c < num_chunks; ++c) {
+        offsets[c + 1] = offsets[c] + chunks[c].row_indices.size();
+        if (chunks[c].failed) {
+            if (offsets[c + 1] < stored_nnz) {
+                throw std::runtime_error(EntryErrorMessage<Value>());
+            }
+            std::fill(offsets.begin() + c + 2, offsets.end(), offsets[c + 1]);
+            break;
+        }
+    }
+    if (offsets[num_chunks] < stored_nnz) {
+        throw std::runtime_error(EntryErrorMessage<Value>());
+    }
+    CooStore<Value, DimIndex> store;
+    store.m = m;
+    store.n = n;
+    store.row_indices.resize(stored_nnz);
+    store.col_indices.resize(stored_nnz);
+    if constexpr (!std::is_same_v<Value, std::monostate>) {
+        store.values.resize(stored_nnz);
+    }
+    ThreadPool::Get().Run(num_chunks, [&](std::size_t c) {
+        const std::size_t begin{std::min(offsets[c], stored_nnz)};
+        const std::size_t count{std::min(offsets[c + 1], stored_nnz) - begin};
+        std::copy_n(chunks[c].row_indices.begin(), count, store.row_indices.begin() + begin);
+        std::copy_n(chunks[c].col_indices.begin(), count, store.col_indices.begin() + begin);
+        if constexpr (!std::is_same_v<Value, std::monostate>) {
+            std::copy_n(chunks[c].values.begin(), count, store.values.begin() + begin);
+        }
+        chunks[c] = {};
+    });
+    return store;
+}
+
+AnyCoo ParseMatrixMarket(std::string_view text) {
+    // 头部行、注释与空行之后的首个其他行为尺寸行，其后为元素
+    std::size_t body_begin{0};
+    for (bool first{true}; body_begin < text.size(); first = false) {
+        const std::size_t eol{text.find('\n', body_begin)};
+        const std::size_t line_end{eol == std::string_view::npos ? text.size() : eol};
+        const bool skip{first || line_end == body_begin || text[body_begin] == '%'};
+        body_begin = eol == std::string_view::npos ? text.size() : eol + 1;
+        if (!skip) {
+            break;
+        }
+    }
+    std::istringstream header_is{std::string{text.substr(0, body_begin)}};
+    const MatrixMarketHeader header{ReadMatrixMarketHeader(header_is)};
+    const std::size_t m{header.m}, n{header.n}, stored_nnz{header.stored_nnz};
+    const MatrixSymmetric symmetric{header.symmetric};
+    const std::string_view body{text.substr(body_begin)};
+    return std::visit(
+        [body, m, n, stored_nnz, symmetric](auto value_type, auto index_type) -> AnyCoo {
+            using ValueType = typename decltype(value_type)::Type;
+            using IndexType = typename decltype(index_type)::Type;
+            return Coo<ValueType, IndexType>{
+                ParseMatrixMarketStore<ValueType, IndexType>(body, m, n, stored_nnz), symmetric};
+        },
+        header.value_var, DimIndexVar(m));
 }
 
 template <typename Value, typename DimIndex>
@@ -0,0 +1,200 @@
+#include "oops/shared_matrix.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "oops/allocator.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// "OOPSMTX"与布局版本号
+static constexpr std::uint64_t SHARED_MATRIX_MAGIC{0x4f4f50534d545801ULL};
+static_assert(sizeof(SharedMatrixHeader) <= SharedMatrix::HEADER_BYTES);
+
+static std::system_error SystemError(const std::string &what) {
+    return std::system_error{errno, std::generic_category(), what};
+}
+
+static void *Map(int fd, std::size_t bytes, int prot) {
+    void *p{mmap(nullptr, bytes, prot, MAP_SHARED, fd, 0)};
+    if (p == MAP_FAILED) {
+        throw SystemError("mmap shared matrix");
+    }
+    return p;
+}
+
+// 段长度不小于头部且不超过文件长度，各数组按缓存行对齐且完整位于段内
+static bool ValidLayout(const SharedMatrixInfo &info, std::size_t file_bytes) {
+    if (info.bytes < SharedMatrix::HEADER_BYTES || info.bytes > file_bytes) {
+        return false;
+    }
+    for (std::size_t i{0}; i < info.counts.size(); ++i) {
+        if (info.item_sizes[i] == 0 || info.offsets[i] < SharedMatrix::HEADER_BYTES ||
+            info.offsets[i] % CACHE_LINE_SIZE != 0 || info.offsets[i] > info.bytes ||
+            info.counts[i] > (info.bytes - info.offsets[i]) / info.item_sizes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SharedMatrix::SharedMatrix(SharedMatrix &&rhs) noexcept
+    : name_{std::move(rhs.name_)}, fd_{rhs.fd_}, header_{rhs.header_}, data_{rhs.data_} {
+    rhs.fd_ = -1;
+    rhs.header_ = nullptr;
+    rhs.data_ = nullptr;
+}
+
+SharedMatrix &SharedMatrix::operator=(SharedMatrix &&rhs) noexcept {
+    if (this != &rhs) {
+        Detach();
+        name_ = std::move(rhs.name_);
+        fd_ = rhs.fd_;
+        header_ = rhs.header_;
+        data_ = rhs.data_;
+        rhs.fd_ = -1;
+        rhs.header_ = nullptr;
+        rhs.data_ = nullptr;
+    }
+    return *this;
+}
+
+SharedMatrix SharedMatrix::Create(const std::string &name, SharedMatrixInfo info) {
+    std::uint64_t offset{HEADER_BYTES};
+    for (std::size_t i{0}; i < info.counts.size(); ++i) {
+        offset = (offset + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+        info.offsets[i] = offset;
+        offset += info.counts[i] * info.item_sizes[i];
+    }
+    info.bytes = offset;
+
+    SharedMatrix shared;
+    shared.name_ = name;
+    if (name.empty()) {
+        shared.fd_ = memfd_create("oops_shared_matrix", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    } else {
+        shared.fd_ = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (shared.fd_ < 0) {
+        throw SystemError(name.empty() ? "memfd_create" : "shm_open " + name);
+    }
+    void *header{nullptr};
+    try {
+        if (ftruncate(shared.fd_, static_cast<off_t>(info.bytes)) != 0) {
+            throw SystemError("ftruncate shared matrix");
+        }
+        header = Map(shared.fd_, HEADER_BYTES, PROT_READ | PROT_WRITE);
+    } catch (...) {
+        if (!name.empty()) {
+            shm_unlink(name.c_str());
+        }
+        throw;
+    }
+    // 此后异常由析构归还引用并删除段
+    shared.header_ = new (header) SharedMatrixHeader{{0}, {1}, info};
+    shared.data_ = static_cast<std::byte *>(Map(shared.fd_, info.bytes, PROT_READ | PROT_WRITE));
+    return shared;
+}
+
+SharedMatrix SharedMatrix::Attach(const std::string &name) {
+    const int fd{shm_open(name.c_str(), O_RDWR, 0)};
+    if (fd < 0) {
+        throw SystemError("shm_open " + name);
+    }
+    return AttachFd(fd, name);
+}
+
+SharedMatrix SharedMatrix::Attach(int fd) {
+    const int dup_fd{fcntl(fd, F_DUPFD_CLOEXEC, 0)};
+    if (dup_fd < 0) {
+        throw SystemError("dup shared matrix fd");
+    }
+    return AttachFd(dup_fd, {});
+}
+
+SharedMatrix SharedMatrix::AttachFd(int fd, const std::string &name) {
+    SharedMatrix shared;
+    shared.fd_ = fd;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        throw SystemError("fstat shared matrix");
+    }
+    if (static_cast<std::size_t>(st.st_size) < HEADER_BYTES) {
+        throw std::runtime_error("shared matrix not ready");
+    }
+    auto *header{static_cast<SharedMatrixHeader *>(Map(fd, HEADER_BYTES, PROT_READ | PROT_WRITE))};
+    if (header->magic.load(std::memory_order_acquire) != SHARED_MATRIX_MAGIC) {
+        munmap(header, HEADER_BYTES);
+        throw std::runtime_error("shared matrix not ready");
+    }
+    // 头部可被其他进程改写，按校验时的副本映射
+    const SharedMatrixInfo info{header->info};
+    if (!ValidLayout(info, static_cast<std::size_t>(st.st_size))) {
+        munmap(header, HEADER_BYTES);
+        throw std::runtime_error("shared matrix corrupt");
+    }
+    // 引用计数已归零的段正在被删除，不可再附加
+    auto count{header->ref_count.load(std::memory_order_relaxed)};
+    do {
+        if (count == 0) {
+            munmap(header, HEADER_BYTES);
+            throw std::runtime_error("shared matrix released");
+        }
+    } while (!header->ref_count.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel));
+    shared.name_ = name;
+    shared.header_ = header;
+    shared.data_ = static_cast<std::byte *>(Map(fd, info.bytes, PROT_READ));
+    return shared;
+}
+
+void SharedMatrix::Detach() noexcept {
+    if (header_ != nullptr) {
+        const std::size_t bytes{header_->info.bytes};
+        if (header_->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1 && !name_.empty()) {
+            shm_unlink(name_.c_str());
+        }
+        if (data_ != nullptr) {
+            munmap(data_, bytes);
+        }
+        munmap(header_, HEADER_BYTES);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+    name_.clear();
+    fd_ = -1;
+    header_ = nullptr;
+    data_ = nullptr;
+}
+
+void SharedMatrix::Write(std::size_t i, const void *src) {
+    const auto &info{Info()};
+    const std::size_t bytes{info.counts[i] * info.item_sizes[i]};
+    std::byte *dst{data_ + info.offsets[i]};
+    const auto *from{static_cast<const std::byte *>(src)};
+    // 新段首次写入伴随缺页，多线程分摊
+    ParallelFor(0, bytes, std::size_t{1} << 20, [dst, from](std::size_t begin, std::size_t end) {
+        std::memcpy(dst + begin, from + begin, end - begin);
+    });
+}
+
+void SharedMatrix::Seal() {
+    const std::size_t page{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))};
+    const std::size_t bytes{Info().bytes};
+    const std::size_t protect_begin{(HEADER_BYTES + page - 1) / page * page};
+    if (protect_begin < bytes && mprotect(data_ + protect_begin, bytes - protect_begin, PROT_READ) != 0) {
+        throw SystemError("mprotect shared matrix");
+    }
+    if (name_.empty() && fcntl(fd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        throw SystemError("seal shared matrix");
+    }
+    header_->magic.store(SHARED_MATRIX_MAGIC, std::memory_order_release);
+}
+} // namespace oops
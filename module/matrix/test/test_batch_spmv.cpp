@@ -0,0 +1,104 @@
+#include <random>
+
+#include "oops/batch_spmv.h"
+#include "oops/convert.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+// 每行约nnz_per_row个随机元素的m x n矩阵
+Csr<double, int32_t> MakeRandom(int32_t m, int32_t n, int32_t nnz_per_row, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<int32_t> col{0, n - 1};
+    std::uniform_real_distribution<double> value{-1., 1.};
+    CooStore<double, int32_t> store;
+    store.m = m;
+    store.n = n;
+    for (int32_t r{0}; r < m; ++r) {
+        for (int32_t k{0}; k < (r % 5 == 0 ? 0 : nnz_per_row); ++k) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(col(gen));
+            store.values.push_back(value(gen));
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store)});
+}
+
+std::vector<double> MakeVector(std::size_t n, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_real_distribution<double> value{-1., 1.};
+    std::vector<double> x(n);
+    for (auto &v : x) {
+        v = value(gen);
+    }
+    return x;
+}
+} // namespace
+
+TEST(BatchSpMV, MatchesSpMV) {
+    std::vector<Csr<double, int32_t>> a;
+    std::vector<std::vector<double>> x;
+    for (unsigned i{0}; i < 40; ++i) {
+        // 含足以切分为多个单元的大矩阵与空矩阵
+        const int32_t m{i == 7 ? 30000 : i == 11 ? 0 : static_cast<int32_t>(50 + 37 * i)};
+        a.push_back(MakeRandom(m, 300, 4, i));
+        x.push_back(MakeVector(300, 100 + i));
+    }
+    std::vector<std::vector<double>> y;
+    BatchSpMV(a, x, y);
+    ASSERT_EQ(y.size(), a.size());
+    for (std::size_t i{0}; i < a.size(); ++i) {
+        std::vector<double> ref;
+        SpMV(a[i], x[i], ref);
+        EXPECT_EQ(y[i], ref) << i;
+    }
+
+    x[3].pop_back();
+    EXPECT_THROW(BatchSpMV(a, x, y), std::invalid_argument);
+}
+
+TEST(BatchSpMV, SharedPattern) {
+    auto base{MakeRandom(2000, 2000, 6, 1)};
+    const auto &row_ptr{base.GetRowPtr()};
+    const auto &col_indices{base.GetColIndices()};
+    // 同一份行指针与列索引上的11组值，超过单组容量；另加一份内容相同但地址不同的结构
+    std::vector<std::vector<double>> values, x, y(13, std::vector<double>(2000));
+    for (unsigned i{0}; i < 13; ++i) {
+        values.push_back(MakeVector(base.StoredNnz(), i));
+        x.push_back(MakeVector(2000, 50 + i));
+    }
+    auto copy{base};
+    std::vector<SpMVBatchItem<double, int32_t>> items;
+    for (std::size_t i{0}; i < 11; ++i) {
+        items.push_back({{2000, 2000, values[i].data(), row_ptr.data(), col_indices.data()}, x[i].data(), y[i].data()});
+    }
+    items.push_back({base, x[11].data(), y[11].data()});
+    items.push_back({copy, x[12].data(), y[12].data()});
+
+    for (bool compare : {false, true}) {
+        BatchSpMVOptions options;
+        options.compare_patterns = compare;
+        BatchSpMV(items, options);
+        for (std::size_t i{0}; i < items.size(); ++i) {
+            std::vector<double> ref(2000);
+            SpMV(items[i].a, x[i].data(), ref.data());
+            EXPECT_EQ(y[i], ref) << i;
+        }
+    }
+}
+
+TEST(BatchSpMV, Symmetric) {
+    CooStore<double, int32_t> store{4, 4, {4, 1, 5, 2, 6, 7}, {0, 1, 1, 2, 3, 3}, {0, 0, 1, 1, 2, 3}};
+    auto sym{ToCsr(Coo<double, int32_t>{store, MatrixSymmetric::SYMMETRIC_LOWER})};
+    auto general{MakeRandom(4, 4, 2, 3)};
+    std::vector<CsrView<double, int32_t>> a{sym, general, sym};
+    std::vector<std::vector<double>> x{{1, 2, 3, 4}, {5, 6, 7, 8}, {-1, 0, 1, 2}}, y;
+    BatchSpMV(a, x, y);
+    for (std::size_t i{0}; i < a.size(); ++i) {
+        std::vector<double> ref;
+        SpMV(a[i], x[i], ref);
+        EXPECT_EQ(y[i], ref) << i;
+    }
+    EXPECT_EQ(y[0], (std::vector<double>{6, 17, 28, 46}));
+}
@@ -0,0 +1,70 @@
+#include <filesystem>
+#include <fstream>
+
+#include "oops/convert.h"
+#include "oops/matrix_market_io.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+namespace fs = std::filesystem;
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+TEST(Convert, CooToCsrUnsorted) {
+    CooStore<double, int32_t> store;
+    store.m = 5;
+    store.n = 5;
+    store.values = {6.7, 1.5, 4.6, 7.8, 8.2, 2.3, 3.9, 5.1};
+    store.row_indices = {4, 0, 2, 0, 2, 0, 2, 4};
+    store.col_indices = {4, 4, 0, 1, 4, 0, 2, 0};
+
+    auto csr{ToCsr(Coo<double, int32_t>{store})};
+    static_assert(std::is_same_v<decltype(csr), Csr<double, int32_t, int32_t>>);
+    EXPECT_EQ(csr.M(), 5);
+    EXPECT_EQ(csr.N(), 5);
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int32_t>{0, 3, 3, 6, 6, 8}));
+    EXPECT_EQ(csr.GetColIndices(), (std::vector<int32_t>{0, 1, 4, 0, 2, 4, 0, 4}));
+    EXPECT_EQ(csr.GetValues(), (std::vector<double>{2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}));
+}
+
+TEST(Convert, CooToCsrNnzIndex) {
+    CooStore<std::monostate, int32_t> store;
+    store.m = 2;
+    store.n = 3;
+    store.row_indices = {1, 0, 1};
+    store.col_indices = {2, 1, 0};
+
+    auto csr{ToCsr<int64_t>(Coo<std::monostate, int32_t>{store})};
+    static_assert(std::is_same_v<decltype(csr), Csr<std::monostate, int32_t, int64_t>>);
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int64_t>{0, 1, 3}));
+    EXPECT_EQ(csr.GetColIndices(), (std::vector<int32_t>{1, 0, 2}));
+    EXPECT_TRUE(csr.GetValues().empty());
+}
+
+TEST(Convert, CooToCsrMatrixMarket) {
+    std::ifstream ifs(fs::path{OOPS_CASE_DIR} / "m_coo_real_sym.mtx");
+    auto any_coo{ReadMatrixMarket(ifs)};
+    auto csr{ToCsr(any_coo.Get<double, int32_t>())};
+    EXPECT_EQ(csr.GetSymmetric(), MatrixSymmetric::SYMMETRIC_LOWER);
+    EXPECT_EQ(csr.StoredNnz(), 4);
+    EXPECT_EQ(csr.Nnz(), 5);
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int32_t>{0, 1, 2, 4}));
+    EXPECT_EQ(csr.GetColIndices(), (std::vector<int32_t>{0, 1, 0, 2}));
+}
+
+TEST(Convert, AnyCooToAnyCsr) {
+    std::ifstream ifs(fs::path{OOPS_CASE_DIR} / "m_coo_real_sym.mtx");
+    auto any_csr{ToCsr(ReadMatrixMarket(ifs))};
+    EXPECT_EQ(any_csr.GetFormat(), MatrixFormat::SPARSE_CSR);
+    EXPECT_EQ(any_csr.GetValueNumeric(), MatrixNumeric::REAL);
+    EXPECT_EQ(any_csr.M(), 3);
+    EXPECT_EQ(any_csr.Nnz(), 5);
+    const auto &csr{any_csr.Get<double, int32_t>()};
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int32_t>{0, 1, 2, 4}));
+
+    any_csr.ConvertInplace<float, int64_t>();
+    EXPECT_EQ((any_csr.Get<float, int64_t>().GetColIndices()), (std::vector<int64_t>{0, 1, 0, 2}));
+}
@@ -0,0 +1,150 @@
+#include <map>
+#include <thread>
+
+#include "oops/coo_builder.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+// 类有限元装配：一维单元(i, i + 1)贡献2x2单元矩阵，内部结点对角元被相邻两单元重复添加
+void AssembleElements(CooBuilder<double, int32_t> &builder, int32_t num_elements, int num_threads, double scale = 1) {
+    std::vector<std::thread> threads;
+    for (int t{0}; t < num_threads; ++t) {
+        threads.emplace_back([&builder, num_elements, num_threads, t, scale] {
+            for (int32_t e{t}; e < num_elements; e += num_threads) {
+                const double k{scale * (1 + e % 5)};
+                builder.Add(e, e, k);
+                builder.Add(e, e + 1, -k);
+                builder.Add(e + 1, e, -k);
+                builder.Add(e + 1, e + 1, k);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+std::map<std::pair<int32_t, int32_t>, double> ExpectedElements(int32_t num_elements, double scale = 1) {
+    std::map<std::pair<int32_t, int32_t>, double> expected;
+    for (int32_t e{0}; e < num_elements; ++e) {
+        const double k{scale * (1 + e % 5)};
+        expected[{e, e}] += k;
+        expected[{e, e + 1}] -= k;
+        expected[{e + 1, e}] -= k;
+        expected[{e + 1, e + 1}] += k;
+    }
+    return expected;
+}
+} // namespace
+
+TEST(CooBuilder, ToCsr) {
+    constexpr int32_t num_elements{5000};
+    CooBuilder<double, int32_t> builder{num_elements + 1, num_elements + 1};
+    AssembleElements(builder, num_elements, 4);
+    EXPECT_EQ(builder.Size(), 4 * num_elements);
+
+    auto csr{builder.ToCsr<int64_t>()};
+    EXPECT_EQ(builder.Size(), 0);
+    auto expected{ExpectedElements(num_elements)};
+    ASSERT_EQ(csr.StoredNnz(), expected.size());
+    auto it{expected.begin()};
+    for (std::size_t r{0}; r < csr.M(); ++r) {
+        for (auto i{csr.GetRowPtr()[r]}; i < csr.GetRowPtr()[r + 1]; ++i, ++it) {
+            EXPECT_EQ(it->first.first, static_cast<int32_t>(r));
+            EXPECT_EQ(it->first.second, csr.GetColIndices()[i]);
+            EXPECT_DOUBLE_EQ(it->second, csr.GetValues()[i]);
+        }
+    }
+}
+
+TEST(CooBuilder, Deterministic) {
+    // 重复元素的累加顺序与线程划分无关，结果逐位相同
+    constexpr int32_t n{200};
+    auto build = [](int num_threads) {
+        CooBuilder<double, int32_t> builder{n, n};
+        std::vector<std::thread> threads;
+        for (int t{0}; t < num_threads; ++t) {
+            threads.emplace_back([&builder, num_threads, t] {
+                for (int32_t i{t}; i < 20 * n; i += num_threads) {
+                    builder.Add(i % n, (7 * i) % n, 1.0 / (1 + i));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return builder.ToCsr();
+    };
+    auto ref{build(1)};
+    for (int num_threads : {2, 3, 8}) {
+        auto csr{build(num_threads)};
+        EXPECT_EQ(csr.GetRowPtr(), ref.GetRowPtr());
+        EXPECT_EQ(csr.GetColIndices(), ref.GetColIndices());
+        EXPECT_EQ(csr.GetValues(), ref.GetValues());
+    }
+}
+
+TEST(CooBuilder, ToCoo) {
+    CooBuilder<double, int32_t> builder{3, 4};
+    builder.Add(2, 3, 1.5);
+    builder.Add(0, 1, 2.0);
+    builder.Add(2, 0, 1.0);
+    builder.Add(0, 1, 0.5);
+    auto coo{builder.ToCoo()};
+    EXPECT_EQ(coo.M(), 3);
+    EXPECT_EQ(coo.N(), 4);
+    EXPECT_EQ(coo.GetRowIndices(), (std::vector<int32_t>{0, 2, 2}));
+    EXPECT_EQ(coo.GetColIndices(), (std::vector<int32_t>{1, 0, 3}));
+    EXPECT_EQ(coo.GetValues(), (std::vector<double>{2.5, 1.0, 1.5}));
+
+    // 缓冲已清空，可继续构造
+    builder.Add(1, 1, 3.0);
+    EXPECT_EQ(builder.ToCoo().StoredNnz(), 1);
+}
+
+TEST(CooBuilder, Pattern) {
+    CooBuilder<std::monostate, int32_t> builder{2, 2, MatrixSymmetric::SYMMETRIC_LOWER};
+    builder.Add(1, 0);
+    builder.Add(0, 0);
+    builder.Add(1, 0);
+    auto csr{builder.ToCsr()};
+    EXPECT_EQ(csr.GetSymmetric(), MatrixSymmetric::SYMMETRIC_LOWER);
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int32_t>{0, 1, 2}));
+    EXPECT_EQ(csr.GetColIndices(), (std::vector<int32_t>{0, 0}));
+}
+
+TEST(CooBuilder, Reuse) {
+    constexpr int32_t num_elements{3000};
+    CooBuilder<double, int32_t> builder{num_elements + 1, num_elements + 1};
+    AssembleElements(builder, num_elements, 3);
+    auto csr{builder.ToCsr()};
+
+    builder.Reuse(csr);
+    EXPECT_TRUE(builder.IsReusing());
+    std::vector<double> values;
+    for (double scale : {2.0, -0.5}) {
+        AssembleElements(builder, num_elements, 4, scale);
+        builder.Assemble(values);
+        auto expected{ExpectedElements(num_elements, scale)};
+        ASSERT_EQ(values.size(), expected.size());
+        auto it{expected.begin()};
+        for (std::size_t i{0}; i < values.size(); ++i, ++it) {
+            EXPECT_DOUBLE_EQ(values[i], it->second);
+        }
+    }
+    EXPECT_THROW(builder.Add(0, 5, 1.0), std::out_of_range);
+    EXPECT_THROW(builder.ToCsr(), std::logic_error);
+}
+
+TEST(CooBuilder, InvalidArgument) {
+    CooBuilder<double, int32_t> builder{2, 3};
+    EXPECT_THROW(builder.Add(2, 0, 1.0), std::out_of_range);
+    EXPECT_THROW(builder.Add(0, -1, 1.0), std::out_of_range);
+    std::vector<double> values;
+    EXPECT_THROW(builder.Assemble(values), std::logic_error);
+
+    CsrStore<double, int32_t> store{3, {1, 1}, {0, 2, 2}, {1, 0}};
+    EXPECT_THROW(builder.Reuse(Csr<double, int32_t>{store}), std::invalid_argument);
+}
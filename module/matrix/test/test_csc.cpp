@@ -0,0 +1,93 @@
+#include <random>
+
+#include "oops/allocator.h"
+#include "oops/convert.h"
+#include "oops/csc.h"
+#include "oops/sparse_product.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+// 每行nnz_per_row个随机列，行内有序无重复
+static Csr<double, int32_t> MakeRandom(int32_t m, int32_t n, int32_t nnz_per_row, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<int32_t> col{0, n - 1};
+    std::uniform_real_distribution<double> value{-1, 1};
+    CooStore<double, int32_t> store{static_cast<std::size_t>(m), static_cast<std::size_t>(n), {}, {}, {}};
+    for (int32_t r{0}; r < m; ++r) {
+        std::vector<int32_t> cols;
+        for (int32_t k{0}; k < nnz_per_row; ++k) {
+            cols.push_back(col(gen));
+        }
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        for (auto c : cols) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(c);
+            store.values.push_back(value(gen));
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{store});
+}
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+TEST(Csc, FromCsr) {
+    CsrStore<double, int32_t> store{
+        5, {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}, {0, 3, 3, 6, 6, 8}, {0, 1, 4, 0, 2, 4, 0, 4}};
+    auto csc{ToCsc(Csr<double, int32_t>{store})};
+    EXPECT_EQ(csc.GetFormat(), MatrixFormat::SPARSE_CSC);
+    EXPECT_EQ(csc.M(), 5);
+    EXPECT_EQ(csc.N(), 5);
+    EXPECT_EQ(csc.StoredNnz(), 8);
+    EXPECT_EQ(csc.DiagNnz(), 3);
+    EXPECT_EQ(csc.GetColPtr(), (std::vector<int32_t>{0, 3, 4, 5, 5, 8}));
+    EXPECT_EQ(csc.GetRowIndices(), (std::vector<int32_t>{0, 2, 4, 0, 2, 0, 2, 4}));
+    EXPECT_EQ(csc.GetValues(), (std::vector<double>{2.3, 4.6, 5.1, 7.8, 3.9, 1.5, 8.2, 6.7}));
+}
+
+TEST(Csc, ParallelMatchesSerial) {
+    auto csr{MakeRandom(20000, 300, 8, 7)};
+    auto csc{ToCsc(csr)};
+    // 逐列核对：行索引升序且与行存储一致
+    const auto &store{csr.GetStore()};
+    std::vector<int32_t> col_ptr(csr.N() + 1, 0);
+    for (auto c : store.col_indices) {
+        ++col_ptr[c + 1];
+    }
+    std::partial_sum(col_ptr.begin(), col_ptr.end(), col_ptr.begin());
+    EXPECT_EQ(csc.GetColPtr(), col_ptr);
+    std::vector<int32_t> row_indices(csr.StoredNnz());
+    std::vector<double> values(csr.StoredNnz());
+    for (std::size_t r{0}; r < csr.M(); ++r) {
+        for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+            auto p{col_ptr[store.col_indices[i]]++};
+            row_indices[p] = static_cast<int32_t>(r);
+            values[p] = store.values[i];
+        }
+    }
+    EXPECT_EQ(csc.GetRowIndices(), row_indices);
+    EXPECT_EQ(csc.GetValues(), values);
+
+    auto t{Transpose(csr)};
+    EXPECT_EQ(t.GetRowPtr(), csc.GetColPtr());
+    EXPECT_EQ(t.GetColIndices(), csc.GetRowIndices());
+}
+
+TEST(Csc, AllocatorAndView) {
+    using Alloc = AlignedAllocator<double>;
+    auto csr{MakeRandom(100, 40, 3, 1)};
+    Csr<double, int32_t, int32_t, Alloc> aligned{csr};
+    auto csc{ToCsc(aligned)};
+    static_assert(std::is_same_v<decltype(csc), Csc<double, int32_t, int32_t, Alloc>>);
+    // 行区间子视图的行索引相对于子视图
+    auto sub{ToCsc(CsrView<double, int32_t>{csr}.Rows(50, 100))};
+    EXPECT_EQ(sub.M(), 50);
+    EXPECT_EQ(sub.StoredNnz(), csr.GetRowPtr()[100] - csr.GetRowPtr()[50]);
+    for (auto r : sub.GetRowIndices()) {
+        EXPECT_LT(r, 50);
+    }
+}
@@ -1,3 +1,6 @@
+#include <utility>
+
+#include "oops/allocator.h"
 #include "oops/csr.h"
 #include "gtest/gtest.h"
 
@@ -41,3 +44,70 @@ TEST(Csr, GeneralSquare) {
     assigned = csr;
     check(assigned);
 }
+
+TEST(Csr, MovedFrom) {
+    CsrStore<double, int32_t> store{3, {1, 2, 3}, {0, 1, 2, 3}, {0, 1, 2}};
+    // 默认构造的对象共享同一空模式
+    Csr<double, int32_t> empty, other_empty;
+    EXPECT_EQ(empty.GetPattern(), other_empty.GetPattern());
+    EXPECT_EQ(empty.M(), 0);
+    EXPECT_EQ(empty.GetRowPtr(), (std::vector<int32_t>{0}));
+
+    // 被移动后为0 x 0的空矩阵，可继续查询与赋值
+    auto check_empty = [&empty](const auto &csr) {
+        EXPECT_EQ(csr.M(), 0);
+        EXPECT_EQ(csr.N(), 0);
+        EXPECT_EQ(csr.StoredNnz(), 0);
+        EXPECT_EQ(csr.GetRowPtr().size(), 1);
+        EXPECT_TRUE(csr.GetValues().empty());
+        EXPECT_NE(csr.GetPattern(), nullptr);
+    };
+    Csr<double, int32_t> a{store};
+    Csr<double, int32_t> b{std::move(a)};
+    check_empty(a);
+    EXPECT_EQ(a.GetPattern(), empty.GetPattern());
+    EXPECT_EQ(b.StoredNnz(), 3);
+
+    Csr<double, int32_t> c;
+    c = std::move(b);
+    check_empty(b);
+    EXPECT_EQ(c.M(), 3);
+    b = c;
+    EXPECT_EQ(b.GetValues(), c.GetValues());
+
+    // 类型转换的移动同样置空
+    Csr<float, int64_t> converted{std::move(c)};
+    check_empty(c);
+    EXPECT_EQ(converted.StoredNnz(), 3);
+    Csr<double, int64_t> d;
+    d = std::move(converted);
+    check_empty(converted);
+    EXPECT_EQ(d.GetValues(), (std::vector<double>{1, 2, 3}));
+}
+
+TEST(Csr, Allocator) {
+    using Alloc = AlignedAllocator<double>;
+    CsrStore<double, int32_t, int32_t, Alloc> store;
+    store.n = 5;
+    store.values = {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7};
+    store.row_ptr = {0, 3, 3, 6, 6, 8};
+    store.col_indices = {0, 1, 4, 0, 2, 4, 0, 4};
+    Csr<double, int32_t, int32_t, Alloc> csr{store};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(csr.GetValues().data()) % CACHE_LINE_SIZE, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(csr.GetColIndices().data()) % CACHE_LINE_SIZE, 0);
+
+    // 类型转换保留分配器族
+    Csr<float, int64_t, int64_t, AlignedAllocator<float>> converted{csr};
+    static_assert(std::is_same_v<
+                  std::decay_t<decltype(converted.GetRowPtr())>,
+                  std::vector<int64_t, AlignedAllocator<int64_t>>>);
+    EXPECT_EQ(converted.StoredNnz(), 8);
+    EXPECT_FLOAT_EQ(converted.GetValues()[5], 8.2f);
+    EXPECT_EQ(converted.GetColIndices()[2], 4);
+
+    // 与默认分配器互相转换
+    Csr<double, int32_t> plain{csr};
+    EXPECT_EQ(plain.GetValues(), (std::vector<double>{store.values.begin(), store.values.end()}));
+    Csr<double, int32_t, int32_t, PoolAllocator<double>> pooled{std::move(plain)};
+    EXPECT_EQ(pooled.DiagNnz(), 3);
+}
@@ -0,0 +1,82 @@
+#include "oops/convert.h"
+#include "oops/csr.h"
+#include "oops/sparse_product.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+Csr<double, int32_t> MakeCsr() {
+    // 1 0 2
+    // 0 3 0
+    // 4 0 5
+    return CsrStore<double, int32_t>{3, {1, 2, 3, 4, 5}, {0, 2, 3, 5}, {0, 2, 1, 0, 2}};
+}
+} // namespace
+
+TEST(CsrPattern, HashAndSame) {
+    auto a{MakeCsr()};
+    auto b{MakeCsr()};
+    EXPECT_NE(a.GetPattern(), b.GetPattern());
+    EXPECT_EQ(a.GetPattern()->Hash(), b.GetPattern()->Hash());
+    EXPECT_TRUE(a.GetPattern()->Same(*b.GetPattern()));
+    EXPECT_EQ(a.DiagNnz(), 3);
+
+    CsrStore<double, int32_t> store = a.GetStore();
+    store.col_indices[1] = 1;
+    Csr<double, int32_t> c{std::move(store)};
+    EXPECT_FALSE(a.GetPattern()->Same(*c.GetPattern()));
+    EXPECT_NE(a.GetPattern()->Hash(), c.GetPattern()->Hash());
+}
+
+TEST(CsrPattern, Share) {
+    auto a{MakeCsr()};
+    auto copy{a};
+    EXPECT_EQ(copy.GetPattern(), a.GetPattern());
+    // 只改变数值类型时共享模式，改变索引类型时生成新模式
+    Csr<float, int32_t> f{a};
+    EXPECT_EQ(f.GetPattern().get(), a.GetPattern().get());
+    Csr<double, int64_t> wide{a};
+    EXPECT_EQ(wide.GetColIndices(), (std::vector<int64_t>{0, 2, 1, 0, 2}));
+
+    Csr<double, int32_t> b{a.GetPattern(), {5, 4, 3, 2, 1}};
+    EXPECT_EQ(b.GetPattern(), a.GetPattern());
+    EXPECT_EQ(b.GetValues(), (std::vector<double>{5, 4, 3, 2, 1}));
+    EXPECT_THROW((Csr<double, int32_t>{a.GetPattern(), {1, 2}}), std::invalid_argument);
+    EXPECT_THROW((Csr<double, int32_t>{nullptr, {}}), std::invalid_argument);
+    Csr<std::monostate, int32_t> p{a.GetPattern(), {}};
+    EXPECT_EQ(p.StoredNnz(), 5);
+}
+
+TEST(CsrPattern, UpdateValues) {
+    auto a{MakeCsr()};
+    auto copy{a};
+    const double values[]{-1, -2, -3, -4, -5};
+    a.UpdateValues(values);
+    EXPECT_EQ(a.GetValues(), (std::vector<double>{-1, -2, -3, -4, -5}));
+    EXPECT_EQ(copy.GetValues(), (std::vector<double>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(a.GetPattern(), copy.GetPattern());
+
+    a.UpdateValues(std::vector<double>{6, 7, 8, 9, 10});
+    EXPECT_EQ(a.GetValues(), (std::vector<double>{6, 7, 8, 9, 10}));
+    EXPECT_THROW(a.UpdateValues(std::vector<double>{1}), std::invalid_argument);
+}
+
+TEST(CsrPattern, TransposeCache) {
+    auto a{MakeCsr()};
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 0);
+    auto t{Transpose(a)};
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 1);
+    EXPECT_EQ(t.GetRowPtr(), (std::vector<int32_t>{0, 2, 3, 5}));
+    EXPECT_EQ(t.GetColIndices(), (std::vector<int32_t>{0, 2, 1, 0, 2}));
+    EXPECT_EQ(t.GetValues(), (std::vector<double>{1, 4, 3, 2, 5}));
+
+    // 数值变化后复用缓存的转置结构
+    a.UpdateValues(std::vector<double>{6, 7, 8, 9, 10});
+    auto t2{Transpose(a)};
+    EXPECT_EQ(t2.GetPattern(), t.GetPattern());
+    EXPECT_EQ(t2.GetValues(), (std::vector<double>{6, 9, 8, 7, 10}));
+    auto csc{ToCsc(a)};
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 1);
+    EXPECT_EQ(csc.GetValues(), t2.GetValues());
+}
@@ -0,0 +1,105 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "oops/convert.h"
+#include "oops/dia.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+using namespace testing;
+
+namespace {
+// 五点差分格式的二维网格矩阵，对角线偏移为0、±1、±nx
+Csr<double, int32_t> MakeGrid(int32_t nx, int32_t ny) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = nx * ny;
+    auto add = [&store](int32_t r, int32_t c, double v) {
+        store.row_indices.push_back(r);
+        store.col_indices.push_back(c);
+        store.values.push_back(v);
+    };
+    for (int32_t j{0}; j < ny; ++j) {
+        for (int32_t i{0}; i < nx; ++i) {
+            const int32_t r{j * nx + i};
+            if (j > 0) {
+                add(r, r - nx, -1.1);
+            }
+            if (i > 0) {
+                add(r, r - 1, -0.9);
+            }
+            add(r, r, 4 + 0.01 * (r % 7));
+            if (i + 1 < nx) {
+                add(r, r + 1, -1.2);
+            }
+            if (j + 1 < ny) {
+                add(r, r + nx, -0.8);
+            }
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store)});
+}
+} // namespace
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+TEST(Dia, FromCsr) {
+    CsrStore<double, int32_t> store{
+        5, {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}, {0, 3, 3, 6, 6, 8}, {0, 1, 4, 0, 2, 4, 0, 4}};
+    Csr<double, int32_t> csr{store};
+    EXPECT_THROW(ToDia(csr), std::invalid_argument);
+
+    DiaOptions options;
+    options.max_fill = 10;
+    auto dia{ToDia(csr, options)};
+    EXPECT_EQ(dia.GetFormat(), MatrixFormat::SPARSE_DIA);
+    EXPECT_EQ(dia.GetOffsets(), (std::vector<int32_t>{-4, -2, 0, 1, 2, 4}));
+    std::vector<double> x{1, 2, 3, 4, 5}, y;
+    SpMV(dia, x, y);
+    EXPECT_THAT(y, ElementsAre(DoubleEq(25.4), 0, DoubleEq(57.3), 0, DoubleEq(38.6)));
+}
+
+TEST(Dia, Grid) {
+    auto csr{MakeGrid(300, 40)};
+    auto dia{ToDia(csr)};
+    EXPECT_EQ(dia.NumDiagonals(), 5);
+    EXPECT_EQ(dia.GetOffsets(), (std::vector<int32_t>{-300, -1, 0, 1, 300}));
+
+    std::vector<double> x(csr.N()), y, ref;
+    for (std::size_t i{0}; i < x.size(); ++i) {
+        x[i] = 1.0 + static_cast<double>(i % 13) / 5;
+    }
+    SpMV(dia, x, y);
+    SpMV(csr, x, ref);
+    EXPECT_EQ(y, ref);
+}
+
+TEST(Dia, Rectangular) {
+    CooStore<double, int32_t> store{2, 4, {1, 2, 3, 4}, {0, 0, 1, 1}, {0, 3, 1, 2}};
+    auto csr{ToCsr(Coo<double, int32_t>{store})};
+    auto dia{ToDia(csr)};
+    std::vector<double> x{1, 2, 3, 4}, y;
+    SpMV(dia, x, y);
+    EXPECT_THAT(y, ElementsAre(9, 18));
+    EXPECT_THROW(SpMV(dia, std::vector<double>(3), y), std::invalid_argument);
+}
+
+// 网格的±1对角线在块边界处有空缺(如第300行无列299)，x含Inf与NaN时空缺槽位不参与计算，结果与CSR逐位一致
+TEST(Dia, InfInput) {
+    auto csr{MakeGrid(300, 40)};
+    auto dia{ToDia(csr)};
+    std::vector<double> x(csr.N(), 1.5), y, ref;
+    x[299] = std::numeric_limits<double>::infinity();
+    x[599] = -std::numeric_limits<double>::infinity();
+    x[4000] = std::numeric_limits<double>::quiet_NaN();
+    SpMV(dia, x, y);
+    SpMV(csr, x, ref);
+    ASSERT_EQ(y.size(), ref.size());
+    EXPECT_EQ(std::memcmp(y.data(), ref.data(), y.size() * sizeof(double)), 0);
+    EXPECT_TRUE(std::isfinite(y[300]));
+    EXPECT_TRUE(std::isfinite(y[600]));
+}
@@ -0,0 +1,83 @@
+#include "oops/dict_csr.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+using namespace testing;
+
+namespace {
+// 带状矩阵，第r行的取值由value(r, c)给出
+template <typename F>
+Csr<double, int32_t> MakeBand(int32_t n, int32_t bandwidth, F &&value) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = n;
+    for (int32_t r{0}; r < n; ++r) {
+        for (int32_t c{std::max(r - bandwidth, 0)}; c <= std::min(r + bandwidth, n - 1); ++c) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(c);
+            store.values.push_back(value(r, c));
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store)});
+}
+
+std::vector<double> MakeX(std::size_t n) {
+    std::vector<double> x(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        x[i] = 0.5 + static_cast<double>(i % 17) / 3;
+    }
+    return x;
+}
+} // namespace
+
+TEST(DictCsr, Laplacian8Bit) {
+    auto csr{MakeBand(5000, 1, [](int32_t r, int32_t c) { return r == c ? 2.0 : -1.0; })};
+    auto dict{ToDictCsr(csr)};
+    ASSERT_TRUE(dict.has_value());
+    EXPECT_EQ(dict->CodeBytes(), 1);
+    EXPECT_THAT(dict->GetTable(), ElementsAre(2.0, -1.0));
+    EXPECT_EQ(dict->GetCodes8().size(), csr.StoredNnz());
+    EXPECT_TRUE(dict->GetCodes16().empty());
+
+    auto x{MakeX(csr.N())};
+    std::vector<double> y, ref;
+    SpMV(*dict, x, y);
+    SpMV(csr, x, ref);
+    EXPECT_EQ(y, ref);
+    EXPECT_EQ(ToCsr(*dict).GetValues(), csr.GetValues());
+}
+
+TEST(DictCsr, Codes16Bit) {
+    auto csr{MakeBand(3000, 2, [](int32_t r, int32_t c) { return 1.0 + (5 * r + c - r + 2) % 1000; })};
+    auto dict{ToDictCsr(csr)};
+    ASSERT_TRUE(dict.has_value());
+    EXPECT_EQ(dict->CodeBytes(), 2);
+    EXPECT_EQ(dict->GetTable().size(), 1000);
+
+    auto x{MakeX(csr.N())};
+    std::vector<double> y, ref;
+    SpMV(*dict, x, y);
+    SpMV(csr, x, ref);
+    EXPECT_EQ(y, ref);
+
+    DictCsrOptions options;
+    options.max_table = 999;
+    EXPECT_FALSE(ToDictCsr(csr, options).has_value());
+    options.max_table = std::size_t{1} << 17;
+    EXPECT_THROW(ToDictCsr(csr, options), std::invalid_argument);
+}
+
+TEST(DictCsr, SignedZeroAndSymmetric) {
+    // -0.0与0.0分别编码
+    CooStore<double, int32_t> store{3, 3, {0.0, -0.0, 1.5, -0.0}, {0, 1, 2, 2}, {0, 1, 0, 2}};
+    Coo<double, int32_t> coo{store, MatrixSymmetric::SYMMETRIC_LOWER};
+    auto dict{ToDictCsr(coo)};
+    ASSERT_TRUE(dict.has_value());
+    EXPECT_EQ(dict->GetTable().size(), 3);
+    EXPECT_EQ(dict->GetSymmetric(), MatrixSymmetric::SYMMETRIC_LOWER);
+
+    std::vector<double> x{1, 2, 3}, y, ref;
+    SpMV(*dict, x, y);
+    SpMV(ToCsr(coo), x, ref);
+    EXPECT_EQ(y, ref);
+}
@@ -0,0 +1,213 @@
+#include <map>
+#include <thread>
+
+#include "oops/dynamic_csr.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+using Entries = std::map<std::pair<int32_t, int32_t>, double>;
+
+Csr<double, int32_t> MakeCsr(std::size_t m, std::size_t n, const Entries &entries) {
+    CsrStore<double, int32_t, int32_t> store;
+    store.n = n;
+    store.row_ptr.assign(m + 1, 0);
+    for (const auto &[pos, value] : entries) {
+        ++store.row_ptr[pos.first + 1];
+        store.col_indices.push_back(pos.second);
+        store.values.push_back(value);
+    }
+    for (std::size_t r{0}; r < m; ++r) {
+        store.row_ptr[r + 1] += store.row_ptr[r];
+    }
+    return {std::move(store)};
+}
+
+void ExpectSame(const Csr<double, int32_t> &csr, const Entries &expected) {
+    const auto ref{MakeCsr(csr.M(), csr.N(), expected)};
+    EXPECT_EQ(csr.GetRowPtr(), ref.GetRowPtr());
+    EXPECT_EQ(csr.GetColIndices(), ref.GetColIndices());
+    EXPECT_EQ(csr.GetValues(), ref.GetValues());
+}
+
+void ExpectSpMV(const DynamicCsrSnapshot<double, int32_t> &snapshot) {
+    std::vector<double> x(snapshot.N());
+    for (std::size_t i{0}; i < x.size(); ++i) {
+        x[i] = 0.5 + static_cast<double>(i % 7);
+    }
+    std::vector<double> y;
+    std::vector<double> ref;
+    SpMV(snapshot, x, y);
+    SpMV(snapshot.ToCsr(), x, ref);
+    EXPECT_EQ(y, ref);
+}
+} // namespace
+
+TEST(DynamicCsr, InsertErase) {
+    Entries entries{{{0, 0}, 1}, {{0, 2}, 2}, {{1, 1}, 3}, {{2, 0}, 4}, {{2, 3}, 5}};
+    DynamicCsr<double, int32_t> a{MakeCsr(3, 4, entries)};
+    const auto before{a.Snapshot()};
+    EXPECT_EQ(before->PendingDeltas(), 0);
+    EXPECT_EQ(a.Snapshot(), before);
+
+    a.Insert(0, 1, 6);
+    a.Insert(0, 2, 7);
+    a.Erase(1, 1);
+    a.Erase(1, 3);
+    a.Insert(2, 2, 8);
+    a.Erase(2, 2);
+    a.Insert(2, 1, 9);
+    a.Erase(2, 1);
+    a.Insert(2, 1, 10);
+    EXPECT_EQ(a.PendingLogs(), 9);
+
+    const auto snapshot{a.Snapshot()};
+    entries[{0, 1}] = 6;
+    entries[{0, 2}] = 7;
+    entries.erase({1, 1});
+    entries[{2, 1}] = 10;
+    // 删除(1, 3)与(2, 2)的增量对基矩阵无效果，不计入
+    EXPECT_EQ(snapshot->PendingDeltas(), 4);
+    EXPECT_EQ(snapshot->StoredNnz(), entries.size());
+    EXPECT_TRUE(snapshot->Contains(0, 1));
+    EXPECT_FALSE(snapshot->Contains(1, 1));
+    EXPECT_FALSE(snapshot->Contains(2, 2));
+    EXPECT_EQ(snapshot->Get(0, 2), 7);
+    EXPECT_EQ(snapshot->Get(2, 3), 5);
+    EXPECT_EQ(snapshot->Get(1, 1), 0);
+    EXPECT_THROW(snapshot->Get(3, 0), std::out_of_range);
+    ExpectSame(snapshot->ToCsr(), entries);
+    ExpectSpMV(*snapshot);
+
+    // 合并后旧快照不变，新快照没有增量
+    a.Merge();
+    EXPECT_EQ(a.PendingLogs(), 0);
+    EXPECT_EQ(before->StoredNnz(), 5);
+    EXPECT_EQ(before->Get(1, 1), 3);
+    ExpectSame(*a.GetBase(), entries);
+    EXPECT_EQ(a.Snapshot()->PendingDeltas(), 0);
+    ExpectSame(snapshot->ToCsr(), entries);
+}
+
+TEST(DynamicCsr, ValueOnlyDeltasSharePattern) {
+    DynamicCsr<double, int32_t> a{MakeCsr(2, 2, {{{0, 0}, 1}, {{1, 0}, 2}, {{1, 1}, 3}})};
+    const auto base{a.GetBase()};
+    a.Insert(1, 0, 4);
+    a.Merge();
+    EXPECT_EQ(a.GetBase()->GetPattern(), base->GetPattern());
+    EXPECT_EQ(a.GetBase()->GetValues(), (std::vector<double>{1, 4, 3}));
+}
+
+// 只改数值的增量与删除不存在元素的增量共存时走共享模式的路径，合并不能访问基矩阵外的位置
+TEST(DynamicCsr, EraseAbsent) {
+    const Entries diagonal{{{0, 0}, 1}, {{1, 1}, 2}, {{2, 2}, 3}, {{3, 3}, 4}};
+    auto expected{diagonal};
+    expected[{0, 0}] = 5;
+    const auto update{[](DynamicCsr<double, int32_t> &a) {
+        a.Insert(0, 0, 5);
+        a.Erase(1, 3);
+        a.Insert(2, 0, 6);
+        a.Erase(2, 0);
+    }};
+
+    DynamicCsr<double, int32_t> a{MakeCsr(4, 4, diagonal)};
+    update(a);
+    const auto snapshot{a.Snapshot()};
+    EXPECT_EQ(snapshot->PendingDeltas(), 1);
+    EXPECT_EQ(snapshot->StoredNnz(), 4);
+    EXPECT_FALSE(snapshot->Contains(1, 3));
+    EXPECT_FALSE(snapshot->Contains(2, 0));
+    const auto csr{snapshot->ToCsr()};
+    EXPECT_EQ(csr.GetPattern(), snapshot->GetBase()->GetPattern());
+    ExpectSame(csr, expected);
+    ExpectSpMV(*snapshot);
+
+    // Snapshot触发的后台合并与同步合并
+    for (const bool background : {false, true}) {
+        DynamicCsrOptions options;
+        options.min_merge_logs = 1;
+        options.background_merge = background;
+        DynamicCsr<double, int32_t> b{MakeCsr(4, 4, diagonal), options};
+        const auto base{b.GetBase()};
+        update(b);
+        b.Snapshot();
+        b.Merge();
+        EXPECT_EQ(b.PendingLogs(), 0);
+        EXPECT_EQ(b.GetBase()->GetPattern(), base->GetPattern());
+        ExpectSame(*b.GetBase(), expected);
+    }
+}
+
+TEST(DynamicCsr, ConcurrentUpdates) {
+    constexpr int32_t n{3000};
+    constexpr int num_threads{4};
+    for (bool background : {true, false}) {
+        DynamicCsrOptions options;
+        options.min_merge_logs = 500;
+        options.background_merge = background;
+        DynamicCsr<double, int32_t> a{n, n, options};
+        // 每个线程负责互不相交的行，先插入三对角元素，再删除其中的上对角元素
+        std::vector<std::thread> threads;
+        for (int t{0}; t < num_threads; ++t) {
+            threads.emplace_back([&a, t] {
+                for (int32_t r{t}; r < n; r += num_threads) {
+                    for (int32_t c{std::max(r - 1, 0)}; c <= std::min(r + 1, n - 1); ++c) {
+                        a.Insert(r, c, r == c ? 2. : -1.);
+                    }
+                    if (r % 50 == 0) {
+                        // 查询期间触发合并，快照始终包含本线程此前的全部操作
+                        const auto snapshot{a.Snapshot()};
+                        EXPECT_TRUE(snapshot->Contains(r, r));
+                    }
+                }
+                for (int32_t r{t}; r + 1 < n; r += num_threads) {
+                    a.Erase(r, r + 1);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        Entries expected;
+        for (int32_t r{0}; r < n; ++r) {
+            expected[{r, r}] = 2;
+            if (r > 0) {
+                expected[{r, r - 1}] = -1;
+            }
+        }
+        const auto snapshot{a.Snapshot()};
+        EXPECT_EQ(snapshot->StoredNnz(), expected.size());
+        ExpectSame(snapshot->ToCsr(), expected);
+        ExpectSpMV(*snapshot);
+        a.Merge();
+        EXPECT_EQ(a.PendingLogs(), 0);
+        ExpectSame(*a.GetBase(), expected);
+    }
+}
+
+TEST(DynamicCsr, Pattern) {
+    DynamicCsr<std::monostate, int32_t> a{3, 3};
+    a.Insert(2, 1);
+    a.Insert(0, 0);
+    a.Erase(0, 0);
+    a.Insert(1, 2);
+    const auto snapshot{a.Snapshot()};
+    EXPECT_EQ(snapshot->StoredNnz(), 2);
+    const auto csr{snapshot->ToCsr()};
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int32_t>{0, 0, 1, 2}));
+    EXPECT_EQ(csr.GetColIndices(), (std::vector<int32_t>{2, 1}));
+}
+
+TEST(DynamicCsr, Errors) {
+    DynamicCsr<double, int32_t> a{2, 3};
+    EXPECT_THROW(a.Insert(2, 0, 1), std::out_of_range);
+    EXPECT_THROW(a.Erase(0, -1), std::out_of_range);
+
+    CsrStore<double, int32_t, int32_t> unsorted{2, {1, 2}, {0, 2, 2}, {1, 0}};
+    EXPECT_THROW((DynamicCsr<double, int32_t>{Csr<double, int32_t>{unsorted}}), std::invalid_argument);
+    CsrStore<double, int32_t, int32_t> lower{2, {1, 2}, {0, 1, 2}, {0, 1}};
+    EXPECT_THROW(
+        (DynamicCsr<double, int32_t>{Csr<double, int32_t>{lower, MatrixSymmetric::SYMMETRIC_LOWER}}),
+        std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "oops/convert.h"
+#include "oops/hyb.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+using namespace testing;
+
+namespace {
+// 大部分行长度为base，每隔stride行出现一条长度为long_len的长行
+Csr<double, int32_t> MakeSkewed(int32_t m, int32_t base, int32_t stride, int32_t long_len) {
+    std::mt19937 gen{11};
+    std::uniform_real_distribution<double> value{-1, 1};
+    CooStore<double, int32_t> store;
+    store.m = store.n = m;
+    for (int32_t r{0}; r < m; ++r) {
+        const int32_t len{r % stride == 0 ? long_len : base};
+        for (int32_t k{0}; k < len; ++k) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back((r + k * 37) % m);
+            store.values.push_back(value(gen));
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store)});
+}
+} // namespace
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+TEST(Hyb, FromCsr) {
+    CsrStore<double, int32_t> store{
+        5, {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}, {0, 3, 3, 6, 6, 8}, {0, 1, 4, 0, 2, 4, 0, 4}};
+    Csr<double, int32_t> csr{store};
+    auto hyb{ToHyb(csr)};
+    EXPECT_EQ(hyb.GetFormat(), MatrixFormat::SPARSE_HYB);
+    EXPECT_EQ(hyb.EllWidth(), 3);
+    EXPECT_EQ(hyb.CooNnz(), 0);
+    EXPECT_EQ(hyb.GetStore().ell_ld % HYB_ROW_ALIGN, 0);
+    std::vector<double> x{1, 2, 3, 4, 5}, y;
+    SpMV(hyb, x, y);
+    EXPECT_THAT(y, ElementsAre(DoubleEq(25.4), 0, DoubleEq(57.3), 0, DoubleEq(38.6)));
+
+    // 宽度2时第0、2行各有一个元素溢出到COO
+    HybOptions options;
+    options.ell_width = 2;
+    hyb = ToHyb(csr, options);
+    EXPECT_EQ(hyb.CooNnz(), 2);
+    SpMV(hyb, x, y);
+    EXPECT_THAT(y, ElementsAre(DoubleEq(25.4), 0, DoubleEq(57.3), 0, DoubleEq(38.6)));
+
+    // 宽度3时两行为空，ELL槽位15个仅存8个非零元
+    options.ell_width = 3;
+    options.max_fill = 1.5;
+    EXPECT_THROW(ToHyb(csr, options), std::invalid_argument);
+}
+
+TEST(Hyb, Skewed) {
+    auto csr{MakeSkewed(5000, 5, 100, 300)};
+    auto hyb{ToHyb(csr)};
+    EXPECT_EQ(hyb.EllWidth(), 5);
+    EXPECT_EQ(hyb.CooNnz(), 50 * 295);
+
+    std::vector<double> x(csr.N()), y, ref;
+    for (std::size_t i{0}; i < x.size(); ++i) {
+        x[i] = std::cos(static_cast<double>(i));
+    }
+    SpMV(hyb, x, y);
+    SpMV(csr, x, ref);
+    EXPECT_EQ(y, ref);
+}
+
+// 空行以列0填充、短行以行内末列填充，x含Inf时填充槽位不参与计算，结果与CSR逐位一致
+TEST(Hyb, InfInput) {
+    CsrStore<double, int32_t> store{
+        5, {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}, {0, 3, 3, 6, 6, 8}, {0, 1, 4, 0, 2, 4, 0, 4}};
+    Csr<double, int32_t> csr{store};
+    auto hyb{ToHyb(csr)};
+    std::vector<double> x{std::numeric_limits<double>::infinity(), 2, 3, 4, std::numeric_limits<double>::infinity()};
+    std::vector<double> y, ref;
+    SpMV(hyb, x, y);
+    SpMV(csr, x, ref);
+    EXPECT_EQ(y[1], 0);
+    EXPECT_EQ(y[3], 0);
+    EXPECT_EQ(std::memcmp(y.data(), ref.data(), y.size() * sizeof(double)), 0);
+
+    auto skewed{MakeSkewed(5000, 5, 100, 300)};
+    auto skewed_hyb{ToHyb(skewed)};
+    std::vector<double> xs(skewed.N(), 0.5);
+    xs[37] = std::numeric_limits<double>::infinity();
+    xs[1000] = std::numeric_limits<double>::quiet_NaN();
+    SpMV(skewed_hyb, xs, y);
+    SpMV(skewed, xs, ref);
+    ASSERT_EQ(y.size(), ref.size());
+    EXPECT_EQ(std::memcmp(y.data(), ref.data(), y.size() * sizeof(double)), 0);
+}
@@ -0,0 +1,236 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "oops/convert.h"
+#include "oops/matrix_cache.h"
+#include "oops/matrix_market_io.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+namespace fs = std::filesystem;
+
+namespace {
+// 测试用工作目录，析构时删除
+struct WorkDir {
+    WorkDir(const char *tag) : path{fs::temp_directory_path() / ("oops_cache_test_" + std::to_string(getpid()) + tag)} {
+        fs::create_directories(path);
+    }
+    ~WorkDir() { fs::remove_all(path); }
+
+    fs::path path;
+};
+
+std::string MakeRealMtx(std::size_t n, std::size_t stored_nnz, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<std::size_t> index{1, n};
+    std::uniform_real_distribution<double> value{-10., 10.};
+    std::ostringstream oss;
+    oss.precision(17);
+    oss << "%%MatrixMarket matrix coordinate real general\n" << n << ' ' << n << ' ' << stored_nnz << '\n';
+    for (std::size_t i{0}; i < stored_nnz; ++i) {
+        oss << index(gen) << ' ' << index(gen) << ' ' << value(gen) << '\n';
+    }
+    return oss.str();
+}
+
+void WriteFile(const fs::path &path, const std::string &content) {
+    std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+    ofs << content;
+}
+} // namespace
+
+TEST(MatrixCache, Fingerprint) {
+    WorkDir dir{"fingerprint"};
+    const fs::path path{dir.path / "a.mtx"};
+    WriteFile(path, MakeRealMtx(100, 5000, 1));
+    MatrixCacheOptions options;
+    options.sample_block = 256;
+    options.sample_count = 4;
+    auto fingerprint{ComputeMatrixFingerprint(path, options)};
+    EXPECT_EQ(fingerprint, ComputeMatrixFingerprint(path, options));
+    EXPECT_EQ(fingerprint.size, fs::file_size(path));
+
+    // 改动采样块内的一个字节，保持大小与修改时间不变
+    const auto mtime{fs::last_write_time(path)};
+    std::string content{MakeRealMtx(100, 5000, 1)};
+    content[content.size() - 2] = content[content.size() - 2] == '1' ? '2' : '1';
+    WriteFile(path, content);
+    fs::last_write_time(path, mtime);
+    auto changed{ComputeMatrixFingerprint(path, options)};
+    EXPECT_EQ(changed.mtime_ns, fingerprint.mtime_ns);
+    EXPECT_NE(changed.sample_hash, fingerprint.sample_hash);
+    EXPECT_NE(changed.Key(), fingerprint.Key());
+}
+
+TEST(MatrixCache, ReadThrough) {
+    WorkDir dir{"read"};
+    const fs::path path{dir.path / "a.mtx"};
+    const std::string mtx{MakeRealMtx(300, 4000, 2)};
+    WriteFile(path, mtx);
+    MatrixCacheOptions options;
+    options.dir = dir.path / "cache";
+
+    std::istringstream is{mtx};
+    const auto ref{ReadMatrixMarket(is).Get<double, int32_t>()};
+    const auto ref_csr{ToCsr(ref)};
+    const MatrixCache cache{options};
+    const auto fingerprint{ComputeMatrixFingerprint(path, options)};
+    EXPECT_FALSE(cache.LoadCoo(fingerprint));
+
+    for (int pass{0}; pass < 2; ++pass) {
+        auto coo{ReadMatrixMarket(path, options).Get<double, int32_t>()};
+        EXPECT_EQ(coo.GetStore().row_indices, ref.GetStore().row_indices);
+        EXPECT_EQ(coo.GetStore().values, ref.GetStore().values);
+        auto csr{ReadMatrixMarketCsr(path, options).Get<double, int32_t>()};
+        EXPECT_EQ(csr.GetRowPtr(), ref_csr.GetRowPtr());
+        EXPECT_EQ(csr.GetColIndices(), ref_csr.GetColIndices());
+        EXPECT_EQ(csr.GetValues(), ref_csr.GetValues());
+    }
+    EXPECT_TRUE(cache.LoadCoo(fingerprint));
+    EXPECT_TRUE(cache.LoadCsr(fingerprint));
+    EXPECT_GT(cache.TotalBytes(), 0);
+
+    // 损坏的条目视为未命中并删除
+    const fs::path entry{options.dir / (fingerprint.Key() + ".csr")};
+    fs::resize_file(entry, fs::file_size(entry) - 1);
+    EXPECT_FALSE(cache.LoadCsr(fingerprint));
+    EXPECT_FALSE(fs::exists(entry));
+    auto csr{ReadMatrixMarketCsr(path, options).Get<double, int32_t>()};
+    EXPECT_EQ(csr.GetValues(), ref_csr.GetValues());
+    EXPECT_TRUE(fs::exists(entry));
+}
+
+// 截断或头部计数损坏的条目视为未命中并删除，不按头部计数分配内存
+TEST(MatrixCache, CorruptEntry) {
+    WorkDir dir{"corrupt"};
+    const fs::path path{dir.path / "a.mtx"};
+    const std::string mtx{MakeRealMtx(200, 3000, 5)};
+    WriteFile(path, mtx);
+    MatrixCacheOptions options;
+    options.dir = dir.path / "cache";
+    const MatrixCache cache{options};
+    const auto fingerprint{ComputeMatrixFingerprint(path, options)};
+    const fs::path coo_entry{options.dir / (fingerprint.Key() + ".coo")};
+    const fs::path csr_entry{options.dir / (fingerprint.Key() + ".csr")};
+    const auto ref{ReadMatrixMarketCsr(path, options).Get<double, int32_t>()};
+    ASSERT_TRUE(fs::exists(coo_entry));
+    ASSERT_TRUE(fs::exists(csr_entry));
+
+    // 头部为64字节，其中m位于偏移40，stored_nnz位于偏移56
+    auto overwrite = [](const fs::path &entry, std::streamoff offset, std::uint64_t value) {
+        std::fstream fs{entry, std::ios::binary | std::ios::in | std::ios::out};
+        fs.seekp(offset);
+        fs.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    for (std::uint64_t count : {std::uint64_t{1} << 60, ~std::uint64_t{0}, std::uint64_t{2999}}) {
+        overwrite(coo_entry, 56, count);
+        EXPECT_FALSE(cache.LoadCoo(fingerprint));
+        EXPECT_FALSE(fs::exists(coo_entry));
+        overwrite(csr_entry, 40, count);
+        EXPECT_FALSE(cache.LoadCsr(fingerprint));
+        EXPECT_FALSE(fs::exists(csr_entry));
+        EXPECT_EQ((ReadMatrixMarketCsr(path, options).Get<double, int32_t>().GetValues()), ref.GetValues());
+    }
+
+    for (std::uintmax_t size : {std::uintmax_t{0}, std::uintmax_t{10}, std::uintmax_t{64}, std::uintmax_t{1000}}) {
+        fs::resize_file(csr_entry, size);
+        EXPECT_FALSE(cache.LoadCsr(fingerprint));
+        EXPECT_FALSE(fs::exists(csr_entry));
+        fs::resize_file(coo_entry, size);
+        auto coo{ReadMatrixMarket(path, options).Get<double, int32_t>()};
+        EXPECT_EQ(coo.StoredNnz(), 3000);
+        EXPECT_TRUE(fs::exists(coo_entry));
+        EXPECT_EQ((ReadMatrixMarketCsr(path, options).Get<double, int32_t>().GetColIndices()), ref.GetColIndices());
+    }
+}
+
+// 大小相符但行指针或列号非法的CSR条目视为未命中并删除
+TEST(MatrixCache, CorruptCsrStructure) {
+    WorkDir dir{"structure"};
+    const fs::path path{dir.path / "a.mtx"};
+    WriteFile(path, MakeRealMtx(200, 3000, 6));
+    MatrixCacheOptions options;
+    options.dir = dir.path / "cache";
+    const MatrixCache cache{options};
+    const auto fingerprint{ComputeMatrixFingerprint(path, options)};
+    const fs::path csr_entry{options.dir / (fingerprint.Key() + ".csr")};
+    const auto ref{ReadMatrixMarketCsr(path, options).Get<double, int32_t>()};
+    ASSERT_TRUE(cache.LoadCsr(fingerprint));
+
+    // 头部64字节后依次为201个行指针与列号，均为int32_t
+    auto overwrite = [&csr_entry](std::streamoff offset, int32_t value) {
+        std::fstream fs{csr_entry, std::ios::binary | std::ios::in | std::ios::out};
+        fs.seekp(offset);
+        fs.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    const std::streamoff row_ptr{64};
+    const std::streamoff col_indices{row_ptr + 201 * 4};
+    const auto nnz{static_cast<int32_t>(ref.StoredNnz())};
+    const std::vector<std::pair<std::streamoff, int32_t>> corruptions{
+        {row_ptr, 1}, {row_ptr + 4, nnz + 1}, {row_ptr + 200 * 4, nnz - 1}, {col_indices, -1}, {col_indices, 200}};
+    for (const auto &[offset, value] : corruptions) {
+        overwrite(offset, value);
+        EXPECT_FALSE(cache.LoadCsr(fingerprint));
+        EXPECT_FALSE(fs::exists(csr_entry));
+        auto csr{ReadMatrixMarketCsr(path, options).Get<double, int32_t>()};
+        EXPECT_EQ(csr.GetRowPtr(), ref.GetRowPtr());
+        EXPECT_EQ(csr.GetColIndices(), ref.GetColIndices());
+        EXPECT_TRUE(cache.LoadCsr(fingerprint));
+    }
+}
+
+TEST(MatrixCache, PatternSymmetric) {
+    WorkDir dir{"pattern"};
+    const fs::path path{dir.path / "p.mtx"};
+    WriteFile(path, "%%MatrixMarket matrix coordinate patten symmetric\n4 4 3\n3 1\n1 1\n4 2\n");
+    MatrixCacheOptions options;
+    options.dir = dir.path / "cache";
+    ReadMatrixMarketCsr(path, options);
+    auto csr{ReadMatrixMarketCsr(path, options)};
+    EXPECT_EQ(csr.GetSymmetric(), MatrixSymmetric::SYMMETRIC_LOWER);
+    EXPECT_EQ((csr.Get<std::monostate, int32_t>().GetColIndices()), (std::vector<int32_t>{0, 0, 1}));
+}
+
+TEST(MatrixCache, EvictLeastRecentlyUsed) {
+    WorkDir dir{"evict"};
+    MatrixCacheOptions options;
+    options.dir = dir.path / "cache";
+    std::vector<MatrixFingerprint> fingerprints;
+    for (unsigned i{0}; i < 3; ++i) {
+        const fs::path path{dir.path / (std::to_string(i) + ".mtx")};
+        WriteFile(path, MakeRealMtx(50, 500, i));
+        fingerprints.push_back(ComputeMatrixFingerprint(path, options));
+        ReadMatrixMarket(path, options);
+    }
+    const MatrixCache cache{options};
+    const std::size_t total{cache.TotalBytes()};
+    // 访问最早写入的条目后，淘汰至约两个条目时应保留它
+    const auto now{fs::file_time_type::clock::now()};
+    for (unsigned i{0}; i < 3; ++i) {
+        fs::last_write_time(options.dir / (fingerprints[i].Key() + ".coo"), now - std::chrono::seconds{10 - i});
+    }
+    EXPECT_TRUE(cache.LoadCoo(fingerprints[0]));
+
+    options.size_limit = total * 2 / 3 + 1;
+    MatrixCache small{options};
+    small.Evict();
+    EXPECT_LE(small.TotalBytes(), options.size_limit);
+    EXPECT_TRUE(small.LoadCoo(fingerprints[0]));
+    EXPECT_FALSE(small.LoadCoo(fingerprints[1]));
+    EXPECT_TRUE(small.LoadCoo(fingerprints[2]));
+}
+
+TEST(MatrixCache, Disabled) {
+    WorkDir dir{"disabled"};
+    const fs::path path{dir.path / "a.mtx"};
+    WriteFile(path, MakeRealMtx(20, 50, 3));
+    unsetenv("OOPS_MATRIX_CACHE_DIR");
+    MatrixCache cache;
+    EXPECT_FALSE(cache.Enabled());
+    EXPECT_EQ(ReadMatrixMarket(path).StoredNnz(), 50);
+    EXPECT_THROW(ReadMatrixMarket(dir.path / "missing.mtx"), std::runtime_error);
+}
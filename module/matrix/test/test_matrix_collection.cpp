@@ -0,0 +1,117 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "oops/matrix_collection.h"
+#include "oops/matrix_market_io.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+namespace fs = std::filesystem;
+
+namespace {
+// 测试用工作目录，析构时删除
+struct WorkDir {
+    WorkDir(const char *tag)
+        : path{fs::temp_directory_path() / ("oops_collection_test_" + std::to_string(getpid()) + tag)} {
+        fs::create_directories(path);
+    }
+    ~WorkDir() { fs::remove_all(path); }
+
+    fs::path path;
+};
+
+std::string MakeRealMtx(std::size_t n, std::size_t stored_nnz, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<std::size_t> index{1, n};
+    std::uniform_real_distribution<double> value{-10., 10.};
+    std::ostringstream oss;
+    oss.precision(17);
+    oss << "%%MatrixMarket matrix coordinate real general\n" << n << ' ' << n << ' ' << stored_nnz << '\n';
+    for (std::size_t i{0}; i < stored_nnz; ++i) {
+        oss << index(gen) << ' ' << index(gen) << ' ' << value(gen) << '\n';
+    }
+    return oss.str();
+}
+
+// 写入count个大小不一的矩阵，返回各自的文本
+std::vector<std::string> WriteCollection(const fs::path &dir, std::size_t count) {
+    std::vector<std::string> texts;
+    for (std::size_t i{0}; i < count; ++i) {
+        texts.push_back(MakeRealMtx(20 + i, i % 4 == 3 ? 30000 : 10 * (i + 1), static_cast<unsigned>(i)));
+        // 补零使文件名顺序与编号一致
+        const std::string index{std::to_string(i)};
+        std::ofstream{dir / ("m" + std::string(index.size() < 2 ? 2 - index.size() : 0, '0') + index + ".mtx")}
+            << texts.back();
+    }
+    return texts;
+}
+
+void ExpectSame(const AnyCoo &coo, const std::string &text) {
+    std::istringstream is{text};
+    const auto ref{ReadMatrixMarket(is).Get<double, int32_t>().GetStore()};
+    const auto &store{coo.Get<double, int32_t>().GetStore()};
+    EXPECT_EQ(store.row_indices, ref.row_indices);
+    EXPECT_EQ(store.col_indices, ref.col_indices);
+    EXPECT_EQ(store.values, ref.values);
+}
+} // namespace
+
+TEST(MatrixCollection, List) {
+    WorkDir dir{"list"};
+    WriteCollection(dir.path, 3);
+    fs::create_directories(dir.path / "sub");
+    std::ofstream{dir.path / "notes.txt"} << "x";
+    std::ofstream{dir.path / "sub" / "s.mtx"} << MakeRealMtx(3, 2, 0);
+
+    const auto listed{ListMatrixCollection(dir.path.string())};
+    ASSERT_EQ(listed.size(), 3);
+    EXPECT_EQ(listed[0].filename(), "m00.mtx");
+    EXPECT_EQ(listed[2].filename(), "m02.mtx");
+    EXPECT_EQ(ListMatrixCollection((dir.path / "m0[12].mtx").string()).size(), 2);
+    EXPECT_EQ(ListMatrixCollection((dir.path / "*.txt").string()).size(), 1);
+    EXPECT_TRUE(ListMatrixCollection((dir.path / "none*").string()).empty());
+}
+
+TEST(MatrixCollection, LoadInOrder) {
+    WorkDir dir{"load"};
+    const auto texts{WriteCollection(dir.path, 12)};
+    for (std::size_t max_files : {0, 1, 3}) {
+        CollectionLoadOptions options;
+        options.max_files_in_flight = max_files;
+        options.max_bytes_in_flight = 64 << 10;
+        // 含30000个元素的文件按大文件在调用线程上分块解析
+        options.large_file_bytes = 256 << 10;
+        std::size_t next{0};
+        LoadMatrixCollection(
+            dir.path.string(),
+            [&](std::size_t index, const fs::path &path, AnyCoo coo) {
+                EXPECT_EQ(index, next++);
+                EXPECT_EQ(path.filename(), ListMatrixCollection(dir.path.string())[index].filename());
+                ExpectSame(coo, texts[index]);
+            },
+            options);
+        EXPECT_EQ(next, texts.size());
+    }
+}
+
+TEST(MatrixCollection, Errors) {
+    WorkDir dir{"errors"};
+    WriteCollection(dir.path, 4);
+    std::ofstream{dir.path / "m01.mtx"} << "%%MatrixMarket matrix coordinate real general\n2 2 3\n1 1 1\n";
+    std::size_t delivered{0};
+    try {
+        LoadMatrixCollection(dir.path.string(), [&](std::size_t, const fs::path &, AnyCoo) { ++delivered; });
+        FAIL();
+    } catch (const std::runtime_error &e) {
+        EXPECT_NE(std::string{e.what()}.find("m01.mtx"), std::string::npos);
+    }
+    EXPECT_EQ(delivered, 1);
+
+    std::vector<fs::path> missing{dir.path / "missing.mtx"};
+    EXPECT_THROW(LoadMatrixCollection(missing, [](std::size_t, const fs::path &, AnyCoo) {}), std::runtime_error);
+}
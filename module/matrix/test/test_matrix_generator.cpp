@@ -0,0 +1,135 @@
+#include "oops/matrix_generator.h"
+#include "oops/sparse_product.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+// 逐行串行调用生成器得到的参考CSR
+template <typename Value, typename Generator>
+CsrStore<Value, int64_t> SerialReference(const Generator &gen) {
+    CsrStore<Value, int64_t> store;
+    store.n = gen.N();
+    store.row_ptr.push_back(0);
+    for (std::size_t r{0}; r < gen.M(); ++r) {
+        gen.template Row<Value>(r, [&](std::size_t c, const Value &v) {
+            store.col_indices.push_back(static_cast<int64_t>(c));
+            if constexpr (!std::is_same_v<Value, std::monostate>) {
+                store.values.push_back(v);
+            }
+        });
+        store.row_ptr.push_back(static_cast<int64_t>(store.col_indices.size()));
+    }
+    return store;
+}
+
+template <typename Value, typename Generator>
+void ExpectMatchesSerial(const Generator &gen) {
+    const auto ref{SerialReference<Value>(gen)};
+    const auto csr{GenerateCsr<Value, int64_t>(gen)};
+    EXPECT_EQ(csr.GetRowPtr(), ref.row_ptr);
+    EXPECT_EQ(csr.GetColIndices(), ref.col_indices);
+    EXPECT_EQ(csr.GetValues(), ref.values);
+
+    const auto coo{GenerateCoo<Value, int64_t>(gen)};
+    EXPECT_EQ(coo.GetStore().col_indices, ref.col_indices);
+    EXPECT_EQ(coo.GetStore().values, ref.values);
+    for (std::size_t r{0}; r < gen.M(); ++r) {
+        for (auto i{ref.row_ptr[r]}; i < ref.row_ptr[r + 1]; ++i) {
+            ASSERT_EQ(coo.GetStore().row_indices[i], static_cast<int64_t>(r));
+        }
+    }
+}
+
+template <typename Value>
+bool IsSymmetric(const Csr<Value, int32_t> &a) {
+    auto t{Transpose(a)};
+    return t.GetRowPtr() == a.GetRowPtr() && t.GetColIndices() == a.GetColIndices() && t.GetValues() == a.GetValues();
+}
+} // namespace
+
+TEST(MatrixGenerator, Laplacian) {
+    auto a{GenerateCsr<double, int32_t>(Laplacian2DGenerator{3, 4})};
+    EXPECT_EQ(a.M(), 12);
+    EXPECT_EQ(a.StoredNnz(), 12 + 2 * (2 * 4 + 3 * 3));
+    // 节点(1, 1)
+    const auto &row_ptr{a.GetRowPtr()};
+    EXPECT_EQ(
+        std::vector<int32_t>(a.GetColIndices().begin() + row_ptr[5], a.GetColIndices().begin() + row_ptr[6]),
+        (std::vector<int32_t>{1, 4, 5, 6, 9}));
+    EXPECT_TRUE(IsSymmetric(a));
+
+    auto b{GenerateCsr<float, int32_t>(Laplacian3DGenerator{3, 4, 5})};
+    EXPECT_EQ(b.M(), 60);
+    EXPECT_EQ(b.StoredNnz(), 60 + 2 * (2 * 4 * 5 + 3 * 3 * 5 + 3 * 4 * 4));
+    EXPECT_TRUE(IsSymmetric(b));
+    ExpectMatchesSerial<double>(Laplacian3DGenerator{20, 30, 40});
+}
+
+TEST(MatrixGenerator, Banded) {
+    BandedGenerator gen{50000, 3, 2, 7};
+    auto a{GenerateCsr<double, int32_t>(gen)};
+    EXPECT_EQ(a.StoredNnz(), 50000 * 6 - (1 + 2 + 3) - (1 + 2));
+    ExpectMatchesSerial<double>(gen);
+    ExpectMatchesSerial<std::complex<float>>(gen);
+    ExpectMatchesSerial<intmax_t>(gen);
+    // 不同种子得到不同数值
+    auto b{GenerateCsr<double, int32_t>(BandedGenerator{50000, 3, 2, 8})};
+    EXPECT_EQ(b.GetColIndices(), a.GetColIndices());
+    EXPECT_NE(b.GetValues(), a.GetValues());
+}
+
+TEST(MatrixGenerator, ErdosRenyi) {
+    ErdosRenyiGenerator gen{40000, 30000, 8, 3};
+    auto a{GenerateCsr<double, int32_t>(gen)};
+    EXPECT_NEAR(static_cast<double>(a.StoredNnz()) / a.M(), 8, 0.1);
+    ExpectMatchesSerial<double>(gen);
+    // 结构与数值类型无关
+    auto p{GenerateCsr<std::monostate, int32_t>(gen)};
+    EXPECT_EQ(p.GetColIndices(), a.GetColIndices());
+    auto dense{GenerateCsr<double, int32_t>(ErdosRenyiGenerator{10, 7, 100, 3})};
+    EXPECT_EQ(dense.StoredNnz(), 70);
+    EXPECT_EQ((GenerateCsr<double, int32_t>(ErdosRenyiGenerator{10, 7, 0, 3}).StoredNnz()), 0);
+}
+
+TEST(MatrixGenerator, Rmat) {
+    RmatGenerator gen{14, 8, 11};
+    auto coo{GenerateCoo<double, int32_t>(gen)};
+    EXPECT_EQ(coo.M(), 1 << 14);
+    EXPECT_EQ(coo.StoredNnz(), 8 << 14);
+    for (std::size_t i{0}; i < coo.StoredNnz(); i += 997) {
+        std::size_t row, col;
+        const double v{gen.Entry<double>(i, row, col)};
+        EXPECT_EQ(coo.GetStore().row_indices[i], static_cast<int32_t>(row));
+        EXPECT_EQ(coo.GetStore().col_indices[i], static_cast<int32_t>(col));
+        EXPECT_EQ(coo.GetStore().values[i], v);
+    }
+    // 幂律分布：最大行度远大于平均度
+    auto csr{GenerateCsr<double, int32_t>(gen)};
+    std::size_t max_degree{0};
+    for (std::size_t r{0}; r < csr.M(); ++r) {
+        max_degree = std::max<std::size_t>(max_degree, csr.GetRowPtr()[r + 1] - csr.GetRowPtr()[r]);
+    }
+    EXPECT_GT(max_degree, 20 * 8);
+    EXPECT_THROW((RmatGenerator{10, 8, 1, 0.6, 0.3, 0.3}), std::invalid_argument);
+    EXPECT_THROW((GenerateCsr<double, int32_t>(RmatGenerator{40, 1, 1})), std::overflow_error);
+}
+
+TEST(MatrixGenerator, BlockDiagonal) {
+    auto a{GenerateCsr<double, int32_t>(BlockDiagonalGenerator{4, 3, 0, 5})};
+    EXPECT_EQ(a.M(), 12);
+    EXPECT_EQ(a.StoredNnz(), 4 * 9);
+    EXPECT_TRUE(IsSymmetric(a));
+
+    BlockDiagonalGenerator chain{1000, 4, 1, 5};
+    auto b{GenerateCsr<double, int32_t>(chain)};
+    EXPECT_EQ(b.M(), 3 * 999 + 4);
+    EXPECT_TRUE(IsSymmetric(b));
+    // 重叠行位于两个块中，列区间为两块之并
+    const auto &row_ptr{b.GetRowPtr()};
+    EXPECT_EQ(row_ptr[4] - row_ptr[3], 7);
+    EXPECT_EQ(b.GetColIndices()[row_ptr[3]], 0);
+    ExpectMatchesSerial<double>(chain);
+    ExpectMatchesSerial<std::monostate>(chain);
+    EXPECT_THROW((BlockDiagonalGenerator{4, 3, 3, 5}), std::invalid_argument);
+}
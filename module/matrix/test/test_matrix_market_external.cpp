@@ -0,0 +1,93 @@
+#include <filesystem>
+#include <random>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "oops/convert.h"
+#include "oops/matrix_market_external.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+namespace fs = std::filesystem;
+
+namespace {
+// 测试用工作目录，析构时删除
+struct WorkDir {
+    WorkDir(const char *tag) : path{fs::temp_directory_path() / ("oops_ext_test_" + std::to_string(getpid()) + tag)} {
+        fs::create_directories(path / "tmp");
+    }
+    ~WorkDir() { fs::remove_all(path); }
+
+    fs::path path;
+};
+
+// 随机生成含重复元素与空行的实数一般矩阵
+std::string MakeRealMtx(std::size_t m, std::size_t n, std::size_t stored_nnz) {
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<std::size_t> row{1, m / 2}, col{1, n};
+    std::uniform_real_distribution<double> value{-10., 10.};
+    std::ostringstream oss;
+    oss.precision(17);
+    oss << "%%MatrixMarket matrix coordinate real general\n% comment\n" << m << ' ' << n << ' ' << stored_nnz << '\n';
+    for (std::size_t i{0}; i < stored_nnz; ++i) {
+        // 行号取偶数，奇数行为空行
+        oss << 2 * row(gen) << ' ' << (i % 7 == 0 ? 3 : col(gen)) << ' ' << value(gen) << '\n';
+    }
+    return oss.str();
+}
+} // namespace
+
+TEST(MatrixMarketExternal, MultiPassMatchesInMemory) {
+    WorkDir dir{"multi"};
+    const std::string mtx{MakeRealMtx(200, 150, 3000)};
+    std::istringstream external_is{mtx};
+    ExternalCsrOptions options;
+    options.memory_budget = 4096;
+    options.temp_dir = dir.path / "tmp";
+    auto external{ConvertMatrixMarketToCsr(external_is, dir.path / "a", options)};
+    EXPECT_EQ(external.m, 200);
+    EXPECT_EQ(external.stored_nnz, 3000);
+    EXPECT_GT(external.num_runs, 2);
+    EXPECT_GT(external.merge_passes, 1);
+    EXPECT_TRUE(fs::is_empty(options.temp_dir));
+    EXPECT_EQ(fs::file_size(external.row_ptr_path), 201 * sizeof(int64_t));
+
+    std::istringstream is{mtx};
+    auto ref{ToCsr<int64_t>(ReadMatrixMarket(is).Get<double, int32_t>())};
+    auto csr{ReadExternalCsr<double, int32_t>(external)};
+    EXPECT_EQ(csr.GetRowPtr(), ref.GetRowPtr());
+    EXPECT_EQ(csr.GetColIndices(), ref.GetColIndices());
+    EXPECT_EQ(csr.GetValues(), ref.GetValues());
+    EXPECT_THROW((ReadExternalCsr<float, int32_t>(external)), std::invalid_argument);
+    EXPECT_THROW((ReadExternalCsr<double, int64_t>(external)), std::invalid_argument);
+}
+
+TEST(MatrixMarketExternal, SingleRunPatternSymmetric) {
+    WorkDir dir{"pattern"};
+    std::istringstream is{"%%MatrixMarket matrix coordinate patten symmetric\n4 4 5\n3 1\n1 1\n4 2\n3 3\n2 2\n"};
+    auto external{ConvertMatrixMarketToCsr(is, dir.path / "p")};
+    EXPECT_EQ(external.num_runs, 1);
+    EXPECT_EQ(external.merge_passes, 1);
+    EXPECT_TRUE(external.values_path.empty());
+    auto csr{ReadExternalCsr<std::monostate, int32_t>(external)};
+    EXPECT_EQ(csr.GetSymmetric(), MatrixSymmetric::SYMMETRIC_LOWER);
+    EXPECT_EQ(csr.GetRowPtr(), (std::vector<int64_t>{0, 1, 2, 4, 5}));
+    EXPECT_EQ(csr.GetColIndices(), (std::vector<int32_t>{0, 1, 0, 2, 1}));
+}
+
+TEST(MatrixMarketExternal, Errors) {
+    WorkDir dir{"errors"};
+    ExternalCsrOptions options;
+    options.temp_dir = dir.path / "tmp";
+    std::istringstream out_of_range{"%%MatrixMarket matrix coordinate integer general\n2 2 2\n1 1 5\n3 1 7\n"};
+    EXPECT_THROW(ConvertMatrixMarketToCsr(out_of_range, dir.path / "e", options), std::runtime_error);
+    EXPECT_TRUE(fs::is_empty(options.temp_dir));
+
+    std::istringstream truncated{"%%MatrixMarket matrix coordinate integer general\n2 2 3\n1 1 5\n"};
+    EXPECT_THROW(ConvertMatrixMarketToCsr(truncated, dir.path / "e", options), std::runtime_error);
+
+    options.memory_budget = 8;
+    std::istringstream small{"%%MatrixMarket matrix coordinate integer general\n2 2 1\n1 1 5\n"};
+    EXPECT_THROW(ConvertMatrixMarketToCsr(small, dir.path / "e", options), std::invalid_argument);
+}
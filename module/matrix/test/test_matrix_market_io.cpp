@@ -1,5 +1,7 @@
 #include <filesystem>
 #include <fstream>
+#include <random>
+#include <sstream>
 
 #include "oops/matrix_market_io.h"
 #include "gtest/gtest.h"
@@ -41,3 +43,71 @@ TEST(MatrixCoo, AnyCoo) {
 
     any_coo.ConvertInplace<float, int32_t>();
 }
+
+TEST(MatrixMarket, ParseMatchesStream) {
+    // 超过单块大小以覆盖多块拼接，含空行、CRLF、前导正号与多余的元素
+    std::mt19937 gen{7};
+    std::uniform_int_distribution<int> index{1, 5000};
+    std::uniform_real_distribution<double> value{-1e3, 1e3};
+    std::ostringstream oss;
+    oss.precision(17);
+    constexpr std::size_t stored_nnz{80000};
+    oss << "%%MatrixMarket matrix coordinate real general\n%\n\n5000 5000 " << stored_nnz << "\r\n";
+    for (std::size_t i{0}; i < stored_nnz + 3; ++i) {
+        const double v{value(gen)};
+        oss << index(gen) << ' ' << index(gen) << ' ' << (v > 0 && i % 3 == 0 ? "+" : "") << v
+            << (i % 5 == 0 ? "\r\n" : "\n") << (i % 1000 == 0 ? "\n" : "");
+    }
+    const std::string text{oss.str()};
+    std::istringstream is{text};
+    const auto ref{ReadMatrixMarket(is).Get<double, int32_t>().GetStore()};
+    const auto coo{ParseMatrixMarket(text).Get<double, int32_t>().GetStore()};
+    EXPECT_EQ(coo.row_indices, ref.row_indices);
+    EXPECT_EQ(coo.col_indices, ref.col_indices);
+    EXPECT_EQ(coo.values, ref.values);
+}
+
+// 前stored_nnz个元素之后的行两种读取方式均忽略，即使无法解析
+TEST(MatrixMarket, TrailingData) {
+    auto check = [](const std::string &text) {
+        std::istringstream is{text};
+        const auto ref{ReadMatrixMarket(is).Get<double, int32_t>().GetStore()};
+        const auto coo{ParseMatrixMarket(text).Get<double, int32_t>().GetStore()};
+        EXPECT_EQ(coo.row_indices, ref.row_indices);
+        EXPECT_EQ(coo.col_indices, ref.col_indices);
+        EXPECT_EQ(coo.values, ref.values);
+        return coo.values.size();
+    };
+    const std::string header{"%%MatrixMarket matrix coordinate real general\n"};
+    EXPECT_EQ(check(header + "2 2 2\n1 1 1\n2 2 2\n1 2 3\n"), 2);
+    EXPECT_EQ(check(header + "2 2 2\n1 1 1\n2 2 2\nnot an entry\n1 x\n"), 2);
+
+    // 多块解析，无法解析的行位于靠后的块
+    std::ostringstream oss;
+    constexpr std::size_t stored_nnz{200000};
+    oss << header << "1000 1000 " << stored_nnz << '\n';
+    for (std::size_t i{0}; i < stored_nnz; ++i) {
+        oss << i % 1000 + 1 << ' ' << i / 1000 % 1000 + 1 << ' ' << i << '\n';
+    }
+    oss << "trailing garbage\n";
+    for (std::size_t i{0}; i < 100000; ++i) {
+        oss << "1 1 1\n";
+    }
+    EXPECT_EQ(check(oss.str()), stored_nnz);
+}
+
+TEST(MatrixMarket, ParseTypes) {
+    auto complex{ParseMatrixMarket("%%MatrixMarket matrix coordinate complex hermitian\n2 2 2\n1 1 1.5 0\n2 1 -2 3")};
+    EXPECT_EQ(complex.GetSymmetric(), MatrixSymmetric::HERMITIAN_LOWER);
+    EXPECT_EQ(
+        (complex.Get<std::complex<double>, int32_t>().GetStore().values),
+        (std::vector<std::complex<double>>{{1.5, 0}, {-2, 3}}));
+    auto pattern{ParseMatrixMarket("%%MatrixMarket matrix coordinate patten general\n3 3 2\n3 1\n2 2\n")};
+    EXPECT_EQ((pattern.Get<std::monostate, int32_t>().GetStore().row_indices), (std::vector<int32_t>{2, 1}));
+    auto integer{ParseMatrixMarket("%%MatrixMarket matrix coordinate integer general\n1 1 1\n1 1 -7\n")};
+    EXPECT_EQ((integer.Get<intmax_t, int32_t>().GetStore().values), (std::vector<intmax_t>{-7}));
+
+    const std::string header{"%%MatrixMarket matrix coordinate real general\n"};
+    EXPECT_THROW(ParseMatrixMarket(header + "2 2 2\n1 1 1\n"), std::runtime_error);
+    EXPECT_THROW(ParseMatrixMarket(header + "2 2 1\n1 x 1\n"), std::runtime_error);
+}
@@ -0,0 +1,89 @@
+#include "oops/convert.h"
+#include "oops/matrix_powers.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+// 半带宽为bandwidth的非对称带状矩阵，far为真时另加稀疏的反对角元制造非局部依赖
+Csr<double, int32_t> MakeBanded(int32_t n, int32_t bandwidth, bool far = true) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = n;
+    for (int32_t r{0}; r < n; ++r) {
+        for (int32_t c{std::max(r - bandwidth, 0)}; c <= std::min(r + bandwidth, n - 1); ++c) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(c);
+            store.values.push_back(r == c ? 0.6 : 0.1 / (1 + r % 3 + c - r + bandwidth));
+        }
+        if (far && r % 97 == 0 && std::abs(n - 1 - 2 * r) > bandwidth) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(n - 1 - r);
+            store.values.push_back(0.05);
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store)});
+}
+
+std::vector<double> ReferencePowers(const Csr<double, int32_t> &a, const std::vector<double> &x, std::size_t s) {
+    const std::size_t n{a.M()};
+    std::vector<double> v(n * (s + 1));
+    std::copy(x.begin(), x.end(), v.begin());
+    for (std::size_t k{1}; k <= s; ++k) {
+        SpMV(a, v.data() + (k - 1) * n, v.data() + k * n);
+    }
+    return v;
+}
+} // namespace
+
+TEST(MatrixPowers, MatchSpMV) {
+    auto a{MakeBanded(3000, 3)};
+    std::vector<double> x(a.N());
+    for (std::size_t i{0}; i < x.size(); ++i) {
+        x[i] = 1.0 + static_cast<double>(i % 11) / 7;
+    }
+    for (std::size_t s : {0, 1, 4, 8}) {
+        for (std::size_t block_rows : {0, 1, 64, 5000}) {
+            MatrixPowersOptions options;
+            options.block_rows = block_rows;
+            MatrixPowers<double, int32_t> powers{a, s, options};
+            std::vector<double> v;
+            powers.Apply(x, v);
+            // 行内求和顺序与SpMV一致，结果逐位相同
+            EXPECT_EQ(v, ReferencePowers(a, x, s));
+        }
+    }
+}
+
+TEST(MatrixPowers, GhostZone) {
+    // 三对角矩阵s步依赖区每侧扩展s行
+    auto a{MakeBanded(1000, 1, false)};
+    MatrixPowersOptions options;
+    options.block_rows = 100;
+    MatrixPowers<double, int32_t> powers{a, 4, options};
+    EXPECT_EQ(powers.NumBlocks(), 10);
+    // 内部块第k步计算100 + 2 * (4 - k)行，两端块少一侧
+    const std::size_t interior{100 * 4 + 2 * (3 + 2 + 1)};
+    const std::size_t boundary{100 * 4 + (3 + 2 + 1)};
+    EXPECT_EQ(powers.ComputedRows(), 8 * interior + 2 * boundary);
+
+    // 超出ldv的列写入指定位置
+    std::vector<double> x(a.N(), 1.0);
+    std::vector<double> v(1010 * 5, -1.0);
+    powers.Apply(x.data(), v.data(), 1010);
+    auto ref{ReferencePowers(a, x, 4)};
+    for (std::size_t k{0}; k <= 4; ++k) {
+        EXPECT_TRUE(std::equal(ref.begin() + k * 1000, ref.begin() + (k + 1) * 1000, v.begin() + k * 1010));
+        EXPECT_EQ(v[k * 1010 + 1000], -1.0);
+    }
+}
+
+TEST(MatrixPowers, InvalidArgument) {
+    CooStore<double, int32_t> store{2, 2, {2, -1, 2}, {0, 1, 1}, {0, 0, 1}};
+    auto lower{ToCsr(Coo<double, int32_t>{store, MatrixSymmetric::SYMMETRIC_LOWER})};
+    EXPECT_THROW((MatrixPowers<double, int32_t>{lower, 2}), std::invalid_argument);
+
+    auto a{MakeBanded(10, 1)};
+    MatrixPowers<double, int32_t> powers{a, 2};
+    std::vector<double> x(9), v;
+    EXPECT_THROW(powers.Apply(x, v), std::invalid_argument);
+}
@@ -0,0 +1,87 @@
+#include "oops/convert.h"
+#include "oops/matrix_view.h"
+#include "oops/spmv.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+TEST(MatrixView, CsrView) {
+    // 外部缓冲，不经过Csr
+    std::vector<double> values{2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7};
+    std::vector<int64_t> row_ptr{0, 3, 3, 6, 6, 8};
+    std::vector<int32_t> col_indices{0, 1, 4, 0, 2, 4, 0, 4};
+    CsrView<double, int32_t, int64_t> view{5, 5, values.data(), row_ptr.data(), col_indices.data()};
+    EXPECT_EQ(view.M(), 5);
+    EXPECT_EQ(view.N(), 5);
+    EXPECT_EQ(view.StoredNnz(), 8);
+    EXPECT_EQ(view.DiagNnz(), 3);
+    EXPECT_EQ(view.Nnz(), 8);
+
+    std::vector<double> x{1, 2, 3, 4, 5}, y;
+    SpMV(view, x, y);
+    std::vector<double> ref;
+    SpMV(Csr<double, int32_t, int64_t>{{5, values, row_ptr, col_indices}}, x, ref);
+    EXPECT_EQ(y, ref);
+
+    // 行区间子视图共享底层数据
+    auto rows{view.Rows(2, 5)};
+    EXPECT_EQ(rows.M(), 3);
+    EXPECT_EQ(rows.N(), 5);
+    EXPECT_EQ(rows.StoredNnz(), 5);
+    EXPECT_EQ(rows.DiagNnz(), 2);
+    EXPECT_EQ(rows.RowOffset(), 2);
+    EXPECT_EQ(rows.GetValues(), values.data());
+    EXPECT_EQ(rows.GetRowPtr(), row_ptr.data() + 2);
+    SpMV(rows, x, y);
+    EXPECT_EQ(y, (std::vector<double>{ref[2], ref[3], ref[4]}));
+    auto nested{rows.Rows(2, 3)};
+    EXPECT_EQ(nested.RowOffset(), 4);
+    EXPECT_EQ(nested.DiagNnz(), 1);
+    SpMV(nested, x, y);
+    EXPECT_EQ(y, (std::vector<double>{ref[4]}));
+
+    EXPECT_THROW(view.Rows(3, 6), std::out_of_range);
+    EXPECT_THROW(SpMV(view, std::vector<double>(4), y), std::invalid_argument);
+}
+
+TEST(MatrixView, SymmetricCsrView) {
+    CooStore<double, int32_t> store{3, 3, {3.2, 5.4, 2.0, 1.1}, {0, 1, 2, 2}, {0, 1, 0, 2}};
+    auto csr{ToCsr(Coo<double, int32_t>{store, MatrixSymmetric::SYMMETRIC_LOWER})};
+    CsrView<double, int32_t> view{csr};
+    EXPECT_EQ(view.GetSymmetric(), MatrixSymmetric::SYMMETRIC_LOWER);
+    EXPECT_EQ(view.Nnz(), csr.Nnz());
+
+    std::vector<double> x{1, 2, 3}, y, ref;
+    SpMV(view, x, y);
+    SpMV(csr, x, ref);
+    EXPECT_EQ(y, ref);
+    EXPECT_THROW(view.Rows(0, 1), std::invalid_argument);
+}
+
+TEST(MatrixView, CooView) {
+    CooStore<double, int32_t> store{3, 3, {1, 2, 3, 4, 5}, {2, 0, 1, 0, 2}, {2, 1, 1, 0, 0}};
+    Coo<double, int32_t> coo{store};
+    CooView<double, int32_t> view{coo};
+    EXPECT_EQ(view.StoredNnz(), 5);
+    EXPECT_EQ(view.DiagNnz(), 3);
+
+    // 视图转换与持有对象转换结果一致
+    auto csr{ToCsr(view)};
+    auto ref{ToCsr(coo)};
+    EXPECT_EQ(csr.GetRowPtr(), ref.GetRowPtr());
+    EXPECT_EQ(csr.GetColIndices(), ref.GetColIndices());
+    EXPECT_EQ(csr.GetValues(), ref.GetValues());
+
+    // 元素区间子视图
+    auto part{ToCsr(view.Entries(1, 4))};
+    EXPECT_EQ(part.M(), 3);
+    EXPECT_EQ(part.GetRowPtr(), (std::vector<int32_t>{0, 2, 3, 3}));
+    EXPECT_EQ(part.GetColIndices(), (std::vector<int32_t>{0, 1, 1}));
+    EXPECT_EQ(part.GetValues(), (std::vector<double>{4, 2, 3}));
+    EXPECT_THROW(view.Entries(2, 6), std::out_of_range);
+}
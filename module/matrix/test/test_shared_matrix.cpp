@@ -0,0 +1,152 @@
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "oops/allocator.h"
+#include "oops/convert.h"
+#include "oops/shared_matrix.h"
+#include "oops/spmv.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+static std::string SegmentName(const char *tag) { return "/oops_test_" + std::to_string(getpid()) + "_" + tag; }
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+static Coo<double, int32_t> MakeCoo() {
+    return CooStore<double, int32_t>{
+        5, 5, {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}, {0, 0, 0, 2, 2, 2, 4, 4}, {0, 1, 4, 0, 2, 4, 0, 4}};
+}
+
+TEST(SharedMatrix, PublishAttachCsr) {
+    const auto name{SegmentName("csr")};
+    auto csr{ToCsr<int64_t>(MakeCoo())};
+    auto published{SharedMatrix::Publish(name, csr)};
+    EXPECT_EQ(published.UseCount(), 1);
+    {
+        auto attached{SharedMatrix::Attach(name)};
+        EXPECT_EQ(attached.UseCount(), 2);
+        EXPECT_EQ(attached.Info().format, MatrixFormat::SPARSE_CSR);
+        auto view{attached.GetCsr<double, int32_t, int64_t>()};
+        EXPECT_EQ(view.M(), 5);
+        EXPECT_EQ(view.N(), 5);
+        EXPECT_EQ(view.StoredNnz(), 8);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.GetValues()) % CACHE_LINE_SIZE, 0);
+
+        std::vector<double> x{1, 2, 3, 4, 5}, y, ref;
+        SpMV(view, x, y);
+        SpMV(csr, x, ref);
+        EXPECT_EQ(y, ref);
+
+        EXPECT_THROW((attached.GetCsr<double, int32_t>()), std::invalid_argument);
+        EXPECT_THROW((attached.GetCsr<float, int32_t, int64_t>()), std::invalid_argument);
+        EXPECT_THROW((attached.GetCoo<double, int32_t>()), std::invalid_argument);
+    }
+    EXPECT_EQ(published.UseCount(), 1);
+    EXPECT_THROW(SharedMatrix::Publish(name, csr), std::system_error);
+}
+
+TEST(SharedMatrix, PublishAttachCoo) {
+    const auto name{SegmentName("coo")};
+    auto coo{MakeCoo()};
+    auto published{SharedMatrix::Publish(name, coo)};
+    auto attached{SharedMatrix::Attach(name)};
+    auto view{attached.GetCoo<double, int32_t>()};
+    EXPECT_EQ(view.StoredNnz(), 8);
+    EXPECT_EQ(view.GetRowIndices()[3], 2);
+    EXPECT_EQ(view.GetColIndices()[7], 4);
+    EXPECT_EQ(view.GetValues()[5], 8.2);
+
+    auto csr{ToCsr(view)};
+    EXPECT_EQ(csr.GetColIndices(), ToCsr(coo).GetColIndices());
+}
+
+TEST(SharedMatrix, UnlinkOnLastDetach) {
+    const auto name{SegmentName("unlink")};
+    auto attached{[&name] {
+        auto published{SharedMatrix::Publish(name, MakeCoo())};
+        return SharedMatrix::Attach(name);
+    }()};
+    // 发布方已分离，段仍可用
+    EXPECT_EQ(attached.UseCount(), 1);
+    EXPECT_EQ((attached.GetCoo<double, int32_t>().GetValues()[0]), 2.3);
+
+    attached.Detach();
+    EXPECT_FALSE(attached.Attached());
+    EXPECT_THROW(SharedMatrix::Attach(name), std::system_error);
+    const int fd{shm_open(name.c_str(), O_RDONLY, 0)};
+    EXPECT_LT(fd, 0);
+}
+
+// 截断的段或头部布局越界的段不可附加
+TEST(SharedMatrix, Corrupt) {
+    const auto name{SegmentName("truncated")};
+    auto csr{ToCsr(MakeCoo())};
+    auto published{SharedMatrix::Publish(name, csr)};
+    const int fd{shm_open(name.c_str(), O_RDWR, 0)};
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, static_cast<off_t>(published.Info().bytes - 8)), 0);
+    close(fd);
+    EXPECT_THROW(SharedMatrix::Attach(name), std::runtime_error);
+    EXPECT_EQ(published.UseCount(), 1);
+
+    auto memfd{SharedMatrix::Publish({}, csr)};
+    auto *header{static_cast<SharedMatrixHeader *>(
+        mmap(nullptr, SharedMatrix::HEADER_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, memfd.Fd(), 0))};
+    ASSERT_NE(header, MAP_FAILED);
+    const SharedMatrixInfo info{header->info};
+    header->info.offsets[2] = info.bytes + CACHE_LINE_SIZE;
+    EXPECT_THROW(SharedMatrix::Attach(memfd.Fd()), std::runtime_error);
+    header->info = info;
+    header->info.counts[1] = info.counts[1] + 64;
+    EXPECT_THROW(SharedMatrix::Attach(memfd.Fd()), std::runtime_error);
+    header->info = info;
+    header->info.bytes = info.bytes + 4096;
+    EXPECT_THROW(SharedMatrix::Attach(memfd.Fd()), std::runtime_error);
+    header->info = info;
+    EXPECT_EQ((SharedMatrix::Attach(memfd.Fd()).GetCsr<double, int32_t>().StoredNnz()), 8);
+    EXPECT_EQ(memfd.UseCount(), 1);
+    munmap(header, SharedMatrix::HEADER_BYTES);
+}
+
+TEST(SharedMatrix, Pattern) {
+    CooStore<std::monostate, int32_t> store{3, 3, {}, {0, 1, 2}, {2, 1, 0}};
+    auto published{SharedMatrix::Publish({}, ToCsr(Coo<std::monostate, int32_t>{store}))};
+    auto attached{SharedMatrix::Attach(published.Fd())};
+    auto view{attached.GetCsr<std::monostate, int32_t>()};
+    EXPECT_EQ(view.GetValues(), nullptr);
+    EXPECT_EQ(view.StoredNnz(), 3);
+    EXPECT_EQ(view.GetColIndices()[0], 2);
+}
+
+TEST(SharedMatrix, MemfdAcrossFork) {
+    auto csr{ToCsr(MakeCoo())};
+    auto published{SharedMatrix::Publish({}, csr)};
+    EXPECT_TRUE(published.Name().empty());
+
+    const pid_t pid{fork()};
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // 子进程只读访问，不使用线程池
+        auto attached{SharedMatrix::Attach(published.Fd())};
+        auto view{attached.GetCsr<double, int32_t>()};
+        const bool ok{
+            attached.UseCount() == 2 && view.StoredNnz() == csr.StoredNnz() && view.GetValues()[7] == 6.7 &&
+            view.GetRowPtr()[5] == 8};
+        // _exit不执行析构，需显式归还引用
+        attached.Detach();
+        _exit(ok ? 0 : 1);
+    }
+    int status{};
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(published.UseCount(), 1);
+}
@@ -0,0 +1,131 @@
+#include <map>
+#include <random>
+
+#include "oops/convert.h"
+#include "oops/sparse_product.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+Csr<double, int32_t> GetGeneralSquareCsr() {
+    CsrStore<double, int32_t> store;
+    store.n = 5;
+    store.values = {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7};
+    store.row_ptr = {0, 3, 3, 6, 6, 8};
+    store.col_indices = {0, 1, 4, 0, 2, 4, 0, 4};
+    return {store};
+}
+
+std::vector<double> ToDense(const Csr<double, int32_t> &a) {
+    std::vector<double> dense(a.M() * a.N());
+    for (std::size_t r{0}; r < a.M(); ++r) {
+        for (auto i{a.GetRowPtr()[r]}; i < a.GetRowPtr()[r + 1]; ++i) {
+            dense[r * a.N() + a.GetColIndices()[i]] += a.GetValues()[i];
+        }
+    }
+    return dense;
+}
+} // namespace
+
+TEST(SparseProduct, Transpose) {
+    auto a{GetGeneralSquareCsr()};
+    auto t{Transpose(a)};
+    EXPECT_EQ(t.GetRowPtr(), (std::vector<int32_t>{0, 3, 4, 5, 5, 8}));
+    EXPECT_EQ(t.GetColIndices(), (std::vector<int32_t>{0, 2, 4, 0, 2, 0, 2, 4}));
+    EXPECT_EQ(t.GetValues(), (std::vector<double>{2.3, 4.6, 5.1, 7.8, 3.9, 1.5, 8.2, 6.7}));
+    EXPECT_EQ(Transpose(t).GetStore().col_indices, a.GetColIndices());
+}
+
+TEST(SparseProduct, Multiply) {
+    auto a{GetGeneralSquareCsr()};
+    auto t{Transpose(a)};
+    auto c{Multiply(a, t)};
+    EXPECT_EQ(c.M(), 5);
+    EXPECT_EQ(c.N(), 5);
+
+    auto da{ToDense(a)};
+    auto dc{ToDense(c)};
+    for (std::size_t i{0}; i < 5; ++i) {
+        for (std::size_t j{0}; j < 5; ++j) {
+            double expected{0};
+            for (std::size_t k{0}; k < 5; ++k) {
+                expected += da[i * 5 + k] * da[j * 5 + k];
+            }
+            EXPECT_NEAR(dc[i * 5 + j], expected, 1e-12);
+        }
+    }
+    // 行内列索引有序
+    for (std::size_t r{0}; r < c.M(); ++r) {
+        EXPECT_TRUE(std::is_sorted(
+            c.GetColIndices().begin() + c.GetRowPtr()[r], c.GetColIndices().begin() + c.GetRowPtr()[r + 1]));
+    }
+}
+
+TEST(SparseProduct, MultiplyRectangular) {
+    // [1 2]   [1 0 1]   [1 4 1]
+    // [0 3] * [0 2 0] = [0 6 0]
+    CooStore<double, int32_t> a_store{2, 2, {1, 2, 3}, {0, 0, 1}, {0, 1, 1}};
+    CooStore<double, int32_t> b_store{2, 3, {1, 1, 2}, {0, 0, 1}, {0, 2, 1}};
+    auto c{Multiply(ToCsr(Coo<double, int32_t>{a_store}), ToCsr(Coo<double, int32_t>{b_store}))};
+    EXPECT_EQ(c.N(), 3);
+    EXPECT_EQ(c.GetRowPtr(), (std::vector<int32_t>{0, 3, 4}));
+    EXPECT_EQ(c.GetColIndices(), (std::vector<int32_t>{0, 1, 2, 1}));
+    EXPECT_EQ(c.GetValues(), (std::vector<double>{1, 4, 1, 6}));
+    EXPECT_THROW(Multiply(c, c), std::invalid_argument);
+}
+
+// 稀疏行走排序累加器，少数稠密行走稠密累加器；两者按乘积生成顺序求和，与逐行的有序映射结果逐位相同
+TEST(SparseProduct, MultiplyMixedAccumulators) {
+    constexpr int32_t n{4000};
+    std::mt19937 gen{11};
+    std::uniform_int_distribution<int32_t> col{0, n - 1};
+    std::uniform_real_distribution<double> value{-1, 1};
+    auto make = [&](int32_t heavy_every) {
+        CooStore<double, int32_t> store{n, n, {}, {}, {}};
+        for (int32_t r{0}; r < n; ++r) {
+            const int32_t count{r % heavy_every == 0 ? 400 : 3};
+            for (int32_t k{0}; k < count; ++k) {
+                store.row_indices.push_back(r);
+                store.col_indices.push_back(col(gen));
+                store.values.push_back(value(gen));
+            }
+        }
+        return ToCsr(Coo<double, int32_t>{store});
+    };
+    const auto a{make(997)};
+    const auto b{make(101)};
+    const auto c{Multiply(a, b)};
+
+    const auto &ap{a.GetRowPtr()};
+    const auto &bp{b.GetRowPtr()};
+    std::vector<int32_t> ref_ptr{0};
+    std::vector<int32_t> ref_cols;
+    std::vector<double> ref_values;
+    for (std::size_t r{0}; r < a.M(); ++r) {
+        std::map<int32_t, double> row;
+        for (auto i{ap[r]}; i < ap[r + 1]; ++i) {
+            const auto k{a.GetColIndices()[i]};
+            for (auto j{bp[k]}; j < bp[k + 1]; ++j) {
+                const double product{a.GetValues()[i] * b.GetValues()[j]};
+                const auto [it, inserted]{row.emplace(b.GetColIndices()[j], product)};
+                if (!inserted) {
+                    it->second += product;
+                }
+            }
+        }
+        for (const auto &[c_col, c_value] : row) {
+            ref_cols.push_back(c_col);
+            ref_values.push_back(c_value);
+        }
+        ref_ptr.push_back(static_cast<int32_t>(ref_cols.size()));
+    }
+    EXPECT_EQ(c.GetRowPtr(), ref_ptr);
+    EXPECT_EQ(c.GetColIndices(), ref_cols);
+    EXPECT_EQ(c.GetValues(), ref_values);
+}
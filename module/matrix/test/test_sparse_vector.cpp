@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "oops/sparse_vector.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+TEST(SparseVector, Sorted) {
+    SparseVector<double, int32_t> x{100, {3, 64, 99}, {1.5, -2, 4}};
+    EXPECT_EQ(x.GetFormat(), SparseVectorFormat::SORTED);
+    EXPECT_EQ(x.N(), 100);
+    EXPECT_EQ(x.Nnz(), 3);
+    EXPECT_DOUBLE_EQ(x.Density(), 0.03);
+    EXPECT_TRUE(x.Contains(64));
+    EXPECT_FALSE(x.Contains(65));
+    EXPECT_EQ(x.Get(99), 4);
+    EXPECT_EQ(x.Get(0), 0);
+    EXPECT_THROW(x.Get(100), std::out_of_range);
+
+    std::vector<std::size_t> indices;
+    x.ForEach([&indices](std::size_t i, double) { indices.push_back(i); });
+    EXPECT_EQ(indices, (std::vector<std::size_t>{3, 64, 99}));
+    auto dense{x.ToDense()};
+    EXPECT_EQ(dense.size(), 100);
+    EXPECT_EQ(dense[3], 1.5);
+    EXPECT_EQ(dense[64], -2);
+
+    EXPECT_THROW((SparseVector<double, int32_t>{10, {3, 3}, {1, 2}}), std::invalid_argument);
+    EXPECT_THROW((SparseVector<double, int32_t>{10, {4, 3}, {1, 2}}), std::invalid_argument);
+    EXPECT_THROW((SparseVector<double, int32_t>{10, {10}, {1}}), std::invalid_argument);
+    EXPECT_THROW((SparseVector<double, int32_t>{10, {1, 2}, {1}}), std::invalid_argument);
+}
+
+TEST(SparseVector, Bitmap) {
+    SparseVector<double, int32_t> x{130, {0, 63, 64, 129}, {1, 2, 3, 4}};
+    auto b{x.ToBitmap()};
+    EXPECT_EQ(b.GetFormat(), SparseVectorFormat::BITMAP);
+    EXPECT_EQ(b.Nnz(), 4);
+    EXPECT_EQ(b.GetBits(), (std::vector<std::uint64_t>{1 | std::uint64_t{1} << 63, 1, 2}));
+    EXPECT_EQ(b.GetValues().size(), 130);
+    EXPECT_TRUE(b.Contains(129));
+    EXPECT_FALSE(b.Contains(128));
+    EXPECT_EQ(b.Get(64), 3);
+    EXPECT_EQ(b.ToDense(), x.ToDense());
+
+    auto s{b.ToSorted()};
+    EXPECT_EQ(s.GetFormat(), SparseVectorFormat::SORTED);
+    EXPECT_EQ(s.GetIndices(), x.GetIndices());
+    EXPECT_EQ(s.GetValues(), x.GetValues());
+
+    // 未标记位置的值不参与
+    auto f{SparseVector<double, int32_t>::FromBitmap(3, {0b101}, {1, 7, 3})};
+    EXPECT_EQ(f.Nnz(), 2);
+    EXPECT_EQ(f.Get(1), 0);
+    EXPECT_EQ(f.ToDense(), (std::vector<double>{1, 0, 3}));
+    EXPECT_THROW((SparseVector<double, int32_t>::FromBitmap(3, {0b1001}, {1, 2, 3})), std::invalid_argument);
+    EXPECT_THROW((SparseVector<double, int32_t>::FromBitmap(65, {1}, std::vector<double>(65))), std::invalid_argument);
+}
+
+TEST(SparseVector, Pattern) {
+    SparseVector<std::monostate, int64_t> x{70, {2, 68}};
+    EXPECT_TRUE(x.GetValues().empty());
+    auto b{x.ToBitmap()};
+    EXPECT_TRUE(b.GetValues().empty());
+    EXPECT_TRUE(b.Contains(68));
+    EXPECT_EQ(b.ToSorted().GetIndices(), (std::vector<int64_t>{2, 68}));
+    EXPECT_THROW((SparseVector<std::monostate, int64_t>{70, {2}, {std::monostate{}}}), std::invalid_argument);
+
+    SparseVector<std::monostate, int64_t> empty{0};
+    EXPECT_EQ(empty.Density(), 0);
+    EXPECT_EQ(empty.ToBitmap().Nnz(), 0);
+}
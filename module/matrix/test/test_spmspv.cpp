@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "oops/matrix_generator.h"
+#include "oops/spmspv.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+
+namespace {
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+Csr<double, int32_t> GetGeneralSquareCsr() {
+    CsrStore<double, int32_t> store;
+    store.n = 5;
+    store.values = {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7};
+    store.row_ptr = {0, 3, 3, 6, 6, 8};
+    store.col_indices = {0, 1, 4, 0, 2, 4, 0, 4};
+    return {store};
+}
+
+// 稀疏度为nnz / n的随机向量
+SparseVector<double, int32_t> RandomVector(std::size_t n, std::size_t nnz, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::vector<std::uint64_t> bits(SparseVector<double, int32_t>::BitWords(n), 0);
+    std::vector<double> values(n);
+    std::uniform_real_distribution<double> dist{-1, 1};
+    for (std::size_t k{0}; k < nnz; ++k) {
+        const std::size_t i{gen() % n};
+        bits[i >> 6] |= std::uint64_t{1} << (i & 63);
+        values[i] = dist(gen);
+    }
+    return SparseVector<double, int32_t>::FromBitmap(n, std::move(bits), std::move(values)).ToSorted();
+}
+} // namespace
+
+TEST(SpMSpV, General) {
+    auto a{GetGeneralSquareCsr()};
+    SparseVector<double, int32_t> x{5, {1}, {2}};
+    auto y{SpMSpV(a, x, {1.})};
+    EXPECT_EQ(y.GetFormat(), SparseVectorFormat::SORTED);
+    EXPECT_EQ(y.GetIndices(), (std::vector<int32_t>{0}));
+    EXPECT_DOUBLE_EQ(y.Get(0), 15.6);
+
+    x = SparseVector<double, int32_t>{5, {0, 4}, {1, -1}};
+    y = SpMSpV(a, x, {1.});
+    EXPECT_EQ(y.GetIndices(), (std::vector<int32_t>{0, 2, 4}));
+    EXPECT_DOUBLE_EQ(y.Get(0), 0.8);
+    EXPECT_DOUBLE_EQ(y.Get(2), -3.6);
+    EXPECT_DOUBLE_EQ(y.Get(4), -1.6);
+    auto z{SpMSpV(a, x, {0.})};
+    EXPECT_EQ(z.GetFormat(), SparseVectorFormat::BITMAP);
+    EXPECT_EQ(z.ToDense(), y.ToDense());
+
+    EXPECT_EQ(SpMSpV(a, SparseVector<double, int32_t>{5}).Nnz(), 0);
+    EXPECT_THROW(SpMSpV(a, SparseVector<double, int32_t>{4}), std::invalid_argument);
+    Csr<double, int32_t> sym{a.GetPattern(), a.GetValues(), MatrixSymmetric::SYMMETRIC_LOWER};
+    EXPECT_THROW(SpMSpV(sym, x), std::invalid_argument);
+}
+
+// 两条路径与SpMV逐元素相同
+TEST(SpMSpV, MatchesSpMV) {
+    auto a{GenerateCsr<double, int32_t>(ErdosRenyiGenerator{3000, 2000, 6, 5})};
+    for (std::size_t nnz : {1, 10, 100, 1000}) {
+        auto x{RandomVector(a.N(), nnz, static_cast<unsigned>(nnz))};
+        std::vector<double> expected;
+        SpMV(a, x.ToDense(), expected);
+        auto by_columns{SpMSpV(a, x, {1.})};
+        auto by_rows{SpMSpV(a, x, {0.})};
+        EXPECT_EQ(by_columns.GetFormat(), SparseVectorFormat::SORTED);
+        EXPECT_EQ(by_rows.GetFormat(), SparseVectorFormat::BITMAP);
+        EXPECT_EQ(by_columns.ToDense(), expected);
+        EXPECT_EQ(by_rows.ToDense(), expected);
+        EXPECT_EQ(by_rows.ToSorted().GetIndices(), by_columns.GetIndices());
+        // 默认阈值下按密度自动选择路径
+        const bool dense{x.Density() > SpMSpVOptions{}.dense_threshold};
+        EXPECT_EQ(SpMSpV(a, x).GetFormat(), dense ? SparseVectorFormat::BITMAP : SparseVectorFormat::SORTED);
+    }
+}
+
+// pattern矩阵与向量：一步前沿扩展，结果为前沿顶点的出邻居
+TEST(SpMSpV, Pattern) {
+    CsrStore<std::monostate, int32_t> store;
+    store.n = 4;
+    store.row_ptr = {0, 1, 3, 3, 4};
+    store.col_indices = {1, 0, 3, 3};
+    Csr<std::monostate, int32_t> a{store};
+    SparseVector<std::monostate, int32_t> frontier{4, {3}};
+    EXPECT_EQ(SpMSpV(a, frontier, {1.}).GetIndices(), (std::vector<int32_t>{1, 3}));
+    EXPECT_EQ(SpMSpV(a, frontier, {0.}).ToSorted().GetIndices(), (std::vector<int32_t>{1, 3}));
+    frontier = SparseVector<std::monostate, int32_t>{4, {2}};
+    EXPECT_EQ(SpMSpV(a, frontier).Nnz(), 0);
+}
@@ -0,0 +1,198 @@
+#include <cmath>
+#include <complex>
+#include <random>
+
+#include "oops/convert.h"
+#include "oops/sparse_product.h"
+#include "oops/spmv.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace oops;
+using namespace testing;
+
+// [2.3 7.8  .   .  1.5]
+// [ .   .   .   .   . ]
+// [4.6  .  3.9  .  8.2]
+// [ .   .   .   .   . ]
+// [5.1  .   .   .  6.7]
+TEST(SpMV, General) {
+    CsrStore<double, int32_t> store;
+    store.n = 5;
+    store.values = {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7};
+    store.row_ptr = {0, 3, 3, 6, 6, 8};
+    store.col_indices = {0, 1, 4, 0, 2, 4, 0, 4};
+    Csr<double, int32_t> csr{store};
+
+    std::vector<double> x{1, 2, 3, 4, 5};
+    std::vector<double> y;
+    SpMV(csr, x, y);
+    EXPECT_THAT(y, ElementsAre(DoubleEq(25.4), 0, DoubleEq(57.3), 0, DoubleEq(38.6)));
+}
+
+// [3.2  .  2.0]
+// [ .  5.4  . ]
+// [2.0  .  1.1]
+TEST(SpMV, SymmetricLower) {
+    CooStore<double, int32_t> store{3, 3, {3.2, 5.4, 2.0, 1.1}, {0, 1, 2, 2}, {0, 1, 0, 2}};
+    auto csr{ToCsr(Coo<double, int32_t>{store, MatrixSymmetric::SYMMETRIC_LOWER})};
+
+    std::vector<double> x{1, 2, 3};
+    std::vector<double> y;
+    SpMV(csr, x, y);
+    EXPECT_THAT(y, ElementsAre(DoubleEq(9.2), DoubleEq(10.8), DoubleEq(5.3)));
+}
+
+TEST(SpMV, SkewAndHermitian) {
+    CooStore<std::complex<double>, int32_t> store{2, 2, {{0, 0}, {1, 2}, {0, 0}}, {0, 1, 1}, {0, 0, 1}};
+    std::vector<std::complex<double>> x{{1, 0}, {0, 1}};
+    std::vector<std::complex<double>> y;
+
+    // [0     1-2i]
+    // [1+2i  0   ]
+    SpMV(ToCsr(Coo<std::complex<double>, int32_t>{store, MatrixSymmetric::HERMITIAN_LOWER}), x, y);
+    EXPECT_EQ(y[0], (std::complex<double>{2, 1}));
+    EXPECT_EQ(y[1], (std::complex<double>{1, 2}));
+
+    // [0     -1-2i]
+    // [1+2i  0    ]
+    SpMV(ToCsr(Coo<std::complex<double>, int32_t>{store, MatrixSymmetric::SKEW_LOWER}), x, y);
+    EXPECT_EQ(y[0], (std::complex<double>{2, -1}));
+    EXPECT_EQ(y[1], (std::complex<double>{1, 2}));
+}
+
+// 每行nnz_per_row个随机列
+static Csr<double, int32_t> MakeRandomCsr(int32_t m, int32_t n, int32_t nnz_per_row, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<int32_t> col{0, n - 1};
+    std::uniform_real_distribution<double> value{-1, 1};
+    CooStore<double, int32_t> store{static_cast<std::size_t>(m), static_cast<std::size_t>(n), {}, {}, {}};
+    for (int32_t r{0}; r < m; ++r) {
+        for (int32_t k{0}; k < nnz_per_row; ++k) {
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(col(gen));
+            store.values.push_back(value(gen));
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{store});
+}
+
+// 行数较多的对称矩阵：Csr沿缓存的转置结构收集，视图按块归约，与展开为一般存储的结果一致
+TEST(SpMV, SymmetricParallel) {
+    constexpr int32_t n{50000};
+    std::mt19937 gen{7};
+    std::uniform_int_distribution<int32_t> offset{0, 64};
+    std::uniform_real_distribution<double> value{-1, 1};
+    CooStore<double, int32_t> lower{n, n, {}, {}, {}};
+    CooStore<double, int32_t> full{n, n, {}, {}, {}};
+    for (int32_t r{0}; r < n; ++r) {
+        for (int32_t k{0}; k < 4; ++k) {
+            const int32_t c{std::max(r - offset(gen), 0)};
+            const double v{value(gen)};
+            lower.row_indices.push_back(r);
+            lower.col_indices.push_back(c);
+            lower.values.push_back(v);
+            full.row_indices.push_back(r);
+            full.col_indices.push_back(c);
+            full.values.push_back(v);
+            if (c != r) {
+                full.row_indices.push_back(c);
+                full.col_indices.push_back(r);
+                full.values.push_back(v);
+            }
+        }
+    }
+    const auto csr{ToCsr(Coo<double, int32_t>{lower, MatrixSymmetric::SYMMETRIC_LOWER})};
+    const auto general{ToCsr(Coo<double, int32_t>{full})};
+    std::vector<double> x(n);
+    for (std::size_t i{0}; i < x.size(); ++i) {
+        x[i] = std::sin(static_cast<double>(i));
+    }
+    std::vector<double> y, y_view, ref;
+    SpMV(csr, x, y);
+    SpMV(CsrView<double, int32_t, int32_t>{csr}, x, y_view);
+    SpMV(general, x, ref);
+    ASSERT_EQ(y.size(), ref.size());
+    ASSERT_EQ(y_view.size(), ref.size());
+    for (std::size_t r{0}; r < ref.size(); ++r) {
+        EXPECT_NEAR(y[r], ref[r], 1e-12);
+        EXPECT_NEAR(y_view[r], ref[r], 1e-12);
+    }
+
+    // pattern矩阵按整数计算，结果精确相等
+    const Csr<std::monostate, int32_t> pattern{csr.GetPattern(), {}, MatrixSymmetric::SYMMETRIC_LOWER};
+    const Csr<std::monostate, int32_t> general_pattern{general.GetPattern(), {}};
+    std::vector<intmax_t> xi(n);
+    for (std::size_t i{0}; i < xi.size(); ++i) {
+        xi[i] = static_cast<intmax_t>(i % 13) - 6;
+    }
+    std::vector<intmax_t> yi, yi_view, refi;
+    SpMV(pattern, xi, yi);
+    SpMV(CsrView<std::monostate, int32_t, int32_t>{pattern}, xi, yi_view);
+    SpMV(general_pattern, xi, refi);
+    EXPECT_EQ(yi, refi);
+    EXPECT_EQ(yi_view, refi);
+}
+
+TEST(SpMV, Transpose) {
+    CsrStore<double, int32_t> store{
+        5, {2.3, 7.8, 1.5, 4.6, 3.9, 8.2, 5.1, 6.7}, {0, 3, 3, 6, 6, 8}, {0, 1, 4, 0, 2, 4, 0, 4}};
+    Csr<double, int32_t> csr{store};
+    std::vector<double> x{1, 2, 3, 4, 5}, y;
+    TransposeSpMV(csr, x, y);
+    EXPECT_THAT(y, ElementsAre(DoubleEq(41.6), DoubleEq(7.8), DoubleEq(11.7), 0, DoubleEq(59.6)));
+    EXPECT_THROW(TransposeSpMV(csr, std::vector<double>(4), y), std::invalid_argument);
+}
+
+TEST(SpMV, TransposeReductionAndAtomic) {
+    // 列数少时走私有缓冲归约，列数多时走原子累加
+    for (int32_t n : {64, 200000}) {
+        auto csr{MakeRandomCsr(50000, n, 4, static_cast<unsigned>(n))};
+        std::vector<double> x(csr.M());
+        for (std::size_t i{0}; i < x.size(); ++i) {
+            x[i] = std::sin(static_cast<double>(i));
+        }
+        std::vector<double> y, ref;
+        TransposeSpMV(csr, x, y);
+        SpMV(Transpose(csr), x, ref);
+        ASSERT_EQ(y.size(), ref.size());
+        for (std::size_t c{0}; c < y.size(); ++c) {
+            EXPECT_NEAR(y[c], ref[c], 1e-12);
+        }
+    }
+}
+
+TEST(SpMV, TransposeSymmetric) {
+    CooStore<std::complex<double>, int32_t> store{2, 2, {{0, 0}, {1, 2}, {0, 0}}, {0, 1, 1}, {0, 0, 1}};
+    std::vector<std::complex<double>> x{{1, 0}, {0, 1}}, y, ref;
+    for (auto symmetric : {MatrixSymmetric::HERMITIAN_LOWER, MatrixSymmetric::SKEW_LOWER}) {
+        auto csr{ToCsr(Coo<std::complex<double>, int32_t>{store, symmetric})};
+        TransposeSpMV(csr, x, y);
+        // 完整矩阵的转置按行展开后做SpMV
+        std::vector<std::complex<double>> dense{0, 0, 0, 0};
+        dense[1 * 2 + 0] = {1, 2};
+        dense[0 * 2 + 1] = MirrorValue(symmetric, std::complex<double>{1, 2});
+        ref = {dense[0] * x[0] + dense[2] * x[1], dense[1] * x[0] + dense[3] * x[1]};
+        EXPECT_EQ(y, ref);
+    }
+}
+
+TEST(SpMV, Pattern) {
+    // [1 1 .]
+    // [. . 1]
+    // [1 . 1]
+    CooStore<std::monostate, int32_t> store{3, 3, {}, {0, 0, 1, 2, 2}, {0, 1, 2, 0, 2}};
+    auto csr{ToCsr(Coo<std::monostate, int32_t>{store})};
+    std::vector<double> x{1, 2, 3}, y;
+    SpMV(csr, x, y);
+    EXPECT_THAT(y, ElementsAre(3, 3, 4));
+
+    std::vector<int64_t> xi{1, 2, 3}, yi;
+    SpMV(CsrView<std::monostate, int32_t>{csr}, xi, yi);
+    EXPECT_THAT(yi, ElementsAre(3, 3, 4));
+
+    // 斜对称下三角[0 -1; 1 0]
+    CooStore<std::monostate, int32_t> lower{2, 2, {}, {1}, {0}};
+    SpMV(ToCsr(Coo<std::monostate, int32_t>{lower, MatrixSymmetric::SKEW_LOWER}), std::vector<double>{1, 2}, y);
+    EXPECT_THAT(y, ElementsAre(-2, 1));
+}
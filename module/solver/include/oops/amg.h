@@ -0,0 +1,573 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/krylov_kernel.h"
+#include "oops/preconditioner.h"
+#include "oops/sparse_product.h"
+
+namespace oops {
+enum class AmgSmoother : std::uint8_t { JACOBI, CHEBYSHEV };
+
+struct AmgOptions {
+    double strength_threshold{0.08}; // |a(i, j)| >= θ * sqrt(|a(i, i) * a(j, j)|)视为强连接
+    std::size_t max_levels{20};
+    std::size_t max_coarse_size{500}; // 最粗层规模上限，最粗层稠密LU直接求解
+    AmgSmoother smoother{AmgSmoother::CHEBYSHEV};
+    std::size_t pre_sweeps{1};
+    std::size_t post_sweeps{1};
+    double jacobi_weight{2.0 / 3.0};
+    std::size_t chebyshev_degree{2};
+    double chebyshev_ratio{30}; // Chebyshev平滑区间[λmax / ratio, λmax]
+};
+
+// 粗层矩阵按规模选择紧凑索引类型，能以int32索引时减半索引带宽
+template <typename Value>
+using CompactCsrVar = std::variant<Csr<Value, int32_t, int32_t>, Csr<Value, int64_t, int64_t>>;
+
+template <typename Value, typename DimIndex, typename NnzIndex>
+CompactCsrVar<Value> ToCompact(Csr<Value, DimIndex, NnzIndex> &&a) {
+    constexpr std::size_t int32_max{static_cast<std::size_t>(std::numeric_limits<int32_t>::max())};
+    if (a.M() <= int32_max && a.N() <= int32_max && a.StoredNnz() <= int32_max) {
+        return Csr<Value, int32_t, int32_t>{std::move(a)};
+    }
+    return Csr<Value, int64_t, int64_t>{std::move(a)};
+}
+
+// 光滑聚集代数多重网格(SA-AMG)，作为Krylov求解器的预条件子使用
+// 1. 强连接图上并行求距离2极大独立集作为聚集根，其余节点依距离归入相邻聚集，结果与线程数无关
+// 2. 以常向量为近零空间构造试探延拓P0，经一步加权Jacobi光滑得P = (I - ω * D^-1 * A) * P0
+// 3. 粗层算子取Galerkin三重积Ac = P^T * A * P
+// 4. V循环工作向量在Setup时一次分配，Apply不分配内存；同一实例不可被多线程并发Apply
+// 细层矩阵以指针引用，须在预条件子生命周期内保持有效
+template <typename Value, typename DimIndex = int32_t, typename NnzIndex = DimIndex>
+class AmgPreconditioner : public Preconditioner<Value> {
+    static_assert(std::is_floating_point_v<Value>);
+
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+
+    explicit AmgPreconditioner(AmgOptions options = {}) : options_{options} {}
+    AmgPreconditioner(const CsrType &a, AmgOptions options = {}) : options_{options} { Setup(a); }
+
+    void Setup(const CsrType &a) {
+        if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+            throw std::invalid_argument("amg requires general storage");
+        }
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("amg requires a square matrix");
+        }
+        fine_ = &a;
+        levels_.clear();
+        levels_.emplace_back();
+        SetupLevel(levels_.back(), a);
+
+        while (levels_.size() < options_.max_levels) {
+            const std::size_t n{LevelSize(levels_.size() - 1)};
+            if (n <= options_.max_coarse_size) {
+                break;
+            }
+            auto coarse{VisitLevel(levels_.size() - 1, [this](const auto &level_a) { return Coarsen(level_a); })};
+            if (!coarse) {
+                break; // 粗化停滞
+            }
+            levels_.emplace_back();
+            levels_.back().a = std::move(*coarse);
+            std::visit([this](const auto &level_a) { SetupLevel(levels_.back(), level_a); }, levels_.back().a);
+        }
+        coarse_direct_ = LevelSize(levels_.size() - 1) <= options_.max_coarse_size;
+        if (coarse_direct_) {
+            VisitLevel(levels_.size() - 1, [this](const auto &level_a) { SetupCoarseSolver(level_a); });
+        } else {
+            coarse_lu_.clear();
+            coarse_pivots_.clear();
+        }
+    }
+
+    std::size_t NumLevels() const { return levels_.size(); }
+    std::size_t LevelSize(std::size_t l) const {
+        return VisitLevel(l, [](const auto &level_a) { return level_a.M(); });
+    }
+    std::size_t LevelNnz(std::size_t l) const {
+        return VisitLevel(l, [](const auto &level_a) { return level_a.StoredNnz(); });
+    }
+    bool IsCompactLevel(std::size_t l) const {
+        return l > 0 && std::holds_alternative<Csr<Value, int32_t, int32_t>>(levels_[l].a);
+    }
+
+    // 算子复杂度：各层非零元总数 / 细层非零元数
+    double OperatorComplexity() const {
+        double total{0};
+        for (std::size_t l{0}; l < levels_.size(); ++l) {
+            total += static_cast<double>(LevelNnz(l));
+        }
+        return total / static_cast<double>(LevelNnz(0));
+    }
+
+    // z = V-cycle(r)，零初值
+    void Apply(std::size_t n, const Value *r, Value *z) const override {
+        if (levels_.empty() || n != LevelSize(0)) {
+            throw std::invalid_argument("preconditioner size mismatch");
+        }
+        if (r == z) {
+            std::copy(r, r + n, levels_[0].b.begin());
+            r = levels_[0].b.data();
+        }
+        Cycle(0, r, z);
+    }
+
+private:
+    struct Level {
+        CompactCsrVar<Value> a; // 第0层不使用，引用fine_
+        CompactCsrVar<Value> p; // 下一层到本层的延拓
+        CompactCsrVar<Value> r; // 本层到下一层的限制，P^T
+        std::vector<Value> inv_diag;
+        Value lambda_max{};
+
+        // V循环工作向量
+        mutable std::vector<Value> x, b, res, dir;
+    };
+
+    template <typename F>
+    decltype(auto) VisitLevel(std::size_t l, F &&f) const {
+        if (l == 0) {
+            return f(*fine_);
+        }
+        return std::visit(std::forward<F>(f), levels_[l].a);
+    }
+
+    template <typename Matrix>
+    void SetupLevel(Level &level, const Matrix &a) {
+        const std::size_t n{a.M()};
+        const auto &store{a.GetStore()};
+        level.inv_diag.assign(n, Value{});
+        ParallelFor(0, n, SPMV_ROW_GRAIN, [&store, &level](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                Value diag{};
+                for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                    if (static_cast<std::size_t>(store.col_indices[i]) == r) {
+                        diag += store.values[i];
+                    }
+                }
+                if (diag == Value{}) {
+                    throw std::runtime_error("amg zero diagonal at row " + std::to_string(r));
+                }
+                level.inv_diag[r] = Value{1} / diag;
+            }
+        });
+        for (auto *v : {&level.x, &level.b, &level.res, &level.dir}) {
+            v->assign(n, Value{});
+        }
+        level.lambda_max = EstimateLambdaMax(a, level);
+    }
+
+    // 幂迭代估计ρ(D^-1 * A)，固定初值保证结果可复现
+    template <typename Matrix>
+    static Value EstimateLambdaMax(const Matrix &a, Level &level) {
+        constexpr std::size_t POWER_ITERATIONS{15};
+        const std::size_t n{a.M()};
+        Value *v{level.x.data()};
+        Value *w{level.res.data()};
+        for (std::size_t i{0}; i < n; ++i) {
+            v[i] = Value{1} + static_cast<Value>(i % 7) / Value{7};
+        }
+        Value lambda{};
+        for (std::size_t it{0}; it < POWER_ITERATIONS; ++it) {
+            Value norm{Norm2(n, v)};
+            if (norm == Value{}) {
+                break;
+            }
+            for (std::size_t i{0}; i < n; ++i) {
+                v[i] /= norm;
+            }
+            SpMV(a, v, w);
+            for (std::size_t i{0}; i < n; ++i) {
+                w[i] *= level.inv_diag[i];
+            }
+            lambda = Dot(n, v, w);
+            std::swap(v, w);
+        }
+        std::fill(level.x.begin(), level.x.end(), Value{});
+        std::fill(level.res.begin(), level.res.end(), Value{});
+        // 幂迭代从下方逼近，放大以保证上界
+        return std::max(lambda, Value{1e-12}) * Value{1.1};
+    }
+
+    // 强连接图，不含对角元
+    template <typename Matrix>
+    static void BuildStrength(
+        const Matrix &a, double theta, std::vector<std::size_t> &s_ptr, std::vector<std::size_t> &s_cols) {
+        const auto &store{a.GetStore()};
+        const std::size_t n{a.M()};
+        std::vector<Value> diag(n);
+        ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                    if (static_cast<std::size_t>(store.col_indices[i]) == r) {
+                        diag[r] += store.values[i];
+                    }
+                }
+            }
+        });
+        auto strong = [&](std::size_t r, std::size_t c, Value v) {
+            return c != r && std::abs(v) >= theta * std::sqrt(std::abs(diag[r] * diag[c]));
+        };
+        s_ptr.assign(n + 1, 0);
+        ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                    s_ptr[r + 1] += strong(r, store.col_indices[i], store.values[i]);
+                }
+            }
+        });
+        for (std::size_t r{0}; r < n; ++r) {
+            s_ptr[r + 1] += s_ptr[r];
+        }
+        s_cols.resize(s_ptr[n]);
+        ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                std::size_t p{s_ptr[r]};
+                for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                    if (strong(r, store.col_indices[i], store.values[i])) {
+                        s_cols[p++] = store.col_indices[i];
+                    }
+                }
+            }
+        });
+    }
+
+    // 强连接图上的并行聚集，返回每个节点所属聚集编号及聚集数
+    static std::size_t Aggregate(
+        const std::vector<std::size_t> &s_ptr, const std::vector<std::size_t> &s_cols, std::vector<std::size_t> &agg) {
+        const std::size_t n{s_ptr.size() - 1};
+        enum State : std::uint8_t { OUT, UNDECIDED, IN };
+        // (状态, 随机优先级, 编号)字典序比较，IN最大以便向外传播
+        struct Tuple {
+            bool operator<(const Tuple &rhs) const {
+                if (state != rhs.state) {
+                    return state < rhs.state;
+                }
+                if (priority != rhs.priority) {
+                    return priority < rhs.priority;
+                }
+                return index < rhs.index;
+            }
+            std::uint8_t state;
+            std::uint64_t priority;
+            std::size_t index;
+        };
+        auto hash = [](std::uint64_t x) {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        };
+
+        // 距离2极大独立集(Bell, Dalton & Olson)：两轮邻域最大值传播后，自身为最大者入选，邻域内有入选者则出局
+        std::vector<Tuple> t(n), t1(n), t2(n);
+        for (std::size_t i{0}; i < n; ++i) {
+            t[i] = {UNDECIDED, hash(i), i};
+        }
+        auto propagate = [&s_ptr, &s_cols, n](const std::vector<Tuple> &src, std::vector<Tuple> &dst) {
+            ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    Tuple best{src[i]};
+                    for (std::size_t p{s_ptr[i]}; p < s_ptr[i + 1]; ++p) {
+                        best = std::max(best, src[s_cols[p]]);
+                    }
+                    dst[i] = best;
+                }
+            });
+        };
+        for (bool undecided{true}; undecided;) {
+            propagate(t, t1);
+            propagate(t1, t2);
+            ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    if (t[i].state != UNDECIDED) {
+                        continue;
+                    }
+                    if (t2[i].index == i) {
+                        t[i].state = IN;
+                    } else if (t2[i].state == IN) {
+                        t[i].state = OUT;
+                    }
+                }
+            });
+            undecided = std::any_of(t.begin(), t.end(), [](const Tuple &x) { return x.state == UNDECIDED; });
+        }
+
+        // 聚集根按节点编号顺序编号
+        constexpr std::size_t NONE{std::numeric_limits<std::size_t>::max()};
+        agg.assign(n, NONE);
+        std::size_t num_aggs{0};
+        for (std::size_t i{0}; i < n; ++i) {
+            if (t[i].state == IN) {
+                agg[i] = num_aggs++;
+            }
+        }
+        // 距离1节点归入首个相邻根，距离2节点归入首个已归属邻居所在聚集
+        auto attach = [&](const std::vector<std::size_t> &src, std::vector<std::size_t> &dst) {
+            ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    dst[i] = src[i];
+                    if (src[i] != NONE) {
+                        continue;
+                    }
+                    for (std::size_t p{s_ptr[i]}; p < s_ptr[i + 1]; ++p) {
+                        if (src[s_cols[p]] != NONE) {
+                            dst[i] = src[s_cols[p]];
+                            break;
+                        }
+                    }
+                }
+            });
+        };
+        std::vector<std::size_t> roots_only(agg);
+        attach(roots_only, agg);
+        std::vector<std::size_t> first_pass(agg);
+        attach(first_pass, agg);
+        // 非对称强连接图下可能残留的节点独立成聚集
+        for (std::size_t i{0}; i < n; ++i) {
+            if (agg[i] == NONE) {
+                agg[i] = num_aggs++;
+            }
+        }
+        return num_aggs;
+    }
+
+    // 构造下一层：返回粗层矩阵，并写入本层的P、R
+    template <typename Matrix>
+    std::optional<CompactCsrVar<Value>> Coarsen(const Matrix &a) {
+        using DimIndexType = typename Matrix::DimIndexType;
+        using NnzIndexType = typename Matrix::NnzIndexType;
+        using LevelCsr = Csr<Value, DimIndexType, NnzIndexType>;
+        Level &level{levels_.back()};
+        const std::size_t n{a.M()};
+
+        std::vector<std::size_t> s_ptr, s_cols, agg;
+        BuildStrength(a, options_.strength_threshold, s_ptr, s_cols);
+        const std::size_t num_aggs{Aggregate(s_ptr, s_cols, agg)};
+        if (num_aggs == 0 || num_aggs * 10 >= n * 9) {
+            return std::nullopt;
+        }
+
+        // 试探延拓P0：每行一个非零，按聚集规模归一化
+        std::vector<std::size_t> agg_size(num_aggs, 0);
+        for (auto g : agg) {
+            ++agg_size[g];
+        }
+        CsrStore<Value, DimIndexType, NnzIndexType> p0_store;
+        p0_store.n = num_aggs;
+        p0_store.row_ptr.resize(n + 1);
+        p0_store.col_indices.resize(n);
+        p0_store.values.resize(n);
+        for (std::size_t i{0}; i <= n; ++i) {
+            p0_store.row_ptr[i] = static_cast<NnzIndexType>(i);
+        }
+        for (std::size_t i{0}; i < n; ++i) {
+            p0_store.col_indices[i] = static_cast<DimIndexType>(agg[i]);
+            p0_store.values[i] = Value{1} / std::sqrt(static_cast<Value>(agg_size[agg[i]]));
+        }
+        LevelCsr p0{std::move(p0_store)};
+
+        // P = P0 - ω * D^-1 * A * P0，A * P0的模式包含P0的模式
+        const Value omega{Value{4} / (Value{3} * level.lambda_max)};
+        LevelCsr ap0{Multiply(a, p0)};
+        // P与A * P0共享模式，只复制数值
+        auto p_values{ap0.GetValues()};
+        const auto &p_row_ptr{ap0.GetRowPtr()};
+        const auto &p_col_indices{ap0.GetColIndices()};
+        ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                const Value scale{-omega * level.inv_diag[r]};
+                for (auto i{p_row_ptr[r]}; i < p_row_ptr[r + 1]; ++i) {
+                    p_values[i] *= scale;
+                    if (static_cast<std::size_t>(p_col_indices[i]) == agg[r]) {
+                        p_values[i] += p0.GetValues()[r];
+                    }
+                }
+            }
+        });
+        LevelCsr p{ap0.GetPattern(), std::move(p_values)};
+        LevelCsr r{Transpose(p)};
+        LevelCsr ac{Multiply(r, Multiply(a, p))};
+
+        level.p = ToCompact(std::move(p));
+        level.r = ToCompact(std::move(r));
+        return ToCompact(std::move(ac));
+    }
+
+    // 最粗层稠密LU分解(部分选主元)
+    template <typename Matrix>
+    void SetupCoarseSolver(const Matrix &a) {
+        const std::size_t n{a.M()};
+        const auto &store{a.GetStore()};
+        coarse_lu_.assign(n * n, Value{});
+        coarse_pivots_.resize(n);
+        for (std::size_t r{0}; r < n; ++r) {
+            for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                coarse_lu_[r * n + store.col_indices[i]] += store.values[i];
+            }
+        }
+        for (std::size_t k{0}; k < n; ++k) {
+            std::size_t pivot{k};
+            for (std::size_t i{k + 1}; i < n; ++i) {
+                if (std::abs(coarse_lu_[i * n + k]) > std::abs(coarse_lu_[pivot * n + k])) {
+                    pivot = i;
+                }
+            }
+            coarse_pivots_[k] = pivot;
+            if (pivot != k) {
+                std::swap_ranges(
+                    coarse_lu_.begin() + k * n, coarse_lu_.begin() + (k + 1) * n, coarse_lu_.begin() + pivot * n);
+            }
+            const Value diag{coarse_lu_[k * n + k]};
+            if (diag == Value{}) {
+                continue; // 奇异粗层(如纯Neumann问题)，对应分量置零
+            }
+            for (std::size_t i{k + 1}; i < n; ++i) {
+                Value l{coarse_lu_[i * n + k] /= diag};
+                for (std::size_t j{k + 1}; j < n; ++j) {
+                    coarse_lu_[i * n + j] -= l * coarse_lu_[k * n + j];
+                }
+            }
+        }
+    }
+
+    void CoarseSolve(const Value *b, Value *x) const {
+        const std::size_t n{coarse_pivots_.size()};
+        std::copy(b, b + n, x);
+        for (std::size_t k{0}; k < n; ++k) {
+            std::swap(x[k], x[coarse_pivots_[k]]);
+        }
+        for (std::size_t i{0}; i < n; ++i) {
+            for (std::size_t j{0}; j < i; ++j) {
+                x[i] -= coarse_lu_[i * n + j] * x[j];
+            }
+        }
+        for (std::size_t i{n}; i-- > 0;) {
+            for (std::size_t j{i + 1}; j < n; ++j) {
+                x[i] -= coarse_lu_[i * n + j] * x[j];
+            }
+            const Value diag{coarse_lu_[i * n + i]};
+            x[i] = (diag == Value{}) ? Value{} : x[i] / diag;
+        }
+    }
+
+    // 加权Jacobi：x += w * D^-1 * (b - A * x)
+    template <typename Matrix>
+    void JacobiSweep(const Matrix &a, const Level &level, const Value *b, Value *x) const {
+        const std::size_t n{a.M()};
+        Value *res{level.res.data()};
+        Residual(a, b, x, res);
+        const Value weight{static_cast<Value>(options_.jacobi_weight)};
+        const Value *inv_diag{level.inv_diag.data()};
+        ParallelFor(0, n, REDUCE_GRAIN, [=](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                x[i] += weight * inv_diag[i] * res[i];
+            }
+        });
+    }
+
+    // D^-1 * A在[λmax / ratio, λmax]上的Chebyshev多项式平滑(Saad, Alg. 12.1)
+    template <typename Matrix>
+    void ChebyshevSweep(const Matrix &a, const Level &level, const Value *b, Value *x) const {
+        const std::size_t n{a.M()};
+        const Value upper{level.lambda_max};
+        const Value lower{upper / static_cast<Value>(options_.chebyshev_ratio)};
+        const Value theta{(upper + lower) / 2};
+        const Value delta{(upper - lower) / 2};
+        const Value sigma{theta / delta};
+        Value rho{1 / sigma};
+        Value *res{level.res.data()};
+        Value *dir{level.dir.data()};
+        const Value *inv_diag{level.inv_diag.data()};
+
+        Residual(a, b, x, res);
+        ParallelFor(0, n, REDUCE_GRAIN, [=](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                dir[i] = inv_diag[i] * res[i] / theta;
+            }
+        });
+        for (std::size_t k{1};; ++k) {
+            ParallelFor(0, n, REDUCE_GRAIN, [=](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    x[i] += dir[i];
+                }
+            });
+            if (k >= options_.chebyshev_degree) {
+                break;
+            }
+            Residual(a, b, x, res);
+            const Value rho_new{1 / (2 * sigma - rho)};
+            const Value c1{rho_new * rho};
+            const Value c2{2 * rho_new / delta};
+            ParallelFor(0, n, REDUCE_GRAIN, [=](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    dir[i] = c1 * dir[i] + c2 * inv_diag[i] * res[i];
+                }
+            });
+            rho = rho_new;
+        }
+    }
+
+    template <typename Matrix>
+    void Smooth(const Matrix &a, const Level &level, const Value *b, Value *x, std::size_t sweeps) const {
+        for (std::size_t s{0}; s < sweeps; ++s) {
+            if (options_.smoother == AmgSmoother::JACOBI) {
+                JacobiSweep(a, level, b, x);
+            } else {
+                ChebyshevSweep(a, level, b, x);
+            }
+        }
+    }
+
+    void Cycle(std::size_t l, const Value *b, Value *x) const {
+        const Level &level{levels_[l]};
+        if (l + 1 == levels_.size() && coarse_direct_) {
+            CoarseSolve(b, x);
+            return;
+        }
+        VisitLevel(l, [&](const auto &a) {
+            const std::size_t n{a.M()};
+            std::fill(x, x + n, Value{});
+            if (l + 1 == levels_.size()) {
+                // 粗化停滞且最粗层过大时不做稠密分解，仅以平滑近似求解
+                Smooth(a, level, b, x, options_.pre_sweeps + options_.post_sweeps);
+                return;
+            }
+            const Level &next{levels_[l + 1]};
+            Smooth(a, level, b, x, options_.pre_sweeps);
+
+            Residual(a, b, x, level.res.data());
+            std::visit([&](const auto &r) { SpMV(r, level.res.data(), next.b.data()); }, level.r);
+            Cycle(l + 1, next.b.data(), next.x.data());
+            std::visit([&](const auto &p) { SpMV(p, next.x.data(), level.res.data()); }, level.p);
+            ParallelFor(0, n, REDUCE_GRAIN, [x, &level](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    x[i] += level.res[i];
+                }
+            });
+
+            Smooth(a, level, b, x, options_.post_sweeps);
+        });
+    }
+
+    AmgOptions options_;
+    const CsrType *fine_{nullptr};
+    std::vector<Level> levels_;
+    bool coarse_direct_{false};
+    std::vector<Value> coarse_lu_;
+    std::vector<std::size_t> coarse_pivots_;
+};
+} // namespace oops
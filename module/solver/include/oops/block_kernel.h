@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/krylov_kernel.h"
+#include "oops/spmv.h"
+
+namespace oops {
+// 多向量块运算，块为n x k列主序矩阵，列间距ld
+// 行方向并行；规约按固定分块求和，结果与线程数无关
+constexpr std::size_t BLOCK_ROW_GRAIN{1024};
+
+// C(k1 x k2) = X^T * Y
+template <typename Value>
+void BlockDot(
+    std::size_t n, std::size_t k1, const Value *x, std::size_t ldx, std::size_t k2, const Value *y, std::size_t ldy,
+    Value *c, std::size_t ldc) {
+    const std::size_t num_chunks{ReduceChunks(n)};
+    std::vector<Value> partials(num_chunks * k1 * k2, Value{});
+    ParallelChunks(n, num_chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        Value *part{partials.data() + chunk * k1 * k2};
+        for (std::size_t j{0}; j < k2; ++j) {
+            const Value *y_j{y + j * ldy};
+            for (std::size_t i{0}; i < k1; ++i) {
+                const Value *x_i{x + i * ldx};
+                Value sum{};
+                for (std::size_t r{begin}; r < end; ++r) {
+                    sum += x_i[r] * y_j[r];
+                }
+                part[i + j * k1] = sum;
+            }
+        }
+    });
+    for (std::size_t j{0}; j < k2; ++j) {
+        for (std::size_t i{0}; i < k1; ++i) {
+            Value sum{};
+            for (std::size_t chunk{0}; chunk < num_chunks; ++chunk) {
+                sum += partials[chunk * k1 * k2 + i + j * k1];
+            }
+            c[i + j * ldc] = sum;
+        }
+    }
+}
+
+// Y(n x k2) -= X(n x k1) * C(k1 x k2)
+template <typename Value>
+void BlockUpdate(
+    std::size_t n, std::size_t k1, const Value *x, std::size_t ldx, std::size_t k2, const Value *c, std::size_t ldc,
+    Value *y, std::size_t ldy) {
+    ParallelFor(0, n, BLOCK_ROW_GRAIN, [=](std::size_t begin, std::size_t end) {
+        for (std::size_t j{0}; j < k2; ++j) {
+            Value *y_j{y + j * ldy};
+            for (std::size_t i{0}; i < k1; ++i) {
+                const Value c_ij{c[i + j * ldc]};
+                const Value *x_i{x + i * ldx};
+                for (std::size_t r{begin}; r < end; ++r) {
+                    y_j[r] -= x_i[r] * c_ij;
+                }
+            }
+        }
+    });
+}
+
+// X(:, 0:k2) = X(:, 0:k1) * C(k1 x k2)，k2 <= k1，原位计算，仅需按行分块的临时空间
+template <typename Value>
+void BlockMultiplyInPlace(
+    std::size_t n, std::size_t k1, Value *x, std::size_t ldx, std::size_t k2, const Value *c, std::size_t ldc) {
+    ParallelFor(0, n, BLOCK_ROW_GRAIN, [=](std::size_t begin, std::size_t end) {
+        const std::size_t len{end - begin};
+        std::vector<Value> tmp(len * k2, Value{});
+        for (std::size_t j{0}; j < k2; ++j) {
+            Value *t_j{tmp.data() + j * len};
+            for (std::size_t i{0}; i < k1; ++i) {
+                const Value c_ij{c[i + j * ldc]};
+                const Value *x_i{x + i * ldx + begin};
+                for (std::size_t r{0}; r < len; ++r) {
+                    t_j[r] += x_i[r] * c_ij;
+                }
+            }
+        }
+        for (std::size_t j{0}; j < k2; ++j) {
+            std::copy(tmp.begin() + j * len, tmp.begin() + (j + 1) * len, x + j * ldx + begin);
+        }
+    });
+}
+
+// 对称矩阵的块乘Y = A * X，直接使用压缩存储的一半
+// 镜像部分按缓存于模式上的转置结构收集，使每行结果只由本行写入，避免散射写冲突
+template <typename Value, typename DimIndex, typename NnzIndex>
+class SymmetricSpMM {
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+
+    explicit SymmetricSpMM(const CsrType &a) : a_{&a} {
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("spmm requires a square matrix");
+        }
+        const auto symmetric{a.GetSymmetric()};
+        if (symmetric == MatrixSymmetric::GENERAL) {
+            return;
+        }
+        if (symmetric != MatrixSymmetric::SYMMETRIC_LOWER && symmetric != MatrixSymmetric::SYMMETRIC_UPPER) {
+            throw std::invalid_argument("spmm requires symmetric or general storage");
+        }
+        transposed_ = detail::GetTransposedPattern(*a.GetPattern());
+    }
+
+    std::size_t N() const { return a_->M(); }
+
+    // Y(n x k) = A * X(n x k)
+    void Apply(std::size_t k, const Value *x, std::size_t ldx, Value *y, std::size_t ldy) const {
+        const auto &store{a_->GetStore()};
+        const bool mirror{transposed_ != nullptr};
+        const NnzIndex *t_row_ptr{mirror ? transposed_->pattern->GetRowPtr().data() : nullptr};
+        const DimIndex *t_col_indices{mirror ? transposed_->pattern->GetColIndices().data() : nullptr};
+        const NnzIndex *t_src{mirror ? transposed_->src.data() : nullptr};
+        ParallelFor(0, N(), SPMV_ROW_GRAIN, [&, x, y](std::size_t begin, std::size_t end) {
+            for (std::size_t r{begin}; r < end; ++r) {
+                for (std::size_t j{0}; j < k; ++j) {
+                    y[r + j * ldy] = Value{};
+                }
+                for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                    const Value v{store.values[i]};
+                    const Value *x_c{x + store.col_indices[i]};
+                    for (std::size_t j{0}; j < k; ++j) {
+                        y[r + j * ldy] += v * x_c[j * ldx];
+                    }
+                }
+                if (!mirror) {
+                    continue;
+                }
+                for (auto i{t_row_ptr[r]}; i < t_row_ptr[r + 1]; ++i) {
+                    if (static_cast<std::size_t>(t_col_indices[i]) == r) {
+                        continue;
+                    }
+                    const Value v{store.values[t_src[i]]};
+                    const Value *x_c{x + t_col_indices[i]};
+                    for (std::size_t j{0}; j < k; ++j) {
+                        y[r + j * ldy] += v * x_c[j * ldx];
+                    }
+                }
+            }
+        });
+    }
+
+private:
+    const CsrType *a_;
+    // 对称存储时为缓存于a模式上的转置结构，一般存储时为空
+    std::shared_ptr<const detail::TransposedPattern<typename CsrType::PatternType>> transposed_;
+};
+} // namespace oops
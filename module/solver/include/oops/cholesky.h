@@ -0,0 +1,679 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "oops/convert.h"
+#include "oops/csr.h"
+#include "oops/dense_kernel.h"
+#include "oops/level_schedule.h"
+
+namespace oops {
+enum class CholeskyOrdering : std::uint8_t { NATURAL, AMD };
+
+struct CholeskyOptions {
+    CholeskyOrdering ordering{CholeskyOrdering::AMD};
+};
+
+// 近似最小度排序，输入为不含对角的对称邻接结构，返回消去顺序perm，perm[k]为第k个消去的原编号
+// 在商图上消去：已消去节点成为元素，度取|A_i| + |L_p \ i| + Σ|L_e \ L_p|的上界近似，同度按编号升序，结果确定
+inline std::vector<std::size_t>
+ApproximateMinimumDegree(const std::vector<std::size_t> &adj_ptr, const std::vector<std::size_t> &adj) {
+    constexpr std::size_t NONE{std::numeric_limits<std::size_t>::max()};
+    const std::size_t n{adj_ptr.size() - 1};
+    std::vector<std::vector<std::size_t>> vars(n);  // 相邻的未消去变量
+    std::vector<std::vector<std::size_t>> elems(n); // 相邻元素
+    std::vector<std::vector<std::size_t>> elem_vars(n);
+    std::vector<std::uint8_t> eliminated(n, 0), absorbed(n, 0);
+    std::vector<std::size_t> degree(n), mark(n, NONE), w(n), w_mark(n, NONE);
+    std::set<std::pair<std::size_t, std::size_t>> queue;
+    for (std::size_t i{0}; i < n; ++i) {
+        vars[i].assign(adj.begin() + adj_ptr[i], adj.begin() + adj_ptr[i + 1]);
+        degree[i] = vars[i].size();
+        queue.emplace(degree[i], i);
+    }
+
+    std::vector<std::size_t> perm;
+    perm.reserve(n);
+    for (std::size_t k{0}; k < n; ++k) {
+        const std::size_t p{queue.begin()->second};
+        queue.erase(queue.begin());
+        eliminated[p] = 1;
+        perm.push_back(p);
+
+        // L_p = A_p ∪ (∪ L_e) \ {p}，被合并的元素吸收进p
+        std::vector<std::size_t> &lp{elem_vars[p]};
+        mark[p] = k;
+        auto add = [&](std::size_t v) {
+            if (!eliminated[v] && mark[v] != k) {
+                mark[v] = k;
+                lp.push_back(v);
+            }
+        };
+        for (auto v : vars[p]) {
+            add(v);
+        }
+        for (auto e : elems[p]) {
+            if (!absorbed[e]) {
+                for (auto v : elem_vars[e]) {
+                    add(v);
+                }
+                absorbed[e] = 1;
+                std::vector<std::size_t>{}.swap(elem_vars[e]);
+            }
+        }
+        std::vector<std::size_t>{}.swap(vars[p]);
+        std::vector<std::size_t>{}.swap(elems[p]);
+
+        // w[e] = |L_e \ L_p|
+        for (auto i : lp) {
+            for (auto e : elems[i]) {
+                if (!absorbed[e]) {
+                    if (w_mark[e] != k) {
+                        w_mark[e] = k;
+                        w[e] = elem_vars[e].size();
+                    }
+                    --w[e];
+                }
+            }
+        }
+        for (auto i : lp) {
+            // L_p内的变量已经由元素p连通，从A_i中剪除；L_e ⊆ L_p的元素被p吸收
+            auto &vi{vars[i]};
+            vi.erase(
+                std::remove_if(vi.begin(), vi.end(), [&](std::size_t v) { return eliminated[v] || mark[v] == k; }),
+                vi.end());
+            auto &ei{elems[i]};
+            std::size_t d{vi.size() + lp.size() - 1};
+            auto dead = [&](std::size_t e) {
+                if (!absorbed[e] && w[e] == 0) {
+                    absorbed[e] = 1;
+                    std::vector<std::size_t>{}.swap(elem_vars[e]);
+                }
+                if (absorbed[e]) {
+                    return true;
+                }
+                d += w[e];
+                return false;
+            };
+            ei.erase(std::remove_if(ei.begin(), ei.end(), dead), ei.end());
+            ei.push_back(p);
+
+            d = std::min(d, n - k - 1);
+            queue.erase({degree[i], i});
+            degree[i] = d;
+            queue.emplace(d, i);
+        }
+    }
+    return perm;
+}
+
+// 超节点稀疏Cholesky直接求解，A = P^T * L * L^T * P
+// 1. Analyze：填充约减排序、消去树后序、列计数、基本超节点划分及各超节点行结构，并生成超节点间的更新列表
+// 2. Factorize：左视超节点数值分解，对角块与次对角块使用稠密分块核；按超节点树分层，同层超节点并行分解
+//    模式不变时可反复调用，跳过符号分析
+// 3. Solve：多右端项前代/回代，右端项按列主序存放
+// 输入为对称下三角/上三角存储或一般存储(取下三角)，亦可为Coo
+template <typename Value, typename DimIndex = int32_t, typename NnzIndex = DimIndex>
+class SupernodalCholesky {
+    static_assert(std::is_floating_point_v<Value>);
+    static constexpr std::size_t NONE{std::numeric_limits<std::size_t>::max()};
+
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+    using CooType = Coo<Value, DimIndex>;
+
+    explicit SupernodalCholesky(CholeskyOptions options = {}) : options_{options} {}
+    SupernodalCholesky(const CsrType &a, CholeskyOptions options = {}) : options_{options} {
+        Analyze(a);
+        Factorize(a);
+    }
+    SupernodalCholesky(const CooType &a, CholeskyOptions options = {})
+        : SupernodalCholesky(ToCsr<NnzIndex>(a), options) {}
+
+    void Analyze(const CooType &a) { Analyze(ToCsr<NnzIndex>(a)); }
+    void Factorize(const CooType &a) { Factorize(ToCsr<NnzIndex>(a)); }
+
+    void Analyze(const CsrType &a) {
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("cholesky requires a square matrix");
+        }
+        const auto symmetric{a.GetSymmetric()};
+        if (symmetric != MatrixSymmetric::GENERAL && symmetric != MatrixSymmetric::SYMMETRIC_LOWER &&
+            symmetric != MatrixSymmetric::SYMMETRIC_UPPER) {
+            throw std::invalid_argument("cholesky requires symmetric or general storage");
+        }
+        n_ = a.M();
+        symmetric_ = symmetric;
+        pattern_ = a.GetPattern();
+        // 符号分析只依赖模式、存储方式与排序选项，结果缓存于模式上；命中时共享只读结果，跳过排序与超节点划分
+        const std::uint64_t key{
+            static_cast<std::uint64_t>(options_.ordering) << 8 | static_cast<std::uint64_t>(symmetric)};
+        symbolic_ = pattern_->template Cached<Symbolic>(key, [this] {
+            Symbolic sym;
+            AnalyzePattern(sym);
+            return sym;
+        });
+        AllocateWorkspaces();
+        values_.clear();
+    }
+
+    // 以新的数值重新分解，a的模式须与Analyze时一致
+    void Factorize(const CsrType &a) {
+        if (pattern_ == nullptr || a.GetSymmetric() != symmetric_ ||
+            (a.GetPattern() != pattern_ && !a.GetPattern()->Same(*pattern_))) {
+            throw std::invalid_argument("cholesky refactorization with a different pattern");
+        }
+        const Symbolic &sym{*symbolic_};
+        values_.assign(sym.sup_val_ptr.back(), Value{});
+        const Value *a_values{a.GetValues().data()};
+        auto factorize_f = [this, &sym, a_values](std::size_t chunk, std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                FactorizeSupernode(sym.sup_schedule.rows[i], a_values, workspaces_[chunk]);
+            }
+        };
+        for (std::size_t level{0}; level < sym.sup_schedule.NumLevels(); ++level) {
+            const std::size_t begin{sym.sup_schedule.level_ptr[level]};
+            const std::size_t end{sym.sup_schedule.level_ptr[level + 1]};
+            if (end - begin == 1) {
+                // 单个超节点(通常为靠近根的大超节点)，由稠密核内部并行
+                factorize_f(0, begin, end);
+                continue;
+            }
+            const std::size_t num_chunks{std::min(end - begin, workspaces_.size())};
+            ParallelChunks(end - begin, num_chunks, [&](std::size_t chunk, std::size_t b, std::size_t e) {
+                factorize_f(chunk, begin + b, begin + e);
+            });
+        }
+    }
+
+    // 求解A * X = B，B、X为n x nrhs列主序矩阵，允许b与x为同一数组
+    void Solve(const Value *b, Value *x, std::size_t nrhs = 1) const {
+        if (symbolic_ == nullptr || (values_.empty() && n_ > 0)) {
+            throw std::logic_error("cholesky solve before factorization");
+        }
+        const Symbolic &sym{*symbolic_};
+        std::vector<Value> w(n_ * nrhs);
+        for (std::size_t r{0}; r < nrhs; ++r) {
+            for (std::size_t k{0}; k < n_; ++k) {
+                w[k + r * n_] = b[sym.perm[k] + r * n_];
+            }
+        }
+        // 右端项分块并行，各块独立完成前代与回代
+        const std::size_t num_chunks{std::min(nrhs, workspaces_.size())};
+        ParallelChunks(nrhs, num_chunks, [this, &sym, &w](std::size_t, std::size_t begin, std::size_t end) {
+            std::vector<Value> gather(sym.max_below * (end - begin));
+            SolveBlock(w.data() + begin * n_, end - begin, gather.data());
+        });
+        for (std::size_t r{0}; r < nrhs; ++r) {
+            for (std::size_t k{0}; k < n_; ++k) {
+                x[sym.perm[k] + r * n_] = w[k + r * n_];
+            }
+        }
+    }
+
+    void Solve(const std::vector<Value> &b, std::vector<Value> &x) const {
+        if (n_ == 0 || b.size() % n_ != 0) {
+            throw std::invalid_argument("cholesky rhs size mismatch");
+        }
+        x.resize(b.size());
+        Solve(b.data(), x.data(), b.size() / n_);
+    }
+
+    std::size_t N() const { return n_; }
+    std::size_t NumSupernodes() const { return symbolic_ == nullptr ? 0 : symbolic_->sup_ptr.size() - 1; }
+    std::size_t FactorNnz() const { return symbolic_ == nullptr ? 0 : symbolic_->factor_nnz; }
+    const std::vector<std::size_t> &GetPermutation() const {
+        static const std::vector<std::size_t> empty;
+        return symbolic_ == nullptr ? empty : symbolic_->perm;
+    }
+
+private:
+    struct Workspace {
+        std::vector<std::size_t> rel; // 全局行号到当前超节点局部行号的映射
+        std::vector<Value> update;
+    };
+
+    struct Update {
+        std::size_t source; // 提供更新的后代超节点
+        std::size_t begin;  // 在source行结构中的起始偏移
+        std::size_t end;
+    };
+
+    // 符号分析结果，缓存于输入矩阵的模式上，同一模式的分解器共享
+    // 超节点s包含列[sup_ptr[s], sup_ptr[s + 1])，其L块为sup_rows[sup_row_ptr[s]:]各行的列主序稠密块
+    struct Symbolic {
+        std::vector<std::size_t> perm;
+        std::vector<std::size_t> col_ptr, col_rows, src;
+        std::vector<std::size_t> lower_row_ptr, lower_cols;
+        std::vector<std::size_t> sup_ptr, super_of;
+        std::vector<std::size_t> sup_row_ptr, sup_rows;
+        std::vector<std::size_t> sup_val_ptr;
+        std::vector<std::size_t> update_ptr;
+        std::vector<Update> updates;
+        LevelSchedule sup_schedule;
+        std::size_t factor_nnz;
+        std::size_t max_below;
+        std::size_t max_update;
+    };
+
+    // 对pattern_做符号分析，结果写入sym
+    void AnalyzePattern(Symbolic &sym) const {
+        const auto &row_ptr{pattern_->GetRowPtr()};
+        const auto &col_indices{pattern_->GetColIndices()};
+
+        // 取下三角元素(row >= col)及其在输入中的位置
+        std::vector<std::size_t> rows, cols, src;
+        for (std::size_t r{0}; r < n_; ++r) {
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                std::size_t c{static_cast<std::size_t>(col_indices[i])};
+                if (symmetric_ == MatrixSymmetric::GENERAL && c > r) {
+                    continue;
+                }
+                rows.push_back(std::max(r, c));
+                cols.push_back(std::min(r, c));
+                src.push_back(static_cast<std::size_t>(i));
+            }
+        }
+
+        sym.perm.resize(n_);
+        for (std::size_t i{0}; i < n_; ++i) {
+            sym.perm[i] = i;
+        }
+        if (options_.ordering == CholeskyOrdering::AMD) {
+            std::vector<std::size_t> adj_ptr, adj;
+            BuildAdjacency(rows, cols, adj_ptr, adj);
+            sym.perm = ApproximateMinimumDegree(adj_ptr, adj);
+        }
+        // 以消去树后序重排，填充不变且使超节点的列连续
+        BuildPermuted(rows, cols, src, sym);
+        std::vector<std::size_t> parent{EliminationTree(sym)};
+        std::vector<std::size_t> post{PostOrder(parent)};
+        std::vector<std::size_t> perm(n_);
+        for (std::size_t k{0}; k < n_; ++k) {
+            perm[k] = sym.perm[post[k]];
+        }
+        sym.perm = std::move(perm);
+        BuildPermuted(rows, cols, src, sym);
+        parent = EliminationTree(sym);
+
+        BuildSupernodes(parent, ColumnCounts(parent, sym), sym);
+        BuildUpdates(sym);
+    }
+
+    void AllocateWorkspaces() {
+        workspaces_.resize(ThreadPool::Get().Size());
+        for (auto &ws : workspaces_) {
+            ws.rel.assign(n_, 0);
+            ws.update.assign(symbolic_->max_update, Value{});
+        }
+    }
+
+    // 下三角元素对应的对称邻接结构，去除对角与重复元素
+    void BuildAdjacency(
+        const std::vector<std::size_t> &rows, const std::vector<std::size_t> &cols, std::vector<std::size_t> &adj_ptr,
+        std::vector<std::size_t> &adj) const {
+        adj_ptr.assign(n_ + 1, 0);
+        for (std::size_t i{0}; i < rows.size(); ++i) {
+            if (rows[i] != cols[i]) {
+                ++adj_ptr[rows[i] + 1];
+                ++adj_ptr[cols[i] + 1];
+            }
+        }
+        for (std::size_t k{0}; k < n_; ++k) {
+            adj_ptr[k + 1] += adj_ptr[k];
+        }
+        adj.resize(adj_ptr[n_]);
+        std::vector<std::size_t> pos(adj_ptr.begin(), adj_ptr.end() - 1);
+        for (std::size_t i{0}; i < rows.size(); ++i) {
+            if (rows[i] != cols[i]) {
+                adj[pos[rows[i]]++] = cols[i];
+                adj[pos[cols[i]]++] = rows[i];
+            }
+        }
+        std::size_t nnz{0};
+        for (std::size_t k{0}; k < n_; ++k) {
+            auto first{adj.begin() + adj_ptr[k]};
+            auto last{adj.begin() + adj_ptr[k + 1]};
+            std::sort(first, last);
+            last = std::unique(first, last);
+            adj_ptr[k] = nnz;
+            nnz = std::copy(first, last, adj.begin() + nnz) - adj.begin();
+        }
+        adj_ptr[n_] = nnz;
+        adj.resize(nnz);
+    }
+
+    // 置换后下三角的按列(CSC)与按行(CSR)结构，src_记录按列结构中各元素在输入中的位置
+    void BuildPermuted(
+        const std::vector<std::size_t> &rows, const std::vector<std::size_t> &cols,
+        const std::vector<std::size_t> &src, Symbolic &sym) const {
+        std::vector<std::size_t> inv(n_);
+        for (std::size_t k{0}; k < n_; ++k) {
+            inv[sym.perm[k]] = k;
+        }
+        const std::size_t nnz{rows.size()};
+        sym.col_ptr.assign(n_ + 1, 0);
+        sym.lower_row_ptr.assign(n_ + 1, 0);
+        for (std::size_t i{0}; i < nnz; ++i) {
+            const std::size_t r{std::max(inv[rows[i]], inv[cols[i]])};
+            const std::size_t c{std::min(inv[rows[i]], inv[cols[i]])};
+            ++sym.col_ptr[c + 1];
+            ++sym.lower_row_ptr[r + 1];
+        }
+        for (std::size_t k{0}; k < n_; ++k) {
+            sym.col_ptr[k + 1] += sym.col_ptr[k];
+            sym.lower_row_ptr[k + 1] += sym.lower_row_ptr[k];
+        }
+        sym.col_rows.resize(nnz);
+        sym.src.resize(nnz);
+        sym.lower_cols.resize(nnz);
+        std::vector<std::size_t> col_pos(sym.col_ptr.begin(), sym.col_ptr.end() - 1);
+        std::vector<std::size_t> row_pos(sym.lower_row_ptr.begin(), sym.lower_row_ptr.end() - 1);
+        for (std::size_t i{0}; i < nnz; ++i) {
+            const std::size_t r{std::max(inv[rows[i]], inv[cols[i]])};
+            const std::size_t c{std::min(inv[rows[i]], inv[cols[i]])};
+            sym.col_rows[col_pos[c]] = r;
+            sym.src[col_pos[c]++] = src[i];
+            sym.lower_cols[row_pos[r]++] = c;
+        }
+    }
+
+    // Liu算法，带路径压缩
+    std::vector<std::size_t> EliminationTree(const Symbolic &sym) const {
+        std::vector<std::size_t> parent(n_, NONE), ancestor(n_, NONE);
+        for (std::size_t k{0}; k < n_; ++k) {
+            for (std::size_t p{sym.lower_row_ptr[k]}; p < sym.lower_row_ptr[k + 1]; ++p) {
+                std::size_t i{sym.lower_cols[p]};
+                while (i != NONE && i < k) {
+                    const std::size_t next{ancestor[i]};
+                    ancestor[i] = k;
+                    if (next == NONE) {
+                        parent[i] = k;
+                    }
+                    i = next;
+                }
+            }
+        }
+        return parent;
+    }
+
+    // 非递归深度优先后序，子节点按编号升序访问
+    std::vector<std::size_t> PostOrder(const std::vector<std::size_t> &parent) const {
+        std::vector<std::size_t> head(n_, NONE), next(n_, NONE), stack, post;
+        for (std::size_t j{n_}; j-- > 0;) {
+            if (parent[j] != NONE) {
+                next[j] = head[parent[j]];
+                head[parent[j]] = j;
+            }
+        }
+        post.reserve(n_);
+        for (std::size_t root{0}; root < n_; ++root) {
+            if (parent[root] != NONE) {
+                continue;
+            }
+            stack.push_back(root);
+            while (!stack.empty()) {
+                const std::size_t p{stack.back()};
+                const std::size_t child{head[p]};
+                if (child == NONE) {
+                    stack.pop_back();
+                    post.push_back(p);
+                } else {
+                    head[p] = next[child];
+                    stack.push_back(child);
+                }
+            }
+        }
+        return post;
+    }
+
+    // L的各列非零数(含对角)：第k行的模式为消去树上自A(k, :)各列至k的行子树
+    std::vector<std::size_t> ColumnCounts(const std::vector<std::size_t> &parent, const Symbolic &sym) const {
+        std::vector<std::size_t> counts(n_, 0), mark(n_, NONE);
+        for (std::size_t k{0}; k < n_; ++k) {
+            mark[k] = k;
+            ++counts[k];
+            for (std::size_t p{sym.lower_row_ptr[k]}; p < sym.lower_row_ptr[k + 1]; ++p) {
+                for (std::size_t j{sym.lower_cols[p]}; mark[j] != k; j = parent[j]) {
+                    mark[j] = k;
+                    ++counts[j];
+                }
+            }
+        }
+        return counts;
+    }
+
+    // 基本超节点：列j并入前一列所在超节点，当且仅当j为j - 1的父节点、j仅有此一个子节点且两列模式嵌套
+    // FactorNnz按列计数统计L的真实非零数，不含松弛合并引入的显式零元
+    void BuildSupernodes(
+        const std::vector<std::size_t> &parent, const std::vector<std::size_t> &counts, Symbolic &sym) const {
+        std::vector<std::size_t> num_children(n_, 0);
+        for (std::size_t j{0}; j < n_; ++j) {
+            if (parent[j] != NONE) {
+                ++num_children[parent[j]];
+            }
+        }
+        std::vector<std::size_t> fundamental{0};
+        for (std::size_t j{1}; j <= n_; ++j) {
+            if (j == n_ || parent[j - 1] != j || num_children[j] != 1 || counts[j - 1] != counts[j] + 1) {
+                fundamental.push_back(j);
+            }
+        }
+
+        // 松弛合并：前一超节点为当前超节点的子节点时，若引入的显式零元比例不超过阈值则并为一个稠密块
+        auto relax = [](std::size_t ncols, double zeros) {
+            return ncols <= 4 || (ncols <= 16 && zeros < 0.8) || (ncols <= 48 && zeros < 0.1) || zeros < 0.05;
+        };
+        sym.sup_ptr.assign(1, 0);
+        sym.factor_nnz = 0;
+        std::size_t group_nnz{0};
+        for (std::size_t s{0}; s + 1 < fundamental.size(); ++s) {
+            const std::size_t first{fundamental[s]};
+            const std::size_t last{fundamental[s + 1]};
+            const std::size_t nnz{counts[first] * (last - first) - (last - first) * (last - first - 1) / 2};
+            sym.factor_nnz += nnz;
+            if (first > 0 && parent[first - 1] == first) {
+                const std::size_t ncols{last - sym.sup_ptr.back()};
+                const std::size_t nrows{ncols + counts[last - 1] - 1};
+                const std::size_t stored{ncols * nrows - ncols * (ncols - 1) / 2};
+                const double zeros{static_cast<double>(stored - group_nnz - nnz) / static_cast<double>(stored)};
+                if (relax(ncols, zeros)) {
+                    group_nnz += nnz;
+                    continue;
+                }
+            }
+            if (first > 0) {
+                sym.sup_ptr.push_back(first);
+            }
+            group_nnz = nnz;
+        }
+        if (n_ > 0) {
+            sym.sup_ptr.push_back(n_);
+        }
+        const std::size_t ns{sym.sup_ptr.size() - 1};
+        sym.super_of.resize(n_);
+        for (std::size_t s{0}; s < ns; ++s) {
+            std::fill(sym.super_of.begin() + sym.sup_ptr[s], sym.super_of.begin() + sym.sup_ptr[s + 1], s);
+        }
+
+        // 超节点行结构 = 自身列 ∪ A中对应列的下方行 ∪ 子超节点结构中的下方行
+        std::vector<std::vector<std::size_t>> children(ns);
+        for (std::size_t s{0}; s < ns; ++s) {
+            const std::size_t p{parent[sym.sup_ptr[s + 1] - 1]};
+            if (p != NONE) {
+                children[sym.super_of[p]].push_back(s);
+            }
+        }
+        std::vector<std::size_t> mark(n_, NONE);
+        sym.sup_row_ptr.assign(1, 0);
+        sym.sup_rows.clear();
+        for (std::size_t s{0}; s < ns; ++s) {
+            const std::size_t first{sym.sup_ptr[s]};
+            const std::size_t last{sym.sup_ptr[s + 1]};
+            for (std::size_t j{first}; j < last; ++j) {
+                sym.sup_rows.push_back(j);
+            }
+            const std::size_t below_begin{sym.sup_rows.size()};
+            auto add = [&](std::size_t r) {
+                if (r >= last && mark[r] != s) {
+                    mark[r] = s;
+                    sym.sup_rows.push_back(r);
+                }
+            };
+            for (std::size_t j{first}; j < last; ++j) {
+                for (std::size_t p{sym.col_ptr[j]}; p < sym.col_ptr[j + 1]; ++p) {
+                    add(sym.col_rows[p]);
+                }
+            }
+            for (auto c : children[s]) {
+                for (std::size_t p{sym.sup_row_ptr[c]}; p < sym.sup_row_ptr[c + 1]; ++p) {
+                    add(sym.sup_rows[p]);
+                }
+            }
+            std::sort(sym.sup_rows.begin() + below_begin, sym.sup_rows.end());
+            sym.sup_row_ptr.push_back(sym.sup_rows.size());
+        }
+
+        sym.sup_val_ptr.assign(1, 0);
+        sym.max_below = 0;
+        for (std::size_t s{0}; s < ns; ++s) {
+            const std::size_t nrows{sym.sup_row_ptr[s + 1] - sym.sup_row_ptr[s]};
+            const std::size_t ncols{sym.sup_ptr[s + 1] - sym.sup_ptr[s]};
+            sym.sup_val_ptr.push_back(sym.sup_val_ptr.back() + nrows * ncols);
+            sym.max_below = std::max(sym.max_below, nrows - ncols);
+        }
+    }
+
+    // 超节点d对s的更新取d的行结构中落在s列范围内的连续一段[update_begin, update_end)
+    // 以更新关系作为依赖构建超节点层次调度，并记录工作区所需的更新块大小
+    void BuildUpdates(Symbolic &sym) const {
+        const std::size_t ns{sym.sup_ptr.size() - 1};
+        std::vector<std::vector<Update>> lists(ns);
+        sym.max_update = 0;
+        for (std::size_t d{0}; d < ns; ++d) {
+            const std::size_t ncols{sym.sup_ptr[d + 1] - sym.sup_ptr[d]};
+            const std::size_t end{sym.sup_row_ptr[d + 1]};
+            for (std::size_t p{sym.sup_row_ptr[d] + ncols}; p < end;) {
+                const std::size_t s{sym.super_of[sym.sup_rows[p]]};
+                std::size_t q{p};
+                while (q < end && sym.sup_rows[q] < sym.sup_ptr[s + 1]) {
+                    ++q;
+                }
+                lists[s].push_back({d, p - sym.sup_row_ptr[d], q - sym.sup_row_ptr[d]});
+                sym.max_update = std::max(sym.max_update, (end - p) * (q - p));
+                p = q;
+            }
+        }
+        sym.update_ptr.assign(1, 0);
+        sym.updates.clear();
+        std::vector<std::size_t> dep_ptr{0}, deps;
+        for (std::size_t s{0}; s < ns; ++s) {
+            for (const auto &u : lists[s]) {
+                sym.updates.push_back(u);
+                deps.push_back(u.source);
+            }
+            sym.update_ptr.push_back(sym.updates.size());
+            dep_ptr.push_back(deps.size());
+        }
+        sym.sup_schedule = BuildLevelSchedule(ns, dep_ptr, deps, true);
+    }
+
+    void FactorizeSupernode(std::size_t s, const Value *a_values, Workspace &ws) {
+        const Symbolic &sym{*symbolic_};
+        const std::size_t first{sym.sup_ptr[s]};
+        const std::size_t ncols{sym.sup_ptr[s + 1] - first};
+        const std::size_t *rows{sym.sup_rows.data() + sym.sup_row_ptr[s]};
+        const std::size_t nrows{sym.sup_row_ptr[s + 1] - sym.sup_row_ptr[s]};
+        Value *panel{values_.data() + sym.sup_val_ptr[s]};
+        for (std::size_t i{0}; i < nrows; ++i) {
+            ws.rel[rows[i]] = i;
+        }
+        for (std::size_t j{0}; j < ncols; ++j) {
+            for (std::size_t p{sym.col_ptr[first + j]}; p < sym.col_ptr[first + j + 1]; ++p) {
+                panel[ws.rel[sym.col_rows[p]] + j * nrows] += a_values[sym.src[p]];
+            }
+        }
+
+        // 左视更新：panel -= L_d(update_begin:, :) * L_d(update_begin:update_end, :)^T
+        for (std::size_t u{sym.update_ptr[s]}; u < sym.update_ptr[s + 1]; ++u) {
+            const Update &update{sym.updates[u]};
+            const std::size_t d{update.source};
+            const std::size_t *d_rows{sym.sup_rows.data() + sym.sup_row_ptr[d] + update.begin};
+            const std::size_t d_nrows{sym.sup_row_ptr[d + 1] - sym.sup_row_ptr[d]};
+            const std::size_t d_ncols{sym.sup_ptr[d + 1] - sym.sup_ptr[d]};
+            const Value *d_panel{values_.data() + sym.sup_val_ptr[d] + update.begin};
+            const std::size_t m{d_nrows - update.begin};
+            const std::size_t k{update.end - update.begin};
+            std::fill(ws.update.begin(), ws.update.begin() + m * k, Value{});
+            DenseGemmNT(m, k, d_ncols, d_panel, d_nrows, d_panel, d_nrows, ws.update.data(), m);
+            for (std::size_t j{0}; j < k; ++j) {
+                Value *col{panel + (d_rows[j] - first) * nrows};
+                const Value *c_j{ws.update.data() + j * m};
+                for (std::size_t i{j}; i < m; ++i) {
+                    col[ws.rel[d_rows[i]]] += c_j[i];
+                }
+            }
+        }
+
+        const std::size_t info{DenseCholesky(ncols, panel, nrows)};
+        if (info != ncols) {
+            throw std::runtime_error("cholesky non-positive pivot at row " + std::to_string(sym.perm[first + info]));
+        }
+        DenseTrsmRLT(nrows - ncols, ncols, panel, nrows, panel + ncols, nrows);
+    }
+
+    // 对连续nrhs列右端项依次执行超节点前代与回代
+    void SolveBlock(Value *w, std::size_t nrhs, Value *gather) const {
+        const Symbolic &sym{*symbolic_};
+        const std::size_t ns{NumSupernodes()};
+        for (std::size_t s{0}; s < ns; ++s) {
+            const std::size_t first{sym.sup_ptr[s]};
+            const std::size_t ncols{sym.sup_ptr[s + 1] - first};
+            const std::size_t nrows{sym.sup_row_ptr[s + 1] - sym.sup_row_ptr[s]};
+            const std::size_t nbelow{nrows - ncols};
+            const std::size_t *below{sym.sup_rows.data() + sym.sup_row_ptr[s] + ncols};
+            const Value *panel{values_.data() + sym.sup_val_ptr[s]};
+            DenseTrsmLN(ncols, nrhs, panel, nrows, w + first, n_);
+            std::fill(gather, gather + nbelow * nrhs, Value{});
+            DenseGemmNN(nbelow, nrhs, ncols, panel + ncols, nrows, w + first, n_, gather, nbelow);
+            for (std::size_t r{0}; r < nrhs; ++r) {
+                for (std::size_t i{0}; i < nbelow; ++i) {
+                    w[below[i] + r * n_] += gather[i + r * nbelow];
+                }
+            }
+        }
+        for (std::size_t s{ns}; s-- > 0;) {
+            const std::size_t first{sym.sup_ptr[s]};
+            const std::size_t ncols{sym.sup_ptr[s + 1] - first};
+            const std::size_t nrows{sym.sup_row_ptr[s + 1] - sym.sup_row_ptr[s]};
+            const std::size_t nbelow{nrows - ncols};
+            const std::size_t *below{sym.sup_rows.data() + sym.sup_row_ptr[s] + ncols};
+            const Value *panel{values_.data() + sym.sup_val_ptr[s]};
+            for (std::size_t r{0}; r < nrhs; ++r) {
+                for (std::size_t i{0}; i < nbelow; ++i) {
+                    gather[i + r * nbelow] = w[below[i] + r * n_];
+                }
+            }
+            DenseGemmTN(ncols, nrhs, nbelow, panel + ncols, nrows, gather, nbelow, w + first, n_);
+            DenseTrsmLTN(ncols, nrhs, panel, nrows, w + first, n_);
+        }
+    }
+
+    CholeskyOptions options_;
+    std::size_t n_{0};
+    MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
+    std::shared_ptr<const typename CsrType::PatternType> pattern_;
+    std::shared_ptr<const Symbolic> symbolic_;
+
+    std::vector<Value> values_;
+    std::vector<Workspace> workspaces_;
+};
+} // namespace oops
@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 图着色结果：同色顶点互不相邻(距离1)或距离大于2(距离2)，可并行处理
+struct Coloring {
+    std::size_t NumColors() const { return color_ptr.empty() ? 0 : color_ptr.size() - 1; }
+
+    std::vector<std::size_t> colors;    // 各顶点颜色
+    std::vector<std::size_t> color_ptr; // 各颜色在rows中的起始位置
+    std::vector<std::size_t> rows;      // 按颜色排列的顶点，同色内升序
+};
+
+// 由稀疏模式得到A + A^T的邻接结构，不含对角
+template <typename Value, typename DimIndex, typename NnzIndex>
+void SymmetricAdjacency(
+    const Csr<Value, DimIndex, NnzIndex> &a, std::vector<std::size_t> &adj_ptr, std::vector<std::size_t> &adj) {
+    if (a.M() != a.N()) {
+        throw std::invalid_argument("coloring requires a square matrix");
+    }
+    const auto &store{a.GetStore()};
+    const std::size_t n{a.M()};
+    adj_ptr.assign(n + 1, 0);
+    for (std::size_t r{0}; r < n; ++r) {
+        for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+            const std::size_t c{static_cast<std::size_t>(store.col_indices[i])};
+            if (c != r) {
+                ++adj_ptr[r + 1];
+                ++adj_ptr[c + 1];
+            }
+        }
+    }
+    for (std::size_t r{0}; r < n; ++r) {
+        adj_ptr[r + 1] += adj_ptr[r];
+    }
+    adj.resize(adj_ptr[n]);
+    std::vector<std::size_t> pos(adj_ptr.begin(), adj_ptr.end() - 1);
+    for (std::size_t r{0}; r < n; ++r) {
+        for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+            const std::size_t c{static_cast<std::size_t>(store.col_indices[i])};
+            if (c != r) {
+                adj[pos[r]++] = c;
+                adj[pos[c]++] = r;
+            }
+        }
+    }
+    // 去除A与A^T重合的重复边
+    std::vector<std::size_t> unique_ptr(n + 1, 0);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t r{begin}; r < end; ++r) {
+            auto first{adj.begin() + adj_ptr[r]};
+            auto last{adj.begin() + adj_ptr[r + 1]};
+            std::sort(first, last);
+            unique_ptr[r + 1] = std::unique(first, last) - first;
+        }
+    });
+    for (std::size_t r{0}; r < n; ++r) {
+        unique_ptr[r + 1] += unique_ptr[r];
+    }
+    std::vector<std::size_t> unique_adj(unique_ptr[n]);
+    ParallelFor(0, n, SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t r{begin}; r < end; ++r) {
+            const std::size_t len{unique_ptr[r + 1] - unique_ptr[r]};
+            std::copy_n(adj.begin() + adj_ptr[r], len, unique_adj.begin() + unique_ptr[r]);
+        }
+    });
+    adj_ptr = std::move(unique_ptr);
+    adj = std::move(unique_adj);
+}
+
+// Jones-Plassmann并行着色：每轮中优先级高于全部未着色冲突邻居的顶点取冲突邻居未用的最小颜色
+// 同轮着色的顶点互不冲突，先判定后着色两阶段执行，结果与线程数无关
+// distance为1时冲突邻居为相邻顶点，为2时包含邻居的邻居
+inline Coloring
+ColorGraph(const std::vector<std::size_t> &adj_ptr, const std::vector<std::size_t> &adj, std::size_t distance = 1) {
+    if (distance != 1 && distance != 2) {
+        throw std::invalid_argument("coloring distance must be 1 or 2");
+    }
+    constexpr std::size_t NONE{std::numeric_limits<std::size_t>::max()};
+    const std::size_t n{adj_ptr.size() - 1};
+    auto priority = [](std::size_t i) {
+        std::uint64_t x{i + 0x9e3779b97f4a7c15ULL};
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    };
+    auto before = [&priority](std::size_t i, std::size_t j) {
+        const auto pi{priority(i)};
+        const auto pj{priority(j)};
+        return pi != pj ? pi > pj : i < j;
+    };
+    // 对i的每个冲突邻居调用f，f返回false时停止
+    auto for_conflicts = [&adj_ptr, &adj, distance](std::size_t i, auto &&f) {
+        for (std::size_t p{adj_ptr[i]}; p < adj_ptr[i + 1]; ++p) {
+            const std::size_t j{adj[p]};
+            if (!f(j)) {
+                return;
+            }
+            if (distance == 2) {
+                for (std::size_t q{adj_ptr[j]}; q < adj_ptr[j + 1]; ++q) {
+                    if (adj[q] != i && !f(adj[q])) {
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    Coloring coloring;
+    coloring.colors.assign(n, NONE);
+    std::vector<std::size_t> worklist(n), next;
+    for (std::size_t i{0}; i < n; ++i) {
+        worklist[i] = i;
+    }
+    std::vector<std::uint8_t> selected(n, 0);
+    while (!worklist.empty()) {
+        auto &colors{coloring.colors};
+        ParallelFor(0, worklist.size(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t w{begin}; w < end; ++w) {
+                const std::size_t i{worklist[w]};
+                bool local_max{true};
+                for_conflicts(i, [&](std::size_t j) {
+                    local_max = colors[j] != NONE || before(i, j);
+                    return local_max;
+                });
+                selected[i] = local_max;
+            }
+        });
+        ParallelFor(0, worklist.size(), SPMV_ROW_GRAIN, [&](std::size_t begin, std::size_t end) {
+            std::vector<std::uint8_t> used;
+            for (std::size_t w{begin}; w < end; ++w) {
+                const std::size_t i{worklist[w]};
+                if (!selected[i]) {
+                    continue;
+                }
+                used.clear();
+                for_conflicts(i, [&](std::size_t j) {
+                    if (colors[j] != NONE) {
+                        if (colors[j] >= used.size()) {
+                            used.resize(colors[j] + 1, 0);
+                        }
+                        used[colors[j]] = 1;
+                    }
+                    return true;
+                });
+                colors[i] = std::find(used.begin(), used.end(), 0) - used.begin();
+            }
+        });
+        next.clear();
+        for (auto i : worklist) {
+            if (!selected[i]) {
+                next.push_back(i);
+            }
+        }
+        worklist.swap(next);
+    }
+
+    // 计数排序，同色内保持顶点升序
+    std::size_t num_colors{0};
+    for (auto c : coloring.colors) {
+        num_colors = std::max(num_colors, c + 1);
+    }
+    coloring.color_ptr.assign(num_colors + 1, 0);
+    for (auto c : coloring.colors) {
+        ++coloring.color_ptr[c + 1];
+    }
+    for (std::size_t c{0}; c < num_colors; ++c) {
+        coloring.color_ptr[c + 1] += coloring.color_ptr[c];
+    }
+    coloring.rows.resize(n);
+    std::vector<std::size_t> pos(coloring.color_ptr.begin(), coloring.color_ptr.end() - 1);
+    for (std::size_t i{0}; i < n; ++i) {
+        coloring.rows[pos[coloring.colors[i]]++] = i;
+    }
+    return coloring;
+}
+
+// 以A + A^T的稀疏模式着色
+template <typename Value, typename DimIndex, typename NnzIndex>
+Coloring ColorGraph(const Csr<Value, DimIndex, NnzIndex> &a, std::size_t distance = 1) {
+    std::vector<std::size_t> adj_ptr, adj;
+    SymmetricAdjacency(a, adj_ptr, adj);
+    return ColorGraph(adj_ptr, adj, distance);
+}
+} // namespace oops
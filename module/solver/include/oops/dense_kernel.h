@@ -0,0 +1,258 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 列主序稠密块运算，供超节点分解与多右端项回代使用
+// 内层循环沿列连续访问以便向量化，按k分块保持A、B的块驻留缓存
+constexpr std::size_t DENSE_BLOCK{64};
+// 单个并行任务的最小乘加次数
+constexpr std::size_t DENSE_TASK_FLOPS{1 << 16};
+
+namespace detail {
+// C(m x n) -= A(m x k) * op(B)，op(B)(p, j) = b[p * b_row_stride + j * b_col_stride]
+template <typename Value>
+void DenseGemmUpdate(
+    std::size_t m, std::size_t n, std::size_t k, const Value *a, std::size_t lda, const Value *b,
+    std::size_t b_row_stride, std::size_t b_col_stride, Value *c, std::size_t ldc) {
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+    const std::size_t grain{std::max<std::size_t>(DENSE_TASK_FLOPS / (m * k), 1)};
+    ParallelFor(0, n, grain, [=](std::size_t col_begin, std::size_t col_end) {
+        for (std::size_t p0{0}; p0 < k; p0 += DENSE_BLOCK) {
+            const std::size_t p1{std::min(p0 + DENSE_BLOCK, k)};
+            for (std::size_t j{col_begin}; j < col_end; ++j) {
+                Value *c_j{c + j * ldc};
+                for (std::size_t p{p0}; p < p1; ++p) {
+                    const Value b_pj{b[p * b_row_stride + j * b_col_stride]};
+                    const Value *a_p{a + p * lda};
+                    for (std::size_t i{0}; i < m; ++i) {
+                        c_j[i] -= a_p[i] * b_pj;
+                    }
+                }
+            }
+        }
+    });
+}
+} // namespace detail
+
+// C(m x n) -= A(m x k) * B(k x n)
+template <typename Value>
+void DenseGemmNN(
+    std::size_t m, std::size_t n, std::size_t k, const Value *a, std::size_t lda, const Value *b, std::size_t ldb,
+    Value *c, std::size_t ldc) {
+    detail::DenseGemmUpdate(m, n, k, a, lda, b, 1, ldb, c, ldc);
+}
+
+// C(m x n) -= A(m x k) * B(n x k)^T
+template <typename Value>
+void DenseGemmNT(
+    std::size_t m, std::size_t n, std::size_t k, const Value *a, std::size_t lda, const Value *b, std::size_t ldb,
+    Value *c, std::size_t ldc) {
+    detail::DenseGemmUpdate(m, n, k, a, lda, b, ldb, 1, c, ldc);
+}
+
+// C(m x n) -= A(k x m)^T * B(k x n)，按列内积计算
+template <typename Value>
+void DenseGemmTN(
+    std::size_t m, std::size_t n, std::size_t k, const Value *a, std::size_t lda, const Value *b, std::size_t ldb,
+    Value *c, std::size_t ldc) {
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+    const std::size_t grain{std::max<std::size_t>(DENSE_TASK_FLOPS / (m * k), 1)};
+    ParallelFor(0, n, grain, [=](std::size_t col_begin, std::size_t col_end) {
+        for (std::size_t j{col_begin}; j < col_end; ++j) {
+            const Value *b_j{b + j * ldb};
+            for (std::size_t i{0}; i < m; ++i) {
+                const Value *a_i{a + i * lda};
+                Value sum{};
+                for (std::size_t p{0}; p < k; ++p) {
+                    sum += a_i[p] * b_j[p];
+                }
+                c[i + j * ldc] -= sum;
+            }
+        }
+    });
+}
+
+// B(m x n) = B * L^-T，L为n x n下三角；各行相互独立，按行分块并行
+template <typename Value>
+void DenseTrsmRLT(std::size_t m, std::size_t n, const Value *l, std::size_t ldl, Value *b, std::size_t ldb) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    const std::size_t grain{std::max<std::size_t>(2 * DENSE_TASK_FLOPS / (n * n), DENSE_BLOCK)};
+    ParallelFor(0, m, grain, [=](std::size_t row_begin, std::size_t row_end) {
+        for (std::size_t j{0}; j < n; ++j) {
+            Value *b_j{b + j * ldb};
+            for (std::size_t p{0}; p < j; ++p) {
+                const Value l_jp{l[j + p * ldl]};
+                const Value *b_p{b + p * ldb};
+                for (std::size_t i{row_begin}; i < row_end; ++i) {
+                    b_j[i] -= b_p[i] * l_jp;
+                }
+            }
+            const Value inv{Value{1} / l[j + j * ldl]};
+            for (std::size_t i{row_begin}; i < row_end; ++i) {
+                b_j[i] *= inv;
+            }
+        }
+    });
+}
+
+// 求解L * X = B，L为n x n下三角，B为n x nrhs
+template <typename Value>
+void DenseTrsmLN(std::size_t n, std::size_t nrhs, const Value *l, std::size_t ldl, Value *b, std::size_t ldb) {
+    for (std::size_t r{0}; r < nrhs; ++r) {
+        Value *x{b + r * ldb};
+        for (std::size_t j{0}; j < n; ++j) {
+            const Value *l_j{l + j * ldl};
+            const Value x_j{x[j] /= l_j[j]};
+            for (std::size_t i{j + 1}; i < n; ++i) {
+                x[i] -= l_j[i] * x_j;
+            }
+        }
+    }
+}
+
+// 求解L^T * X = B，L为n x n下三角，B为n x nrhs
+template <typename Value>
+void DenseTrsmLTN(std::size_t n, std::size_t nrhs, const Value *l, std::size_t ldl, Value *b, std::size_t ldb) {
+    for (std::size_t r{0}; r < nrhs; ++r) {
+        Value *x{b + r * ldb};
+        for (std::size_t j{n}; j-- > 0;) {
+            const Value *l_j{l + j * ldl};
+            Value sum{x[j]};
+            for (std::size_t i{j + 1}; i < n; ++i) {
+                sum -= l_j[i] * x[i];
+            }
+            x[j] = sum / l_j[j];
+        }
+    }
+}
+
+// 原位分块Cholesky分解A = L * L^T，仅访问下三角
+// 成功返回n，否则返回首个非正主元所在列
+template <typename Value>
+std::size_t DenseCholesky(std::size_t n, Value *a, std::size_t lda) {
+    for (std::size_t j0{0}; j0 < n; j0 += DENSE_BLOCK) {
+        const std::size_t jb{std::min(DENSE_BLOCK, n - j0)};
+        Value *a11{a + j0 + j0 * lda};
+        // 对角块：左视非分块分解
+        for (std::size_t j{0}; j < jb; ++j) {
+            Value *a_j{a11 + j * lda};
+            for (std::size_t p{0}; p < j; ++p) {
+                const Value *a_p{a11 + p * lda};
+                const Value l_jp{a_p[j]};
+                for (std::size_t i{j}; i < jb; ++i) {
+                    a_j[i] -= a_p[i] * l_jp;
+                }
+            }
+            if (!(a_j[j] > Value{0})) {
+                return j0 + j;
+            }
+            const Value d{std::sqrt(a_j[j])};
+            a_j[j] = d;
+            for (std::size_t i{j + 1}; i < jb; ++i) {
+                a_j[i] /= d;
+            }
+        }
+        const std::size_t rest{n - j0 - jb};
+        if (rest == 0) {
+            continue;
+        }
+        // 对角块以下：A21 = A21 * L11^-T，尾部更新A22 -= A21 * A21^T(仅下三角所在列块)
+        Value *a21{a11 + jb};
+        DenseTrsmRLT(rest, jb, a11, lda, a21, lda);
+        for (std::size_t c0{0}; c0 < rest; c0 += DENSE_BLOCK) {
+            const std::size_t cb{std::min(DENSE_BLOCK, rest - c0)};
+            DenseGemmNT(rest - c0, cb, jb, a21 + c0, lda, a21 + c0, lda, a21 + c0 + (jb + c0) * lda, lda);
+        }
+    }
+    return n;
+}
+
+// 对称矩阵特征分解(循环Jacobi)，a为n x n列主序完整对称矩阵，计算中被覆盖
+// w返回升序特征值，v返回对应的单位特征向量(列)
+template <typename Value>
+void DenseSymmetricEigen(std::size_t n, Value *a, std::size_t lda, Value *w, Value *v, std::size_t ldv) {
+    constexpr std::size_t MAX_SWEEPS{64};
+    for (std::size_t j{0}; j < n; ++j) {
+        for (std::size_t i{0}; i < n; ++i) {
+            v[i + j * ldv] = (i == j) ? Value{1} : Value{0};
+        }
+    }
+    Value norm{};
+    for (std::size_t j{0}; j < n; ++j) {
+        for (std::size_t i{0}; i < n; ++i) {
+            norm += a[i + j * lda] * a[i + j * lda];
+        }
+    }
+    const Value eps{std::numeric_limits<Value>::epsilon()};
+    for (std::size_t sweep{0}; sweep < MAX_SWEEPS; ++sweep) {
+        Value off{};
+        for (std::size_t q{1}; q < n; ++q) {
+            for (std::size_t p{0}; p < q; ++p) {
+                off += a[p + q * lda] * a[p + q * lda];
+            }
+        }
+        if (off <= eps * eps * norm) {
+            break;
+        }
+        for (std::size_t q{1}; q < n; ++q) {
+            for (std::size_t p{0}; p < q; ++p) {
+                const Value a_pq{a[p + q * lda]};
+                if (a_pq == Value{0}) {
+                    continue;
+                }
+                // 旋转角使a(p, q)归零：t = tan(φ)取绝对值较小的根
+                const Value theta{(a[q + q * lda] - a[p + p * lda]) / (2 * a_pq)};
+                const Value t{(theta >= 0 ? Value{1} : Value{-1}) / (std::abs(theta) + std::sqrt(theta * theta + 1))};
+                const Value c{1 / std::sqrt(t * t + 1)};
+                const Value s{t * c};
+                for (std::size_t k{0}; k < n; ++k) {
+                    const Value a_kp{a[k + p * lda]};
+                    const Value a_kq{a[k + q * lda]};
+                    a[k + p * lda] = c * a_kp - s * a_kq;
+                    a[k + q * lda] = s * a_kp + c * a_kq;
+                }
+                for (std::size_t k{0}; k < n; ++k) {
+                    const Value a_pk{a[p + k * lda]};
+                    const Value a_qk{a[q + k * lda]};
+                    a[p + k * lda] = c * a_pk - s * a_qk;
+                    a[q + k * lda] = s * a_pk + c * a_qk;
+                }
+                a[p + q * lda] = a[q + p * lda] = Value{0};
+                for (std::size_t k{0}; k < n; ++k) {
+                    const Value v_kp{v[k + p * ldv]};
+                    const Value v_kq{v[k + q * ldv]};
+                    v[k + p * ldv] = c * v_kp - s * v_kq;
+                    v[k + q * ldv] = s * v_kp + c * v_kq;
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [a, lda](std::size_t i, std::size_t j) {
+        return a[i + i * lda] < a[j + j * lda];
+    });
+    std::vector<Value> sorted(n * n);
+    for (std::size_t j{0}; j < n; ++j) {
+        w[j] = a[order[j] + order[j] * lda];
+        std::copy(v + order[j] * ldv, v + order[j] * ldv + n, sorted.begin() + j * n);
+    }
+    for (std::size_t j{0}; j < n; ++j) {
+        std::copy(sorted.begin() + j * n, sorted.begin() + (j + 1) * n, v + j * ldv);
+    }
+}
+} // namespace oops
@@ -0,0 +1,435 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/block_kernel.h"
+#include "oops/csr.h"
+#include "oops/dense_kernel.h"
+#include "oops/preconditioner.h"
+
+namespace oops {
+enum class EigenWhich : std::uint8_t { LARGEST, SMALLEST };
+
+struct EigenOptions {
+    std::size_t num_eigenpairs{4};
+    EigenWhich which{EigenWhich::LARGEST}; // 按代数值取最大/最小端
+    double tolerance{1e-8};                // ||A * x - θ * x|| <= tolerance * ||A||估计
+    std::size_t max_iterations{1000};      // Lanczos重启次数 / LOBPCG迭代次数
+    std::size_t basis_size{0};             // Lanczos基向量数，0取max(2 * nev + 1, 20)
+    std::size_t block_size{0};             // LOBPCG块大小，0取nev
+    std::size_t memory_budget{0};          // 基向量与块向量的内存上限(字节)，0为不限
+};
+
+template <typename Value>
+struct EigenResult {
+    bool converged{};
+    std::size_t iterations{};
+    std::size_t matvecs{};    // 矩阵与单个向量乘积的次数
+    std::vector<Value> values; // 按which由端点向内排列
+    std::vector<Value> vectors; // n x nev列主序，各列为单位向量
+};
+
+namespace detail {
+template <typename Value>
+class EigenSolverBase {
+    static_assert(std::is_floating_point_v<Value>, "eigensolvers require real floating point values");
+
+public:
+    explicit EigenSolverBase(EigenOptions options) : options_{options} {}
+
+    const EigenOptions &GetOptions() const { return options_; }
+    EigenOptions &GetOptions() { return options_; }
+
+protected:
+    void CheckSize(std::size_t n) const {
+        if (options_.num_eigenpairs == 0 || options_.num_eigenpairs > n) {
+            throw std::invalid_argument("invalid number of eigenpairs");
+        }
+    }
+
+    // 预算内可容纳的长度为n的向量数
+    std::size_t BudgetVectors(std::size_t n) const {
+        if (options_.memory_budget == 0) {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        return options_.memory_budget / (n * sizeof(Value));
+    }
+
+    // 确定性伪随机初始向量，取值[-1, 1)
+    static void StartVector(std::size_t n, std::size_t seed, Value *v) {
+        ParallelFor(0, n, BLOCK_ROW_GRAIN, [seed, v](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                std::uint64_t x{i * 0x9e3779b97f4a7c15ULL + seed * 0xd1b54a32d192ed03ULL};
+                x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+                x ^= x >> 31;
+                v[i] = static_cast<Value>(x >> 11) * static_cast<Value>(0x1.0p-52) - Value{1};
+            }
+        });
+    }
+
+    // 由Ritz值升序下标得到按which排列的下标
+    std::vector<std::size_t> SelectOrder(std::size_t m) const {
+        std::vector<std::size_t> order(m);
+        std::iota(order.begin(), order.end(), 0);
+        if (options_.which == EigenWhich::LARGEST) {
+            std::reverse(order.begin(), order.end());
+        }
+        return order;
+    }
+
+    EigenOptions options_;
+};
+} // namespace detail
+
+// 厚重启Lanczos方法(Wu & Simon)，求对称矩阵端部特征对
+// 1. 单向量Lanczos扩展至m维，以块内积/块更新做两次经典Gram-Schmidt完全重正交化
+// 2. 重启时保留l个最优Ritz向量与残差方向，原位压缩基底，投影矩阵变为箭形
+// 内存为n * (m + 1)个基向量元素，m受memory_budget约束
+// 矩阵可为对称上/下三角存储或一般存储(视为对称)
+template <typename Value>
+class LanczosSolver : public detail::EigenSolverBase<Value> {
+    using Base = detail::EigenSolverBase<Value>;
+
+public:
+    explicit LanczosSolver(EigenOptions options = {}) : Base{options} {}
+
+    template <typename DimIndex, typename NnzIndex>
+    EigenResult<Value> Solve(const Csr<Value, DimIndex, NnzIndex> &a) {
+        SymmetricSpMM<Value, DimIndex, NnzIndex> op{a};
+        const std::size_t n{a.M()};
+        Base::CheckSize(n);
+        const std::size_t nev{Base::options_.num_eigenpairs};
+        const std::size_t m{BasisSize(n)};
+        const Value eps{std::numeric_limits<Value>::epsilon()};
+
+        basis_.resize(n * (m + 1));
+        h_.assign(m * m, Value{});
+        h_work_.resize(m * m);
+        y_.resize(m * m);
+        theta_.resize(m);
+        coef_.resize(m + 1);
+        coef_work_.resize(m + 1);
+        Value *v{basis_.data()};
+        Base::StartVector(n, 0, v);
+        Normalize(n, v);
+
+        EigenResult<Value> res;
+        std::size_t start{0};
+        Value beta{};
+        std::vector<std::size_t> order;
+        for (res.iterations = 1;; ++res.iterations) {
+            for (std::size_t j{start}; j < m; ++j) {
+                Value *w{v + (j + 1) * n};
+                op.Apply(1, v + j * n, n, w, n);
+                ++res.matvecs;
+                const Value w_norm{Norm2(n, w)};
+                beta = Orthogonalize(n, j + 1, w);
+                for (std::size_t i{0}; i <= j; ++i) {
+                    h_[i + j * m] = h_[j + i * m] = coef_[i];
+                }
+                if (beta <= 100 * eps * w_norm) {
+                    // 不变子空间：以与当前基正交的新方向继续扩展，投影矩阵在此处解耦
+                    beta = Value{};
+                    if (j + 1 < m) {
+                        Base::StartVector(n, j + 1, w);
+                        Orthogonalize(n, j + 1, w);
+                        Normalize(n, w);
+                    }
+                } else {
+                    Scale(n, Value{1} / beta, w);
+                }
+                if (j + 1 < m) {
+                    h_[j + 1 + j * m] = h_[j + (j + 1) * m] = beta;
+                }
+            }
+
+            // Rayleigh-Ritz，第i个Ritz对的残差范数为|β * y(m - 1, i)|
+            std::copy(h_.begin(), h_.end(), h_work_.begin());
+            DenseSymmetricEigen(m, h_work_.data(), m, theta_.data(), y_.data(), m);
+            order = Base::SelectOrder(m);
+            const Value a_norm{std::max(std::abs(theta_[0]), std::abs(theta_[m - 1]))};
+            bool converged{true};
+            for (std::size_t i{0}; i < nev; ++i) {
+                const Value residual{std::abs(beta * y_[m - 1 + order[i] * m])};
+                converged = converged && residual <= static_cast<Value>(Base::options_.tolerance) * a_norm;
+            }
+            if (converged || res.iterations >= Base::options_.max_iterations) {
+                res.converged = converged;
+                break;
+            }
+
+            // 厚重启：V(:, 0:l) = V * Y(:, order[0:l])，原残差方向v_m移至第l列
+            const std::size_t l{std::min(nev + (m - nev) / 2, m - 1)};
+            Compress(n, m, l, order);
+            std::copy(v + m * n, v + (m + 1) * n, v + l * n);
+            std::fill(h_.begin(), h_.end(), Value{});
+            for (std::size_t i{0}; i < l; ++i) {
+                h_[i + i * m] = theta_[order[i]];
+                h_[l + i * m] = h_[i + l * m] = beta * y_[m - 1 + order[i] * m];
+            }
+            start = l;
+        }
+
+        Compress(n, m, nev, order);
+        res.values.resize(nev);
+        for (std::size_t i{0}; i < nev; ++i) {
+            res.values[i] = theta_[order[i]];
+        }
+        res.vectors.assign(v, v + n * nev);
+        return res;
+    }
+
+private:
+    std::size_t BasisSize(std::size_t n) const {
+        const std::size_t nev{Base::options_.num_eigenpairs};
+        std::size_t m{Base::options_.basis_size};
+        if (m == 0) {
+            m = std::max<std::size_t>(2 * nev + 1, 20);
+        }
+        const std::size_t budget{Base::BudgetVectors(n)};
+        m = std::min({m, n, budget > 0 ? budget - 1 : 0});
+        if (m < n && m <= nev) {
+            throw std::invalid_argument("eigen basis size or memory budget too small");
+        }
+        return m;
+    }
+
+    // 两次经典Gram-Schmidt，w对基底前k列正交化，系数累加至coef_，返回正交化后的范数
+    Value Orthogonalize(std::size_t n, std::size_t k, Value *w) {
+        const Value *v{basis_.data()};
+        Value *c{coef_.data()};
+        BlockDot(n, k, v, n, 1, w, n, c, k);
+        BlockUpdate(n, k, v, n, 1, c, k, w, n);
+        Value *c2{coef_work_.data()};
+        BlockDot(n, k, v, n, 1, w, n, c2, k);
+        BlockUpdate(n, k, v, n, 1, c2, k, w, n);
+        for (std::size_t i{0}; i < k; ++i) {
+            c[i] += c2[i];
+        }
+        return Norm2(n, w);
+    }
+
+    void Compress(std::size_t n, std::size_t m, std::size_t l, const std::vector<std::size_t> &order) {
+        std::vector<Value> &y_sel{h_work_};
+        for (std::size_t i{0}; i < l; ++i) {
+            std::copy(y_.begin() + order[i] * m, y_.begin() + (order[i] + 1) * m, y_sel.begin() + i * m);
+        }
+        BlockMultiplyInPlace(n, m, basis_.data(), n, l, y_sel.data(), m);
+    }
+
+    static void Scale(std::size_t n, Value alpha, Value *x) {
+        ParallelFor(0, n, REDUCE_GRAIN, [alpha, x](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                x[i] *= alpha;
+            }
+        });
+    }
+
+    static void Normalize(std::size_t n, Value *x) { Scale(n, Value{1} / Norm2(n, x), x); }
+
+    std::vector<Value> basis_; // n x (m + 1)列主序
+    std::vector<Value> h_;     // 投影矩阵V^T * A * V
+    std::vector<Value> h_work_, y_, theta_, coef_, coef_work_;
+};
+
+// 局部最优块预条件共轭梯度法(LOBPCG, Knyazev)，求对称矩阵端部特征对
+// 每轮在子空间[X, W, P]上做Rayleigh-Ritz，W为预条件残差，P为上一轮的隐式搜索方向
+// W、P依次对已有方向做两次块投影并以Cholesky QR原位正交化，子空间基底始终正交，Rayleigh-Ritz退化为标准特征问题
+// 内存为[X, W, P]及其A像共6 * n * k个元素，超出memory_budget时抛出异常
+template <typename Value>
+class LobpcgSolver : public detail::EigenSolverBase<Value> {
+    using Base = detail::EigenSolverBase<Value>;
+
+public:
+    explicit LobpcgSolver(EigenOptions options = {}) : Base{options} {}
+
+    template <typename DimIndex, typename NnzIndex>
+    EigenResult<Value> Solve(const Csr<Value, DimIndex, NnzIndex> &a) {
+        return Solve(a, IdentityPreconditioner<Value>{});
+    }
+
+    template <typename DimIndex, typename NnzIndex>
+    EigenResult<Value> Solve(const Csr<Value, DimIndex, NnzIndex> &a, const Preconditioner<Value> &m) {
+        SymmetricSpMM<Value, DimIndex, NnzIndex> op{a};
+        const std::size_t n{a.M()};
+        Base::CheckSize(n);
+        const std::size_t nev{Base::options_.num_eigenpairs};
+        const std::size_t k{std::max(Base::options_.block_size, nev)};
+        if (3 * k > n) {
+            throw std::invalid_argument("lobpcg block size too large for the matrix");
+        }
+        if (6 * k + 1 > Base::BudgetVectors(n)) {
+            throw std::invalid_argument("lobpcg memory budget too small");
+        }
+        // 求最大端时对-A求最小端
+        const Value sign{Base::options_.which == EigenWhich::LARGEST ? Value{-1} : Value{1}};
+        auto apply_op = [&](std::size_t cols, const Value *x, Value *y) {
+            op.Apply(cols, x, n, y, n);
+            if (sign < Value{0}) {
+                ParallelFor(0, n * cols, REDUCE_GRAIN, [y](std::size_t begin, std::size_t end) {
+                    for (std::size_t i{begin}; i < end; ++i) {
+                        y[i] = -y[i];
+                    }
+                });
+            }
+        };
+
+        s_.resize(n * 3 * k);
+        as_.resize(n * 3 * k);
+        tmp_.resize(n);
+        gram_.resize(9 * k * k);
+        c_.resize(9 * k * k);
+        theta_.resize(3 * k);
+        diag_.resize(k);
+        Value *x{s_.data()}, *w{x + n * k}, *p{w + n * k};
+        Value *ax{as_.data()}, *aw{ax + n * k}, *ap{aw + n * k};
+
+        for (std::size_t j{0}; j < k; ++j) {
+            Base::StartVector(n, j, x + j * n);
+        }
+        if (!CholeskyQr(n, k, x, nullptr)) {
+            throw std::runtime_error("lobpcg initial block is rank deficient");
+        }
+        EigenResult<Value> res;
+        apply_op(k, x, ax);
+        res.matvecs += k;
+        RayleighRitz(n, k, k);
+
+        bool has_p{false};
+        for (res.iterations = 1;; ++res.iterations) {
+            // W = A * X - X * diag(θ)
+            const Value *theta{theta_.data()};
+            ParallelFor(0, n, BLOCK_ROW_GRAIN, [=](std::size_t begin, std::size_t end) {
+                for (std::size_t j{0}; j < k; ++j) {
+                    for (std::size_t i{begin}; i < end; ++i) {
+                        w[i + j * n] = ax[i + j * n] - theta[j] * x[i + j * n];
+                    }
+                }
+            });
+            bool converged{true};
+            for (std::size_t j{0}; j < nev; ++j) {
+                const Value residual{Norm2(n, w + j * n)};
+                converged = converged && residual <= static_cast<Value>(Base::options_.tolerance) * a_norm_;
+            }
+            res.converged = converged;
+            if (converged || res.iterations >= Base::options_.max_iterations) {
+                break;
+            }
+
+            for (std::size_t j{0}; j < k; ++j) {
+                m.Apply(n, w + j * n, tmp_.data());
+                std::copy(tmp_.begin(), tmp_.end(), w + j * n);
+            }
+            Project(n, k, x, nullptr, k, w, nullptr);
+            if (!CholeskyQr(n, k, w, nullptr)) {
+                break; // 残差方向已落入X张成的子空间，无法继续改进
+            }
+            apply_op(k, w, aw);
+            res.matvecs += k;
+            if (has_p) {
+                // [X, W]在s_中连续存放
+                Project(n, 2 * k, x, ax, k, p, ap);
+                has_p = CholeskyQr(n, k, p, ap);
+            }
+            RayleighRitz(n, has_p ? 3 * k : 2 * k, k);
+            has_p = true;
+        }
+
+        res.values.resize(nev);
+        for (std::size_t j{0}; j < nev; ++j) {
+            res.values[j] = sign * theta_[j];
+        }
+        res.vectors.assign(x, x + n * nev);
+        return res;
+    }
+
+private:
+    // Y -= B * (B^T * Y)两次，AY同步更新；B为s_中前nb列，AB为as_中对应列
+    void Project(std::size_t n, std::size_t nb, const Value *b, const Value *ab, std::size_t k, Value *y, Value *ay) {
+        for (std::size_t pass{0}; pass < 2; ++pass) {
+            BlockDot(n, nb, b, n, k, y, n, c_.data(), nb);
+            BlockUpdate(n, nb, b, n, k, c_.data(), nb, y, n);
+            if (ay != nullptr) {
+                BlockUpdate(n, nb, ab, n, k, c_.data(), nb, ay, n);
+            }
+        }
+    }
+
+    // Cholesky QR两遍：Y = Y * L^-T，AY同步变换；Gram矩阵数值秩亏时返回false
+    bool CholeskyQr(std::size_t n, std::size_t k, Value *y, Value *ay) {
+        const Value tol{std::sqrt(std::numeric_limits<Value>::epsilon())};
+        for (std::size_t pass{0}; pass < 2; ++pass) {
+            Value *g{gram_.data()};
+            BlockDot(n, k, y, n, k, y, n, g, k);
+            for (std::size_t j{0}; j < k; ++j) {
+                diag_[j] = g[j + j * k];
+            }
+            if (DenseCholesky(k, g, k) != k) {
+                return false;
+            }
+            for (std::size_t j{0}; j < k; ++j) {
+                if (g[j + j * k] <= tol * std::sqrt(diag_[j])) {
+                    return false;
+                }
+            }
+            DenseTrsmRLT(n, k, g, k, y, n);
+            if (ay != nullptr) {
+                DenseTrsmRLT(n, k, g, k, ay, n);
+            }
+        }
+        return true;
+    }
+
+    // 在s_前width列张成的正交子空间上做Rayleigh-Ritz，取最小的k个Ritz对
+    // 新的X = S * C，新的P = S(:, k:) * C(k:, :)，s_与as_原位更新；首轮width = k时P置零
+    void RayleighRitz(std::size_t n, std::size_t width, std::size_t k) {
+        Value *g{gram_.data()};
+        BlockDot(n, width, s_.data(), n, width, as_.data(), n, g, width);
+        for (std::size_t j{0}; j < width; ++j) {
+            for (std::size_t i{0}; i < j; ++i) {
+                g[i + j * width] = g[j + i * width] = (g[i + j * width] + g[j + i * width]) / 2;
+            }
+        }
+        DenseSymmetricEigen(width, g, width, theta_.data(), c_.data(), width);
+        a_norm_ = std::max(std::abs(theta_[0]), std::abs(theta_[width - 1]));
+        UpdateBlocks(n, width, k, s_.data());
+        UpdateBlocks(n, width, k, as_.data());
+    }
+
+    void UpdateBlocks(std::size_t n, std::size_t width, std::size_t k, Value *s) const {
+        const Value *c{c_.data()};
+        ParallelFor(0, n, BLOCK_ROW_GRAIN, [=](std::size_t begin, std::size_t end) {
+            const std::size_t len{end - begin};
+            std::vector<Value> tmp(2 * len * k, Value{});
+            Value *t_x{tmp.data()}, *t_p{t_x + len * k};
+            for (std::size_t j{0}; j < k; ++j) {
+                for (std::size_t i{0}; i < width; ++i) {
+                    const Value c_ij{c[i + j * width]};
+                    const Value *s_i{s + i * n + begin};
+                    Value *t{(i < k ? t_x : t_p) + j * len};
+                    for (std::size_t r{0}; r < len; ++r) {
+                        t[r] += s_i[r] * c_ij;
+                    }
+                }
+            }
+            for (std::size_t j{0}; j < k; ++j) {
+                for (std::size_t r{0}; r < len; ++r) {
+                    s[begin + r + j * n] = t_x[r + j * len] + t_p[r + j * len];
+                    s[begin + r + (2 * k + j) * n] = t_p[r + j * len];
+                }
+            }
+        });
+    }
+
+    std::vector<Value> s_;  // [X, W, P]，n x 3k列主序
+    std::vector<Value> as_; // [A * X, A * W, A * P]
+    std::vector<Value> tmp_, gram_, c_, theta_, diag_;
+    Value a_norm_{}; // 子空间Ritz值的最大模，作为||A||的估计
+};
+} // namespace oops
@@ -0,0 +1,321 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/level_schedule.h"
+#include "oops/preconditioner.h"
+
+namespace oops {
+// 零填充不完全LU分解，L(单位下三角)与U共用输入矩阵的稀疏模式
+// 1. Analyze：符号分析，记录对角位置并按下/上三角依赖构建层次调度
+// 2. Factorize：数值分解，按下三角层次逐层并行；模式不变时可反复调用，跳过符号分析
+template <typename Value, typename DimIndex = int32_t, typename NnzIndex = DimIndex>
+class Ilu0Preconditioner : public Preconditioner<Value> {
+    static_assert(std::is_floating_point_v<Value>);
+
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+
+    Ilu0Preconditioner() = default;
+    explicit Ilu0Preconditioner(const CsrType &a) {
+        Analyze(a);
+        Factorize(a);
+    }
+
+    void Analyze(const CsrType &a) {
+        if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+            throw std::invalid_argument("ilu0 requires general storage");
+        }
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("ilu0 requires a square matrix");
+        }
+        // 共享a的模式，符号分析结果缓存于模式上，同一模式的其他矩阵再次分析时直接复用
+        n_ = a.M();
+        pattern_ = a.GetPattern();
+        row_ptr_ = pattern_->GetRowPtr().data();
+        col_indices_ = pattern_->GetColIndices().data();
+        symbolic_ = pattern_->template Cached<Symbolic>(0, [this] {
+            Symbolic symbolic;
+            symbolic.diag_pos.resize(n_);
+            for (std::size_t r{0}; r < n_; ++r) {
+                symbolic.diag_pos[r] = FindDiag(r);
+            }
+            symbolic.lower_schedule = BuildLevelSchedule(n_, pattern_->GetRowPtr(), pattern_->GetColIndices(), true);
+            symbolic.upper_schedule = BuildLevelSchedule(n_, pattern_->GetRowPtr(), pattern_->GetColIndices(), false);
+            return symbolic;
+        });
+        diag_pos_ = symbolic_->diag_pos.data();
+        values_.clear();
+    }
+
+    // 以新的数值重新分解，a的模式须与Analyze时一致；共享同一模式时省去逐元素比较
+    void Factorize(const CsrType &a) {
+        if (pattern_ == nullptr || (a.GetPattern() != pattern_ && !a.GetPattern()->Same(*pattern_))) {
+            throw std::invalid_argument("ilu0 refactorization with a different pattern");
+        }
+        values_.assign(a.GetValues().begin(), a.GetValues().end());
+        symbolic_->lower_schedule.ForEach([this](std::size_t r) { FactorizeRow(r); });
+    }
+
+    std::size_t NumLowerLevels() const { return symbolic_->lower_schedule.NumLevels(); }
+    std::size_t NumUpperLevels() const { return symbolic_->upper_schedule.NumLevels(); }
+
+    // z = U^-1 * L^-1 * r，允许r与z为同一向量
+    void Apply(std::size_t n, const Value *r, Value *z) const override {
+        if (symbolic_ == nullptr || n != n_) {
+            throw std::invalid_argument("preconditioner size mismatch");
+        }
+        symbolic_->lower_schedule.ForEach([this, r, z](std::size_t row) {
+            Value sum{r[row]};
+            for (auto i{row_ptr_[row]}; i < diag_pos_[row]; ++i) {
+                sum -= values_[i] * z[col_indices_[i]];
+            }
+            z[row] = sum;
+        });
+        symbolic_->upper_schedule.ForEach([this, z](std::size_t row) {
+            Value sum{z[row]};
+            for (auto i{diag_pos_[row] + 1}; i < row_ptr_[row + 1]; ++i) {
+                sum -= values_[i] * z[col_indices_[i]];
+            }
+            z[row] = sum / values_[diag_pos_[row]];
+        });
+    }
+
+private:
+    using PatternType = typename CsrType::PatternType;
+
+    struct Symbolic {
+        std::vector<NnzIndex> diag_pos;
+        LevelSchedule lower_schedule;
+        LevelSchedule upper_schedule;
+    };
+
+    NnzIndex FindDiag(std::size_t r) const {
+        NnzIndex diag{row_ptr_[r + 1]};
+        for (auto i{row_ptr_[r]}; i < row_ptr_[r + 1]; ++i) {
+            if (i > row_ptr_[r] && col_indices_[i] <= col_indices_[i - 1]) {
+                throw std::invalid_argument("ilu0 requires sorted unique column indices");
+            }
+            if (static_cast<std::size_t>(col_indices_[i]) == r) {
+                diag = i;
+            }
+        }
+        if (diag == row_ptr_[r + 1]) {
+            throw std::invalid_argument("ilu0 missing diagonal at row " + std::to_string(r));
+        }
+        return diag;
+    }
+
+    // IKJ形式：依次以已分解行k消去当前行，行内与行k的U部分按列有序归并，仅更新模式内位置
+    void FactorizeRow(std::size_t r) {
+        const NnzIndex row_end{row_ptr_[r + 1]};
+        for (auto i{row_ptr_[r]}; i < diag_pos_[r]; ++i) {
+            const std::size_t k{static_cast<std::size_t>(col_indices_[i])};
+            const Value l{values_[i] /= values_[diag_pos_[k]]};
+            auto j{i + 1};
+            auto t{diag_pos_[k] + 1};
+            while (j < row_end && t < row_ptr_[k + 1]) {
+                if (col_indices_[j] == col_indices_[t]) {
+                    values_[j++] -= l * values_[t++];
+                } else if (col_indices_[j] < col_indices_[t]) {
+                    ++j;
+                } else {
+                    ++t;
+                }
+            }
+        }
+        if (values_[diag_pos_[r]] == Value{0}) {
+            throw std::runtime_error("ilu0 zero pivot at row " + std::to_string(r));
+        }
+    }
+
+    std::size_t n_{0};
+    std::shared_ptr<const PatternType> pattern_;
+    std::shared_ptr<const Symbolic> symbolic_;
+    // 指向pattern_与symbolic_中的数组
+    const NnzIndex *row_ptr_{nullptr};
+    const DimIndex *col_indices_{nullptr};
+    const NnzIndex *diag_pos_{nullptr};
+    std::vector<Value> values_; // L(不含单位对角)与U合并存储
+};
+
+// 零填充不完全Cholesky分解，A ≈ L * L^T，L的模式取A的下三角
+// 输入可为一般存储(取下三角)或对称下三角存储；回代所需的L^T结构在符号分析阶段一次生成
+template <typename Value, typename DimIndex = int32_t, typename NnzIndex = DimIndex>
+class Ic0Preconditioner : public Preconditioner<Value> {
+    static_assert(std::is_floating_point_v<Value>);
+
+public:
+    using CsrType = Csr<Value, DimIndex, NnzIndex>;
+
+    Ic0Preconditioner() = default;
+    explicit Ic0Preconditioner(const CsrType &a) {
+        Analyze(a);
+        Factorize(a);
+    }
+
+    void Analyze(const CsrType &a) {
+        MatrixSymmetric symmetric{a.GetSymmetric()};
+        if (symmetric != MatrixSymmetric::GENERAL && symmetric != MatrixSymmetric::SYMMETRIC_LOWER) {
+            throw std::invalid_argument("ic0 requires general or symmetric lower storage");
+        }
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("ic0 requires a square matrix");
+        }
+        // 共享a的模式，L与L^T的结构及层次调度缓存于模式上，同一模式的其他矩阵再次分析时直接复用
+        n_ = a.M();
+        symmetric_ = symmetric;
+        pattern_ = a.GetPattern();
+        symbolic_ = pattern_->template Cached<Symbolic>(static_cast<std::uint64_t>(symmetric), [this] {
+            return AnalyzePattern();
+        });
+        values_.clear();
+    }
+
+    // 以新的数值重新分解，a的模式须与Analyze时一致；共享同一模式时省去逐元素比较
+    void Factorize(const CsrType &a) {
+        if (pattern_ == nullptr || a.GetSymmetric() != symmetric_ ||
+            (a.GetPattern() != pattern_ && !a.GetPattern()->Same(*pattern_))) {
+            throw std::invalid_argument("ic0 refactorization with a different pattern");
+        }
+        const auto &src_pos{symbolic_->src_pos};
+        const Value *a_values{a.GetValues().data()};
+        values_.resize(src_pos.size());
+        for (std::size_t i{0}; i < src_pos.size(); ++i) {
+            values_[i] = a_values[src_pos[i]];
+        }
+        symbolic_->lower_schedule.ForEach([this](std::size_t r) { FactorizeRow(r); });
+    }
+
+    std::size_t NumLowerLevels() const { return symbolic_->lower_schedule.NumLevels(); }
+    std::size_t NumUpperLevels() const { return symbolic_->upper_schedule.NumLevels(); }
+
+    // z = L^-T * L^-1 * r，允许r与z为同一向量
+    void Apply(std::size_t n, const Value *r, Value *z) const override {
+        if (symbolic_ == nullptr || n != n_) {
+            throw std::invalid_argument("preconditioner size mismatch");
+        }
+        const Symbolic &sym{*symbolic_};
+        sym.lower_schedule.ForEach([this, &sym, r, z](std::size_t row) {
+            const NnzIndex diag{sym.row_ptr[row + 1] - 1};
+            Value sum{r[row]};
+            for (auto i{sym.row_ptr[row]}; i < diag; ++i) {
+                sum -= values_[i] * z[sym.col_indices[i]];
+            }
+            z[row] = sum / values_[diag];
+        });
+        sym.upper_schedule.ForEach([this, &sym, z](std::size_t row) {
+            const NnzIndex diag{sym.t_row_ptr[row]};
+            Value sum{z[row]};
+            for (auto i{diag + 1}; i < sym.t_row_ptr[row + 1]; ++i) {
+                sum -= values_[sym.t_pos[i]] * z[sym.t_col_indices[i]];
+            }
+            z[row] = sum / values_[sym.t_pos[diag]];
+        });
+    }
+
+private:
+    using PatternType = typename CsrType::PatternType;
+
+    struct Symbolic {
+        std::vector<NnzIndex> row_ptr;
+        std::vector<DimIndex> col_indices;
+        std::vector<NnzIndex> src_pos; // L元素在输入矩阵中的位置
+        std::vector<NnzIndex> t_row_ptr;
+        std::vector<DimIndex> t_col_indices;
+        std::vector<NnzIndex> t_pos; // L^T元素在values_中的位置
+        LevelSchedule lower_schedule;
+        LevelSchedule upper_schedule;
+    };
+
+    Symbolic AnalyzePattern() const {
+        const auto &a_row_ptr{pattern_->GetRowPtr()};
+        const auto &a_col_indices{pattern_->GetColIndices()};
+        Symbolic sym;
+
+        // 提取下三角模式，记录每个L元素在A中的位置以便重分解时直接收集数值
+        sym.row_ptr.assign(n_ + 1, 0);
+        for (std::size_t r{0}; r < n_; ++r) {
+            for (auto i{a_row_ptr[r]}; i < a_row_ptr[r + 1]; ++i) {
+                if (i > a_row_ptr[r] && a_col_indices[i] <= a_col_indices[i - 1]) {
+                    throw std::invalid_argument("ic0 requires sorted unique column indices");
+                }
+                if (static_cast<std::size_t>(a_col_indices[i]) <= r) {
+                    sym.col_indices.push_back(a_col_indices[i]);
+                    sym.src_pos.push_back(i);
+                }
+            }
+            if (sym.col_indices.empty() || static_cast<std::size_t>(sym.col_indices.back()) != r) {
+                throw std::invalid_argument("ic0 missing diagonal at row " + std::to_string(r));
+            }
+            sym.row_ptr[r + 1] = static_cast<NnzIndex>(sym.col_indices.size());
+        }
+
+        // L^T的行即L的列，行内行号升序，首元素为对角
+        const std::size_t l_nnz{sym.col_indices.size()};
+        sym.t_row_ptr.assign(n_ + 1, 0);
+        for (std::size_t i{0}; i < l_nnz; ++i) {
+            ++sym.t_row_ptr[sym.col_indices[i] + 1];
+        }
+        for (std::size_t r{0}; r < n_; ++r) {
+            sym.t_row_ptr[r + 1] += sym.t_row_ptr[r];
+        }
+        sym.t_col_indices.resize(l_nnz);
+        sym.t_pos.resize(l_nnz);
+        std::vector<NnzIndex> pos(sym.t_row_ptr.begin(), sym.t_row_ptr.end() - 1);
+        for (std::size_t r{0}; r < n_; ++r) {
+            for (auto i{sym.row_ptr[r]}; i < sym.row_ptr[r + 1]; ++i) {
+                auto &p{pos[sym.col_indices[i]]};
+                sym.t_col_indices[p] = static_cast<DimIndex>(r);
+                sym.t_pos[p++] = i;
+            }
+        }
+
+        sym.lower_schedule = BuildLevelSchedule(n_, sym.row_ptr, sym.col_indices, true);
+        sym.upper_schedule = BuildLevelSchedule(n_, sym.t_row_ptr, sym.t_col_indices, false);
+        return sym;
+    }
+
+    // 按行(up-looking)分解：l(r, k) = (a(r, k) - Σ l(r, j) * l(k, j)) / l(k, k)，行r与行k按列有序归并
+    void FactorizeRow(std::size_t r) {
+        const auto &row_ptr{symbolic_->row_ptr};
+        const auto &col_indices{symbolic_->col_indices};
+        const NnzIndex row_begin{row_ptr[r]};
+        const NnzIndex diag{row_ptr[r + 1] - 1};
+        Value diag_sum{values_[diag]};
+        for (auto i{row_begin}; i < diag; ++i) {
+            const std::size_t k{static_cast<std::size_t>(col_indices[i])};
+            const NnzIndex k_diag{row_ptr[k + 1] - 1};
+            Value sum{values_[i]};
+            auto j{row_begin};
+            auto t{row_ptr[k]};
+            while (j < i && t < k_diag) {
+                if (col_indices[j] == col_indices[t]) {
+                    sum -= values_[j++] * values_[t++];
+                } else if (col_indices[j] < col_indices[t]) {
+                    ++j;
+                } else {
+                    ++t;
+                }
+            }
+            values_[i] = sum / values_[k_diag];
+            diag_sum -= values_[i] * values_[i];
+        }
+        if (!(diag_sum > Value{0})) {
+            throw std::runtime_error("ic0 breakdown with non-positive pivot at row " + std::to_string(r));
+        }
+        values_[diag] = std::sqrt(diag_sum);
+    }
+
+    std::size_t n_{0};
+    MatrixSymmetric symmetric_{MatrixSymmetric::GENERAL};
+    std::shared_ptr<const PatternType> pattern_;
+    std::shared_ptr<const Symbolic> symbolic_;
+    std::vector<Value> values_;
+};
+} // namespace oops
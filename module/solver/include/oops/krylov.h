@@ -0,0 +1,510 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "oops/krylov_kernel.h"
+#include "oops/preconditioner.h"
+
+namespace oops {
+struct SolverOptions {
+    std::size_t max_iterations{1000};
+    double rtol{1e-8};       // 相对||b||的残差容限
+    double atol{0};          // 绝对残差容限，取二者较大值
+    std::size_t restart{30}; // GMRES重启长度
+};
+
+struct SolverResult {
+    bool converged{};
+    std::size_t iterations{};
+    double residual_norm{};
+};
+
+namespace detail {
+// Krylov求解器公共部分：参数检查、收敛阈值及工作向量复用
+// 工作向量仅在问题规模变化时重新分配，迭代过程中不分配内存
+template <typename Value>
+class KrylovSolverBase {
+    static_assert(std::is_floating_point_v<Value>, "krylov solvers require real floating point values");
+
+public:
+    explicit KrylovSolverBase(SolverOptions options) : options_{options} {}
+
+    const SolverOptions &GetOptions() const { return options_; }
+    SolverOptions &GetOptions() { return options_; }
+
+protected:
+    template <typename Matrix>
+    std::size_t Prepare(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x) const {
+        static_assert(std::is_same_v<typename Matrix::ValueType, Value>);
+        if (a.M() != a.N()) {
+            throw std::invalid_argument("krylov solver requires a square matrix");
+        }
+        if (b.size() != a.M()) {
+            throw std::invalid_argument("right-hand side size mismatch");
+        }
+        if (x.empty()) {
+            x.assign(a.N(), Value{}); // 未提供初值时以零向量起步
+        } else if (x.size() != a.N()) {
+            throw std::invalid_argument("initial guess size mismatch");
+        }
+        return a.M();
+    }
+
+    double Tolerance(const std::vector<Value> &b) const {
+        return std::max(options_.rtol * static_cast<double>(Norm2(b.size(), b.data())), options_.atol);
+    }
+
+    static void Reserve(std::size_t n, std::initializer_list<std::vector<Value> *> vectors) {
+        for (auto *v : vectors) {
+            v->resize(n);
+        }
+    }
+
+    SolverOptions options_;
+};
+} // namespace detail
+
+// 预条件共轭梯度法，适用于对称正定矩阵
+// 每轮迭代4遍扫描：SpMV融合(p, Ap)、x/r更新融合(r, r)、预条件融合(r, z)、p更新
+template <typename Value>
+class CgSolver : public detail::KrylovSolverBase<Value> {
+    using Base = detail::KrylovSolverBase<Value>;
+
+public:
+    explicit CgSolver(SolverOptions options = {}) : Base{options} {}
+
+    template <typename Matrix>
+    SolverResult Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x) {
+        return Solve(a, b, x, IdentityPreconditioner<Value>{});
+    }
+
+    template <typename Matrix>
+    SolverResult
+    Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x, const Preconditioner<Value> &m) {
+        const std::size_t n{Base::Prepare(a, b, x)};
+        Base::Reserve(n, {&r_, &z_, &p_, &q_});
+        const double tol{Base::Tolerance(b)};
+        Value *xd{x.data()}, *r{r_.data()}, *z{z_.data()}, *p{p_.data()}, *q{q_.data()};
+
+        Value rr{Residual(a, b.data(), xd, r)};
+        if (std::sqrt(rr) <= tol) {
+            return {true, 0, std::sqrt(rr)};
+        }
+        Value rz{m.ApplyDot(n, r, z)};
+        std::copy(z, z + n, p);
+
+        for (std::size_t it{1}; it <= Base::options_.max_iterations; ++it) {
+            Value pq{SpMVDot(a, p, q, p)[0]};
+            if (!(pq > Value{0})) {
+                return {false, it, std::sqrt(rr)}; // 非正定或数值崩溃
+            }
+            const Value alpha{rz / pq};
+            rr = ParallelReduce<1, Value>(n, [xd, r, p, q, alpha](std::size_t begin, std::size_t end) {
+                Value sum{};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    xd[i] += alpha * p[i];
+                    r[i] -= alpha * q[i];
+                    sum += r[i] * r[i];
+                }
+                return std::array<Value, 1>{sum};
+            })[0];
+            if (std::sqrt(rr) <= tol) {
+                return {true, it, std::sqrt(rr)};
+            }
+
+            Value rz_new{m.ApplyDot(n, r, z)};
+            const Value beta{rz_new / rz};
+            rz = rz_new;
+            ParallelFor(0, n, REDUCE_GRAIN, [p, z, beta](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    p[i] = z[i] + beta * p[i];
+                }
+            });
+        }
+        return {false, Base::options_.max_iterations, std::sqrt(rr)};
+    }
+
+private:
+    std::vector<Value> r_, z_, p_, q_;
+};
+
+// 流水线共轭梯度法(Ghysels & Vanroose)的递推形式
+// 每轮迭代的三个内积融合进同一遍向量更新扫描，只有一次规约；规约与预条件、SpMV顺序执行，不做重叠
+// 代价是多维护4个辅助向量及递推残差的舍入漂移
+template <typename Value>
+class PipelinedCgSolver : public detail::KrylovSolverBase<Value> {
+    using Base = detail::KrylovSolverBase<Value>;
+
+public:
+    explicit PipelinedCgSolver(SolverOptions options = {}) : Base{options} {}
+
+    template <typename Matrix>
+    SolverResult Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x) {
+        return Solve(a, b, x, IdentityPreconditioner<Value>{});
+    }
+
+    template <typename Matrix>
+    SolverResult
+    Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x, const Preconditioner<Value> &m) {
+        const std::size_t n{Base::Prepare(a, b, x)};
+        Base::Reserve(n, {&r_, &u_, &w_, &m_, &n_});
+        for (auto *v : {&z_, &q_, &s_, &p_}) {
+            v->assign(n, Value{});
+        }
+        const double tol{Base::Tolerance(b)};
+        Value *xd{x.data()}, *r{r_.data()}, *u{u_.data()}, *w{w_.data()}, *md{m_.data()}, *nd{n_.data()};
+        Value *z{z_.data()}, *q{q_.data()}, *s{s_.data()}, *p{p_.data()};
+
+        Value rr{Residual(a, b.data(), xd, r)};
+        if (std::sqrt(rr) <= tol) {
+            return {true, 0, std::sqrt(rr)};
+        }
+        Value gamma{m.ApplyDot(n, r, u)};
+        Value delta{SpMVDot(a, u, w, u)[0]};
+        Value gamma_old{}, alpha_old{};
+
+        for (std::size_t it{1}; it <= Base::options_.max_iterations; ++it) {
+            m.Apply(n, w, md);
+            SpMV(a, md, nd);
+
+            Value beta{}, alpha{};
+            if (it == 1) {
+                alpha = gamma / delta;
+            } else {
+                beta = gamma / gamma_old;
+                alpha = gamma / (delta - beta * gamma / alpha_old);
+            }
+            if (!std::isfinite(alpha)) {
+                return {false, it, std::sqrt(rr)};
+            }
+
+            auto sums{ParallelReduce<3, Value>(n, [=](std::size_t begin, std::size_t end) {
+                std::array<Value, 3> sum{};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    z[i] = nd[i] + beta * z[i];
+                    q[i] = md[i] + beta * q[i];
+                    s[i] = w[i] + beta * s[i];
+                    p[i] = u[i] + beta * p[i];
+                    xd[i] += alpha * p[i];
+                    r[i] -= alpha * s[i];
+                    u[i] -= alpha * q[i];
+                    w[i] -= alpha * z[i];
+                    sum[0] += r[i] * u[i];
+                    sum[1] += w[i] * u[i];
+                    sum[2] += r[i] * r[i];
+                }
+                return sum;
+            })};
+            rr = sums[2];
+            if (std::sqrt(rr) <= tol) {
+                return {true, it, std::sqrt(rr)};
+            }
+            gamma_old = gamma;
+            alpha_old = alpha;
+            gamma = sums[0];
+            delta = sums[1];
+        }
+        return {false, Base::options_.max_iterations, std::sqrt(rr)};
+    }
+
+private:
+    std::vector<Value> r_, u_, w_, m_, n_, z_, q_, s_, p_;
+};
+
+// 右预条件BiCGStab，适用于一般非对称矩阵
+// SpMV与所需内积融合，x/r更新与下一轮的(r0, r)、(r, r)融合
+template <typename Value>
+class BiCgStabSolver : public detail::KrylovSolverBase<Value> {
+    using Base = detail::KrylovSolverBase<Value>;
+
+public:
+    explicit BiCgStabSolver(SolverOptions options = {}) : Base{options} {}
+
+    template <typename Matrix>
+    SolverResult Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x) {
+        return Solve(a, b, x, IdentityPreconditioner<Value>{});
+    }
+
+    template <typename Matrix>
+    SolverResult
+    Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x, const Preconditioner<Value> &m) {
+        const std::size_t n{Base::Prepare(a, b, x)};
+        Base::Reserve(n, {&r_, &r0_, &s_, &s_hat_, &t_, &p_hat_});
+        for (auto *v : {&p_, &v_}) {
+            v->assign(n, Value{});
+        }
+        const double tol{Base::Tolerance(b)};
+        Value *xd{x.data()}, *r{r_.data()}, *r0{r0_.data()}, *p{p_.data()}, *p_hat{p_hat_.data()}, *v{v_.data()};
+        Value *s{s_.data()}, *s_hat{s_hat_.data()}, *t{t_.data()};
+
+        Value rr{Residual(a, b.data(), xd, r)};
+        if (std::sqrt(rr) <= tol) {
+            return {true, 0, std::sqrt(rr)};
+        }
+        std::copy(r, r + n, r0);
+        Value rho{1}, alpha{1}, omega{1};
+        Value rho_new{rr};
+
+        for (std::size_t it{1}; it <= Base::options_.max_iterations; ++it) {
+            if (rho_new == Value{0} || omega == Value{0}) {
+                return {false, it, std::sqrt(rr)}; // 崩溃
+            }
+            const Value beta{(rho_new / rho) * (alpha / omega)};
+            rho = rho_new;
+            ParallelFor(0, n, REDUCE_GRAIN, [r, p, v, beta, omega](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    p[i] = r[i] + beta * (p[i] - omega * v[i]);
+                }
+            });
+
+            m.Apply(n, p, p_hat);
+            Value r0v{SpMVDot(a, p_hat, v, r0)[0]};
+            if (r0v == Value{0}) {
+                return {false, it, std::sqrt(rr)};
+            }
+            alpha = rho / r0v;
+
+            Value ss{ParallelReduce<1, Value>(n, [r, v, s, alpha](std::size_t begin, std::size_t end) {
+                Value sum{};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    s[i] = r[i] - alpha * v[i];
+                    sum += s[i] * s[i];
+                }
+                return std::array<Value, 1>{sum};
+            })[0]};
+            if (std::sqrt(ss) <= tol) {
+                ParallelFor(0, n, REDUCE_GRAIN, [xd, p_hat, alpha](std::size_t begin, std::size_t end) {
+                    for (std::size_t i{begin}; i < end; ++i) {
+                        xd[i] += alpha * p_hat[i];
+                    }
+                });
+                std::copy(s, s + n, r);
+                return {true, it, std::sqrt(ss)};
+            }
+
+            m.Apply(n, s, s_hat);
+            auto [ts, tt]{SpMVDot(a, s_hat, t, s)};
+            omega = (tt == Value{0}) ? Value{0} : ts / tt;
+
+            auto sums{ParallelReduce<2, Value>(n, [=](std::size_t begin, std::size_t end) {
+                std::array<Value, 2> sum{};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    xd[i] += alpha * p_hat[i] + omega * s_hat[i];
+                    r[i] = s[i] - omega * t[i];
+                    sum[0] += r0[i] * r[i];
+                    sum[1] += r[i] * r[i];
+                }
+                return sum;
+            })};
+            rho_new = sums[0];
+            rr = sums[1];
+            if (std::sqrt(rr) <= tol) {
+                return {true, it, std::sqrt(rr)};
+            }
+        }
+        return {false, Base::options_.max_iterations, std::sqrt(rr)};
+    }
+
+private:
+    std::vector<Value> r_, r0_, p_, p_hat_, v_, s_, s_hat_, t_;
+};
+
+// 右预条件重启GMRES(m)
+// 正交化采用两遍经典Gram-Schmidt(CGS2)：每遍的j+1个内积融合为一次扫描，
+// 相比修正Gram-Schmidt的j+1次扫描大幅减少带宽消耗，第二遍保证正交性
+template <typename Value>
+class GmresSolver : public detail::KrylovSolverBase<Value> {
+    using Base = detail::KrylovSolverBase<Value>;
+
+public:
+    explicit GmresSolver(SolverOptions options = {}) : Base{options} {}
+
+    template <typename Matrix>
+    SolverResult Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x) {
+        return Solve(a, b, x, IdentityPreconditioner<Value>{});
+    }
+
+    template <typename Matrix>
+    SolverResult
+    Solve(const Matrix &a, const std::vector<Value> &b, std::vector<Value> &x, const Preconditioner<Value> &m) {
+        const std::size_t n{Base::Prepare(a, b, x)};
+        const std::size_t restart{std::max<std::size_t>(Base::options_.restart, 1)};
+        Reserve(n, restart);
+        const double tol{Base::Tolerance(b)};
+        Value *xd{x.data()}, *w{w_.data()}, *tmp{tmp_.data()};
+
+        std::size_t it{0};
+        double residual_norm{};
+        while (true) {
+            Value *v0{basis_.data()};
+            const Value beta{std::sqrt(Residual(a, b.data(), xd, v0))};
+            residual_norm = beta;
+            if (beta <= tol) {
+                return {true, it, residual_norm};
+            }
+            if (it >= Base::options_.max_iterations) {
+                return {false, it, residual_norm};
+            }
+            Scale(n, v0, Value{1} / beta);
+            std::fill(g_.begin(), g_.end(), Value{});
+            g_[0] = beta;
+
+            std::size_t k{0};
+            while (k < restart && it < Base::options_.max_iterations) {
+                ++it;
+                Value *h{hessenberg_.data() + k * (restart + 1)};
+                m.Apply(n, basis_.data() + k * n, tmp);
+                SpMV(a, tmp, w);
+
+                // CGS2正交化
+                MultiDot(n, k + 1, w, h);
+                Value ww{MultiAxpyNorm(n, k + 1, h, w)};
+                MultiDot(n, k + 1, w, correction_.data());
+                for (std::size_t i{0}; i <= k; ++i) {
+                    h[i] += correction_[i];
+                }
+                ww = MultiAxpyNorm(n, k + 1, correction_.data(), w);
+                const Value h_next{std::sqrt(ww)};
+                h[k + 1] = h_next;
+
+                ApplyGivens(k, h);
+                ++k;
+                residual_norm = std::abs(g_[k]);
+                if (residual_norm <= tol || h_next == Value{0}) {
+                    break; // 收敛或幸运崩溃，后者说明Krylov子空间已包含精确解
+                }
+                Value *v_next{basis_.data() + k * n};
+                const Value inv_norm{Value{1} / h_next};
+                ParallelFor(0, n, REDUCE_GRAIN, [v_next, w, inv_norm](std::size_t begin, std::size_t end) {
+                    for (std::size_t i{begin}; i < end; ++i) {
+                        v_next[i] = w[i] * inv_norm;
+                    }
+                });
+            }
+            UpdateSolution(n, k, restart, m, xd);
+        }
+    }
+
+private:
+    void Reserve(std::size_t n, std::size_t restart) {
+        basis_.resize((restart + 1) * n);
+        hessenberg_.resize((restart + 1) * restart);
+        partials_.resize(REDUCE_MAX_CHUNKS * (restart + 1));
+        correction_.resize(restart + 1);
+        cs_.resize(restart);
+        sn_.resize(restart);
+        g_.resize(restart + 1);
+        y_.resize(restart);
+        w_.resize(n);
+        tmp_.resize(n);
+    }
+
+    static void Scale(std::size_t n, Value *v, Value alpha) {
+        ParallelFor(0, n, REDUCE_GRAIN, [v, alpha](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                v[i] *= alpha;
+            }
+        });
+    }
+
+    // h[j] = (V_j, w)，j ∈ [0, num)，一遍扫描
+    void MultiDot(std::size_t n, std::size_t num, const Value *w, Value *h) {
+        const Value *basis{basis_.data()};
+        Value *partials{partials_.data()};
+        const std::size_t num_chunks{ReduceChunks(n)};
+        ParallelChunks(n, num_chunks, [=](std::size_t chunk, std::size_t begin, std::size_t end) {
+            Value *partial{partials + chunk * num};
+            for (std::size_t j{0}; j < num; ++j) {
+                const Value *v{basis + j * n};
+                Value sum{};
+                for (std::size_t i{begin}; i < end; ++i) {
+                    sum += v[i] * w[i];
+                }
+                partial[j] = sum;
+            }
+        });
+        std::fill(h, h + num, Value{});
+        for (std::size_t chunk{0}; chunk < num_chunks; ++chunk) {
+            for (std::size_t j{0}; j < num; ++j) {
+                h[j] += partials[chunk * num + j];
+            }
+        }
+    }
+
+    // w -= V * h，返回(w, w)
+    Value MultiAxpyNorm(std::size_t n, std::size_t num, const Value *h, Value *w) {
+        const Value *basis{basis_.data()};
+        return ParallelReduce<1, Value>(n, [=](std::size_t begin, std::size_t end) {
+            Value sum{};
+            for (std::size_t i{begin}; i < end; ++i) {
+                Value wi{w[i]};
+                for (std::size_t j{0}; j < num; ++j) {
+                    wi -= h[j] * basis[j * n + i];
+                }
+                w[i] = wi;
+                sum += wi * wi;
+            }
+            return std::array<Value, 1>{sum};
+        })[0];
+    }
+
+    // 将已有Givens旋转作用于新列，并生成消去h[k + 1]的旋转
+    void ApplyGivens(std::size_t k, Value *h) {
+        for (std::size_t i{0}; i < k; ++i) {
+            Value temp{cs_[i] * h[i] + sn_[i] * h[i + 1]};
+            h[i + 1] = -sn_[i] * h[i] + cs_[i] * h[i + 1];
+            h[i] = temp;
+        }
+        Value denom{std::hypot(h[k], h[k + 1])};
+        if (denom == Value{0}) {
+            cs_[k] = 1;
+            sn_[k] = 0;
+        } else {
+            cs_[k] = h[k] / denom;
+            sn_[k] = h[k + 1] / denom;
+        }
+        h[k] = cs_[k] * h[k] + sn_[k] * h[k + 1];
+        h[k + 1] = 0;
+        g_[k + 1] = -sn_[k] * g_[k];
+        g_[k] = cs_[k] * g_[k];
+    }
+
+    // 回代求解上三角系统H * y = g，x += M^-1 * (V * y)
+    void UpdateSolution(std::size_t n, std::size_t k, std::size_t restart, const Preconditioner<Value> &m, Value *x) {
+        for (std::size_t i{k}; i-- > 0;) {
+            Value sum{g_[i]};
+            for (std::size_t j{i + 1}; j < k; ++j) {
+                sum -= hessenberg_[j * (restart + 1) + i] * y_[j];
+            }
+            Value diag{hessenberg_[i * (restart + 1) + i]};
+            y_[i] = (diag == Value{0}) ? Value{0} : sum / diag;
+        }
+        const Value *basis{basis_.data()};
+        const Value *y{y_.data()};
+        Value *w{w_.data()};
+        ParallelFor(0, n, REDUCE_GRAIN, [=](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                Value sum{};
+                for (std::size_t j{0}; j < k; ++j) {
+                    sum += y[j] * basis[j * n + i];
+                }
+                w[i] = sum;
+            }
+        });
+        Value *tmp{tmp_.data()};
+        m.Apply(n, w, tmp);
+        ParallelFor(0, n, REDUCE_GRAIN, [x, tmp](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                x[i] += tmp[i];
+            }
+        });
+    }
+
+    std::vector<Value> basis_;      // Krylov基，(restart + 1)列，列主序
+    std::vector<Value> hessenberg_; // 经Givens旋转后的上三角Hessenberg，列主序
+    std::vector<Value> partials_;   // MultiDot分块部分和
+    std::vector<Value> correction_, cs_, sn_, g_, y_, w_, tmp_;
+};
+} // namespace oops
@@ -0,0 +1,106 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "oops/csr.h"
+#include "oops/spmv.h"
+#include "oops/thread_pool.h"
+
+namespace oops {
+template <typename Value>
+Value Dot(std::size_t n, const Value *x, const Value *y) {
+    return ParallelReduce<1, Value>(n, [x, y](std::size_t begin, std::size_t end) {
+        Value sum{};
+        for (std::size_t i{begin}; i < end; ++i) {
+            sum += x[i] * y[i];
+        }
+        return std::array<Value, 1>{sum};
+    })[0];
+}
+
+template <typename Value>
+Value Norm2(std::size_t n, const Value *x) {
+    return std::sqrt(Dot(n, x, x));
+}
+
+// y = A * x，同一遍扫描返回{(z, y), (y, y)}
+template <typename Value, typename DimIndex, typename NnzIndex>
+std::array<Value, 2> SpMVDot(const CsrView<Value, DimIndex, NnzIndex> &a, const Value *x, Value *y, const Value *z) {
+    const std::size_t m{a.M()};
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        // 对称压缩存储存在散射写，行内无法得到最终结果，退化为两遍扫描
+        SpMV(a, x, y);
+        return ParallelReduce<2, Value>(m, [y, z](std::size_t begin, std::size_t end) {
+            std::array<Value, 2> sum{};
+            for (std::size_t i{begin}; i < end; ++i) {
+                sum[0] += z[i] * y[i];
+                sum[1] += y[i] * y[i];
+            }
+            return sum;
+        });
+    }
+
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    return ParallelReduce<2, Value>(m, [=](std::size_t begin, std::size_t end) {
+        std::array<Value, 2> sum{};
+        for (std::size_t r{begin}; r < end; ++r) {
+            Value yr{};
+            for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+                yr += values[i] * x[col_indices[i]];
+            }
+            y[r] = yr;
+            sum[0] += z[r] * yr;
+            sum[1] += yr * yr;
+        }
+        return sum;
+    });
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+std::array<Value, 2>
+SpMVDot(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, const Value *x, Value *y, const Value *z) {
+    return SpMVDot(CsrView<Value, DimIndex, NnzIndex>{a}, x, y, z);
+}
+
+// r = b - A * x，同一遍扫描返回(r, r)
+template <typename Value, typename DimIndex, typename NnzIndex>
+Value Residual(const CsrView<Value, DimIndex, NnzIndex> &a, const Value *b, const Value *x, Value *r) {
+    const std::size_t m{a.M()};
+    if (a.GetSymmetric() != MatrixSymmetric::GENERAL) {
+        SpMV(a, x, r);
+        return ParallelReduce<1, Value>(m, [b, r](std::size_t begin, std::size_t end) {
+            Value sum{};
+            for (std::size_t i{begin}; i < end; ++i) {
+                r[i] = b[i] - r[i];
+                sum += r[i] * r[i];
+            }
+            return std::array<Value, 1>{sum};
+        })[0];
+    }
+
+    const Value *values{a.GetValues()};
+    const NnzIndex *row_ptr{a.GetRowPtr()};
+    const DimIndex *col_indices{a.GetColIndices()};
+    return ParallelReduce<1, Value>(m, [=](std::size_t begin, std::size_t end) {
+        Value sum{};
+        for (std::size_t row{begin}; row < end; ++row) {
+            Value ax{};
+            for (auto i{row_ptr[row]}; i < row_ptr[row + 1]; ++i) {
+                ax += values[i] * x[col_indices[i]];
+            }
+            r[row] = b[row] - ax;
+            sum += r[row] * r[row];
+        }
+        return std::array<Value, 1>{sum};
+    })[0];
+}
+
+template <typename Value, typename DimIndex, typename NnzIndex, typename Allocator>
+Value Residual(const Csr<Value, DimIndex, NnzIndex, Allocator> &a, const Value *b, const Value *x, Value *r) {
+    return Residual(CsrView<Value, DimIndex, NnzIndex>{a}, b, x, r);
+}
+} // namespace oops
@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "oops/thread_pool.h"
+
+namespace oops {
+// 三角依赖的层次调度：同层内的行互不依赖，可并行处理，层间串行
+struct LevelSchedule {
+    // 单层内行数较少时并行收益低于调度开销，由ParallelFor退化为串行
+    static constexpr std::size_t ROW_GRAIN{256};
+
+    std::size_t NumLevels() const { return level_ptr.empty() ? 0 : level_ptr.size() - 1; }
+
+    // 逐层执行f(row)，层内并行
+    template <typename F>
+    void ForEach(F &&f) const {
+        for (std::size_t level{0}; level < NumLevels(); ++level) {
+            const std::size_t *level_rows{rows.data()};
+            auto level_f = [level_rows, &f](std::size_t begin, std::size_t end) {
+                for (std::size_t i{begin}; i < end; ++i) {
+                    f(level_rows[i]);
+                }
+            };
+            ParallelFor(level_ptr[level], level_ptr[level + 1], ROW_GRAIN, level_f);
+        }
+    }
+
+    std::vector<std::size_t> level_ptr; // 各层在rows中的起始位置
+    std::vector<std::size_t> rows;      // 按层排列的行号，层内升序
+};
+
+// 由CSR结构构建层次调度
+// lower为真时行r依赖列索引c < r的行(前代)，否则依赖c > r的行(回代)
+template <typename DimIndex, typename NnzIndex>
+LevelSchedule BuildLevelSchedule(
+    std::size_t n, const std::vector<NnzIndex> &row_ptr, const std::vector<DimIndex> &col_indices, bool lower) {
+    std::vector<std::size_t> level(n, 0);
+    std::size_t num_levels{0};
+    auto visit = [&](std::size_t r) {
+        std::size_t lv{0};
+        for (auto i{row_ptr[r]}; i < row_ptr[r + 1]; ++i) {
+            std::size_t c{static_cast<std::size_t>(col_indices[i])};
+            if (lower ? (c < r) : (c > r)) {
+                lv = std::max(lv, level[c] + 1);
+            }
+        }
+        level[r] = lv;
+        num_levels = std::max(num_levels, lv + 1);
+    };
+    if (lower) {
+        for (std::size_t r{0}; r < n; ++r) {
+            visit(r);
+        }
+    } else {
+        for (std::size_t r{n}; r-- > 0;) {
+            visit(r);
+        }
+    }
+
+    // 计数排序，层内保持行号升序
+    LevelSchedule schedule;
+    schedule.level_ptr.assign(num_levels + 1, 0);
+    for (std::size_t r{0}; r < n; ++r) {
+        ++schedule.level_ptr[level[r] + 1];
+    }
+    for (std::size_t lv{0}; lv < num_levels; ++lv) {
+        schedule.level_ptr[lv + 1] += schedule.level_ptr[lv];
+    }
+    schedule.rows.resize(n);
+    std::vector<std::size_t> pos(schedule.level_ptr.begin(), schedule.level_ptr.end() - 1);
+    for (std::size_t r{0}; r < n; ++r) {
+        schedule.rows[pos[level[r]]++] = r;
+    }
+    return schedule;
+}
+} // namespace oops
@@ -0,0 +1,99 @@
+#pragma once
+#include <stdexcept>
+#include <vector>
+
+#include "oops/csr.h"
+#include "oops/krylov_kernel.h"
+
+namespace oops {
+// 预条件子接口，z = M^-1 * r
+// 实现应避免在Apply中分配内存，供Krylov求解器每轮迭代调用
+template <typename Value>
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    virtual void Apply(std::size_t n, const Value *r, Value *z) const = 0;
+
+    // z = M^-1 * r并返回(r, z)，可重载为单遍扫描
+    virtual Value ApplyDot(std::size_t n, const Value *r, Value *z) const {
+        Apply(n, r, z);
+        return Dot(n, r, z);
+    }
+};
+
+template <typename Value>
+class IdentityPreconditioner : public Preconditioner<Value> {
+public:
+    void Apply(std::size_t n, const Value *r, Value *z) const override {
+        if (r != z) {
+            std::copy(r, r + n, z);
+        }
+    }
+
+    Value ApplyDot(std::size_t n, const Value *r, Value *z) const override {
+        Apply(n, r, z);
+        return Dot(n, r, r);
+    }
+};
+
+// 对角预条件，M = diag(A)
+template <typename Value>
+class JacobiPreconditioner : public Preconditioner<Value> {
+public:
+    JacobiPreconditioner() = default;
+    template <typename DimIndex, typename NnzIndex>
+    explicit JacobiPreconditioner(const Csr<Value, DimIndex, NnzIndex> &a) {
+        Setup(a);
+    }
+
+    template <typename DimIndex, typename NnzIndex>
+    void Setup(const Csr<Value, DimIndex, NnzIndex> &a) {
+        const auto &store{a.GetStore()};
+        inv_diag_.assign(a.M(), Value{});
+        for (std::size_t r{0}; r < a.M(); ++r) {
+            for (auto i{store.row_ptr[r]}; i < store.row_ptr[r + 1]; ++i) {
+                if (static_cast<std::size_t>(store.col_indices[i]) == r) {
+                    inv_diag_[r] += store.values[i];
+                }
+            }
+            if (inv_diag_[r] == Value{}) {
+                throw std::runtime_error("jacobi preconditioner with zero diagonal at row " + std::to_string(r));
+            }
+            inv_diag_[r] = Value{1} / inv_diag_[r];
+        }
+    }
+
+    void Apply(std::size_t n, const Value *r, Value *z) const override {
+        CheckSize(n);
+        ParallelFor(0, n, REDUCE_GRAIN, [this, r, z](std::size_t begin, std::size_t end) {
+            for (std::size_t i{begin}; i < end; ++i) {
+                z[i] = inv_diag_[i] * r[i];
+            }
+        });
+    }
+
+    Value ApplyDot(std::size_t n, const Value *r, Value *z) const override {
+        CheckSize(n);
+        return ParallelReduce<1, Value>(n, [this, r, z](std::size_t begin, std::size_t end) {
+            Value sum{};
+            for (std::size_t i{begin}; i < end; ++i) {
+                z[i] = inv_diag_[i] * r[i];
+                sum += r[i] * z[i];
+            }
+            return std::array<Value, 1>{sum};
+        })[0];
+    }
+
+    const std::vector<Value> &GetInvDiag() const { return inv_diag_; }
+
+private:
+    void CheckSize(std::size_t n) const {
+        if (n != inv_diag_.size()) {
+            throw std::invalid_argument("preconditioner size mismatch");
+        }
+    }
+
+    std::vector<Value> inv_diag_;
+};
+} // namespace oops
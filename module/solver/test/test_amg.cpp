@@ -0,0 +1,66 @@
+#include <cmath>
+
+#include "oops/amg.h"
+#include "oops/krylov.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+TEST(SolverAmg, Hierarchy) {
+    auto a{MakeLaplacian2D(64)};
+    AmgOptions options;
+    options.max_coarse_size = 50;
+    AmgPreconditioner<double> amg{a, options};
+    ASSERT_GT(amg.NumLevels(), 2);
+    for (std::size_t l{1}; l < amg.NumLevels(); ++l) {
+        EXPECT_LT(amg.LevelSize(l), amg.LevelSize(l - 1));
+        EXPECT_TRUE(amg.IsCompactLevel(l));
+    }
+    EXPECT_LE(amg.LevelSize(amg.NumLevels() - 1), 50);
+    EXPECT_LT(amg.OperatorComplexity(), 2.0);
+}
+
+TEST(SolverAmg, CgIterations) {
+    auto a{MakeLaplacian2D(64)};
+    std::vector<double> b(a.M(), 1.0);
+    CgSolver<double> solver;
+
+    std::vector<double> x_jacobi;
+    auto res_jacobi{solver.Solve(a, b, x_jacobi, JacobiPreconditioner<double>{a})};
+
+    for (auto smoother : {AmgSmoother::JACOBI, AmgSmoother::CHEBYSHEV}) {
+        AmgOptions options;
+        options.smoother = smoother;
+        AmgPreconditioner<double> amg{a, options};
+        std::vector<double> x;
+        auto res{solver.Solve(a, b, x, amg)};
+        EXPECT_TRUE(res.converged);
+        EXPECT_LE(TrueResidual(a, b, x), 1e-6 * std::sqrt(static_cast<double>(b.size())));
+        EXPECT_LT(res.iterations * 4, res_jacobi.iterations);
+    }
+}
+
+TEST(SolverAmg, ApplyReuse) {
+    // 重复Apply复用工作向量，结果一致；r与z可为同一数组
+    auto a{MakeLaplacian2D(32, 0.5)};
+    AmgPreconditioner<double> amg{a};
+    std::vector<double> r(a.M());
+    for (std::size_t i{0}; i < r.size(); ++i) {
+        r[i] = std::sin(static_cast<double>(i));
+    }
+    std::vector<double> z1(r.size()), z2(r.size());
+    amg.Apply(r.size(), r.data(), z1.data());
+    amg.Apply(r.size(), r.data(), z2.data());
+    EXPECT_EQ(z1, z2);
+    amg.Apply(r.size(), r.data(), r.data());
+    EXPECT_EQ(r, z1);
+}
+
+TEST(SolverAmg, InvalidArgument) {
+    auto a{MakeLaplacian2D(8)};
+    AmgPreconditioner<double> amg{a};
+    std::vector<double> r(3), z(3);
+    EXPECT_THROW(amg.Apply(3, r.data(), z.data()), std::invalid_argument);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cmath>
+
+#include "oops/convert.h"
+#include "oops/krylov_kernel.h"
+
+namespace oops {
+namespace test {
+// nx * nx网格上的5点差分矩阵，convection非零时叠加迎风对流项得到非对称矩阵
+inline Csr<double, int32_t> MakeLaplacian2D(int32_t nx, double convection = 0) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = static_cast<std::size_t>(nx) * nx;
+    auto add = [&store](int32_t r, int32_t c, double v) {
+        store.row_indices.push_back(r);
+        store.col_indices.push_back(c);
+        store.values.push_back(v);
+    };
+    for (int32_t i{0}; i < nx; ++i) {
+        for (int32_t j{0}; j < nx; ++j) {
+            int32_t r{i * nx + j};
+            add(r, r, 4 + convection);
+            if (i > 0) {
+                add(r, r - nx, -1 - convection);
+            }
+            if (i + 1 < nx) {
+                add(r, r + nx, -1);
+            }
+            if (j > 0) {
+                add(r, r - 1, -1);
+            }
+            if (j + 1 < nx) {
+                add(r, r + 1, -1);
+            }
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store)});
+}
+
+inline double TrueResidual(const Csr<double, int32_t> &a, const std::vector<double> &b, const std::vector<double> &x) {
+    std::vector<double> r(b.size());
+    return std::sqrt(Residual(a, b.data(), x.data(), r.data()));
+}
+} // namespace test
+} // namespace oops
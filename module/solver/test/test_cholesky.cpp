@@ -0,0 +1,187 @@
+#include <cmath>
+
+#include "oops/cholesky.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+Coo<double, int32_t> LowerTriangle(const Csr<double, int32_t> &a) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = a.M();
+    for (std::size_t r{0}; r < a.M(); ++r) {
+        for (auto i{a.GetRowPtr()[r]}; i < a.GetRowPtr()[r + 1]; ++i) {
+            if (a.GetColIndices()[i] <= static_cast<int32_t>(r)) {
+                store.row_indices.push_back(r);
+                store.col_indices.push_back(a.GetColIndices()[i]);
+                store.values.push_back(a.GetValues()[i]);
+            }
+        }
+    }
+    return {std::move(store), MatrixSymmetric::SYMMETRIC_LOWER};
+}
+} // namespace
+
+TEST(SolverCholesky, DenseKernel) {
+    // 跨越分块边界的对角占优矩阵，检验L * L^T = A
+    constexpr std::size_t n{150};
+    std::vector<double> a(n * n), l(n * n);
+    for (std::size_t j{0}; j < n; ++j) {
+        for (std::size_t i{0}; i < n; ++i) {
+            a[i + j * n] = (i == j) ? n : std::cos(static_cast<double>(i + j));
+        }
+    }
+    l = a;
+    ASSERT_EQ(DenseCholesky(n, l.data(), n), n);
+    for (std::size_t j{0}; j < n; ++j) {
+        for (std::size_t i{j}; i < n; ++i) {
+            double sum{0};
+            for (std::size_t p{0}; p <= j; ++p) {
+                sum += l[i + p * n] * l[j + p * n];
+            }
+            EXPECT_NEAR(sum, a[i + j * n], 1e-9);
+        }
+    }
+
+    a[3 + 3 * n] = -1;
+    EXPECT_EQ(DenseCholesky(n, a.data(), n), 3);
+}
+
+TEST(SolverCholesky, MultipleRhs) {
+    auto a{MakeLaplacian2D(30)};
+    SupernodalCholesky<double> chol{a};
+    EXPECT_LT(chol.NumSupernodes(), a.M());
+
+    constexpr std::size_t nrhs{3};
+    const std::size_t n{a.M()};
+    std::vector<double> b(n * nrhs), x;
+    for (std::size_t i{0}; i < b.size(); ++i) {
+        b[i] = std::sin(static_cast<double>(i));
+    }
+    chol.Solve(b, x);
+    for (std::size_t r{0}; r < nrhs; ++r) {
+        std::vector<double> b_r(b.begin() + r * n, b.begin() + (r + 1) * n);
+        std::vector<double> x_r(x.begin() + r * n, x.begin() + (r + 1) * n);
+        EXPECT_LE(TrueResidual(a, b_r, x_r), 1e-10);
+    }
+
+    // 原位求解
+    chol.Solve(b.data(), b.data(), nrhs);
+    EXPECT_EQ(b, x);
+}
+
+TEST(SolverCholesky, Ordering) {
+    auto a{MakeLaplacian2D(30)};
+    SupernodalCholesky<double> amd{a};
+    CholeskyOptions options;
+    options.ordering = CholeskyOrdering::NATURAL;
+    SupernodalCholesky<double> natural{a, options};
+    EXPECT_LT(amd.FactorNnz(), natural.FactorNnz() / 2);
+
+    std::vector<double> b(a.M(), 1.0), x_amd, x_natural;
+    amd.Solve(b, x_amd);
+    natural.Solve(b, x_natural);
+    for (std::size_t i{0}; i < b.size(); ++i) {
+        EXPECT_NEAR(x_amd[i], x_natural[i], 1e-10);
+    }
+}
+
+TEST(SolverCholesky, FactorNnz) {
+    // 与置换后稠密布尔消去得到的填充一致
+    auto a{MakeLaplacian2D(10)};
+    SupernodalCholesky<double> chol{a};
+    const auto &perm{chol.GetPermutation()};
+    const std::size_t n{a.M()};
+    std::vector<std::size_t> inv(n);
+    for (std::size_t k{0}; k < n; ++k) {
+        inv[perm[k]] = k;
+    }
+    std::vector<char> pattern(n * n, 0);
+    for (std::size_t r{0}; r < n; ++r) {
+        for (auto i{a.GetRowPtr()[r]}; i < a.GetRowPtr()[r + 1]; ++i) {
+            pattern[inv[r] * n + inv[a.GetColIndices()[i]]] = 1;
+        }
+    }
+    std::size_t nnz{0};
+    for (std::size_t k{0}; k < n; ++k) {
+        for (std::size_t i{k}; i < n; ++i) {
+            nnz += pattern[i * n + k];
+        }
+        for (std::size_t i{k + 1}; i < n; ++i) {
+            for (std::size_t j{k + 1}; j < n; ++j) {
+                pattern[i * n + j] |= pattern[i * n + k] & pattern[j * n + k];
+            }
+        }
+    }
+    EXPECT_EQ(chol.FactorNnz(), nnz);
+}
+
+TEST(SolverCholesky, SymmetricLowerCoo) {
+    auto full{MakeLaplacian2D(12)};
+    SupernodalCholesky<double> chol{LowerTriangle(full)};
+    std::vector<double> b(full.M(), 1.0), x;
+    chol.Solve(b, x);
+    EXPECT_LE(TrueResidual(full, b, x), 1e-10);
+}
+
+TEST(SolverCholesky, Refactorize) {
+    auto a{MakeLaplacian2D(16)};
+    SupernodalCholesky<double> chol;
+    chol.Analyze(a);
+    chol.Factorize(a);
+    std::vector<double> b(a.M(), 1.0), x1, x2;
+    chol.Solve(b, x1);
+
+    // 数值加倍后解减半
+    CsrStore<double, int32_t> store = a.GetStore();
+    for (auto &v : store.values) {
+        v *= 2;
+    }
+    Csr<double, int32_t> a2{std::move(store)};
+    chol.Factorize(a2);
+    chol.Solve(b, x2);
+    for (std::size_t i{0}; i < b.size(); ++i) {
+        EXPECT_NEAR(x2[i], x1[i] / 2, 1e-12);
+    }
+
+    EXPECT_THROW(chol.Factorize(MakeLaplacian2D(15)), std::invalid_argument);
+}
+
+TEST(SolverCholesky, CachedAnalysis) {
+    auto a{MakeLaplacian2D(12)};
+    SupernodalCholesky<double> chol1;
+    chol1.Analyze(a);
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 1);
+    chol1.Factorize(a);
+
+    // 共享模式的矩阵复用缓存的符号分析，结果逐位一致
+    auto a2{a};
+    a2.UpdateValues(a.GetValues());
+    SupernodalCholesky<double> chol2;
+    chol2.Analyze(a2);
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 1);
+    chol2.Factorize(a2);
+    EXPECT_EQ(chol2.FactorNnz(), chol1.FactorNnz());
+    // 符号结构共享而非复制
+    EXPECT_EQ(chol2.GetPermutation().data(), chol1.GetPermutation().data());
+    std::vector<double> b(a.M(), 1.0), x1, x2;
+    chol1.Solve(b, x1);
+    chol2.Solve(b, x2);
+    EXPECT_EQ(x1, x2);
+
+    CholeskyOptions options;
+    options.ordering = CholeskyOrdering::NATURAL;
+    SupernodalCholesky<double> natural{options};
+    natural.Analyze(a);
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 2);
+}
+
+TEST(SolverCholesky, NotPositiveDefinite) {
+    auto a{MakeLaplacian2D(8)};
+    CsrStore<double, int32_t> store = a.GetStore();
+    store.values[store.row_ptr[5]] = -10;
+    Csr<double, int32_t> b{std::move(store)};
+    EXPECT_THROW(SupernodalCholesky<double>{b}, std::runtime_error);
+}
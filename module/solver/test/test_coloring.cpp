@@ -0,0 +1,87 @@
+#include "oops/coloring.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+void CheckColoring(const Csr<double, int32_t> &a, const Coloring &coloring, std::size_t distance) {
+    std::vector<std::size_t> adj_ptr, adj;
+    SymmetricAdjacency(a, adj_ptr, adj);
+    const std::size_t n{a.M()};
+    ASSERT_EQ(coloring.colors.size(), n);
+    for (std::size_t i{0}; i < n; ++i) {
+        ASSERT_LT(coloring.colors[i], coloring.NumColors());
+        for (std::size_t p{adj_ptr[i]}; p < adj_ptr[i + 1]; ++p) {
+            const std::size_t j{adj[p]};
+            EXPECT_NE(coloring.colors[i], coloring.colors[j]);
+            if (distance == 2) {
+                for (std::size_t q{adj_ptr[j]}; q < adj_ptr[j + 1]; ++q) {
+                    if (adj[q] != i) {
+                        EXPECT_NE(coloring.colors[i], coloring.colors[adj[q]]);
+                    }
+                }
+            }
+        }
+    }
+    // rows按颜色分段，段内升序
+    ASSERT_EQ(coloring.rows.size(), n);
+    EXPECT_EQ(coloring.color_ptr.front(), 0);
+    EXPECT_EQ(coloring.color_ptr.back(), n);
+    for (std::size_t c{0}; c < coloring.NumColors(); ++c) {
+        EXPECT_LT(coloring.color_ptr[c], coloring.color_ptr[c + 1]);
+        for (std::size_t k{coloring.color_ptr[c]}; k < coloring.color_ptr[c + 1]; ++k) {
+            EXPECT_EQ(coloring.colors[coloring.rows[k]], c);
+            if (k > coloring.color_ptr[c]) {
+                EXPECT_LT(coloring.rows[k - 1], coloring.rows[k]);
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(SolverColoring, SymmetricAdjacency) {
+    // 非对称模式：0->1、2->1，对角不计入
+    CooStore<double, int32_t> store{3, 3, {1, 1, 1, 1, 1}, {0, 0, 1, 1, 2}, {0, 1, 0, 1, 1}};
+    auto a{ToCsr(Coo<double, int32_t>{store})};
+    std::vector<std::size_t> adj_ptr, adj;
+    SymmetricAdjacency(a, adj_ptr, adj);
+    EXPECT_EQ(adj_ptr, (std::vector<std::size_t>{0, 1, 3, 4}));
+    EXPECT_EQ(adj, (std::vector<std::size_t>{1, 0, 2, 1}));
+}
+
+TEST(SolverColoring, Distance1) {
+    auto a{MakeLaplacian2D(30)};
+    auto coloring{ColorGraph(a)};
+    CheckColoring(a, coloring, 1);
+    // 最大度为4，贪心着色至多5色
+    EXPECT_LE(coloring.NumColors(), 5);
+}
+
+TEST(SolverColoring, Distance2) {
+    auto a{MakeLaplacian2D(30)};
+    auto coloring{ColorGraph(a, 2)};
+    CheckColoring(a, coloring, 2);
+    // 距离2邻居至多12个
+    EXPECT_LE(coloring.NumColors(), 13);
+    EXPECT_GT(coloring.NumColors(), ColorGraph(a).NumColors());
+}
+
+TEST(SolverColoring, Deterministic) {
+    auto a{MakeLaplacian2D(50, 0.5)};
+    auto first{ColorGraph(a)};
+    for (int i{0}; i < 3; ++i) {
+        auto again{ColorGraph(a)};
+        EXPECT_EQ(again.colors, first.colors);
+        EXPECT_EQ(again.rows, first.rows);
+    }
+}
+
+TEST(SolverColoring, InvalidArgument) {
+    auto a{MakeLaplacian2D(4)};
+    EXPECT_THROW(ColorGraph(a, 3), std::invalid_argument);
+    CooStore<double, int32_t> store{2, 3, {1}, {0}, {2}};
+    auto rect{ToCsr(Coo<double, int32_t>{store})};
+    EXPECT_THROW(ColorGraph(rect), std::invalid_argument);
+}
@@ -0,0 +1,169 @@
+#include <cmath>
+
+#include "oops/amg.h"
+#include "oops/eigen.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+// 对角元递增的三对角矩阵，特征值互异
+Csr<double, int32_t> MakeTridiagonal(int32_t n, MatrixSymmetric symmetric) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = n;
+    for (int32_t i{0}; i < n; ++i) {
+        store.row_indices.push_back(i);
+        store.col_indices.push_back(i);
+        store.values.push_back(2 + 0.05 * i);
+        if (i > 0) {
+            store.row_indices.push_back(i);
+            store.col_indices.push_back(i - 1);
+            store.values.push_back(-1);
+        }
+        if (i + 1 < n && symmetric == MatrixSymmetric::GENERAL) {
+            store.row_indices.push_back(i);
+            store.col_indices.push_back(i + 1);
+            store.values.push_back(-1);
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store), symmetric});
+}
+
+std::vector<double> DenseEigenvalues(const Csr<double, int32_t> &a) {
+    const std::size_t n{a.M()};
+    std::vector<double> dense(n * n), w(n), v(n * n);
+    for (std::size_t r{0}; r < n; ++r) {
+        for (auto i{a.GetRowPtr()[r]}; i < a.GetRowPtr()[r + 1]; ++i) {
+            dense[r + a.GetColIndices()[i] * n] = a.GetValues()[i];
+        }
+    }
+    DenseSymmetricEigen(n, dense.data(), n, w.data(), v.data(), n);
+    return w;
+}
+
+void CheckEigenpairs(const Csr<double, int32_t> &a, const EigenResult<double> &res, double tol) {
+    const std::size_t n{a.M()};
+    std::vector<double> ax(n);
+    for (std::size_t j{0}; j < res.values.size(); ++j) {
+        const double *x{res.vectors.data() + j * n};
+        SpMV(a, x, ax.data());
+        double r{0}, norm{0};
+        for (std::size_t i{0}; i < n; ++i) {
+            r += (ax[i] - res.values[j] * x[i]) * (ax[i] - res.values[j] * x[i]);
+            norm += x[i] * x[i];
+        }
+        EXPECT_NEAR(norm, 1, 1e-10);
+        EXPECT_LE(std::sqrt(r), tol);
+    }
+}
+} // namespace
+
+TEST(SolverEigen, SymmetricSpMM) {
+    auto a{MakeTridiagonal(300, MatrixSymmetric::SYMMETRIC_LOWER)};
+    const std::size_t n{a.M()};
+    const std::size_t k{3};
+    std::vector<double> x(n * k), y(n * k);
+    for (std::size_t i{0}; i < x.size(); ++i) {
+        x[i] = std::sin(0.1 * static_cast<double>(i));
+    }
+    SymmetricSpMM<double, int32_t, int32_t> op{a};
+    op.Apply(k, x.data(), n, y.data(), n);
+    // 与SpMV共用模式上缓存的转置结构，累加顺序相同，结果逐位一致
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 1);
+    for (std::size_t j{0}; j < k; ++j) {
+        std::vector<double> x_j(x.begin() + j * n, x.begin() + (j + 1) * n), y_j;
+        SpMV(a, x_j, y_j);
+        EXPECT_EQ(y_j, std::vector<double>(y.begin() + j * n, y.begin() + (j + 1) * n));
+    }
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 1);
+}
+
+TEST(SolverEigen, DenseSymmetricEigen) {
+    std::vector<double> a{2, 1, 0, 1, 2, 1, 0, 1, 2}, w(3), v(9);
+    DenseSymmetricEigen(3, a.data(), 3, w.data(), v.data(), 3);
+    EXPECT_NEAR(w[0], 2 - std::sqrt(2.0), 1e-14);
+    EXPECT_NEAR(w[1], 2, 1e-14);
+    EXPECT_NEAR(w[2], 2 + std::sqrt(2.0), 1e-14);
+}
+
+TEST(SolverEigen, Lanczos) {
+    auto general{MakeTridiagonal(120, MatrixSymmetric::GENERAL)};
+    auto lower{MakeTridiagonal(120, MatrixSymmetric::SYMMETRIC_LOWER)};
+    auto ref{DenseEigenvalues(general)};
+
+    EigenOptions options;
+    options.num_eigenpairs = 4;
+    auto largest{LanczosSolver<double>{options}.Solve(lower)};
+    EXPECT_TRUE(largest.converged);
+    for (std::size_t i{0}; i < 4; ++i) {
+        EXPECT_NEAR(largest.values[i], ref[ref.size() - 1 - i], 1e-8);
+    }
+    CheckEigenpairs(general, largest, 1e-6);
+
+    options.which = EigenWhich::SMALLEST;
+    options.num_eigenpairs = 3;
+    auto smallest{LanczosSolver<double>{options}.Solve(general)};
+    EXPECT_TRUE(smallest.converged);
+    for (std::size_t i{0}; i < 3; ++i) {
+        EXPECT_NEAR(smallest.values[i], ref[i], 1e-8);
+    }
+    CheckEigenpairs(general, smallest, 1e-6);
+}
+
+TEST(SolverEigen, LanczosMemoryBudget) {
+    auto a{MakeTridiagonal(120, MatrixSymmetric::SYMMETRIC_LOWER)};
+    auto ref{DenseEigenvalues(MakeTridiagonal(120, MatrixSymmetric::GENERAL))};
+    EigenOptions options;
+    options.num_eigenpairs = 2;
+    options.memory_budget = 9 * 120 * sizeof(double); // 基底至多8维
+    LanczosSolver<double> solver{options};
+    auto res{solver.Solve(a)};
+    EXPECT_TRUE(res.converged);
+    EXPECT_GT(res.iterations, 1);
+    EXPECT_NEAR(res.values[0], ref.back(), 1e-8);
+
+    solver.GetOptions().memory_budget = 3 * 120 * sizeof(double);
+    EXPECT_THROW(solver.Solve(a), std::invalid_argument);
+}
+
+TEST(SolverEigen, Lobpcg) {
+    // 二维Laplace算子最小特征值含二重特征值，块方法可同时求得
+    constexpr int32_t nx{20};
+    auto a{MakeLaplacian2D(nx)};
+    const double pi{std::acos(-1.0)};
+    auto lambda = [pi](int p, int q) {
+        return 4 - 2 * std::cos(p * pi / (nx + 1)) - 2 * std::cos(q * pi / (nx + 1));
+    };
+    std::vector<double> ref{lambda(1, 1), lambda(1, 2), lambda(2, 1), lambda(2, 2)};
+
+    EigenOptions options;
+    options.which = EigenWhich::SMALLEST;
+    options.num_eigenpairs = 4;
+    options.tolerance = 1e-9;
+    LobpcgSolver<double> solver{options};
+    auto plain{solver.Solve(a)};
+    auto amg{solver.Solve(a, AmgPreconditioner<double>{a})};
+    for (const auto *res : {&plain, &amg}) {
+        EXPECT_TRUE(res->converged);
+        for (std::size_t i{0}; i < ref.size(); ++i) {
+            EXPECT_NEAR(res->values[i], ref[i], 1e-8);
+        }
+        CheckEigenpairs(a, *res, 1e-6);
+    }
+    EXPECT_LT(amg.iterations, plain.iterations);
+}
+
+TEST(SolverEigen, LobpcgLargest) {
+    auto lower{MakeTridiagonal(120, MatrixSymmetric::SYMMETRIC_LOWER)};
+    auto ref{DenseEigenvalues(MakeTridiagonal(120, MatrixSymmetric::GENERAL))};
+    EigenOptions options;
+    options.num_eigenpairs = 3;
+    options.block_size = 5;
+    auto res{LobpcgSolver<double>{options}.Solve(lower)};
+    EXPECT_TRUE(res.converged);
+    for (std::size_t i{0}; i < 3; ++i) {
+        EXPECT_NEAR(res.values[i], ref[ref.size() - 1 - i], 1e-7);
+    }
+}
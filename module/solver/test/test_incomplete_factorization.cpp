@@ -0,0 +1,145 @@
+#include "oops/incomplete_factorization.h"
+#include "oops/krylov.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+// 三对角矩阵的零填充分解即完全分解
+Csr<double, int32_t> MakeTridiagonal(int32_t n, MatrixSymmetric symmetric = MatrixSymmetric::GENERAL) {
+    CooStore<double, int32_t> store;
+    store.m = store.n = n;
+    for (int32_t r{0}; r < n; ++r) {
+        for (int32_t c{std::max(r - 1, 0)}; c <= std::min(r + 1, n - 1); ++c) {
+            if (symmetric == MatrixSymmetric::SYMMETRIC_LOWER && c > r) {
+                continue;
+            }
+            store.row_indices.push_back(r);
+            store.col_indices.push_back(c);
+            store.values.push_back(r == c ? 2.5 : -1.0);
+        }
+    }
+    return ToCsr(Coo<double, int32_t>{std::move(store), symmetric});
+}
+
+void CheckExactSolve(const Csr<double, int32_t> &a, const Preconditioner<double> &m) {
+    std::vector<double> r(a.M());
+    for (std::size_t i{0}; i < r.size(); ++i) {
+        r[i] = 1.0 + static_cast<double>(i % 7);
+    }
+    std::vector<double> z(a.M());
+    m.Apply(r.size(), r.data(), z.data());
+    std::vector<double> az;
+    SpMV(a, z, az);
+    for (std::size_t i{0}; i < r.size(); ++i) {
+        EXPECT_NEAR(az[i], r[i], 1e-10);
+    }
+}
+} // namespace
+
+TEST(SolverIncompleteFactorization, Ilu0Exact) {
+    auto a{MakeTridiagonal(100)};
+    Ilu0Preconditioner<double> ilu{a};
+    CheckExactSolve(a, ilu);
+    EXPECT_EQ(ilu.NumLowerLevels(), 100);
+    EXPECT_EQ(ilu.NumUpperLevels(), 100);
+
+    // 原地求解
+    std::vector<double> r(a.M(), 1.0);
+    std::vector<double> z(a.M());
+    ilu.Apply(r.size(), r.data(), z.data());
+    ilu.Apply(r.size(), r.data(), r.data());
+    EXPECT_EQ(r, z);
+}
+
+TEST(SolverIncompleteFactorization, Ic0Exact) {
+    auto a{MakeTridiagonal(100)};
+    Ic0Preconditioner<double> ic{a};
+    CheckExactSolve(a, ic);
+
+    // 对称下三角存储与一般存储的分解一致
+    auto lower{MakeTridiagonal(100, MatrixSymmetric::SYMMETRIC_LOWER)};
+    Ic0Preconditioner<double> ic_lower{lower};
+    CheckExactSolve(lower, ic_lower);
+}
+
+TEST(SolverIncompleteFactorization, LevelSchedule) {
+    // 5点差分矩阵的前代层数为nx + nx - 1(反对角线波前)
+    auto a{MakeLaplacian2D(20)};
+    Ilu0Preconditioner<double> ilu{a};
+    EXPECT_EQ(ilu.NumLowerLevels(), 39);
+    EXPECT_EQ(ilu.NumUpperLevels(), 39);
+    Ic0Preconditioner<double> ic{a};
+    EXPECT_EQ(ic.NumLowerLevels(), 39);
+    EXPECT_EQ(ic.NumUpperLevels(), 39);
+}
+
+TEST(SolverIncompleteFactorization, Preconditioning) {
+    auto a{MakeLaplacian2D(40)};
+    std::vector<double> b(a.M(), 1.0);
+
+    std::vector<double> x;
+    auto res_plain{CgSolver<double>{}.Solve(a, b, x)};
+    x.clear();
+    auto res_ic{CgSolver<double>{}.Solve(a, b, x, Ic0Preconditioner<double>{a})};
+    EXPECT_TRUE(res_ic.converged);
+    EXPECT_LT(res_ic.iterations, res_plain.iterations);
+    EXPECT_LE(TrueResidual(a, b, x), 1e-6);
+
+    auto c{MakeLaplacian2D(40, 0.5)};
+    x.clear();
+    auto res_gmres{GmresSolver<double>{}.Solve(c, b, x)};
+    x.clear();
+    auto res_ilu{GmresSolver<double>{}.Solve(c, b, x, Ilu0Preconditioner<double>{c})};
+    EXPECT_TRUE(res_ilu.converged);
+    EXPECT_LT(res_ilu.iterations, res_gmres.iterations);
+    EXPECT_LE(TrueResidual(c, b, x), 1e-6);
+}
+
+TEST(SolverIncompleteFactorization, Refactorize) {
+    auto a{MakeTridiagonal(50)};
+    Ilu0Preconditioner<double> ilu{a};
+    Ic0Preconditioner<double> ic{a};
+    // 符号分析缓存于模式上，共享模式的矩阵再次分析时复用
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 2);
+    Ic0Preconditioner<double> ic_shared{a};
+    EXPECT_EQ(a.GetPattern()->CacheSize(), 2);
+    CheckExactSolve(a, ic_shared);
+
+    // 相同模式的新数值只做数值分解
+    CsrStore<double, int32_t> store = a.GetStore();
+    for (auto &v : store.values) {
+        v *= 2;
+    }
+    Csr<double, int32_t> a2{store};
+    ilu.Factorize(a2);
+    ic.Factorize(a2);
+    CheckExactSolve(a2, ilu);
+    CheckExactSolve(a2, ic);
+
+    // 模式不同时拒绝重分解
+    auto b{MakeTridiagonal(51)};
+    EXPECT_THROW(ilu.Factorize(b), std::invalid_argument);
+    EXPECT_THROW(ic.Factorize(b), std::invalid_argument);
+    // 规模相同而模式不同
+    auto lower{MakeTridiagonal(50, MatrixSymmetric::SYMMETRIC_LOWER)};
+    EXPECT_THROW(ic.Factorize(lower), std::invalid_argument);
+    CooStore<double, int32_t> diag{50, 50, {}, {}, {}};
+    for (int32_t r{0}; r < 50; ++r) {
+        diag.row_indices.push_back(r);
+        diag.col_indices.push_back(r);
+        diag.values.push_back(1);
+    }
+    EXPECT_THROW(ic.Factorize(ToCsr(Coo<double, int32_t>{diag})), std::invalid_argument);
+}
+
+TEST(SolverIncompleteFactorization, Breakdown) {
+    CooStore<double, int32_t> store{2, 2, {1, 2, 2, 1}, {0, 0, 1, 1}, {0, 1, 0, 1}};
+    auto a{ToCsr(Coo<double, int32_t>{store})};
+    EXPECT_THROW(Ic0Preconditioner<double>{a}, std::runtime_error);
+
+    CooStore<double, int32_t> no_diag{2, 2, {1, 1}, {0, 1}, {1, 0}};
+    EXPECT_THROW(Ilu0Preconditioner<double>{ToCsr(Coo<double, int32_t>{no_diag})}, std::invalid_argument);
+}
@@ -0,0 +1,148 @@
+#include <cmath>
+
+#include "oops/krylov.h"
+#include "gtest/gtest.h"
+#include "test_case.h"
+
+using namespace oops;
+using namespace oops::test;
+
+namespace {
+template <typename Solver>
+void CheckSolve(Solver &solver, const Csr<double, int32_t> &a, const Preconditioner<double> &m) {
+    std::vector<double> b(a.M(), 1.0);
+    std::vector<double> x;
+    auto res{solver.Solve(a, b, x, m)};
+    EXPECT_TRUE(res.converged);
+    EXPECT_GT(res.iterations, 0);
+    EXPECT_LE(TrueResidual(a, b, x), 1e-6 * std::sqrt(static_cast<double>(b.size())));
+}
+} // namespace
+
+TEST(SolverKrylov, Cg) {
+    auto a{MakeLaplacian2D(40)};
+    CgSolver<double> solver;
+    CheckSolve(solver, a, IdentityPreconditioner<double>{});
+    CheckSolve(solver, a, JacobiPreconditioner<double>{a});
+}
+
+TEST(SolverKrylov, CgSymmetricLower) {
+    // 对称下三角存储与完整存储迭代结果一致
+    auto full{MakeLaplacian2D(16)};
+    CooStore<double, int32_t> store;
+    store.m = store.n = full.M();
+    for (std::size_t r{0}; r < full.M(); ++r) {
+        for (auto i{full.GetRowPtr()[r]}; i < full.GetRowPtr()[r + 1]; ++i) {
+            if (full.GetColIndices()[i] <= static_cast<int32_t>(r)) {
+                store.row_indices.push_back(r);
+                store.col_indices.push_back(full.GetColIndices()[i]);
+                store.values.push_back(full.GetValues()[i]);
+            }
+        }
+    }
+    auto lower{ToCsr(Coo<double, int32_t>{std::move(store), MatrixSymmetric::SYMMETRIC_LOWER})};
+
+    std::vector<double> b(full.M(), 1.0);
+    std::vector<double> x_full, x_lower;
+    CgSolver<double> solver;
+    auto res_full{solver.Solve(full, b, x_full)};
+    auto res_lower{solver.Solve(lower, b, x_lower)};
+    EXPECT_EQ(res_full.iterations, res_lower.iterations);
+    for (std::size_t i{0}; i < x_full.size(); ++i) {
+        EXPECT_NEAR(x_full[i], x_lower[i], 1e-10);
+    }
+}
+
+TEST(SolverKrylov, CsrView) {
+    // 非持有视图与持有矩阵迭代结果逐位相同
+    auto a{MakeLaplacian2D(20)};
+    std::vector<double> b(a.M(), 1.0);
+    std::vector<double> x, x_view;
+    CgSolver<double> solver;
+    auto res{solver.Solve(a, b, x)};
+    auto res_view{solver.Solve(CsrView<double, int32_t>{a}, b, x_view)};
+    EXPECT_EQ(res.iterations, res_view.iterations);
+    EXPECT_EQ(x, x_view);
+}
+
+TEST(SolverKrylov, PipelinedCg) {
+    auto a{MakeLaplacian2D(40)};
+    PipelinedCgSolver<double> solver;
+    CheckSolve(solver, a, IdentityPreconditioner<double>{});
+    CheckSolve(solver, a, JacobiPreconditioner<double>{a});
+
+    // 迭代次数与标准CG相当
+    std::vector<double> b(a.M(), 1.0);
+    std::vector<double> x_cg, x_pipe;
+    auto res_cg{CgSolver<double>{}.Solve(a, b, x_cg)};
+    auto res_pipe{solver.Solve(a, b, x_pipe)};
+    EXPECT_LE(res_pipe.iterations, res_cg.iterations + 2);
+}
+
+TEST(SolverKrylov, BiCgStab) {
+    auto a{MakeLaplacian2D(40, 0.5)};
+    BiCgStabSolver<double> solver;
+    CheckSolve(solver, a, IdentityPreconditioner<double>{});
+    CheckSolve(solver, a, JacobiPreconditioner<double>{a});
+}
+
+TEST(SolverKrylov, Gmres) {
+    auto a{MakeLaplacian2D(40, 0.5)};
+    SolverOptions options;
+    options.restart = 20;
+    options.max_iterations = 2000;
+    GmresSolver<double> solver{options};
+    CheckSolve(solver, a, IdentityPreconditioner<double>{});
+    CheckSolve(solver, a, JacobiPreconditioner<double>{a});
+}
+
+TEST(SolverKrylov, GmresExactInSmallSubspace) {
+    // 3阶矩阵在3步内得到精确解
+    CooStore<double, int32_t> store{3, 3, {2, 1, 1, 3, 1, 4}, {0, 0, 1, 1, 2, 2}, {0, 1, 1, 2, 0, 2}};
+    auto a{ToCsr(Coo<double, int32_t>{store})};
+    std::vector<double> b{1, 2, 3};
+    std::vector<double> x;
+    GmresSolver<double> solver;
+    auto res{solver.Solve(a, b, x)};
+    EXPECT_TRUE(res.converged);
+    EXPECT_LE(res.iterations, 3);
+    EXPECT_LE(TrueResidual(a, b, x), 1e-10);
+}
+
+TEST(SolverKrylov, WorkspaceReuse) {
+    auto a{MakeLaplacian2D(20)};
+    std::vector<double> b(a.M(), 1.0);
+    CgSolver<double> solver;
+    std::vector<double> x;
+    auto res1{solver.Solve(a, b, x)};
+    x.clear();
+    auto res2{solver.Solve(a, b, x)};
+    EXPECT_EQ(res1.iterations, res2.iterations);
+    EXPECT_EQ(res1.residual_norm, res2.residual_norm);
+}
+
+TEST(SolverKrylov, MaxIterations) {
+    auto a{MakeLaplacian2D(40)};
+    SolverOptions options;
+    options.max_iterations = 3;
+    CgSolver<double> solver{options};
+    std::vector<double> b(a.M(), 1.0);
+    std::vector<double> x;
+    auto res{solver.Solve(a, b, x)};
+    EXPECT_FALSE(res.converged);
+    EXPECT_EQ(res.iterations, 3);
+}
+
+TEST(SolverKrylov, InvalidArgument) {
+    auto a{MakeLaplacian2D(4)};
+    std::vector<double> b(3, 1.0);
+    std::vector<double> x;
+    EXPECT_THROW(CgSolver<double>{}.Solve(a, b, x), std::invalid_argument);
+
+    // 非空初值的长度须与矩阵一致
+    b.assign(a.M(), 1.0);
+    x.assign(a.M() + 1, 0.0);
+    EXPECT_THROW(CgSolver<double>{}.Solve(a, b, x), std::invalid_argument);
+    EXPECT_THROW(PipelinedCgSolver<double>{}.Solve(a, b, x), std::invalid_argument);
+    EXPECT_EQ(x.size(), a.M() + 1);
+}
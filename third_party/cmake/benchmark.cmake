@@ -0,0 +1,8 @@
+# google benchmark，使用系统安装版本(>= 1.6)，未找到时明确报告跳过的benchmark目标
+find_package(benchmark 1.6 QUIET)
+if(TARGET benchmark::benchmark)
+    message(STATUS "Google Benchmark ${benchmark_VERSION} found: ${benchmark_DIR}")
+else()
+    message(STATUS "Google Benchmark >= 1.6 not found, benchmark targets are skipped "
+                   "(install it or set benchmark_DIR)")
+endif()